@@ -0,0 +1,191 @@
+/**
+ * @file    BinLog.c
+ * @brief   延迟格式化二进制日志实现
+ * @details 调用处（任务或中断）关中断后把ID、时间戳和参数拷入定长记录环形缓冲区；
+ *          默认任务取出记录，编码成变长帧阻塞发送：
+ *          - ID为格式字符串在ptu_log段内的偏移
+ *          - 时间为距上一帧的us（DWT周期换算，间隔超过10s时改用tick差）
+ *          - 每秒插入一帧BINLOG_ID_TIME，上位机据此对齐绝对时间
+ *          - 参数按int32做zigzag编码，小整数只占1~2字节
+ */
+
+#include "BinLog.h"
+#include "SerialDebug.h"
+#include "Timing.h"
+
+#define BINLOG_RING_LEN       32      // 记录缓冲区条数
+#define BINLOG_PAYLOAD_MAX    64      // 单帧payload上限（ID+时间+6参数，每项最多5字节）
+#define BINLOG_TIME_SYNC_MS   1000    // 绝对时间帧间隔(ms)
+#define BINLOG_LONG_GAP_MS    10000   // 超过该间隔时用tick计算时间差（DWT约25s回绕）
+
+// 格式字符串段基址：ARMCC由armlink生成段符号；GCC下为不分配地址的段，偏移即地址
+#if defined(__CC_ARM)
+extern const char ptu_log$$Base[];
+#define BINLOG_BASE  ((uint32_t)ptu_log$$Base)
+#else
+#define BINLOG_BASE  0U
+#endif
+
+typedef struct {
+    uint32_t id;
+    uint32_t cycles;
+    uint32_t tick;
+    uint32_t argc;
+    uint32_t args[BINLOG_ARGS_MAX];
+} BinLogRecord;
+
+static BinLogRecord binlog_ring[BINLOG_RING_LEN];
+static volatile uint32_t binlog_head = 0;   // 写入位置（调用处）
+static volatile uint32_t binlog_tail = 0;   // 读取位置（默认任务）
+static volatile uint32_t binlog_dropped = 0;
+
+// 编码状态（只在默认任务中访问）
+static uint32_t last_cycles = 0;
+static uint32_t last_tick = 0;
+static uint32_t last_sync_tick = 0;
+static uint8_t synced = 0;
+
+// ==================== 内部函数 ====================
+
+/**
+ * @brief  写入无符号LEB128变长整数
+ * @retval 写入的字节数
+ */
+static uint32_t BinLog_PutVarint(uint8_t *p, uint32_t value)
+{
+    uint32_t n = 0;
+
+    while (value >= 0x80U)
+    {
+        p[n++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    p[n++] = (uint8_t)value;
+    return n;
+}
+
+/**
+ * @brief  编码一帧并发送
+ * @param  id: 格式ID
+ * @param  cycles: 记录时的DWT周期计数
+ * @param  tick: 记录时的系统tick(ms)
+ * @param  argc: 参数个数
+ * @param  args: 参数
+ */
+static void BinLog_SendFrame(uint32_t id, uint32_t cycles, uint32_t tick, uint32_t argc, const uint32_t *args)
+{
+    uint8_t frame[BINLOG_PAYLOAD_MAX + 3];
+    uint8_t *payload = &frame[2];
+    uint32_t len = 0;
+    uint32_t dt_us;
+    uint8_t sum = 0;
+
+    if (tick - last_tick >= BINLOG_LONG_GAP_MS)
+    {
+        dt_us = (tick - last_tick) * 1000U;
+    }
+    else
+    {
+        dt_us = Timing_CyclesToUs(cycles - last_cycles);
+    }
+    last_cycles = cycles;
+    last_tick = tick;
+
+    len += BinLog_PutVarint(&payload[len], id);
+    len += BinLog_PutVarint(&payload[len], dt_us);
+    for (uint32_t i = 0; i < argc; i++)
+    {
+        int32_t v = (int32_t)args[i];
+        len += BinLog_PutVarint(&payload[len], ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+    }
+
+    for (uint32_t i = 0; i < len; i++) sum += payload[i];
+    frame[0] = BINLOG_FRAME_SYNC;
+    frame[1] = (uint8_t)len;
+    frame[2 + len] = (uint8_t)~sum;
+
+    SerialDebug_Write(frame, (uint16_t)(len + 3));
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  记录一条日志
+ * @param  fmt: 格式字符串
+ * @param  argc: 参数个数
+ * @param  args: 参数
+ * @retval None
+ */
+void BinLog_Write(const char *fmt, uint32_t argc, const uint32_t *args)
+{
+    uint32_t cycles = Timing_GetCycles();
+    uint32_t head, next;
+    BinLogRecord *r;
+
+    if (argc > BINLOG_ARGS_MAX) argc = BINLOG_ARGS_MAX;
+
+    __disable_irq();
+    head = binlog_head;
+    next = (head + 1U) % BINLOG_RING_LEN;
+    if (next == binlog_tail)
+    {
+        binlog_dropped++;
+        __enable_irq();
+        return;
+    }
+
+    r = &binlog_ring[head];
+    r->id = (uint32_t)(uintptr_t)fmt - BINLOG_BASE;
+    r->cycles = cycles;
+    r->tick = HAL_GetTick();
+    r->argc = argc;
+    for (uint32_t i = 0; i < argc; i++) r->args[i] = args[i];
+    binlog_head = next;
+    __enable_irq();
+}
+
+/**
+ * @brief  float按位转为32位参数
+ */
+uint32_t BinLog_FloatBits(float value)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits;
+
+    bits.f = value;
+    return bits.u;
+}
+
+/**
+ * @brief  编码并发送缓冲区中的日志
+ * @retval None
+ */
+void BinLog_Flush(void)
+{
+    uint32_t dropped;
+
+    while (binlog_tail != binlog_head)
+    {
+        const BinLogRecord *r = &binlog_ring[binlog_tail];
+
+        if (!synced || r->tick - last_sync_tick >= BINLOG_TIME_SYNC_MS)
+        {
+            BinLog_SendFrame(BINLOG_ID_TIME, r->cycles, r->tick, 1, &r->tick);
+            last_sync_tick = r->tick;
+            synced = 1;
+        }
+        BinLog_SendFrame(r->id, r->cycles, r->tick, r->argc, r->args);
+        binlog_tail = (binlog_tail + 1U) % BINLOG_RING_LEN;
+    }
+
+    if (binlog_dropped)
+    {
+        __disable_irq();
+        dropped = binlog_dropped;
+        binlog_dropped = 0;
+        __enable_irq();
+        BinLog_SendFrame(BINLOG_ID_DROPPED, Timing_GetCycles(), HAL_GetTick(), 1, &dropped);
+    }
+}
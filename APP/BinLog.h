@@ -0,0 +1,105 @@
+/**
+ * @file    BinLog.h
+ * @brief   延迟格式化二进制日志头文件
+ * @details 格式字符串放在单独的ptu_log段，运行时只记录其段内偏移(ID)、DWT时间戳和参数原始值，
+ *          由默认任务编码成二进制帧从USART2发出，上位机host/tools/binlog_decode.py从固件ELF
+ *          读出格式字符串还原文本。单条日志在调用处只有几十个周期、几个字节
+ *
+ *          用法: BINLOG("Track: Pos[%d,%d] PID[%.1f]", x, y, BINLOG_F(out));
+ *          - 格式必须是字符串常量，不含换行（上位机逐条换行）
+ *          - 参数最多BINLOG_ARGS_MAX个，均按32位传递；%f参数必须用BINLOG_F()包装
+ *          - 支持%d %i %u %x %X %o %c %f %e %g及标志/宽度/精度，不支持%s
+ *
+ *          帧格式: 0xFF len payload checksum
+ *          - payload = varint(ID) varint(距上一帧us) zigzag-varint(参数)...
+ *          - checksum = payload各字节之和取反
+ *          文本输出只含0x0A/0x0D/0x20~0x7E，上位机按0xFF区分二进制帧
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _BINLOG_H
+#define _BINLOG_H
+
+#include "stm32f4xx_hal.h"
+
+// 1=二进制日志, 0=退回SerialDebug_Printf直接格式化（调用处不用修改）
+#define BINLOG_ENABLE    1
+
+#define BINLOG_ARGS_MAX  6              ///< 单条日志参数个数上限
+#define BINLOG_FRAME_SYNC 0xFFU         ///< 帧起始字节
+#define BINLOG_ID_DROPPED 0xFFFFFFFFU   ///< 保留ID: 缓冲区满丢弃的条数（参数1个）
+#define BINLOG_ID_TIME    0xFFFFFFFEU   ///< 保留ID: 系统tick(ms)，用于上位机对齐绝对时间（参数1个）
+
+// 格式字符串所在段：GCC下注入段属性去掉"a"标志，链接后保留在ELF中但不占地址空间、不下载；
+// ARMCC没有不加载的只读段，字符串随程序放在Flash中，运行时不读取
+#if defined(__CC_ARM)
+  #define BINLOG_SECTION  "ptu_log"
+#elif defined(__arm__)
+  #define BINLOG_SECTION  ".ptu_log,\"\",%progbits @"
+#else
+  #define BINLOG_SECTION  ".ptu_log,\"\",@progbits #"
+#endif
+
+#if BINLOG_ENABLE
+
+#define BINLOG_F(x)      BinLog_FloatBits((float)(x))
+#define BINLOG_U32(x)    ((uint32_t)(x))
+
+#define BINLOG_EMIT(fmt, n, args) \
+    do { \
+        static const char binlog_fmt_[] __attribute__((section(BINLOG_SECTION), used)) = fmt; \
+        BinLog_Write(binlog_fmt_, (n), (args)); \
+    } while (0)
+
+#define BINLOG_0(fmt)                         BINLOG_EMIT(fmt, 0, NULL)
+#define BINLOG_1(fmt, a)                      BINLOG_EMIT(fmt, 1, ((const uint32_t[]){ BINLOG_U32(a) }))
+#define BINLOG_2(fmt, a, b)                   BINLOG_EMIT(fmt, 2, ((const uint32_t[]){ BINLOG_U32(a), BINLOG_U32(b) }))
+#define BINLOG_3(fmt, a, b, c)                BINLOG_EMIT(fmt, 3, ((const uint32_t[]){ BINLOG_U32(a), BINLOG_U32(b), BINLOG_U32(c) }))
+#define BINLOG_4(fmt, a, b, c, d)             BINLOG_EMIT(fmt, 4, ((const uint32_t[]){ BINLOG_U32(a), BINLOG_U32(b), BINLOG_U32(c), BINLOG_U32(d) }))
+#define BINLOG_5(fmt, a, b, c, d, e)          BINLOG_EMIT(fmt, 5, ((const uint32_t[]){ BINLOG_U32(a), BINLOG_U32(b), BINLOG_U32(c), BINLOG_U32(d), BINLOG_U32(e) }))
+#define BINLOG_6(fmt, a, b, c, d, e, f)       BINLOG_EMIT(fmt, 6, ((const uint32_t[]){ BINLOG_U32(a), BINLOG_U32(b), BINLOG_U32(c), BINLOG_U32(d), BINLOG_U32(e), BINLOG_U32(f) }))
+#define BINLOG_SELECT(fmt, a, b, c, d, e, f, m, ...) m
+
+/**
+ * @brief  记录一条日志: BINLOG(fmt, 参数...)
+ */
+#define BINLOG(...) \
+    BINLOG_SELECT(__VA_ARGS__, BINLOG_6, BINLOG_5, BINLOG_4, BINLOG_3, BINLOG_2, BINLOG_1, BINLOG_0, 0)(__VA_ARGS__)
+
+#else
+
+#include "SerialDebug.h"
+
+#define BINLOG_F(x)      ((double)(x))
+#define BINLOG(...) \
+    do { \
+        SerialDebug_Printf(__VA_ARGS__); \
+        SerialDebug_Printf("\r\n"); \
+    } while (0)
+
+#endif
+
+/**
+ * @brief  记录一条日志（由BINLOG宏调用）
+ * @param  fmt: ptu_log段中的格式字符串
+ * @param  argc: 参数个数
+ * @param  args: 参数（32位原始值）
+ * @retval None
+ * @note   可在中断中调用；缓冲区满时丢弃并计数
+ */
+void BinLog_Write(const char *fmt, uint32_t argc, const uint32_t *args);
+
+/**
+ * @brief  float按位转为32位参数
+ */
+uint32_t BinLog_FloatBits(float value);
+
+/**
+ * @brief  编码并发送缓冲区中的日志
+ * @retval None
+ * @note   在默认任务中周期调用（阻塞发送USART2）
+ */
+void BinLog_Flush(void);
+
+#endif
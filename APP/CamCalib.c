@@ -0,0 +1,209 @@
+/**
+ * @file    CamCalib.c
+ * @brief   相机-云台旋转标定（手眼标定）实现
+ * @details 标定流程（每轴）:
+ *          1. 转到+step，等待静止，取多帧平均坐标
+ *          2. 转到-step，同样取平均坐标
+ *          3. 回到原位；两处坐标之差/(2*step)即该轴的图像位移向量(像素/度)
+ *
+ *          模型: 图像位移 = R(θ)·diag(sx,sy)·k·转角，sx/sy为各轴的安装方向（±1）。
+ *          按各轴主分量的符号归一化后，水平向量u≈k(cosθ, sinθ)，垂直向量v≈k(-sinθ, cosθ)，
+ *          θ取两向量对参考轴的最小二乘旋转: θ = atan2(uy - vx, ux + vy)
+ *
+ * @note    只能处理|θ|<45°的安装误差（用主分量判断各轴方向）；
+ *          两向量夹角偏离90°过多（skew）说明目标在动或被测轴有回差，结果不写入
+ */
+
+#include "CamCalib.h"
+#include "GimbalControl.h"
+#include "Motor.h"
+#include "Camera.h"
+#include "SerialDebug.h"
+#include "cmsis_os.h"
+#include <math.h>
+
+// ==================== 标定参数 ====================
+
+#define CAMCALIB_FRAMES          10     // 每处取平均的帧数
+#define CAMCALIB_FRAME_TIMEOUT   1000   // 取帧超时(ms)
+#define CAMCALIB_SETTLE_MS       500    // 转动后等待云台和图像静止(ms)
+#define CAMCALIB_JITTER_PX       3      // 同一处各帧坐标的最大跨度(像素)
+#define CAMCALIB_SKEW_MAX_DEG    5.0f   // 两轴图像向量夹角偏离90°的上限(度)
+#define CAMCALIB_SCALE_MIN       0.5f   // 像素比例下限(像素/度)，低于该值视为目标未随云台移动
+
+#define RAD_TO_DEG  57.29578f
+
+// 挂起的请求（串口命令写入，默认任务执行）
+static volatile float pending_step = 0.0f;
+
+// ==================== 内部函数 ====================
+
+/**
+ * @brief  相对转动单轴
+ */
+static void CamCalib_Move(uint8_t motor_id, float deg)
+{
+    if (motor_id == MOTOR_ID_HORIZONTAL)
+    {
+        Motor_MoveHorizontal(deg);
+    }
+    else
+    {
+        Motor_MoveVertical(deg);
+    }
+}
+
+/**
+ * @brief  等待静止后取多帧平均坐标
+ * @param  x: 平均X坐标输出（像素）
+ * @param  y: 平均Y坐标输出（像素）
+ * @retval 1=成功, 0=目标丢失或抖动超过阈值
+ */
+static uint8_t CamCalib_Measure(float *x, float *y)
+{
+    int16_t fx, fy, min_x = 0, max_x = 0, min_y = 0, max_y = 0;
+    int32_t sum_x = 0, sum_y = 0;
+    uint32_t cycles;
+    uint32_t frames = 0;
+    uint32_t start;
+
+    osDelay(CAMCALIB_SETTLE_MS);
+
+    // 丢弃转动期间的旧帧
+    while (Camera_TryGetSample(&fx, &fy, &cycles)) {}
+
+    start = HAL_GetTick();
+    while (frames < CAMCALIB_FRAMES)
+    {
+        if (HAL_GetTick() - start >= CAMCALIB_FRAME_TIMEOUT) return 0;
+
+        if (!Camera_TryGetSample(&fx, &fy, &cycles))
+        {
+            osDelay(1);
+            continue;
+        }
+
+        if (frames == 0 || fx < min_x) min_x = fx;
+        if (frames == 0 || fx > max_x) max_x = fx;
+        if (frames == 0 || fy < min_y) min_y = fy;
+        if (frames == 0 || fy > max_y) max_y = fy;
+        sum_x += fx;
+        sum_y += fy;
+        frames++;
+    }
+
+    *x = (float)sum_x / frames;
+    *y = (float)sum_y / frames;
+    return (max_x - min_x) < CAMCALIB_JITTER_PX && (max_y - min_y) < CAMCALIB_JITTER_PX;
+}
+
+/**
+ * @brief  测量单轴的图像位移向量
+ * @param  motor_id: 电机地址
+ * @param  step: 标定转角(度)
+ * @param  jx: X方向像素/度输出
+ * @param  jy: Y方向像素/度输出
+ * @retval 1=成功, 0=目标丢失或不稳定（云台已回到原位）
+ */
+static uint8_t CamCalib_MeasureAxis(uint8_t motor_id, float step, float *jx, float *jy)
+{
+    float xp, yp, xn, yn;
+    uint8_t ok;
+
+    CamCalib_Move(motor_id, step);
+    ok = CamCalib_Measure(&xp, &yp);
+    CamCalib_Move(motor_id, -2.0f * step);
+    ok = ok && CamCalib_Measure(&xn, &yn);
+    CamCalib_Move(motor_id, step);
+
+    if (!ok) return 0;
+
+    *jx = (xp - xn) / (2.0f * step);
+    *jy = (yp - yn) / (2.0f * step);
+    return 1;
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  提交标定请求
+ * @param  step: 标定转角(度)
+ * @retval 1=已受理, 0=参数无效或忙
+ */
+uint8_t CamCalib_Request(float step)
+{
+    if (step < CAMCALIB_STEP_MIN || step > CAMCALIB_STEP_MAX) return 0;
+    if (pending_step != 0.0f) return 0;
+
+    pending_step = step;
+    return 1;
+}
+
+/**
+ * @brief  执行挂起的标定
+ * @retval None
+ */
+void CamCalib_Process(void)
+{
+    float step = pending_step;
+    float hx, hy, vx, vy;
+    float sx, sy, ux, uy, wx, wy;
+    float roll, skew, scale_h, scale_v;
+
+    if (step == 0.0f) return;
+
+    SerialDebug_Printf("Camera calibration: step %.1f deg\r\n", step);
+
+    if (!CamCalib_MeasureAxis(MOTOR_ID_HORIZONTAL, step, &hx, &hy))
+    {
+        SerialDebug_Printf("Error: H axis: target missing or not static\r\n");
+        pending_step = 0.0f;
+        Gimbal_ReleaseMotorBus();
+        return;
+    }
+    if (!CamCalib_MeasureAxis(MOTOR_ID_VERTICAL, step, &vx, &vy))
+    {
+        SerialDebug_Printf("Error: V axis: target missing or not static\r\n");
+        pending_step = 0.0f;
+        Gimbal_ReleaseMotorBus();
+        return;
+    }
+
+    SerialDebug_Printf("  H: (%+.2f, %+.2f) px/deg\r\n", hx, hy);
+    SerialDebug_Printf("  V: (%+.2f, %+.2f) px/deg\r\n", vx, vy);
+
+    // 按各轴主分量符号归一化（安装方向），再求旋转角
+    sx = (hx >= 0.0f) ? 1.0f : -1.0f;
+    sy = (vy >= 0.0f) ? 1.0f : -1.0f;
+    ux = sx * hx;
+    uy = sx * hy;
+    wx = sy * vx;
+    wy = sy * vy;
+
+    scale_h = sqrtf(ux * ux + uy * uy);
+    scale_v = sqrtf(wx * wx + wy * wy);
+    roll = atan2f(uy - wx, ux + wy) * RAD_TO_DEG;
+    // 两向量夹角与90°之差
+    skew = atan2f(ux * wy - uy * wx, ux * wx + uy * wy) * RAD_TO_DEG - 90.0f;
+
+    SerialDebug_Printf("  roll=%+.2f deg skew=%+.2f deg scale H=%.2f V=%.2f px/deg\r\n",
+                       roll, skew, scale_h, scale_v);
+
+    if (scale_h < CAMCALIB_SCALE_MIN || scale_v < CAMCALIB_SCALE_MIN
+        || fabsf(ux) < fabsf(uy) || fabsf(wy) < fabsf(wx))
+    {
+        SerialDebug_Printf("Error: Image motion does not follow the gimbal, not applied\r\n");
+    }
+    else if (fabsf(skew) > CAMCALIB_SKEW_MAX_DEG)
+    {
+        SerialDebug_Printf("Error: Skew too large (target moving or backlash), not applied\r\n");
+    }
+    else
+    {
+        Gimbal_SetCameraRoll(roll);
+        SerialDebug_Printf("Camera roll set to %+.2f deg\r\n", roll);
+    }
+
+    pending_step = 0.0f;
+    Gimbal_ReleaseMotorBus();
+}
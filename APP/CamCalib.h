@@ -0,0 +1,37 @@
+/**
+ * @file    CamCalib.h
+ * @brief   相机-云台旋转标定（手眼标定）头文件
+ * @details 相机绕光轴相对水平轴有滚转时，纯水平转动在图像中是斜线，
+ *          dx→水平、dy→垂直的独立控制会相互耦合，目标螺旋收敛。
+ *          标定对静止目标分别做已知的水平、垂直转动，测出两轴的图像位移向量，
+ *          估计相机到云台的旋转角，控制器对偏差向量做逆旋转后再送入PID
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _CAMCALIB_H
+#define _CAMCALIB_H
+
+#include "stm32f4xx_hal.h"
+
+#define CAMCALIB_STEP_DEFAULT  8.0f    ///< 默认标定转角(度)
+#define CAMCALIB_STEP_MIN      2.0f    ///< 最小标定转角(度)
+#define CAMCALIB_STEP_MAX      15.0f   ///< 最大标定转角(度)
+
+/**
+ * @brief  提交标定请求
+ * @param  step: 标定转角(度)，每轴在±step两处测量
+ * @retval 1=已受理, 0=参数无效或上一次标定尚未完成
+ * @note   可在中断中调用；调用前需关闭跟踪（disable），
+ *         目标静止且尽量居中（两轴转动±step后仍在视野内）
+ */
+uint8_t CamCalib_Request(float step);
+
+/**
+ * @brief  执行挂起的标定
+ * @retval None
+ * @note   在默认任务中周期调用（约5s）；结果合理时自动写入控制器（Gimbal_SetCameraRoll）
+ */
+void CamCalib_Process(void);
+
+#endif
@@ -1,14 +1,19 @@
 /**
  * @file    Camera.c
  * @brief   视觉数据接收模块实现
- * @details 接收MaixCAM通过USART1发送的目标坐标"X,Y\n"，计算偏差
+ * @details 接收MaixCAM通过USART1发送的目标坐标"X,Y\n"，计算偏差；
+ *          以字母开头的行为带标签的数据帧（如统计帧"S,..."）
  * @version 1.0
  * @date    2026-02-25
  */
 
 #include "Camera.h"
+#include "Timing.h"
+#include "BinLog.h"
+#include "UartFast.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdio.h>
 
 // 调试开关（编译时）
 #define DEBUG_CAMERA 1
@@ -22,8 +27,8 @@ static uint8_t camera_debug_enabled = 0;  // 默认关闭调试输出
 #define CAMERA_CENTER_X (CAMERA_WIDTH / 2)   // 120
 #define CAMERA_CENTER_Y (CAMERA_HEIGHT / 2)  // 120
 
-// 接收缓冲区
-static uint8_t camera_rx_buf[32];
+// 接收缓冲区（统计帧约140字节）
+static uint8_t camera_rx_buf[192];
 static volatile uint16_t camera_rx_index = 0;
 static volatile uint8_t camera_data_ready = 0;
 
@@ -31,6 +36,22 @@ static volatile uint8_t camera_data_ready = 0;
 static int16_t target_x = 0;  // 目标X坐标（0表示无目标）
 static int16_t target_y = 0;  // 目标Y坐标（0表示无目标）
 static uint8_t target_valid = 0;  // 目标是否有效
+static uint32_t target_cycles = 0;  // 坐标帧解析完成时的DWT周期计数
+static volatile uint8_t camera_sample_ready = 0;  // 带时间戳的新样本（与camera_data_ready独立）
+
+// 相机端分阶段耗时统计
+static CameraStats camera_stats;
+static volatile uint8_t camera_stats_ready = 0;
+
+// 收到的回环帧数（压力测试）
+static volatile uint32_t camera_loop_count = 0;
+
+// 最近一次收到完整帧的时间（任何帧都说明链路正常）
+static volatile uint32_t camera_rx_tick = 0;
+
+static const char *const camera_stage_names[CAMERA_STAGE_COUNT] = {
+    "cap", "blob", "score", "misc", "tx", "disp", "total"
+};
 
 /**
  * @brief  初始化摄像头接收模块
@@ -42,9 +63,74 @@ void Camera_Init(void)
     camera_rx_index = 0;
     camera_data_ready = 0;
     target_valid = 0;
+    camera_sample_ready = 0;
+    memset(&camera_stats, 0, sizeof(camera_stats));
+    camera_stats_ready = 0;
+    
+    // 启动USART1 DMA接收
+    UartFast_StartRx(UART_FAST_CAMERA, Camera_UART_RxCallback);
+}
+
+/**
+ * @brief  解析统计帧
+ * @param  payload: 标签后的数据（"frames,fps_x10,min,avg,max,..."）
+ * @retval None
+ * @note   字段数不完整时整帧丢弃
+ */
+static void Camera_ParseStats(char *payload)
+{
+    uint32_t fields[2 + CAMERA_STAGE_COUNT * 3];
+    uint8_t count = 0;
+    char *p = payload;
+    
+    while (count < sizeof(fields) / sizeof(fields[0])) {
+        char *end;
+        fields[count] = strtoul(p, &end, 10);
+        if (end == p) break;
+        count++;
+        if (*end != ',') break;
+        p = end + 1;
+    }
+    
+    if (count != sizeof(fields) / sizeof(fields[0])) {
+        return;
+    }
+    
+    camera_stats.frames = fields[0];
+    camera_stats.fps_x10 = fields[1];
+    for (uint8_t i = 0; i < CAMERA_STAGE_COUNT; i++) {
+        camera_stats.stage[i].min = fields[2 + i * 3];
+        camera_stats.stage[i].avg = fields[3 + i * 3];
+        camera_stats.stage[i].max = fields[4 + i * 3];
+    }
+    camera_stats.received_tick = HAL_GetTick();
+    camera_stats.valid = 1;
+    camera_stats_ready = 1;
+}
+
+/**
+ * @brief  解析带标签的数据帧
+ * @retval None
+ * @note   数据格式: "<TAG>,..."，例如"S,60,298,..."
+ */
+static void Camera_ParseTagged(void)
+{
+    char tag = (char)camera_rx_buf[0];
+    
+    if (camera_rx_buf[1] != ',') {
+        return;
+    }
     
-    // 启动USART1中断接收
-    HAL_UART_Receive_IT(&huart1, &camera_rx_buf[camera_rx_index], 1);
+    switch (tag) {
+        case 'S':
+            Camera_ParseStats((char*)&camera_rx_buf[2]);
+            break;
+        case 'L':
+            camera_loop_count++;   // 相机回送的回环帧
+            break;
+        default:
+            break;
+    }
 }
 
 /**
@@ -54,18 +140,21 @@ void Camera_Init(void)
  */
 static void Camera_ParseData(void)
 {
+    if (camera_rx_buf[0] >= 'A' && camera_rx_buf[0] <= 'Z') {
+        Camera_ParseTagged();
+        return;
+    }
+    
     char *comma = strchr((char*)camera_rx_buf, ',');
     if (comma != NULL) {
         *comma = '\0';
         int16_t x = atoi((char*)camera_rx_buf);
         int16_t y = atoi(comma + 1);
         
-        // 调试输出：显示接收到的原始数据
+        // 调试输出：显示接收到的坐标（二进制日志，中断中只记录参数）
         #if DEBUG_CAMERA
         if (camera_debug_enabled) {
-            extern void SerialDebug_Printf(const char *format, ...);
-            SerialDebug_Printf("[CAM RX] Raw: \"%s,%d\" -> X=%d Y=%d\r\n", 
-                              (char*)camera_rx_buf, y, x, y);
+            BINLOG("[CAM RX] X=%d Y=%d", x, y);
         }
         #endif
         
@@ -75,8 +164,7 @@ static void Camera_ParseData(void)
             camera_data_ready = 0;
             #if DEBUG_CAMERA
             if (camera_debug_enabled) {
-                extern void SerialDebug_Printf(const char *format, ...);
-                SerialDebug_Printf("[CAM] No target (0,0)\r\n");
+                BINLOG("[CAM] No target (0,0)");
             }
             #endif
             return;
@@ -90,13 +178,14 @@ static void Camera_ParseData(void)
         
         target_x = x;
         target_y = y;
+        target_cycles = Timing_GetCycles();
         target_valid = 1;
         camera_data_ready = 1;
+        camera_sample_ready = 1;
         
         #if DEBUG_CAMERA
         if (camera_debug_enabled) {
-            extern void SerialDebug_Printf(const char *format, ...);
-            SerialDebug_Printf("[CAM] Target valid: (%d,%d)\r\n", x, y);
+            BINLOG("[CAM] Target valid: (%d,%d)", x, y);
         }
         #endif
     }
@@ -105,21 +194,22 @@ static void Camera_ParseData(void)
 /**
  * @brief  UART接收回调函数
  * @retval None
- * @note   在USART1中断中调用，逐字符接收并解析
+ * @param  received: 收到的字节
+ * @note   在USART1空闲线/DMA中断中逐字节调用，收到行尾时解析
  */
-void Camera_UART_RxCallback(void)
+void Camera_UART_RxCallback(uint8_t received)
 {
-    uint8_t received = camera_rx_buf[camera_rx_index];
-    
     if (received == '\n' || received == '\r') {
         if (camera_rx_index > 0) {  // 只有当缓冲区有数据时才解析
             camera_rx_buf[camera_rx_index] = '\0';
+            camera_rx_tick = HAL_GetTick();
             Camera_ParseData();
         }
         camera_rx_index = 0;
-    } else if ((received >= '0' && received <= '9') || received == ',') {
-        // 只接受数字和逗号
-        camera_rx_index++;
+    } else if ((received >= '0' && received <= '9') || received == ',' ||
+               (received >= 'A' && received <= 'Z')) {
+        // 只接受数字、逗号和帧标签（大写字母）
+        camera_rx_buf[camera_rx_index++] = received;
         if (camera_rx_index >= sizeof(camera_rx_buf) - 1) {
             // 缓冲区溢出，重置
             camera_rx_index = 0;
@@ -127,29 +217,54 @@ void Camera_UART_RxCallback(void)
     } else {
         // 忽略其他字符，不增加索引
     }
-    
-    // 继续接收下一个字节到当前索引位置
-    HAL_UART_Receive_IT(&huart1, &camera_rx_buf[camera_rx_index], 1);
 }
 
 /**
  * @brief  尝试获取目标偏差
  * @param  dx: 水平偏差指针（输出）
  * @param  dy: 垂直偏差指针（输出）
+ * @param  cycles: 该坐标帧到达时的DWT周期计数（输出）
  * @retval 1=有新数据, 0=无数据
- * @note   偏差 = 目标位置 - 中心位置(120,120)
+ * @note   偏差 = 目标位置 - 中心位置(120,120)；坐标和时间戳在关中断下一起取出，属于同一帧
  */
-int Camera_TryGetDelta(int16_t *dx, int16_t *dy)
+int Camera_TryGetDelta(int16_t *dx, int16_t *dy, uint32_t *cycles)
 {
     if (!camera_data_ready || !target_valid) {
         return 0;
     }
     
     // 计算偏差（目标位置 - 中心位置）
+    __disable_irq();
     *dx = target_x - CAMERA_CENTER_X;
     *dy = target_y - CAMERA_CENTER_Y;
-    
+    *cycles = target_cycles;
     camera_data_ready = 0;  // 清除数据就绪标志
+    __enable_irq();
+    
+    return 1;
+}
+
+/**
+ * @brief  尝试获取带时间戳的目标坐标
+ * @param  x: X坐标指针（输出）
+ * @param  y: Y坐标指针（输出）
+ * @param  cycles: 帧到达时的DWT周期计数（输出）
+ * @retval 1=有新数据, 0=无数据
+ * @note   时间戳在USART1中断中收到行尾时记录，不包含相机端处理和串口传输时间；
+ *         就绪标志独立于Camera_TryGetDelta，两者互不消耗
+ */
+uint8_t Camera_TryGetSample(int16_t *x, int16_t *y, uint32_t *cycles)
+{
+    if (!camera_sample_ready) {
+        return 0;
+    }
+    
+    __disable_irq();
+    *x = target_x;
+    *y = target_y;
+    *cycles = target_cycles;
+    camera_sample_ready = 0;
+    __enable_irq();
     
     return 1;
 }
@@ -175,6 +290,118 @@ uint8_t Camera_IsTargetValid(void)
     return target_valid;
 }
 
+/**
+ * @brief  获取相机链路空闲时间
+ * @retval 距最近一次收到完整帧的时间(ms)
+ */
+uint32_t Camera_GetLinkIdleMs(void)
+{
+    uint32_t rx_tick = camera_rx_tick;
+
+    return HAL_GetTick() - rx_tick;
+}
+
+/**
+ * @brief  向相机下发云台角速度和指向
+ * @param  rate_h: 水平角速度（度/秒）
+ * @param  rate_v: 垂直角速度（度/秒）
+ * @param  pointing_valid: 1=指向有效, 0=只发送角速度
+ * @param  pan: 水平指向（度）
+ * @param  tilt: 垂直指向（度）
+ * @retval None
+ */
+void Camera_SendGimbalRate(float rate_h, float rate_v, uint8_t pointing_valid, float pan, float tilt)
+{
+    char buf[48];
+    int len;
+    
+    if (pointing_valid) {
+        len = snprintf(buf, sizeof(buf), "R,%d,%d,%ld,%ld\n",
+                       (int)(rate_h * 100.0f), (int)(rate_v * 100.0f),
+                       (long)(pan * 100.0f), (long)(tilt * 100.0f));
+    } else {
+        len = snprintf(buf, sizeof(buf), "R,%d,%d\n",
+                       (int)(rate_h * 100.0f), (int)(rate_v * 100.0f));
+    }
+    if (len > 0 && len < (int)sizeof(buf)) {
+        UartFast_Send(UART_FAST_CAMERA, (const uint8_t *)buf, (uint16_t)len);
+    }
+}
+
+/**
+ * @brief  向相机下发回环帧
+ * @param  seq: 帧序号
+ * @retval 发送的字节数，0=发送缓冲区已满
+ */
+uint32_t Camera_SendLoopback(uint32_t seq)
+{
+    char buf[32];
+    
+    // 固定31字节：序号后补数字填充
+    int len = snprintf(buf, sizeof(buf), "L,%010lu,01234567890123456\n",
+                       (unsigned long)seq);
+    if (len <= 0 || len >= (int)sizeof(buf)) {
+        return 0;
+    }
+    if (!UartFast_Send(UART_FAST_CAMERA, (const uint8_t *)buf, (uint16_t)len)) {
+        return 0;
+    }
+    return (uint32_t)len;
+}
+
+/**
+ * @brief  获取收到的回环帧数
+ * @retval 上电以来的累计帧数
+ */
+uint32_t Camera_GetLoopbackCount(void)
+{
+    return camera_loop_count;
+}
+
+/**
+ * @brief  获取最近一次相机端耗时统计
+ * @param  stats: 统计数据指针（输出）
+ * @retval 1=有效, 0=尚未收到统计帧
+ */
+uint8_t Camera_GetStats(CameraStats *stats)
+{
+    __disable_irq();
+    *stats = camera_stats;
+    __enable_irq();
+    
+    return stats->valid;
+}
+
+/**
+ * @brief  尝试获取新的相机端耗时统计
+ * @param  stats: 统计数据指针（输出）
+ * @retval 1=有新统计帧, 0=无
+ */
+uint8_t Camera_TryGetStats(CameraStats *stats)
+{
+    if (!camera_stats_ready) {
+        return 0;
+    }
+    
+    camera_stats_ready = 0;
+    Camera_GetStats(stats);
+    
+    return 1;
+}
+
+/**
+ * @brief  获取阶段名称
+ * @param  stage: 阶段
+ * @retval 阶段名称字符串
+ */
+const char *Camera_GetStageName(CameraStage stage)
+{
+    if (stage >= CAMERA_STAGE_COUNT) {
+        return "?";
+    }
+    return camera_stage_names[stage];
+}
+
 /**
  * @brief  设置调试输出开关
  * @param  enabled: 1=开启, 0=关闭
@@ -12,6 +12,40 @@
 #include "stm32f4xx_hal.h"
 #include "usart.h"
 
+/**
+ * @brief 相机端处理阶段（与maixcam.py中StageProfiler.STAGES顺序一致）
+ */
+typedef enum {
+    CAMERA_STAGE_CAPTURE = 0,  ///< 采集
+    CAMERA_STAGE_BLOB,         ///< 阈值+blob搜索
+    CAMERA_STAGE_SCORE,        ///< 候选评分
+    CAMERA_STAGE_MISC,         ///< 杂波图/云台状态接收/自动曝光
+    CAMERA_STAGE_TX,           ///< 串口发送
+    CAMERA_STAGE_DISPLAY,      ///< 显示
+    CAMERA_STAGE_TOTAL,        ///< 整帧
+    CAMERA_STAGE_COUNT
+} CameraStage;
+
+/**
+ * @brief 单个阶段耗时统计（单位us）
+ */
+typedef struct {
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+} CameraStageTime;
+
+/**
+ * @brief 相机端分阶段耗时统计（来自统计帧 "S,..."）
+ */
+typedef struct {
+    uint32_t frames;                           ///< 统计窗口内帧数
+    uint32_t fps_x10;                          ///< 帧率×10
+    CameraStageTime stage[CAMERA_STAGE_COUNT]; ///< 各阶段耗时
+    uint32_t received_tick;                    ///< 收到时的系统tick(ms)
+    uint8_t valid;                             ///< 1=已收到过统计帧
+} CameraStats;
+
 /**
  * @brief  初始化摄像头接收模块
  * @retval None
@@ -23,9 +57,20 @@ void Camera_Init(void);
  * @brief  尝试获取目标偏差（相对于屏幕中心）
  * @param  dx: 水平偏差指针（输出）
  * @param  dy: 垂直偏差指针（输出）
+ * @param  cycles: 该坐标帧到达时的DWT周期计数（输出，见Timing.h）
  * @retval 1=有新数据, 0=无数据
  */
-int Camera_TryGetDelta(int16_t *dx, int16_t *dy);
+int Camera_TryGetDelta(int16_t *dx, int16_t *dy, uint32_t *cycles);
+
+/**
+ * @brief  尝试获取带时间戳的目标坐标
+ * @param  x: X坐标指针（输出）
+ * @param  y: Y坐标指针（输出）
+ * @param  cycles: 帧到达时的DWT周期计数（输出，见Timing.h）
+ * @retval 1=有新数据, 0=无数据
+ * @note   用于延迟测量，不影响Camera_TryGetDelta的就绪标志
+ */
+uint8_t Camera_TryGetSample(int16_t *x, int16_t *y, uint32_t *cycles);
 
 /**
  * @brief  获取目标绝对位置
@@ -41,6 +86,63 @@ void Camera_GetTargetPosition(int16_t *x, int16_t *y);
  */
 uint8_t Camera_IsTargetValid(void);
 
+/**
+ * @brief  获取相机链路空闲时间
+ * @retval 距最近一次收到完整帧的时间(ms)
+ * @note   相机每帧都发送（无目标时发送"0,0"），长时间无帧说明相机或串口故障
+ */
+uint32_t Camera_GetLinkIdleMs(void);
+
+/**
+ * @brief  向相机下发云台角速度和指向
+ * @param  rate_h: 水平角速度（度/秒）
+ * @param  rate_v: 垂直角速度（度/秒）
+ * @param  pointing_valid: 1=指向有效, 0=位置读取失败（只发送角速度）
+ * @param  pan: 水平指向（度，电机编码器位置，右转为正）
+ * @param  tilt: 垂直指向（度，上转为正）
+ * @retval None
+ * @note   格式: "R,rate_h,rate_v[,pan,tilt]\n"（单位0.01度/秒、0.01度），
+ *         相机按运动模糊上限限制曝光时间，并按指向学习/查询静态杂波图；
+ *         排入发送缓冲区后立即返回（TXE中断发送），缓冲区满时丢弃本次
+ */
+void Camera_SendGimbalRate(float rate_h, float rate_v, uint8_t pointing_valid, float pan, float tilt);
+
+/**
+ * @brief  向相机下发回环帧
+ * @param  seq: 帧序号
+ * @retval 发送的字节数，0=发送缓冲区已满
+ * @note   格式: "L,序号,填充\n"，相机原样回送；供压力测试产生USART1双向负载
+ */
+uint32_t Camera_SendLoopback(uint32_t seq);
+
+/**
+ * @brief  获取收到的回环帧数
+ * @retval 上电以来的累计帧数
+ */
+uint32_t Camera_GetLoopbackCount(void);
+
+/**
+ * @brief  获取最近一次相机端耗时统计
+ * @param  stats: 统计数据指针（输出）
+ * @retval 1=有效, 0=尚未收到统计帧
+ */
+uint8_t Camera_GetStats(CameraStats *stats);
+
+/**
+ * @brief  尝试获取新的相机端耗时统计
+ * @param  stats: 统计数据指针（输出）
+ * @retval 1=有新统计帧, 0=无
+ * @note   用于遥测回传，每个统计帧只返回一次
+ */
+uint8_t Camera_TryGetStats(CameraStats *stats);
+
+/**
+ * @brief  获取阶段名称
+ * @param  stage: 阶段
+ * @retval 阶段名称字符串
+ */
+const char *Camera_GetStageName(CameraStage stage);
+
 /**
  * @brief  设置调试输出开关
  * @param  enabled: 1=开启, 0=关闭
@@ -56,9 +158,10 @@ uint8_t Camera_GetDebugOutput(void);
 
 /**
  * @brief  UART接收回调函数
+ * @param  received: 收到的字节
  * @retval None
- * @note   在USART1中断中调用
+ * @note   由UartFast在USART1空闲线/DMA中断中逐字节调用
  */
-void Camera_UART_RxCallback(void);
+void Camera_UART_RxCallback(uint8_t received);
 
 #endif
@@ -0,0 +1,473 @@
+/**
+ * @file    Cue.c
+ * @brief   云台间目标引导模块实现
+ * @details 引导帧（UART4，双向相同）: "C,状态,水平角,垂直角,距离*校验\n"
+ *          - 状态: 0=无目标, 1=跟踪, 2=锁定（最近1s内出现过锁定）
+ *          - 水平角/垂直角: 两轴位置读数，单位0.01度
+ *          - 距离: 本机的目标距离估计（cue range设置），单位0.1m
+ *          - 校验: 'C'到'*'之前所有字符的异或，两位十六进制
+ *
+ *          坐标系: x=零位右方, y=零位前方, z=上方；水平角与x方向一致（俯视顺时针为正），
+ *          垂直角与图像y方向一致（向下为正），即仰角 = -垂直角。
+ *          对方指向 → 目标在对方坐标系的位置（距离×方向）→ 绕z轴旋转yaw并平移到本机坐标系
+ *          → 本机水平角 = atan2(x, y)，垂直角 = -atan2(z, 水平距离)
+ *
+ * @note    - 角度为驱动上电以来的位置计数，两台云台需在零位上电
+ *          - 本机没有测距，距离是人工设置的估计值；机间距离相对目标距离越小，距离误差的影响越小
+ *          - 本机连续500ms没有相机数据且对方有目标时转向一次，之后2s内不重复引导，
+ *            等待相机捕获目标（捕获后由相机闭环接管）
+ */
+
+#include "Cue.h"
+#include "GimbalControl.h"
+#include "Motor.h"
+#include "SerialDebug.h"
+#include "BinLog.h"
+#include "Journal.h"
+#include "UartFast.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// ==================== 引导参数 ====================
+
+#define CUE_ENABLED_DEFAULT  0        // 上电默认关闭（cue on开启）
+#define CUE_SEND_PERIOD_MS   100      // 位置读取与发送周期(10Hz)
+#define CUE_LOST_MS          500      // 本机连续无相机数据超过该时间视为丢失目标
+#define CUE_LOCK_HOLD_MS     1000     // 最近一次锁定后保持"锁定"状态的时间
+#define CUE_STALE_MS         500      // 对方引导帧有效期
+#define CUE_RETRY_MS         2000     // 转向后等待相机捕获的时间，期间不重复引导
+#define CUE_TILT_LIMIT_DEG   90.0f    // 垂直指向限幅(度)
+#define CUE_LINK_TIMEOUT_MS  1000     // 引导开启时对方帧中断超过该时间记入事件日志
+
+// 机间几何默认值：对方与本机同位置、同零位
+#define CUE_PEER_DX_M        0.0f
+#define CUE_PEER_DY_M        0.0f
+#define CUE_PEER_DZ_M        0.0f
+#define CUE_PEER_YAW_DEG     0.0f
+#define CUE_RANGE_DEFAULT_M  20.0f
+
+#define DEG_TO_RAD  0.01745329f
+#define RAD_TO_DEG  57.29578f
+
+/**
+ * @brief 对方引导数据
+ */
+typedef struct {
+    uint8_t state;        ///< CueState
+    float pan;            ///< 水平角(度)
+    float tilt;           ///< 垂直角(度)
+    float range;          ///< 距离估计(m)
+    uint32_t tick;        ///< 收到时的系统tick(ms)
+    uint8_t valid;        ///< 1=已收到过引导帧
+} CuePeer;
+
+// 接收缓冲区
+static uint8_t cue_rx_buf[48];
+static volatile uint16_t cue_rx_index = 0;
+
+// 发送帧组帧缓冲区（UartFast_Send拷入发送环形缓冲区）
+static uint8_t cue_tx_buf[48];
+
+// 对方数据与链路计数（UART4中断写入）
+static CuePeer cue_peer;
+static volatile uint32_t cue_rx_count = 0;
+static volatile uint32_t cue_bad_count = 0;
+static uint32_t cue_tx_count = 0;
+
+// 配置（串口命令写入）
+static volatile uint8_t cue_enabled = CUE_ENABLED_DEFAULT;
+static float geo_dx = CUE_PEER_DX_M;
+static float geo_dy = CUE_PEER_DY_M;
+static float geo_dz = CUE_PEER_DZ_M;
+static float geo_yaw = CUE_PEER_YAW_DEG;
+static float cue_range = CUE_RANGE_DEFAULT_M;
+
+// 本机状态（控制任务）
+static uint8_t own_state = CUE_STATE_NONE;
+static float own_pan = 0.0f;
+static float own_tilt = 0.0f;
+static uint8_t own_pos_valid = 0;
+static uint8_t target_seen = 0;
+static uint8_t lock_seen = 0;
+static uint32_t last_target_tick = 0;
+static uint32_t last_lock_tick = 0;
+static uint32_t last_send_tick = 0;
+static uint32_t retry_tick = 0;
+static uint8_t peer_link = 0;         // 0=尚未收到帧, 1=正常, 2=超时（事件日志）
+static uint32_t peer_outage_tick = 0;
+
+// 引导转向记录
+static uint32_t slew_count = 0;
+static float slew_pan = 0.0f;
+static float slew_tilt = 0.0f;
+
+static const char *const cue_state_names[] = { "NONE", "TRACKING", "LOCKED" };
+
+// ==================== 内部函数 ====================
+
+/**
+ * @brief  计算校验（异或）
+ */
+static uint8_t Cue_Checksum(const uint8_t *data, uint16_t len)
+{
+    uint8_t sum = 0;
+
+    for (uint16_t i = 0; i < len; i++) sum ^= data[i];
+    return sum;
+}
+
+/**
+ * @brief  解析引导帧
+ * @retval 1=有效, 0=格式或校验错误
+ * @note   在UART4中断中调用
+ */
+static uint8_t Cue_ParseFrame(void)
+{
+    char *star = strchr((char*)cue_rx_buf, '*');
+    long fields[4];
+    char *p;
+
+    if (cue_rx_buf[0] != 'C' || cue_rx_buf[1] != ',' || star == NULL) return 0;
+    if (strtoul(star + 1, NULL, 16) != Cue_Checksum(cue_rx_buf, (uint16_t)(star - (char*)cue_rx_buf))) return 0;
+
+    p = (char*)&cue_rx_buf[2];
+    for (uint8_t i = 0; i < 4; i++) {
+        char *end;
+        fields[i] = strtol(p, &end, 10);
+        if (end == p) return 0;
+        if (*end != ((i == 3) ? '*' : ',')) return 0;
+        p = end + 1;
+    }
+    if (fields[0] < CUE_STATE_NONE || fields[0] > CUE_STATE_LOCKED) return 0;
+
+    cue_peer.state = (uint8_t)fields[0];
+    cue_peer.pan = fields[1] * 0.01f;
+    cue_peer.tilt = fields[2] * 0.01f;
+    cue_peer.range = fields[3] * 0.1f;
+    cue_peer.tick = HAL_GetTick();
+    cue_peer.valid = 1;
+    return 1;
+}
+
+/**
+ * @brief  读取两轴位置
+ * @retval None
+ * @note   取控制任务每周期交替读取的指向缓存，不另外访问电机串口
+ */
+static void Cue_ReadPosition(void)
+{
+    float pan, tilt;
+
+    if (Gimbal_GetPointing(&pan, &tilt)) {
+        own_pan = pan;
+        own_tilt = tilt;
+        own_pos_valid = 1;
+    } else {
+        own_pos_valid = 0;
+    }
+}
+
+/**
+ * @brief  发送本机引导帧
+ * @retval None
+ * @note   排入发送缓冲区后立即返回，缓冲区满时丢弃本次；位置无效时不发送
+ */
+static void Cue_Send(void)
+{
+    if (!own_pos_valid) {
+        return;
+    }
+
+    int len = snprintf((char*)cue_tx_buf, sizeof(cue_tx_buf), "C,%u,%ld,%ld,%ld",
+                       own_state, lroundf(own_pan * 100.0f), lroundf(own_tilt * 100.0f),
+                       lroundf(cue_range * 10.0f));
+    if (len <= 0 || len + 4 >= (int)sizeof(cue_tx_buf)) {
+        return;
+    }
+    len += snprintf((char*)&cue_tx_buf[len], sizeof(cue_tx_buf) - len, "*%02X\n",
+                    Cue_Checksum(cue_tx_buf, (uint16_t)len));
+    if (UartFast_Send(UART_FAST_CUE, cue_tx_buf, (uint16_t)len)) {
+        cue_tx_count++;
+    }
+}
+
+/**
+ * @brief  对方指向换算为本机指向
+ * @param  peer: 对方引导数据
+ * @param  pan: 本机水平角(度)（输出）
+ * @param  tilt: 本机垂直角(度)（输出）
+ * @retval None
+ */
+static void Cue_PeerToOwn(const CuePeer *peer, float *pan, float *tilt)
+{
+    float az = peer->pan * DEG_TO_RAD;
+    float el = -peer->tilt * DEG_TO_RAD;   // 垂直角向下为正
+    float dx, dy, dz, yaw;
+
+    __disable_irq();
+    dx = geo_dx;
+    dy = geo_dy;
+    dz = geo_dz;
+    yaw = geo_yaw * DEG_TO_RAD;
+    __enable_irq();
+
+    // 目标在对方坐标系中的位置
+    float px = peer->range * cosf(el) * sinf(az);
+    float py = peer->range * cosf(el) * cosf(az);
+    float pz = peer->range * sinf(el);
+
+    // 旋转到本机坐标系并平移
+    float tx = px * cosf(yaw) + py * sinf(yaw) + dx;
+    float ty = -px * sinf(yaw) + py * cosf(yaw) + dy;
+    float tz = pz + dz;
+
+    *pan = atan2f(tx, ty) * RAD_TO_DEG;
+    *tilt = -atan2f(tz, sqrtf(tx * tx + ty * ty)) * RAD_TO_DEG;
+    if (*tilt > CUE_TILT_LIMIT_DEG) *tilt = CUE_TILT_LIMIT_DEG;
+    if (*tilt < -CUE_TILT_LIMIT_DEG) *tilt = -CUE_TILT_LIMIT_DEG;
+}
+
+/**
+ * @brief  本机无目标时按对方引导转向
+ * @param  now: 当前tick(ms)
+ * @retval None
+ */
+static void Cue_TryAcquire(uint32_t now)
+{
+    CuePeer peer;
+    float pan, tilt;
+
+    if (own_state != CUE_STATE_NONE || !own_pos_valid || (int32_t)(now - retry_tick) < 0) {
+        return;
+    }
+
+    __disable_irq();
+    peer = cue_peer;
+    __enable_irq();
+
+    if (!peer.valid || peer.state == CUE_STATE_NONE || now - peer.tick > CUE_STALE_MS) {
+        return;
+    }
+
+    Cue_PeerToOwn(&peer, &pan, &tilt);
+
+    // 水平轴取最短路径；位置计数可能已超过一圈
+    float move_h = fmodf(pan - own_pan, 360.0f);
+    if (move_h > 180.0f) move_h -= 360.0f;
+    if (move_h < -180.0f) move_h += 360.0f;
+    float move_v = tilt - own_tilt;
+
+    Motor_MoveHorizontal(move_h);
+    Motor_MoveVertical(move_v);
+
+    slew_count++;
+    slew_pan = own_pan + move_h;
+    slew_tilt = tilt;
+    retry_tick = now + CUE_RETRY_MS;
+    own_pos_valid = 0;   // 转动后位置需重新读取
+
+    BINLOG("[CUE] Slew %+.2f/%+.2f deg to pan=%+.2f tilt=%+.2f (peer state %u)",
+           BINLOG_F(move_h), BINLOG_F(move_v), BINLOG_F(slew_pan), BINLOG_F(slew_tilt), peer.state);
+    Journal_Log(JOURNAL_EV_CUE_SLEW, (int32_t)lroundf(slew_pan * 100.0f), (int16_t)lroundf(slew_tilt * 10.0f));
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  初始化引导模块
+ * @retval None
+ */
+void Cue_Init(void)
+{
+    memset(&cue_peer, 0, sizeof(cue_peer));
+    cue_rx_index = 0;
+    own_pos_valid = 0;
+    target_seen = 0;
+    lock_seen = 0;
+
+    // 启动UART4接收中断
+    UartFast_StartRx(UART_FAST_CUE, Cue_UART_RxCallback);
+}
+
+/**
+ * @brief  引导周期处理
+ * @retval None
+ */
+void Cue_Update(void)
+{
+    uint32_t now = HAL_GetTick();
+    GimbalState state = Gimbal_GetState();
+
+    // 相机帧率低于控制频率，无新数据的周期状态为IDLE，按持续时间判断是否丢失
+    if (state != GIMBAL_IDLE) {
+        last_target_tick = now;
+        target_seen = 1;
+    }
+    if (state == GIMBAL_LOCKED) {
+        last_lock_tick = now;
+        lock_seen = 1;
+    }
+
+    if (!target_seen || now - last_target_tick > CUE_LOST_MS) {
+        own_state = CUE_STATE_NONE;
+    } else if (lock_seen && now - last_lock_tick <= CUE_LOCK_HOLD_MS) {
+        own_state = CUE_STATE_LOCKED;
+    } else {
+        own_state = CUE_STATE_TRACKING;
+    }
+
+    // 对方链路监视（引导开启后首次收到帧才开始）
+    if (cue_enabled && cue_peer.valid) {
+        int32_t idle = (int32_t)(now - cue_peer.tick);   // 中断可能在取now之后更新tick
+        if (idle < 0) idle = 0;
+        if (idle < CUE_LINK_TIMEOUT_MS) {
+            if (peer_link == 2) {
+                Journal_Log(JOURNAL_EV_CUE_RESTORED, (int32_t)(now - idle - peer_outage_tick), 0);
+            }
+            peer_link = 1;
+        } else if (peer_link == 1) {
+            peer_link = 2;
+            peer_outage_tick = now - idle;
+            Journal_Log(JOURNAL_EV_CUE_TIMEOUT, idle, 0);
+        }
+    } else if (!cue_enabled) {
+        peer_link = 0;
+    }
+
+    if (!cue_enabled || !Gimbal_IsEnabled()) {
+        own_pos_valid = 0;
+        return;
+    }
+
+    if (now - last_send_tick >= CUE_SEND_PERIOD_MS) {
+        last_send_tick = now;
+        Cue_ReadPosition();
+        Cue_Send();
+    }
+
+    Cue_TryAcquire(now);
+}
+
+/**
+ * @brief  开启/关闭引导
+ * @param  enabled: 1=开启, 0=关闭
+ * @retval None
+ */
+void Cue_SetEnabled(uint8_t enabled)
+{
+    cue_enabled = enabled ? 1 : 0;
+}
+
+/**
+ * @brief  获取引导开关状态
+ * @retval 1=开启, 0=关闭
+ */
+uint8_t Cue_IsEnabled(void)
+{
+    return cue_enabled;
+}
+
+/**
+ * @brief  设置对方云台相对本机的几何关系
+ * @param  dx: 右方(m)
+ * @param  dy: 前方(m)
+ * @param  dz: 上方(m)
+ * @param  yaw_deg: 对方零位相对本机零位的方位角(度)
+ * @retval 1=成功, 0=超出范围
+ */
+uint8_t Cue_SetGeometry(float dx, float dy, float dz, float yaw_deg)
+{
+    if (fabsf(dx) > CUE_BASELINE_MAX_M || fabsf(dy) > CUE_BASELINE_MAX_M ||
+        fabsf(dz) > CUE_BASELINE_MAX_M || fabsf(yaw_deg) > 180.0f) {
+        return 0;
+    }
+
+    // 控制任务换算时整组读取
+    __disable_irq();
+    geo_dx = dx;
+    geo_dy = dy;
+    geo_dz = dz;
+    geo_yaw = yaw_deg;
+    __enable_irq();
+
+    return 1;
+}
+
+/**
+ * @brief  设置本机发送的目标距离估计
+ * @param  range_m: 距离(m)
+ * @retval 1=成功, 0=超出范围
+ */
+uint8_t Cue_SetRange(float range_m)
+{
+    if (range_m < CUE_RANGE_MIN_M || range_m > CUE_RANGE_MAX_M) {
+        return 0;
+    }
+    cue_range = range_m;
+    return 1;
+}
+
+/**
+ * @brief  获取目标距离估计
+ * @retval 距离(m)
+ */
+float Cue_GetRange(void)
+{
+    return cue_range;
+}
+
+/**
+ * @brief  输出引导状态
+ * @retval None
+ */
+void Cue_PrintStatus(void)
+{
+    CuePeer peer;
+
+    __disable_irq();
+    peer = cue_peer;
+    __enable_irq();
+
+    SerialDebug_Printf("Cue: %s  rx=%lu bad=%lu tx=%lu\r\n", cue_enabled ? "ON" : "OFF",
+                       (unsigned long)cue_rx_count, (unsigned long)cue_bad_count, (unsigned long)cue_tx_count);
+    SerialDebug_Printf("Own: %s pan=%+.2f tilt=%+.2f range=%.1f m%s\r\n",
+                       cue_state_names[own_state], own_pan, own_tilt, cue_range,
+                       own_pos_valid ? "" : " (position not read)");
+    if (peer.valid) {
+        SerialDebug_Printf("Peer: %s pan=%+.2f tilt=%+.2f range=%.1f m age=%lu ms\r\n",
+                           cue_state_names[peer.state], peer.pan, peer.tilt, peer.range,
+                           (unsigned long)(HAL_GetTick() - peer.tick));
+    } else {
+        SerialDebug_Printf("Peer: no cue received\r\n");
+    }
+    SerialDebug_Printf("Geometry: peer at (%.2f, %.2f, %.2f) m, yaw %+.1f deg\r\n",
+                       geo_dx, geo_dy, geo_dz, geo_yaw);
+    SerialDebug_Printf("Slews: %lu (last pan=%+.2f tilt=%+.2f)\r\n", (unsigned long)slew_count, slew_pan, slew_tilt);
+}
+
+/**
+ * @brief  UART接收回调函数
+ * @retval None
+ * @param  received: 收到的字节
+ * @note   由UartFast在UART4中断中逐字节调用，收到行尾时解析
+ */
+void Cue_UART_RxCallback(uint8_t received)
+{
+    if (received == '\n' || received == '\r') {
+        if (cue_rx_index > 0) {
+            cue_rx_buf[cue_rx_index] = '\0';
+            if (Cue_ParseFrame()) cue_rx_count++;
+            else cue_bad_count++;
+        }
+        cue_rx_index = 0;
+    } else if (received >= 0x20 && received < 0x7F) {
+        cue_rx_buf[cue_rx_index++] = received;
+        if (cue_rx_index >= sizeof(cue_rx_buf) - 1) {
+            // 缓冲区溢出，重置
+            cue_rx_index = 0;
+            cue_bad_count++;
+        }
+    }
+}
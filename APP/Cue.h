@@ -0,0 +1,98 @@
+/**
+ * @file    Cue.h
+ * @brief   云台间目标引导模块头文件
+ * @details 相邻云台通过UART4互发引导帧（锁定状态、两轴角度、目标距离估计）。
+ *          本机丢失目标时，按配置的机间几何把对方的指向换算为本机指向，
+ *          一次转到位，之后交给本机相机闭环跟踪
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _CUE_H
+#define _CUE_H
+
+#include "stm32f4xx_hal.h"
+#include "usart.h"
+
+#define CUE_RANGE_MIN_M     1.0f      ///< 目标距离估计下限(m)
+#define CUE_RANGE_MAX_M     5000.0f   ///< 目标距离估计上限(m)
+#define CUE_BASELINE_MAX_M  1000.0f   ///< 机间偏移上限(m)
+
+/**
+ * @brief 引导帧中的目标状态
+ */
+typedef enum {
+    CUE_STATE_NONE = 0,   ///< 无目标
+    CUE_STATE_TRACKING,   ///< 跟踪中
+    CUE_STATE_LOCKED      ///< 已锁定
+} CueState;
+
+/**
+ * @brief  初始化引导模块
+ * @retval None
+ * @note   启动UART4中断接收；在任务中调用
+ */
+void Cue_Init(void);
+
+/**
+ * @brief  引导周期处理
+ * @retval None
+ * @note   在控制任务每周期Gimbal_ControlTask之后调用：
+ *         按10Hz读取两轴位置并发送引导帧，本机丢失目标时按对方引导转向；
+ *         未开启引导或未enable时不占用电机串口
+ */
+void Cue_Update(void);
+
+/**
+ * @brief  开启/关闭引导
+ * @param  enabled: 1=开启, 0=关闭
+ * @retval None
+ */
+void Cue_SetEnabled(uint8_t enabled);
+
+/**
+ * @brief  获取引导开关状态
+ * @retval 1=开启, 0=关闭
+ */
+uint8_t Cue_IsEnabled(void);
+
+/**
+ * @brief  设置对方云台相对本机的几何关系
+ * @param  dx: 对方位置，本机零位右方(m)
+ * @param  dy: 对方位置，本机零位前方(m)
+ * @param  dz: 对方位置，上方(m)
+ * @param  yaw_deg: 对方水平零位相对本机水平零位的方位角(度)，与水平轴正方向一致
+ * @retval 1=成功, 0=超出范围
+ * @note   假设两台云台都水平安装（只有方位差）
+ */
+uint8_t Cue_SetGeometry(float dx, float dy, float dz, float yaw_deg);
+
+/**
+ * @brief  设置本机发送的目标距离估计
+ * @param  range_m: 距离(m)，CUE_RANGE_MIN_M~CUE_RANGE_MAX_M
+ * @retval 1=成功, 0=超出范围
+ */
+uint8_t Cue_SetRange(float range_m);
+
+/**
+ * @brief  获取目标距离估计
+ * @retval 距离(m)
+ * @note   cue range设置的值，参数档案按距离自动切换时使用
+ */
+float Cue_GetRange(void);
+
+/**
+ * @brief  输出引导状态（链路计数、本机/对方状态、几何参数）
+ * @retval None
+ */
+void Cue_PrintStatus(void);
+
+/**
+ * @brief  UART接收回调函数
+ * @param  received: 收到的字节
+ * @retval None
+ * @note   由UartFast在UART4中断中逐字节调用
+ */
+void Cue_UART_RxCallback(uint8_t received);
+
+#endif
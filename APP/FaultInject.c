@@ -0,0 +1,509 @@
+/**
+ * @file    FaultInject.c
+ * @brief   链路与执行机构故障注入实现
+ * @details - 概率判定用xorshift32伪随机数（中断和任务共用，偶尔交错只影响随机性）
+ *          - 接收延迟：命中的字节及其后到达的字节按顺序进入每口的字节队列（单生产者为接收中断，
+ *            单消费者为默认任务），到期后在关中断下交给处理函数；队列满时丢弃并计入丢弃次数
+ *          - 发送延迟：整帧进入每口的帧队列，由默认任务按时发出；电机端口在下一次发送前也先补发
+ *            到期的帧，保持顺序（DMA发送在关中断下启动，默认任务与控制任务可以交替调用）
+ *          - 执行机构故障在Motor.c查询：卡死时运动/停止命令直接返回，冻结时位置读取返回冻结值
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "FaultInject.h"
+#include "Motor.h"
+#include "Journal.h"
+#include "SerialDebug.h"
+#include <string.h>
+
+#define FAULT_RX_MASK          (FAULT_RX_QUEUE_LEN - 1U)
+#define FAULT_TX_MASK          (FAULT_TX_QUEUE_LEN - 1U)
+#define FAULT_AXIS_TARGET      16   ///< 事件日志参数0：执行机构故障为16+轴（0=水平 1=垂直），链路故障为串口号
+
+/**
+ * @brief 单方向故障设置
+ */
+typedef struct {
+    uint16_t permille[FAULT_KIND_COUNT];
+    uint16_t delay_ms;
+} FaultLinkConfig;
+
+/**
+ * @brief 延迟字节
+ */
+typedef struct {
+    uint32_t release;       ///< 交付时刻(ms)
+    uint8_t byte;
+} FaultRxByte;
+
+/**
+ * @brief 接收延迟队列
+ */
+typedef struct {
+    FaultRxByte item[FAULT_RX_QUEUE_LEN];
+    volatile uint32_t head;         ///< 写入位置（接收中断）
+    volatile uint32_t tail;         ///< 读取位置（默认任务）
+    UartFastRxHandler handler;
+} FaultRxQueue;
+
+/**
+ * @brief 延迟帧
+ */
+typedef struct {
+    uint32_t release;
+    uint16_t len;
+    uint8_t data[FAULT_TX_FRAME_MAX];
+} FaultTxFrame;
+
+/**
+ * @brief 发送延迟队列
+ */
+typedef struct {
+    FaultTxFrame item[FAULT_TX_QUEUE_LEN];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+} FaultTxQueue;
+
+static FaultLinkConfig fault_link[UART_FAST_PORT_COUNT][FAULT_DIR_COUNT];
+static volatile uint8_t fault_link_active[UART_FAST_PORT_COUNT][FAULT_DIR_COUNT];
+static uint32_t fault_count[UART_FAST_PORT_COUNT][FAULT_DIR_COUNT][FAULT_KIND_COUNT];
+static FaultRxQueue fault_rx_queue[UART_FAST_PORT_COUNT];
+static FaultTxQueue fault_tx_queue[UART_FAST_PORT_COUNT];
+
+static volatile FaultAxisMode fault_axis_mode[2];   // [0]=水平 [1]=垂直
+static uint32_t fault_axis_start[2];
+static uint32_t fault_axis_duration[2];
+
+static uint32_t fault_rng = 0x2545F491U;
+
+static const char *const fault_port_names[UART_FAST_PORT_COUNT] = {
+    "cam", "dbg", "motH", "motV", "cue"
+};
+static const char *const fault_kind_names[FAULT_KIND_COUNT] = {
+    "drop", "corrupt", "dup", "delay"
+};
+static const char *const fault_axis_names[] = { "none", "stall", "freeze" };
+
+// ==================== 内部函数 ====================
+
+/**
+ * @brief  xorshift32伪随机数
+ */
+static uint32_t FaultInject_Random(void)
+{
+    uint32_t x = fault_rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    fault_rng = x;
+    return x;
+}
+
+/**
+ * @brief  按千分比概率判定
+ */
+static uint8_t FaultInject_Roll(uint16_t permille)
+{
+    return permille != 0 && (FaultInject_Random() % FAULT_PERMILLE_MAX) < permille;
+}
+
+static uint8_t FaultInject_IsMotorPort(UartFastPort port)
+{
+    return port == UART_FAST_MOTOR_H || port == UART_FAST_MOTOR_V;
+}
+
+static void FaultInject_UpdateActive(UartFastPort port, FaultDir dir)
+{
+    const FaultLinkConfig *cfg = &fault_link[port][dir];
+    uint8_t active = 0;
+
+    for (uint8_t k = 0; k < FAULT_KIND_COUNT; k++)
+    {
+        if (cfg->permille[k] != 0) active = 1;
+    }
+    fault_link_active[port][dir] = active;
+}
+
+/**
+ * @brief  接收字节进入延迟队列
+ * @retval 1=已入队, 0=队列满
+ */
+static uint8_t FaultInject_RxEnqueue(UartFastPort port, uint8_t byte, uint32_t release, UartFastRxHandler handler)
+{
+    FaultRxQueue *q = &fault_rx_queue[port];
+
+    if (q->head - q->tail >= FAULT_RX_QUEUE_LEN) return 0;
+
+    q->item[q->head & FAULT_RX_MASK].release = release;
+    q->item[q->head & FAULT_RX_MASK].byte = byte;
+    q->handler = handler;
+    q->head++;
+    return 1;
+}
+
+/**
+ * @brief  发出到期的延迟帧
+ * @param  port: 串口
+ * @note   电机端口可能由默认任务、控制任务和定时器任务同时调用，出队在关中断下进行
+ */
+static void FaultInject_TxRelease(UartFastPort port)
+{
+    FaultTxQueue *q = &fault_tx_queue[port];
+    FaultTxFrame frame;
+
+    for (;;)
+    {
+        __disable_irq();
+        if (q->tail == q->head || (int32_t)(HAL_GetTick() - q->item[q->tail & FAULT_TX_MASK].release) < 0)
+        {
+            __enable_irq();
+            break;
+        }
+        frame = q->item[q->tail & FAULT_TX_MASK];
+        q->tail++;
+        __enable_irq();
+
+        (void)UartFast_SendRaw(port, frame.data, frame.len);
+    }
+}
+
+// ==================== 设置 ====================
+
+/**
+ * @brief  设置链路故障
+ * @retval 1=成功, 0=参数无效
+ */
+uint8_t FaultInject_SetLink(UartFastPort port, FaultDir dir, FaultKind kind, uint16_t permille, uint16_t delay_ms)
+{
+    if (port >= UART_FAST_PORT_COUNT || port == UART_FAST_DEBUG) return 0;
+    if (dir >= FAULT_DIR_COUNT || kind >= FAULT_KIND_COUNT) return 0;
+    if (permille > FAULT_PERMILLE_MAX) return 0;
+    if (kind == FAULT_DELAY && permille != 0 && (delay_ms == 0 || delay_ms > FAULT_DELAY_MAX_MS)) return 0;
+    // 电机应答是调用者轮询读取的，只能丢弃或篡改
+    if (dir == FAULT_DIR_RX && FaultInject_IsMotorPort(port) && (kind == FAULT_DUP || kind == FAULT_DELAY)) return 0;
+
+    fault_link[port][dir].permille[kind] = permille;
+    if (kind == FAULT_DELAY && permille != 0) fault_link[port][dir].delay_ms = delay_ms;
+    FaultInject_UpdateActive(port, dir);
+
+    Journal_Log(JOURNAL_EV_FAULT, port, permille != 0);
+    return 1;
+}
+
+/**
+ * @brief  设置执行机构故障
+ * @retval 1=成功, 0=参数无效
+ */
+uint8_t FaultInject_SetAxis(uint8_t motor_id, FaultAxisMode mode, uint32_t duration_ms)
+{
+    uint8_t axis = (motor_id == MOTOR_ID_VERTICAL);
+
+    if (motor_id != MOTOR_ID_HORIZONTAL && motor_id != MOTOR_ID_VERTICAL) return 0;
+    if (mode > FAULT_AXIS_FREEZE || duration_ms > FAULT_DURATION_MAX_MS) return 0;
+
+    fault_axis_start[axis] = HAL_GetTick();
+    fault_axis_duration[axis] = duration_ms;
+    fault_axis_mode[axis] = mode;
+
+    Journal_Log(JOURNAL_EV_FAULT, FAULT_AXIS_TARGET + axis, mode != FAULT_AXIS_NONE);
+    return 1;
+}
+
+/**
+ * @brief  解除全部故障
+ * @retval None
+ */
+void FaultInject_Clear(void)
+{
+    memset(fault_link, 0, sizeof(fault_link));
+    memset((void *)fault_link_active, 0, sizeof(fault_link_active));
+    fault_axis_mode[0] = FAULT_AXIS_NONE;
+    fault_axis_mode[1] = FAULT_AXIS_NONE;
+
+    Journal_Log(JOURNAL_EV_FAULT, -1, 0);
+}
+
+/**
+ * @brief  该方向是否需要经过故障注入
+ * @retval 1=有故障设置或延迟队列非空
+ */
+uint8_t FaultInject_IsActive(UartFastPort port, FaultDir dir)
+{
+    if (fault_link_active[port][dir]) return 1;
+
+    if (dir == FAULT_DIR_RX) return fault_rx_queue[port].head != fault_rx_queue[port].tail;
+    return fault_tx_queue[port].head != fault_tx_queue[port].tail;
+}
+
+// ==================== 注入 ====================
+
+/**
+ * @brief  接收一个字节（中断接收端口）
+ * @retval None
+ */
+void FaultInject_Rx(UartFastPort port, uint8_t byte, UartFastRxHandler handler)
+{
+    const FaultLinkConfig *cfg = &fault_link[port][FAULT_DIR_RX];
+    uint32_t *count = fault_count[port][FAULT_DIR_RX];
+    FaultRxQueue *q = &fault_rx_queue[port];
+    uint8_t copies = 1;
+
+    if (FaultInject_Roll(cfg->permille[FAULT_DROP]))
+    {
+        count[FAULT_DROP]++;
+        return;
+    }
+    if (FaultInject_Roll(cfg->permille[FAULT_CORRUPT]))
+    {
+        byte ^= (uint8_t)(1U << (FaultInject_Random() & 7U));
+        count[FAULT_CORRUPT]++;
+    }
+    if (FaultInject_Roll(cfg->permille[FAULT_DUP]))
+    {
+        copies = 2;
+        count[FAULT_DUP]++;
+    }
+
+    if (q->head != q->tail || FaultInject_Roll(cfg->permille[FAULT_DELAY]))
+    {
+        // 队列非空时跟在最后一个字节之后，不超车
+        uint32_t release = HAL_GetTick();
+
+        if (q->head == q->tail)
+        {
+            release += cfg->delay_ms;
+            count[FAULT_DELAY]++;
+        }
+        else
+        {
+            release = q->item[(q->head - 1U) & FAULT_RX_MASK].release;
+        }
+        while (copies--)
+        {
+            if (!FaultInject_RxEnqueue(port, byte, release, handler)) count[FAULT_DROP]++;
+        }
+        return;
+    }
+
+    while (copies--)
+    {
+        handler(byte);
+    }
+}
+
+/**
+ * @brief  处理轮询接收的数据（电机应答）
+ * @retval 1=正常, 0=注入丢弃
+ */
+uint8_t FaultInject_Read(UartFastPort port, uint8_t *data, uint16_t len)
+{
+    const FaultLinkConfig *cfg = &fault_link[port][FAULT_DIR_RX];
+    uint32_t *count = fault_count[port][FAULT_DIR_RX];
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        if (FaultInject_Roll(cfg->permille[FAULT_DROP]))
+        {
+            count[FAULT_DROP]++;
+            return 0;
+        }
+        if (FaultInject_Roll(cfg->permille[FAULT_CORRUPT]))
+        {
+            data[i] ^= (uint8_t)(1U << (FaultInject_Random() & 7U));
+            count[FAULT_CORRUPT]++;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief  发送一帧
+ * @retval 与UartFast_Send相同
+ */
+uint8_t FaultInject_Send(UartFastPort port, const uint8_t *data, uint16_t len, uint8_t blocking)
+{
+    const FaultLinkConfig *cfg = &fault_link[port][FAULT_DIR_TX];
+    uint32_t *count = fault_count[port][FAULT_DIR_TX];
+    FaultTxQueue *q = &fault_tx_queue[port];
+    uint8_t buf[FAULT_TX_FRAME_MAX];
+    uint8_t copies = 1;
+    uint8_t ok = 1;
+
+    if (len == 0 || len > FAULT_TX_FRAME_MAX)
+    {
+        if (blocking) UartFast_WriteRaw(port, data, len);
+        else ok = UartFast_SendRaw(port, data, len);
+        return ok;
+    }
+
+    if (FaultInject_IsMotorPort(port)) FaultInject_TxRelease(port);
+
+    if (FaultInject_Roll(cfg->permille[FAULT_DROP]))
+    {
+        count[FAULT_DROP]++;
+        return 1;
+    }
+
+    memcpy(buf, data, len);
+    if (FaultInject_Roll(cfg->permille[FAULT_CORRUPT]))
+    {
+        buf[FaultInject_Random() % len] ^= (uint8_t)(1U << (FaultInject_Random() & 7U));
+        count[FAULT_CORRUPT]++;
+    }
+    if (FaultInject_Roll(cfg->permille[FAULT_DUP]))
+    {
+        copies = 2;
+        count[FAULT_DUP]++;
+    }
+
+    // 发送可能来自多个任务，帧队列在关中断下写入
+    __disable_irq();
+    if (q->head != q->tail || FaultInject_Roll(cfg->permille[FAULT_DELAY]))
+    {
+        uint32_t release = HAL_GetTick();
+
+        if (q->head == q->tail)
+        {
+            release += cfg->delay_ms;
+            count[FAULT_DELAY]++;
+        }
+        else
+        {
+            release = q->item[(q->head - 1U) & FAULT_TX_MASK].release;
+        }
+        while (copies--)
+        {
+            FaultTxFrame *frame = &q->item[q->head & FAULT_TX_MASK];
+
+            if (q->head - q->tail >= FAULT_TX_QUEUE_LEN)
+            {
+                count[FAULT_DROP]++;
+                break;
+            }
+            frame->release = release;
+            frame->len = len;
+            memcpy(frame->data, buf, len);
+            q->head++;
+        }
+        __enable_irq();
+        return 1;
+    }
+    __enable_irq();
+
+    while (copies--)
+    {
+        if (blocking) UartFast_WriteRaw(port, buf, len);
+        else ok = UartFast_SendRaw(port, buf, len) && ok;
+    }
+    return ok;
+}
+
+/**
+ * @brief  获取执行机构故障
+ * @retval 当前故障
+ */
+FaultAxisMode FaultInject_GetAxis(uint8_t motor_id)
+{
+    uint8_t axis = (motor_id == MOTOR_ID_VERTICAL);
+    FaultAxisMode mode = fault_axis_mode[axis];
+
+    if (mode != FAULT_AXIS_NONE && fault_axis_duration[axis] != 0 &&
+        HAL_GetTick() - fault_axis_start[axis] >= fault_axis_duration[axis])
+    {
+        fault_axis_mode[axis] = FAULT_AXIS_NONE;
+        Journal_Log(JOURNAL_EV_FAULT, FAULT_AXIS_TARGET + axis, 0);
+        mode = FAULT_AXIS_NONE;
+    }
+    return mode;
+}
+
+/**
+ * @brief  交付/发出到期的延迟数据
+ * @retval None
+ */
+void FaultInject_Process(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    for (uint32_t port = 0; port < UART_FAST_PORT_COUNT; port++)
+    {
+        FaultRxQueue *q = &fault_rx_queue[port];
+
+        while (q->tail != q->head)
+        {
+            const FaultRxByte *item = &q->item[q->tail & FAULT_RX_MASK];
+
+            if ((int32_t)(now - item->release) < 0) break;
+            __disable_irq();
+            q->handler(item->byte);
+            __enable_irq();
+            q->tail++;
+        }
+
+        // 电机端口同样按时发出：控制环停发命令（锁定、停用）时延迟帧不会一直扣留
+        FaultInject_TxRelease((UartFastPort)port);
+    }
+
+    // 持续时间到期的执行机构故障在此解除（轴不运动时Motor.c不会查询）
+    (void)FaultInject_GetAxis(MOTOR_ID_HORIZONTAL);
+    (void)FaultInject_GetAxis(MOTOR_ID_VERTICAL);
+}
+
+// ==================== 显示 ====================
+
+/**
+ * @brief  串口名称
+ * @retval 名称
+ */
+const char *FaultInject_PortName(UartFastPort port)
+{
+    return (port < UART_FAST_PORT_COUNT) ? fault_port_names[port] : "?";
+}
+
+/**
+ * @brief  打印故障设置和注入次数
+ * @retval None
+ */
+void FaultInject_PrintStatus(void)
+{
+    uint8_t any = 0;
+
+    for (uint32_t port = 0; port < UART_FAST_PORT_COUNT; port++)
+    {
+        for (uint32_t dir = 0; dir < FAULT_DIR_COUNT; dir++)
+        {
+            const FaultLinkConfig *cfg = &fault_link[port][dir];
+            const uint32_t *count = fault_count[port][dir];
+
+            if (!fault_link_active[port][dir] && !count[FAULT_DROP] && !count[FAULT_CORRUPT] &&
+                !count[FAULT_DUP] && !count[FAULT_DELAY]) continue;
+
+            any = 1;
+            SerialDebug_Printf("  %s %s:", fault_port_names[port], (dir == FAULT_DIR_RX) ? "rx" : "tx");
+            for (uint32_t k = 0; k < FAULT_KIND_COUNT; k++)
+            {
+                SerialDebug_Printf(" %s=%u", fault_kind_names[k], cfg->permille[k]);
+            }
+            SerialDebug_Printf(" delay_ms=%u  injected %lu/%lu/%lu/%lu\r\n", cfg->delay_ms,
+                               (unsigned long)count[FAULT_DROP], (unsigned long)count[FAULT_CORRUPT],
+                               (unsigned long)count[FAULT_DUP], (unsigned long)count[FAULT_DELAY]);
+        }
+    }
+    if (!any) SerialDebug_Printf("  Links: no faults\r\n");
+
+    for (uint8_t axis = 0; axis < 2; axis++)
+    {
+        FaultAxisMode mode = FaultInject_GetAxis(axis ? MOTOR_ID_VERTICAL : MOTOR_ID_HORIZONTAL);
+        uint32_t left = 0;
+
+        if (mode != FAULT_AXIS_NONE && fault_axis_duration[axis] != 0)
+        {
+            left = fault_axis_duration[axis] - (HAL_GetTick() - fault_axis_start[axis]);
+        }
+        SerialDebug_Printf("  Axis %c: %s", axis ? 'V' : 'H', fault_axis_names[mode]);
+        if (left) SerialDebug_Printf(" (%lums left)", (unsigned long)left);
+        SerialDebug_Printf("\r\n");
+    }
+}
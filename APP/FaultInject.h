@@ -0,0 +1,150 @@
+/**
+ * @file    FaultInject.h
+ * @brief   链路与执行机构故障注入头文件
+ * @details 位于应用模块和UartFast之间，用于评估现场故障下的跟踪性能和恢复时间（fault命令）：
+ *          - 链路（相机、电机、引导串口，调试串口除外）：按千分比概率
+ *            丢弃、篡改（翻转一位）、重复、延迟，接收按字节、发送按帧
+ *          - 执行机构：卡死（驱动忽略所有运动命令，位置读取正常）、
+ *            冻结（运动照常，位置读取一直返回冻结时刻的值），可设持续时间后自动解除
+ *          设置/解除记入事件日志（FAULT），与LOCKED/LOST的时间差即恢复时间。
+ *          未设置故障时每次收发只多一次标志判断
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _FAULT_INJECT_H
+#define _FAULT_INJECT_H
+
+#include "UartFast.h"
+
+#define FAULT_PERMILLE_MAX     1000     ///< 概率上限（千分比）
+#define FAULT_DELAY_MAX_MS     1000     ///< 延迟上限(ms)
+#define FAULT_DURATION_MAX_MS  600000   ///< 执行机构故障持续时间上限(ms)，0=一直保持
+#define FAULT_RX_QUEUE_LEN     64U      ///< 接收延迟队列（字节，2的幂）
+#define FAULT_TX_QUEUE_LEN     4U       ///< 发送延迟队列（帧，2的幂）
+#define FAULT_TX_FRAME_MAX     UART_FAST_DMA_TX_LEN  ///< 可延迟/篡改的最大帧长，更长的帧不注入
+
+/**
+ * @brief 方向
+ */
+typedef enum {
+    FAULT_DIR_RX = 0,
+    FAULT_DIR_TX,
+    FAULT_DIR_COUNT
+} FaultDir;
+
+/**
+ * @brief 链路故障类型
+ */
+typedef enum {
+    FAULT_DROP = 0,     ///< 丢弃
+    FAULT_CORRUPT,      ///< 随机翻转一位
+    FAULT_DUP,          ///< 重复一次
+    FAULT_DELAY,        ///< 延迟（之后的数据排在其后，保持顺序）
+    FAULT_KIND_COUNT
+} FaultKind;
+
+/**
+ * @brief 执行机构故障
+ */
+typedef enum {
+    FAULT_AXIS_NONE = 0,
+    FAULT_AXIS_STALL,   ///< 卡死：运动/停止命令不下发
+    FAULT_AXIS_FREEZE   ///< 冻结：位置读数保持不变
+} FaultAxisMode;
+
+/**
+ * @brief  设置链路故障
+ * @param  port: 串口（不能是调试串口）
+ * @param  dir: 方向
+ * @param  kind: 类型
+ * @param  permille: 概率（0~1000，0=关闭该类型）
+ * @param  delay_ms: FAULT_DELAY的延迟时间(ms)，其他类型忽略
+ * @retval 1=成功, 0=参数无效（电机串口轮询接收不支持重复和延迟）
+ * @note   可在中断中调用
+ */
+uint8_t FaultInject_SetLink(UartFastPort port, FaultDir dir, FaultKind kind, uint16_t permille, uint16_t delay_ms);
+
+/**
+ * @brief  设置执行机构故障
+ * @param  motor_id: 电机地址（MOTOR_ID_HORIZONTAL/MOTOR_ID_VERTICAL）
+ * @param  mode: 故障
+ * @param  duration_ms: 持续时间(ms)，0=一直保持到解除
+ * @retval 1=成功, 0=参数无效
+ * @note   可在中断中调用
+ */
+uint8_t FaultInject_SetAxis(uint8_t motor_id, FaultAxisMode mode, uint32_t duration_ms);
+
+/**
+ * @brief  解除全部故障
+ * @retval None
+ * @note   已延迟的数据照常按时发出/交付
+ */
+void FaultInject_Clear(void);
+
+/**
+ * @brief  该方向是否需要经过故障注入
+ * @param  port: 串口
+ * @param  dir: 方向
+ * @retval 1=有故障设置或延迟队列非空
+ */
+uint8_t FaultInject_IsActive(UartFastPort port, FaultDir dir);
+
+/**
+ * @brief  接收一个字节（中断接收端口）
+ * @param  port: 串口
+ * @param  byte: 收到的字节
+ * @param  handler: 应用层处理函数
+ * @retval None
+ * @note   在接收中断中代替直接调用handler
+ */
+void FaultInject_Rx(UartFastPort port, uint8_t byte, UartFastRxHandler handler);
+
+/**
+ * @brief  处理轮询接收的数据（电机应答）
+ * @param  port: 串口
+ * @param  data: 已收满的数据（原地篡改）
+ * @param  len: 长度
+ * @retval 1=正常, 0=注入丢弃（按超时处理）
+ */
+uint8_t FaultInject_Read(UartFastPort port, uint8_t *data, uint16_t len);
+
+/**
+ * @brief  发送一帧
+ * @param  port: 串口
+ * @param  data: 数据
+ * @param  len: 长度
+ * @param  blocking: 1=阻塞发送(UartFast_Write), 0=排队发送(UartFast_Send)
+ * @retval 与UartFast_Send相同；注入丢弃和延迟时返回1（对调用者不可见）
+ * @note   延迟帧由FaultInject_Process按时发出；电机串口下一次发送前也先补发到期的帧，保持顺序
+ */
+uint8_t FaultInject_Send(UartFastPort port, const uint8_t *data, uint16_t len, uint8_t blocking);
+
+/**
+ * @brief  获取执行机构故障
+ * @param  motor_id: 电机地址
+ * @retval 当前故障（持续时间到时在此解除）
+ */
+FaultAxisMode FaultInject_GetAxis(uint8_t motor_id);
+
+/**
+ * @brief  交付/发出到期的延迟数据
+ * @retval None
+ * @note   在默认任务中周期调用（1ms）；接收处理函数在关中断下调用，与在中断中调用等价
+ */
+void FaultInject_Process(void);
+
+/**
+ * @brief  串口名称（与status一致：cam dbg motH motV cue）
+ * @param  port: 串口
+ * @retval 名称
+ */
+const char *FaultInject_PortName(UartFastPort port);
+
+/**
+ * @brief  打印故障设置和注入次数
+ * @retval None
+ */
+void FaultInject_PrintStatus(void);
+
+#endif
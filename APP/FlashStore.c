@@ -0,0 +1,126 @@
+/**
+ * @file    FlashStore.c
+ * @brief   片内Flash保留扇区读写实现
+ * @details 基于HAL_FLASH/HAL_FLASHEx，每次操作前解锁、结束后上锁
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "FlashStore.h"
+
+/**
+ * @brief 区域与扇区对应关系
+ */
+typedef struct {
+    uint32_t sector;    ///< 扇区号
+    uint32_t address;   ///< 起始地址
+} FlashStoreRegion;
+
+static const FlashStoreRegion flash_regions[FLASH_STORE_AREA_COUNT] = {
+    { FLASH_SECTOR_10, 0x080C0000U },
+    { FLASH_SECTOR_11, 0x080E0000U },
+    { FLASH_SECTOR_9,  0x080A0000U },
+};
+
+/**
+ * @brief  获取区域起始地址
+ * @param  area: 区域
+ * @retval 起始地址
+ */
+const uint8_t *FlashStore_Base(FlashStoreArea area)
+{
+    return (const uint8_t *)flash_regions[area].address;
+}
+
+/**
+ * @brief  擦除区域
+ * @param  area: 区域
+ * @retval 1=成功, 0=失败
+ */
+uint8_t FlashStore_Erase(FlashStoreArea area)
+{
+    FLASH_EraseInitTypeDef erase = {0};
+    uint32_t sector_error = 0;
+    HAL_StatusTypeDef status;
+
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Sector = flash_regions[area].sector;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;   // 2.7~3.6V，按32位并行擦除
+
+    HAL_FLASH_Unlock();
+    status = HAL_FLASHEx_Erase(&erase, &sector_error);   // 结束后HAL会刷新指令/数据缓存
+    HAL_FLASH_Lock();
+
+    return (status == HAL_OK) ? 1 : 0;
+}
+
+/**
+ * @brief  按字编程
+ * @param  area: 区域
+ * @param  offset: 区域内偏移
+ * @param  words: 数据
+ * @param  count: 字数
+ * @retval 1=成功, 0=失败或越界
+ */
+uint8_t FlashStore_Program(FlashStoreArea area, uint32_t offset, const uint32_t *words, uint32_t count)
+{
+    uint32_t address = flash_regions[area].address + offset;
+    uint8_t ok = 1;
+
+    if ((offset & 3U) != 0U || offset + count * 4U > FLASH_STORE_AREA_SIZE) {
+        return 0;
+    }
+
+    HAL_FLASH_Unlock();
+    for (uint32_t i = 0; i < count; i++) {
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i * 4U, words[i]) != HAL_OK) {
+            ok = 0;
+            break;
+        }
+    }
+    HAL_FLASH_Lock();
+
+    // 数据缓存可能还保留编程前读到的0xFF，复位后重新读取
+    if (READ_BIT(FLASH->ACR, FLASH_ACR_DCEN) != 0U) {
+        __HAL_FLASH_DATA_CACHE_DISABLE();
+        __HAL_FLASH_DATA_CACHE_RESET();
+        __HAL_FLASH_DATA_CACHE_ENABLE();
+    }
+
+    return ok;
+}
+
+/**
+ * @brief  检查区域是否为擦除状态
+ * @param  area: 区域
+ * @retval 1=全部为0xFF, 0=有已编程数据
+ */
+uint8_t FlashStore_IsBlank(FlashStoreArea area)
+{
+    const uint32_t *p = (const uint32_t *)FlashStore_Base(area);
+
+    for (uint32_t i = 0; i < FLASH_STORE_AREA_SIZE / 4U; i++) {
+        if (p[i] != 0xFFFFFFFFU) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief  CRC16-CCITT
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval 校验值
+ */
+uint16_t FlashStore_Crc16(const uint8_t *data, uint32_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
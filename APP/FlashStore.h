@@ -0,0 +1,73 @@
+/**
+ * @file    FlashStore.h
+ * @brief   片内Flash保留扇区读写头文件
+ * @details 程序只占用0x08000000~0x0809FFFF（Keil工程IROM1大小0xA0000），
+ *          其后的128KB扇区留给运行时数据：
+ *          - 扇区9  (0x080A0000): 参数档案
+ *          - 扇区10 (0x080C0000): 事件日志A
+ *          - 扇区11 (0x080E0000): 事件日志B
+ * @note    F407只有一个Flash块，擦除/编程期间取指令和读Flash都会停顿，所有中断随之推迟：
+ *          编程一个字约16us，擦除一个128KB扇区约1~2s。擦除只能在控制停止时执行
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _FLASH_STORE_H
+#define _FLASH_STORE_H
+
+#include "stm32f4xx_hal.h"
+
+#define FLASH_STORE_AREA_SIZE  0x20000U   ///< 每个区域一个128KB扇区
+
+/**
+ * @brief 保留区域
+ */
+typedef enum {
+    FLASH_STORE_JOURNAL_A = 0,   ///< 事件日志A（扇区10）
+    FLASH_STORE_JOURNAL_B,       ///< 事件日志B（扇区11）
+    FLASH_STORE_PROFILES,        ///< 参数档案（扇区9）
+    FLASH_STORE_AREA_COUNT
+} FlashStoreArea;
+
+/**
+ * @brief  获取区域起始地址（可直接读取）
+ * @param  area: 区域
+ * @retval 起始地址
+ */
+const uint8_t *FlashStore_Base(FlashStoreArea area);
+
+/**
+ * @brief  擦除区域
+ * @param  area: 区域
+ * @retval 1=成功, 0=失败
+ * @note   阻塞约1~2s，期间CPU停顿；只能在控制停止时于任务中调用
+ */
+uint8_t FlashStore_Erase(FlashStoreArea area);
+
+/**
+ * @brief  按字编程
+ * @param  area: 区域
+ * @param  offset: 区域内偏移（4字节对齐）
+ * @param  words: 数据
+ * @param  count: 字数
+ * @retval 1=成功, 0=失败或越界
+ * @note   只能把1写成0，目标位置应为擦除状态；每个字约16us停顿，在任务中调用
+ */
+uint8_t FlashStore_Program(FlashStoreArea area, uint32_t offset, const uint32_t *words, uint32_t count);
+
+/**
+ * @brief  检查区域是否为擦除状态（全0xFF）
+ * @param  area: 区域
+ * @retval 1=全部为0xFF, 0=有已编程数据
+ */
+uint8_t FlashStore_IsBlank(FlashStoreArea area);
+
+/**
+ * @brief  CRC16-CCITT（保留扇区中的记录校验）
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval 校验值
+ */
+uint16_t FlashStore_Crc16(const uint8_t *data, uint32_t len);
+
+#endif
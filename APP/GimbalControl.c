@@ -6,17 +6,27 @@
  * @date    2026-02-25
  * 
  * @note    控制参数:
- *          - 控制频率: 50Hz (20ms周期)
- *          - PID参数: Kp=150, Ki=0, Kd=0
+ *          - 控制频率: 默认50Hz (20ms周期)，rate命令可在线修改
+ *          - PID参数: Kp=150, Ki=0, Kd=0（连续时间单位，随控制周期自动离散化）
  *          - 死区: ±8像素
- *          - 锁定判定: 连续10次在死区内
+ *          - 锁定判定: 连续200ms在死区内
+ *          - 相机滚转补偿: 偏差向量按标定的相机-云台旋转角逆旋转后送入PID
+ *          - 提前量: 设置载荷延迟后，设定值按目标运动估计移到目标运动方向前方
+ *          - 状态反馈: 每轴可用上位机综合的LQR/LQG增益替代PID（sf命令），ident命令采集辨识数据
  */
 
 #include "GimbalControl.h"
 #include "Camera.h"
 #include "Motor.h"
 #include "PID.h"
+#include "StateFb.h"
+#include "SysId.h"
 #include "SerialDebug.h"
+#include "BinLog.h"
+#include "Journal.h"
+#include "LockOut.h"
+#include "Timing.h"
+#include "cmsis_os.h"
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
@@ -31,13 +41,469 @@ static uint8_t debug_output_enabled = 0;  // 默认关闭调试输出
 static PID_Controller pid_h;  // 水平轴
 static PID_Controller pid_v;  // 垂直轴
 
+// 状态反馈控制器（sf命令上传参数并启用，下一周期开始时在任务中生效）
+static StateFb_Controller sf_ctrl[2];       // 按GimbalAxis索引
+static uint8_t sf_active[2] = {0, 0};       // 1=该轴用状态反馈替代PID
+static StateFbParams requested_sf[2];
+static volatile uint8_t sf_requested[2] = {0, 0};  // 0=无请求, 1=启用requested_sf, 2=恢复PID
+
 // 云台状态
 static GimbalState gimbal_state = GIMBAL_IDLE;
 static uint8_t gimbal_enabled = 0;
 
-// 锁定计数器（连续在死区内的次数）
-static uint8_t lock_counter = 0;
-#define LOCK_THRESHOLD 10  // 连续10次在死区内认为锁定
+// 控制周期（rate命令在线修改，下一周期开始时在任务中生效）
+#define CONTROL_PERIOD_DEFAULT_MS  20     // 默认20ms(50Hz)
+#define CONTROL_PERIOD_MIN_MS      2      // 最高500Hz
+#define CONTROL_PERIOD_MAX_MS      100    // 最低10Hz
+static uint32_t control_period_ms = CONTROL_PERIOD_DEFAULT_MS;
+static float control_dt = CONTROL_PERIOD_DEFAULT_MS * 0.001f;
+static volatile uint32_t requested_period_ms = 0;  // 0=无待生效请求
+static volatile uint32_t overrun_count = 0;        // 控制周期超时次数
+
+// 控制器配置切换（参数档案、deadzone/filter/speed命令请求，下一周期开始时在任务中整体生效）
+static GimbalConfig requested_config;
+static volatile uint8_t config_requested = 0;
+
+// PID输出→角速度：原50Hz下每周期0.01°/单位，即0.5°/s每单位
+#define OUTPUT_DEG_PER_S     0.5f
+#define MEASURE_DT_MAX_MS    100    // 两次测量间隔上限（丢帧后重新捕获时限制单步角度）
+static uint32_t measure_elapsed_ms = 0;
+
+// 锁定计数器（连续在死区内的周期数）
+static uint16_t lock_counter = 0;
+static uint16_t lock_threshold = 10;
+#define LOCK_TIME_MS 200  // 连续200ms在死区内认为锁定
+
+// 自检（test命令请求，默认任务执行）
+#define SELFTEST_POWERUP_MS  2000   // 等待电机上电初始化
+#define SELFTEST_STEP_MS     500    // 每步运动等待时间
+static volatile uint8_t selftest_requested = 0;
+static volatile uint8_t motor_bus_claimed = 0;   // 后台任务占用电机串口（提交请求到任务结束）
+
+// 云台角速度估计（下发给相机用于限制曝光时间）
+#define RATE_REPORT_MS       100    // 下发周期(10Hz)，角速度取该窗口内的平均值
+static float rate_sum_h = 0.0f;     // 窗口内指令角度累计（度）
+static float rate_sum_v = 0.0f;
+static uint32_t rate_window_cycles = 0;
+static uint32_t rate_report_elapsed_ms = 0;
+
+// 目标运动估计（IMM）：按模型概率调度增益和死区（imm命令开关）
+#define IMM_GAIN_BOOST       0.5f   // 机动（匀加速）模型占优时增益最多提高50%
+#define IMM_CA_LOW           0.4f   // 机动概率在LOW~HIGH之间线性提高增益
+#define IMM_CA_HIGH          0.8f
+#define IMM_DEADZONE_MOVING  0.5f   // 目标运动时死区缩小到该比例，提高跟踪精度
+#define IMM_STILL_LOW        0.2f   // 静止概率在LOW~HIGH之间线性恢复完整死区
+#define IMM_STILL_HIGH       0.5f
+static ImmFilter imm_h;
+static ImmFilter imm_v;
+static volatile uint8_t imm_enabled = 1;
+
+// 提前量：载荷响应延迟内目标的角位移，瞄准点从图像中心移到目标运动前方（lead命令设置延迟）
+#define LEAD_LATENCY_MAX_MS  1000   // 载荷延迟上限(ms)
+#define LEAD_MAX_DEG         10.0f  // 提前量限幅(度)，目标保持在视场(±30°)内
+static volatile uint32_t lead_latency_ms = 0;  // 0=不加提前量，瞄准图像中心
+static float lead_h = 0.0f;  // 当前提前量(度)
+static float lead_v = 0.0f;
+
+// 云台指向（读取电机编码器位置）：随角速度帧下发给相机维护静态杂波图，并作为目标运动估计的基准。
+// 每个控制周期只读一个轴（两轴交替），阻塞收发不超过一次
+static float pointing[2] = {0.0f, 0.0f};
+static uint8_t pointing_axis_valid[2] = {0, 0};
+static uint8_t pointing_valid = 0;              // 两轴均有效
+static GimbalAxis pointing_next = GIMBAL_AXIS_H;
+
+// 云台实际角速度（同一轴相邻两次读数差分）：把指向回推到相机帧到达时刻，与图像偏差对齐
+#define POINTING_VEL_GAP_MAX_US  250000U  // 两次读数间隔超过该值时不差分（同一轴两次读数相隔两个控制周期）
+static float pointing_vel[2] = {0.0f, 0.0f};
+static uint32_t pointing_cycles[2] = {0, 0};
+
+// 相机相对云台的滚转角（calib命令标定，roll命令修改）
+#define CAMERA_ROLL_DEG      0.0f   // 上电默认值(度)
+#define CAMERA_ROLL_MAX_DEG  45.0f
+static float camera_roll_deg = CAMERA_ROLL_DEG;
+static float camera_roll_cos = 1.0f;
+static float camera_roll_sin = 0.0f;
+
+// 图像雅可比在线估计（jac命令开关）：开启时代替上面的固定滚转补偿，同时校正像素/度
+static ImgJac img_jac;
+static uint8_t img_jac_active = 0;
+static volatile uint8_t img_jac_requested = 0;  // 0=无请求, 1=开启, 2=关闭, 3=重新开始
+
+// 自校正（str命令开关）：在线估计轴模型，每秒按估计重新设计Kp（Ki、Kd同比例），限制在基准增益附近
+#define SELFTUNE_DESIGN_MS   1000   // 重新设计周期(ms)
+#define SELFTUNE_KP_MIN      0.25f  // Kp下限（相对基准）
+#define SELFTUNE_KP_MAX      2.0f   // Kp上限（相对基准）
+#define SELFTUNE_KP_STEP     1.5f   // 每次设计Kp最多升高的倍数
+static SelfTune self_tune[2];       // 按GimbalAxis索引
+static float self_tune_base_kp[2];
+static uint8_t self_tune_active = 0;
+static volatile uint8_t self_tune_requested = 0;  // 0=无请求, 1=开启, 2=关闭
+static uint32_t self_tune_elapsed_ms = 0;
+
+// 事件日志：目标捕获/锁定/丢失、相机链路超时、控制超时
+#define TARGET_LOST_MS       500    // 连续无目标超过该时间记为丢失
+#define CAMERA_TIMEOUT_MS    1000   // 相机无任何帧超过该时间记为链路超时
+#define OVERRUN_LOG_MS       1000   // 控制超时每秒最多记录一条
+static uint8_t target_held = 0;        // 已捕获目标（尚未记为丢失）
+static uint8_t lock_logged = 0;        // 本次捕获已记录锁定
+static uint32_t acquire_tick = 0;      // 捕获时刻
+static uint32_t target_seen_tick = 0;  // 最近一次看到目标的时刻
+static uint8_t camera_link = 0;        // 0=尚未收到帧, 1=正常, 2=超时
+static uint32_t camera_outage_tick = 0;
+static uint32_t overrun_logged_tick = 0;
+
+/**
+ * @brief  按当前控制周期重新计算各离散系数
+ * @retval None
+ * @note   PID的采样周期为测量间隔，在每次测量时单独设置
+ */
+static void Gimbal_ApplyPeriod(uint32_t period_ms)
+{
+    control_period_ms = period_ms;
+    control_dt = period_ms * 0.001f;
+    lock_threshold = (uint16_t)((LOCK_TIME_MS + period_ms - 1) / period_ms);
+    lock_counter = 0;
+}
+
+/**
+ * @brief  应用控制器配置
+ * @param  config: 配置
+ * @retval None
+ * @note   在控制任务中两次计算之间调用；PID增益无扰切换，积分和微分状态保留
+ */
+static void Gimbal_ApplyConfig(const GimbalConfig *config)
+{
+    PID_SetParamsBumpless(&pid_h, config->kp[GIMBAL_AXIS_H], config->ki[GIMBAL_AXIS_H], config->kd[GIMBAL_AXIS_H]);
+    PID_SetParamsBumpless(&pid_v, config->kp[GIMBAL_AXIS_V], config->ki[GIMBAL_AXIS_V], config->kd[GIMBAL_AXIS_V]);
+    self_tune_base_kp[GIMBAL_AXIS_H] = config->kp[GIMBAL_AXIS_H];
+    self_tune_base_kp[GIMBAL_AXIS_V] = config->kp[GIMBAL_AXIS_V];
+    PID_SetDerivativeFilter(&pid_h, config->d_filter_tau);
+    PID_SetDerivativeFilter(&pid_v, config->d_filter_tau);
+    pid_h.deadzone = config->deadzone;
+    pid_v.deadzone = config->deadzone;
+    Motor_SetSpeed(config->motor_rpm);
+}
+
+/**
+ * @brief  应用状态反馈的启用/关闭请求
+ * @retval None
+ * @note   在控制任务中两次计算之间调用；切换时清除目标控制器的状态，从下一次测量开始计算
+ */
+static void Gimbal_ApplyStateFb(void)
+{
+    for (uint8_t axis = 0; axis < 2; axis++)
+    {
+        uint8_t request;
+        StateFbParams params;
+        
+        __disable_irq();
+        request = sf_requested[axis];
+        params = requested_sf[axis];
+        sf_requested[axis] = 0;
+        __enable_irq();
+        
+        if (request == 1)
+        {
+            StateFb_Init(&sf_ctrl[axis], &params);
+            sf_active[axis] = 1;
+        }
+        else if (request == 2 && sf_active[axis])
+        {
+            PID_Reset((axis == GIMBAL_AXIS_H) ? &pid_h : &pid_v);
+            sf_active[axis] = 0;
+        }
+    }
+}
+
+/**
+ * @brief  应用图像雅可比估计的开关请求
+ * @retval None
+ * @note   在控制任务中两次计算之间调用；开启和重新开始都从当前滚转角和名义像素/度出发
+ */
+static void Gimbal_ApplyImgJac(void)
+{
+    uint8_t request;
+    
+    __disable_irq();
+    request = img_jac_requested;
+    img_jac_requested = 0;
+    __enable_irq();
+    
+    if ((request == 1 && !img_jac_active) || request == 3)
+    {
+        ImgJac_Init(&img_jac, camera_roll_deg);
+    }
+    if (request == 1 || request == 2)
+    {
+        img_jac_active = (request == 1);
+    }
+}
+
+/**
+ * @brief  按比例设置PID增益（Ki、Kd随Kp同比例变化）
+ * @retval None
+ */
+static void Gimbal_ScalePID(PID_Controller *pid, float kp)
+{
+    float ratio = kp / pid->kp;
+    PID_SetParamsBumpless(pid, kp, pid->ki * ratio, pid->kd * ratio);
+}
+
+/**
+ * @brief  应用自校正的开关请求
+ * @retval None
+ * @note   在控制任务中两次计算之间调用；关闭时恢复基准增益
+ */
+static void Gimbal_ApplySelfTune(void)
+{
+    uint8_t request;
+    
+    __disable_irq();
+    request = self_tune_requested;
+    self_tune_requested = 0;
+    __enable_irq();
+    
+    if (request == 1 && !self_tune_active)
+    {
+        SelfTune_Init(&self_tune[GIMBAL_AXIS_H]);
+        SelfTune_Init(&self_tune[GIMBAL_AXIS_V]);
+        self_tune_base_kp[GIMBAL_AXIS_H] = pid_h.kp;
+        self_tune_base_kp[GIMBAL_AXIS_V] = pid_v.kp;
+        self_tune_elapsed_ms = 0;
+        self_tune_active = 1;
+    }
+    else if (request == 2 && self_tune_active)
+    {
+        if (pid_h.kp > 0.0f) Gimbal_ScalePID(&pid_h, self_tune_base_kp[GIMBAL_AXIS_H]);
+        if (pid_v.kp > 0.0f) Gimbal_ScalePID(&pid_v, self_tune_base_kp[GIMBAL_AXIS_V]);
+        self_tune_active = 0;
+    }
+}
+
+/**
+ * @brief  输入一次测量到自校正估计器
+ * @param  axis: 轴
+ * @param  frame_q: 成像时刻的轴指向（度）
+ * @param  measure_dt: 测量间隔(s)
+ * @retval None
+ * @note   指向读取失败时重新开始（转角不连续）；状态反馈控制时只记录历史
+ */
+static void Gimbal_SelfTuneUpdate(GimbalAxis axis, float frame_q, float measure_dt)
+{
+    if (!pointing_valid)
+    {
+        SelfTune_Restart(&self_tune[axis]);
+        return;
+    }
+    SelfTune_Update(&self_tune[axis], frame_q, measure_dt, !sf_active[axis]);
+}
+
+/**
+ * @brief  按估计重新设计PID增益
+ * @param  axis: 轴
+ * @retval None
+ * @note   Kp限制在基准的SELFTUNE_KP_MIN~MAX倍之间；升高每次最多SELFTUNE_KP_STEP倍，
+ *         降低不限速（偏保守的方向，负载突增时尽快退出振荡）
+ */
+static void Gimbal_SelfTuneDesign(GimbalAxis axis)
+{
+    PID_Controller *pid = (axis == GIMBAL_AXIS_H) ? &pid_h : &pid_v;
+    SelfTune *st = &self_tune[axis];
+    float base = self_tune_base_kp[axis];
+    float kp;
+    
+    if (sf_active[axis] || pid->kp <= 0.0f || !SelfTune_Design(st))
+    {
+        return;
+    }
+    
+    kp = base * st->scale;
+    if (kp > pid->kp * SELFTUNE_KP_STEP) kp = pid->kp * SELFTUNE_KP_STEP;
+    if (kp > base * SELFTUNE_KP_MAX) kp = base * SELFTUNE_KP_MAX;
+    if (kp < base * SELFTUNE_KP_MIN) kp = base * SELFTUNE_KP_MIN;
+    Gimbal_ScalePID(pid, kp);
+}
+
+/**
+ * @brief  计算单轴控制输出
+ * @param  axis: 轴
+ * @param  error: 偏差（像素）
+ * @param  measure_dt: 测量间隔(s)
+ * @retval 输出（PID单位：×OUTPUT_DEG_PER_S为角速度）
+ * @note   状态反馈直接给出本次下发角度，换算为PID单位后下游（遥测、下发）不变；
+ *         状态反馈沿用PID的死区和死区调度，不使用增益调度（增益已按模型优化）
+ */
+static float Gimbal_Calculate(GimbalAxis axis, float error, float measure_dt)
+{
+    PID_Controller *pid = (axis == GIMBAL_AXIS_H) ? &pid_h : &pid_v;
+    StateFb_Controller *sf = &sf_ctrl[axis];
+    
+    if (!sf_active[axis])
+    {
+        return PID_Calculate(pid, error);
+    }
+    
+    sf->deadzone = pid->deadzone * pid->deadzone_scale;
+    StateFb_SetSampleTime(sf, measure_dt);
+    return StateFb_Calculate(sf, error) / (OUTPUT_DEG_PER_S * measure_dt);
+}
+
+/**
+ * @brief  把实际下发的角度记入状态反馈的输入历史
+ * @param  step_h: 水平下发角度（度）
+ * @param  step_v: 垂直下发角度（度）
+ * @retval None
+ */
+static void Gimbal_CommitStep(float step_h, float step_v)
+{
+    if (sf_active[GIMBAL_AXIS_H]) StateFb_SetApplied(&sf_ctrl[GIMBAL_AXIS_H], step_h);
+    if (sf_active[GIMBAL_AXIS_V]) StateFb_SetApplied(&sf_ctrl[GIMBAL_AXIS_V], step_v);
+    if (self_tune_active)
+    {
+        SelfTune_Commit(&self_tune[GIMBAL_AXIS_H], step_h);
+        SelfTune_Commit(&self_tune[GIMBAL_AXIS_V], step_v);
+    }
+}
+
+/**
+ * @brief  读取云台指向（每次一个轴，两轴交替）
+ * @retval None
+ * @note   每个控制周期开始时调用（上一周期命令的应答此时已到，读取前清除ORE即丢弃），
+ *         阻塞收发电机串口约1ms（无应答时等待超时）；读取失败的轴在下次读取成功前无效，
+ *         此时下发不带指向、不更新运动估计
+ */
+static void Gimbal_ReadPointing(void)
+{
+    GimbalAxis axis = pointing_next;
+    uint8_t motor_id = (axis == GIMBAL_AXIS_H) ? MOTOR_ID_HORIZONTAL : MOTOR_ID_VERTICAL;
+    float angle;
+    
+    pointing_next = (axis == GIMBAL_AXIS_H) ? GIMBAL_AXIS_V : GIMBAL_AXIS_H;
+    if (Motor_ReadPosition(motor_id, &angle))
+    {
+        uint32_t cycles = Timing_GetCycles();
+        uint32_t gap_us = Timing_CyclesToUs(cycles - pointing_cycles[axis]);
+        
+        if (pointing_axis_valid[axis] && gap_us > 0 && gap_us <= POINTING_VEL_GAP_MAX_US)
+        {
+            pointing_vel[axis] = (angle - pointing[axis]) * 1e6f / gap_us;
+        }
+        else
+        {
+            pointing_vel[axis] = 0.0f;
+        }
+        pointing[axis] = angle;
+        pointing_cycles[axis] = cycles;
+        pointing_axis_valid[axis] = 1;
+    }
+    else
+    {
+        pointing_axis_valid[axis] = 0;
+    }
+    pointing_valid = pointing_axis_valid[GIMBAL_AXIS_H] && pointing_axis_valid[GIMBAL_AXIS_V];
+}
+
+/**
+ * @brief  回推轴指向
+ * @param  axis: 轴
+ * @param  age: 距今时间(s)，0=当前
+ * @retval 该时刻的指向（度）：最近一次读数按该轴实际角速度外推（两轴读数相差一个控制周期）
+ */
+static float Gimbal_PointingAt(GimbalAxis axis, float age)
+{
+    float read_age = Timing_CyclesToUs(Timing_GetCycles() - pointing_cycles[axis]) * 1e-6f;
+    
+    return pointing[axis] - pointing_vel[axis] * (age - read_age);
+}
+
+/**
+ * @brief  更新云台角速度估计并下发给相机
+ * @param  step_h: 本周期水平指令角度（度）
+ * @param  step_v: 本周期垂直指令角度（度）
+ * @retval None
+ * @note   角速度 = 下发窗口内指令角度之和 / 窗口实际时长（DWT计时），
+ *         不随单个控制周期的抖动波动，相机的曝光上限不会来回跳
+ */
+static void Gimbal_UpdateRate(float step_h, float step_v)
+{
+    rate_sum_h += step_h;
+    rate_sum_v += step_v;
+    
+    rate_report_elapsed_ms += control_period_ms;
+    if (rate_report_elapsed_ms >= RATE_REPORT_MS)
+    {
+        uint32_t cycles = Timing_GetCycles();
+        uint32_t window_us = Timing_CyclesToUs(cycles - rate_window_cycles);
+        float rate_h = 0.0f, rate_v = 0.0f;
+        
+        // 首个窗口（起点未知）或异常长的窗口按名义时长计算
+        if (rate_window_cycles == 0 || window_us == 0 || window_us > 2u * rate_report_elapsed_ms * 1000u)
+        {
+            window_us = rate_report_elapsed_ms * 1000u;
+        }
+        rate_h = rate_sum_h * 1e6f / window_us;
+        rate_v = rate_sum_v * 1e6f / window_us;
+        rate_sum_h = 0.0f;
+        rate_sum_v = 0.0f;
+        rate_window_cycles = cycles;
+        rate_report_elapsed_ms = 0;
+        Camera_SendGimbalRate(rate_h, rate_v, pointing_valid,
+                              Gimbal_PointingAt(GIMBAL_AXIS_H, 0.0f), Gimbal_PointingAt(GIMBAL_AXIS_V, 0.0f));
+    }
+}
+
+/**
+ * @brief  线性斜坡：x在lo~hi之间映射为0~1
+ */
+static float Gimbal_Ramp(float x, float lo, float hi)
+{
+    if (x <= lo) return 0.0f;
+    if (x >= hi) return 1.0f;
+    return (x - lo) / (hi - lo);
+}
+
+/**
+ * @brief  按目标运动状态调度增益和死区
+ * @param  pid: PID控制器
+ * @param  imm: 该轴的运动估计
+ * @retval None
+ * @note   机动（急停/反向）时提高增益追上目标；目标运动时缩小死区；静止时恢复整定值
+ */
+static void Gimbal_ApplySchedule(PID_Controller *pid, const ImmFilter *imm)
+{
+    if (!imm_enabled)
+    {
+        PID_SetSchedule(pid, 1.0f, 1.0f);
+        return;
+    }
+    
+    float manoeuvre = Gimbal_Ramp(imm->mu[IMM_MODEL_CA], IMM_CA_LOW, IMM_CA_HIGH);
+    float still = Gimbal_Ramp(imm->mu[IMM_MODEL_STATIONARY], IMM_STILL_LOW, IMM_STILL_HIGH);
+    PID_SetSchedule(pid, 1.0f + IMM_GAIN_BOOST * manoeuvre,
+                    IMM_DEADZONE_MOVING + (1.0f - IMM_DEADZONE_MOVING) * still);
+}
+
+/**
+ * @brief  计算提前量
+ * @param  imm: 该轴目标运动估计
+ * @retval 提前量(度)：载荷延迟T内目标的预测角位移 v·T + a·T²/2，限幅±LEAD_MAX_DEG
+ */
+static float Gimbal_LeadOffset(const ImmFilter *imm)
+{
+    float t = lead_latency_ms * 0.001f;
+    float lead;
+    
+    if (lead_latency_ms == 0 || !imm->initialized)
+    {
+        return 0.0f;
+    }
+    
+    lead = imm->xc[1] * t + 0.5f * imm->xc[2] * t * t;
+    if (lead > LEAD_MAX_DEG) lead = LEAD_MAX_DEG;
+    if (lead < -LEAD_MAX_DEG) lead = -LEAD_MAX_DEG;
+    return lead;
+}
+
 
 /**
  * @brief  云台初始化
@@ -52,28 +518,44 @@ void Gimbal_Init(void)
     // 设置死区
     pid_h.deadzone = 8;
     pid_v.deadzone = 8;
+    Imm_Reset(&imm_h);
+    Imm_Reset(&imm_v);
 
     // 初始化相机和电机
     Camera_Init();
     Motor_Init();
+    LockOut_Init();
 
     gimbal_state = GIMBAL_IDLE;
     gimbal_enabled = 0;
-    lock_counter = 0;
+    Gimbal_ApplyPeriod(CONTROL_PERIOD_DEFAULT_MS);
+    Gimbal_SetCameraRoll(CAMERA_ROLL_DEG);
+    ImgJac_Init(&img_jac, CAMERA_ROLL_DEG);
 }
 
 
 /**
  * @brief  启用云台跟踪
- * @retval None
+ * @retval 1=已启用, 0=电机串口被后台任务占用
  */
-void Gimbal_Enable(void)
+uint8_t Gimbal_Enable(void)
 {
+    __disable_irq();
+    if (motor_bus_claimed)
+    {
+        __enable_irq();
+        return 0;
+    }
     gimbal_enabled = 1;
+    __enable_irq();
     gimbal_state = GIMBAL_IDLE;
     PID_Reset(&pid_h);
     PID_Reset(&pid_v);
+    StateFb_Reset(&sf_ctrl[GIMBAL_AXIS_H]);
+    StateFb_Reset(&sf_ctrl[GIMBAL_AXIS_V]);
     lock_counter = 0;
+    target_held = 0;
+    return 1;
 }
 
 /**
@@ -90,29 +572,169 @@ void Gimbal_Disable(void)
 /**
  * @brief  云台控制任务
  * @retval None
- * @note   在FreeRTOS任务中以50Hz频率调用
+ * @note   在FreeRTOS任务中按Gimbal_GetPeriodMs()周期调用
  */
 void Gimbal_ControlTask(void)
 {
-    if (!gimbal_enabled) return;
+    // 应用rate命令的新周期
+    if (requested_period_ms != 0)
+    {
+        Gimbal_ApplyPeriod(requested_period_ms);
+        requested_period_ms = 0;
+    }
     
+    // 应用新的控制器配置（整体生效，不会出现半新半旧的参数组合）
+    if (config_requested)
+    {
+        GimbalConfig config;
+        __disable_irq();
+        config = requested_config;
+        config_requested = 0;
+        __enable_irq();
+        Gimbal_ApplyConfig(&config);
+    }
+    Gimbal_ApplyStateFb();
+    Gimbal_ApplyImgJac();
+    Gimbal_ApplySelfTune();
+    
+    // 自校正：低频重新设计增益
+    if (self_tune_active)
+    {
+        self_tune_elapsed_ms += control_period_ms;
+        if (self_tune_elapsed_ms >= SELFTUNE_DESIGN_MS)
+        {
+            self_tune_elapsed_ms = 0;
+            Gimbal_SelfTuneDesign(GIMBAL_AXIS_H);
+            Gimbal_SelfTuneDesign(GIMBAL_AXIS_V);
+        }
+    }
+    
+    // 相机链路监视（启动后首次收到帧才开始）
+    uint32_t now = HAL_GetTick();
+    uint32_t camera_idle_ms = Camera_GetLinkIdleMs();
+    if (camera_idle_ms < CAMERA_TIMEOUT_MS)
+    {
+        if (camera_link == 2)
+        {
+            Journal_Log(JOURNAL_EV_CAMERA_RESTORED, (int32_t)(now - camera_idle_ms - camera_outage_tick), 0);
+        }
+        camera_link = 1;
+    }
+    else if (camera_link == 1)
+    {
+        camera_link = 2;
+        camera_outage_tick = now - camera_idle_ms;
+        Journal_Log(JOURNAL_EV_CAMERA_TIMEOUT, (int32_t)camera_idle_ms, 0);
+    }
+    
+    if (!gimbal_enabled)
+    {
+        LockOut_Set(0, 0.0f, 0.0f);
+        SysId_Stop();
+        measure_elapsed_ms = 0;
+        rate_sum_h = 0.0f;
+        rate_sum_v = 0.0f;
+        rate_window_cycles = 0;
+        rate_report_elapsed_ms = 0;
+        Imm_Reset(&imm_h);
+        Imm_Reset(&imm_v);
+        ImgJac_Restart(&img_jac);
+        SelfTune_Restart(&self_tune[GIMBAL_AXIS_H]);
+        SelfTune_Restart(&self_tune[GIMBAL_AXIS_V]);
+        lead_h = 0.0f;
+        lead_v = 0.0f;
+        return;
+    }
+    
+    float step_h = 0.0f, step_v = 0.0f;
     int16_t dx = 0, dy = 0;
+    uint32_t frame_cycles = 0;
     int16_t target_x = 0, target_y = 0;
     static uint32_t debug_counter = 0;
     static uint32_t no_data_counter = 0;
     
+    // 每周期读取一个轴的指向（下发给相机、目标运动估计）
+    Gimbal_ReadPointing();
+    
     // 获取目标位置（用于调试）
     Camera_GetTargetPosition(&target_x, &target_y);
     
+    measure_elapsed_ms += control_period_ms;
+    
     // 获取目标偏差
-    if (Camera_TryGetDelta(&dx, &dy))
+    if (Camera_TryGetDelta(&dx, &dy, &frame_cycles))
     {
         gimbal_state = GIMBAL_TRACKING;
         no_data_counter = 0;
         
-        // 计算PID输出
-        float output_h = PID_Calculate(&pid_h, (float)dx);
-        float output_v = PID_Calculate(&pid_v, (float)dy);
+        if (!target_held)
+        {
+            target_held = 1;
+            lock_logged = 0;
+            acquire_tick = now;
+        }
+        target_seen_tick = now;
+        
+        // 采样周期取实际测量间隔（相机帧率低于控制频率时跨越多个控制周期）
+        uint32_t measure_ms = measure_elapsed_ms;
+        if (measure_ms > MEASURE_DT_MAX_MS) measure_ms = MEASURE_DT_MAX_MS;
+        measure_elapsed_ms = 0;
+        float measure_dt = measure_ms * 0.001f;
+        PID_SetSampleTime(&pid_h, measure_dt);
+        PID_SetSampleTime(&pid_v, measure_dt);
+        
+        // 帧到达时刻的云台指向（帧到达后最多等一个控制周期才处理，云台快速转动时读数与图像相差可达1~2度，按实际角速度回推）；
+        // 帧龄取该坐标帧自己的DWT时间戳（链路空闲计时会被统计行、无目标行刷新，且只有1ms分辨率）
+        float frame_age = Timing_CyclesToUs(Timing_GetCycles() - frame_cycles) * 1e-6f;
+        float frame_h = Gimbal_PointingAt(GIMBAL_AXIS_H, frame_age);
+        float frame_v = Gimbal_PointingAt(GIMBAL_AXIS_V, frame_age);
+        
+        // 图像偏差换算到云台坐标系：固定滚转补偿（消除两轴耦合），或按在线估计的图像雅可比（同时校正像素/度）
+        float err_h, err_v;
+        if (img_jac_active)
+        {
+            if (pointing_valid)
+            {
+                ImgJac_Update(&img_jac, dx, dy, frame_h, frame_v, measure_dt);
+            }
+            else
+            {
+                ImgJac_Restart(&img_jac);
+            }
+            ImgJac_Correct(&img_jac, dx, dy, &err_h, &err_v);
+        }
+        else
+        {
+            err_h = camera_roll_cos * dx + camera_roll_sin * dy;
+            err_v = -camera_roll_sin * dx + camera_roll_cos * dy;
+        }
+        float meas_h = err_h, meas_v = err_v;  // 不含提前量，辨识数据用
+        
+        // 目标运动估计：方位角 = 帧到达时刻的云台指向 + 图像偏差换算的角度；按模型概率调度增益和死区
+        if (pointing_valid)
+        {
+            Imm_Update(&imm_h, frame_h + err_h / IMM_PIXELS_PER_DEG, measure_dt);
+            Imm_Update(&imm_v, frame_v + err_v / IMM_PIXELS_PER_DEG, measure_dt);
+        }
+        Gimbal_ApplySchedule(&pid_h, &imm_h);
+        Gimbal_ApplySchedule(&pid_v, &imm_v);
+        
+        // 自校正：成像时刻之间的实际转角与前两次下发角度回归轴模型
+        if (self_tune_active)
+        {
+            Gimbal_SelfTuneUpdate(GIMBAL_AXIS_H, frame_h, measure_dt);
+            Gimbal_SelfTuneUpdate(GIMBAL_AXIS_V, frame_v, measure_dt);
+        }
+        
+        // 设定值从图像中心移到提前量对应的位置：PID偏差为瞄准点相对视轴的偏差，锁定也按瞄准点判定
+        lead_h = Gimbal_LeadOffset(&imm_h);
+        lead_v = Gimbal_LeadOffset(&imm_v);
+        err_h += lead_h * IMM_PIXELS_PER_DEG;
+        err_v += lead_v * IMM_PIXELS_PER_DEG;
+        
+        // 计算控制输出（PID或状态反馈）
+        float output_h = Gimbal_Calculate(GIMBAL_AXIS_H, err_h, measure_dt);
+        float output_v = Gimbal_Calculate(GIMBAL_AXIS_V, err_v, measure_dt);
         
         // 发送实时数据到上位机
         SerialDebug_SendFeedback(target_x, target_y, dx, dy, output_h, output_v, gimbal_state);
@@ -121,19 +743,22 @@ void Gimbal_ControlTask(void)
         #if DEBUG_GIMBAL
         if (debug_output_enabled && debug_counter % 10 == 0)
         {
-            SerialDebug_Printf("Track: Pos[%d,%d] Delta[%+d,%+d] PID[%.1f,%.1f]\r\n",
-                    target_x, target_y, dx, dy, output_h, output_v);
+            BINLOG("Track: Pos[%d,%d] Delta[%+d,%+d] PID[%.1f,%.1f]",
+                   target_x, target_y, dx, dy, BINLOG_F(output_h), BINLOG_F(output_v));
         }
         debug_counter++;
         #endif
         
-        // 检查是否在死区内
-        if (fabsf(dx) < pid_h.deadzone && fabsf(dy) < pid_v.deadzone)
+        // 检查是否在死区内（辨识采集期间不锁定停止，激励持续下发）
+        if (!SysId_IsRunning() &&
+            fabsf(err_h) < pid_h.deadzone * pid_h.deadzone_scale &&
+            fabsf(err_v) < pid_v.deadzone * pid_v.deadzone_scale)
         {
             lock_counter++;
-            if (lock_counter >= LOCK_THRESHOLD)
+            if (lock_counter >= lock_threshold)
             {
                 gimbal_state = GIMBAL_LOCKED;
+                LockOut_Set(1, err_h, err_v);
                 Motor_Stop();
                 
                 // 发送锁定状态
@@ -142,44 +767,172 @@ void Gimbal_ControlTask(void)
                 #if DEBUG_GIMBAL
                 if (debug_output_enabled)
                 {
-                    SerialDebug_Printf(">>> LOCKED at [%d,%d] <<<\r\n", target_x, target_y);
+                    BINLOG(">>> LOCKED at [%d,%d] <<<", target_x, target_y);
                 }
                 #endif
                 
                 lock_counter = 0;  // 重置计数器，避免一直输出
+                
+                if (!lock_logged)
+                {
+                    lock_logged = 1;
+                    Journal_Log(JOURNAL_EV_TARGET_LOCKED, (int32_t)(now - acquire_tick), 0);
+                }
             }
         }
         else
         {
             lock_counter = 0;
+            LockOut_Set(0, err_h, err_v);
             
-            // 控制电机移动
-            Motor_MoveHorizontal(output_h * 0.01f);  // 转换为角度
-            Motor_MoveVertical(output_v * 0.01f);
+            // 控制电机移动：输出为角速度，按测量间隔积分为角度
+            step_h = output_h * OUTPUT_DEG_PER_S * measure_dt;
+            step_v = output_v * OUTPUT_DEG_PER_S * measure_dt;
+            SysId_Step(meas_h, meas_v, measure_ms, &step_h, &step_v);
+            Motor_MoveHorizontal(step_h);
+            Motor_MoveVertical(step_v);
         }
+        Gimbal_CommitStep(step_h, step_v);
     }
     else
     {
         // 没有接收到相机数据
         no_data_counter++;
         
+        if (target_held && now - target_seen_tick >= TARGET_LOST_MS)
+        {
+            target_held = 0;
+            SysId_Stop();
+            Imm_Reset(&imm_h);
+            Imm_Reset(&imm_v);
+            ImgJac_Restart(&img_jac);
+            SelfTune_Restart(&self_tune[GIMBAL_AXIS_H]);
+            SelfTune_Restart(&self_tune[GIMBAL_AXIS_V]);
+            lead_h = 0.0f;
+            lead_v = 0.0f;
+            Journal_Log(JOURNAL_EV_TARGET_LOST, (int32_t)(target_seen_tick - acquire_tick), lock_logged);
+        }
+        
         #if DEBUG_GIMBAL
         if (debug_output_enabled)
         {
             if (no_data_counter == 1)  // 只在第一次丢失时输出
             {
-                SerialDebug_Printf("Target LOST\r\n");
+                BINLOG("Target LOST");
             }
-            if (no_data_counter % 50 == 0)  // 每1秒输出一次
+            if (no_data_counter % (1000 / control_period_ms) == 0)  // 每1秒输出一次
             {
-                SerialDebug_Printf("Waiting for camera data... (no data for %d cycles)\r\n", no_data_counter);
+                BINLOG("Waiting for camera data... (no data for %d cycles)", no_data_counter);
             }
         }
         #endif
         
         gimbal_state = GIMBAL_IDLE;
-        lock_counter = 0;
+        // 相机帧率低于控制频率，帧间的空周期不打断锁定计数，超过测量间隔上限才清零
+        if (measure_elapsed_ms > MEASURE_DT_MAX_MS)
+        {
+            lock_counter = 0;
+            LockOut_Set(0, 0.0f, 0.0f);
+        }
     }
+    
+    Gimbal_UpdateRate(step_h, step_v);
+}
+
+/**
+ * @brief  云台自检测试
+ * @retval None
+ * @note   在任务中调用（等待用osDelay）
+ */
+void Gimbal_SelfTest(void)
+{
+    // 等待电机自己初始化
+    osDelay(SELFTEST_POWERUP_MS);
+    
+    // STM32初始化电机
+    Motor_Init();
+    osDelay(100);
+    
+    // 测试序列：使用较小的角度和较慢的速度，更平滑
+    
+    // 左转30°（减小角度）
+    Motor_MoveHorizontal(-30.0f);
+    osDelay(SELFTEST_STEP_MS);
+    
+    // 右转30°
+    Motor_MoveHorizontal(30.0f);
+    osDelay(SELFTEST_STEP_MS);
+    
+    // 上转15°（减小角度）
+    Motor_MoveVertical(15.0f);
+    osDelay(SELFTEST_STEP_MS);
+    
+    // 下转15°
+    Motor_MoveVertical(-15.0f);
+    osDelay(SELFTEST_STEP_MS);
+    
+    // 停止
+    Motor_Stop();
+}
+
+/**
+ * @brief  请求自检
+ * @retval 1=已接受, 0=上一次自检未完成
+ */
+uint8_t Gimbal_RequestSelfTest(void)
+{
+    if (selftest_requested) return 0;
+    
+    selftest_requested = 1;
+    return 1;
+}
+
+/**
+ * @brief  执行挂起的自检
+ * @retval None
+ */
+void Gimbal_ProcessSelfTest(void)
+{
+    if (!selftest_requested) return;
+    
+    SerialDebug_Printf("Running self test...\r\n");
+    Gimbal_SelfTest();
+    SerialDebug_Printf("Self test completed\r\n");
+    selftest_requested = 0;
+    Gimbal_ReleaseMotorBus();
+}
+
+/**
+ * @brief  为后台任务占用电机串口
+ * @retval 1=已占用, 0=跟踪中或已被占用
+ */
+uint8_t Gimbal_ClaimMotorBus(void)
+{
+    uint8_t ok;
+    
+    __disable_irq();
+    ok = !gimbal_enabled && !motor_bus_claimed;
+    if (ok) motor_bus_claimed = 1;
+    __enable_irq();
+    return ok;
+}
+
+/**
+ * @brief  释放电机串口
+ * @retval None
+ */
+void Gimbal_ReleaseMotorBus(void)
+{
+    motor_bus_claimed = 0;
+}
+
+/**
+ * @brief  电机串口是否被后台任务占用
+ * @retval 1=已占用, 0=空闲
+ */
+uint8_t Gimbal_IsMotorBusClaimed(void)
+{
+    return motor_bus_claimed;
 }
 
 /**
@@ -191,6 +944,15 @@ GimbalState Gimbal_GetState(void)
     return gimbal_state;
 }
 
+/**
+ * @brief  获取跟踪使能状态
+ * @retval 1=跟踪中, 0=已禁用
+ */
+uint8_t Gimbal_IsEnabled(void)
+{
+    return gimbal_enabled;
+}
+
 /**
  * @brief  设置PID参数
  * @param  axis: 轴选择（水平/垂直）
@@ -209,6 +971,11 @@ void Gimbal_SetPID(GimbalAxis axis, float kp, float ki, float kd)
     {
         PID_SetParams(&pid_v, kp, ki, kd);
     }
+    else
+    {
+        return;
+    }
+    self_tune_base_kp[axis] = kp;  // 自校正以手动设置的增益为新基准
 }
 
 /**
@@ -235,6 +1002,327 @@ void Gimbal_GetPID(GimbalAxis axis, float *kp, float *ki, float *kd)
     }
 }
 
+/**
+ * @brief  获取当前控制器配置
+ * @param  config: 配置（输出）
+ * @retval None
+ * @note   有待生效的请求时返回请求的配置
+ */
+void Gimbal_GetConfig(GimbalConfig *config)
+{
+    __disable_irq();
+    if (config_requested)
+    {
+        *config = requested_config;
+        __enable_irq();
+        return;
+    }
+    __enable_irq();
+    
+    memset(config, 0, sizeof(*config));
+    config->kp[GIMBAL_AXIS_H] = pid_h.kp;
+    config->ki[GIMBAL_AXIS_H] = pid_h.ki;
+    config->kd[GIMBAL_AXIS_H] = pid_h.kd;
+    config->kp[GIMBAL_AXIS_V] = pid_v.kp;
+    config->ki[GIMBAL_AXIS_V] = pid_v.ki;
+    config->kd[GIMBAL_AXIS_V] = pid_v.kd;
+    config->d_filter_tau = pid_h.d_filter_tau;
+    config->motor_rpm = Motor_GetSpeed();
+    config->deadzone = pid_h.deadzone;
+}
+
+/**
+ * @brief  请求切换控制器配置
+ * @param  config: 新配置
+ * @retval 1=已受理, 0=参数超出范围
+ * @note   可在中断中调用；在下一次控制任务开始时整体生效，PID增益无扰切换
+ */
+uint8_t Gimbal_RequestConfig(const GimbalConfig *config)
+{
+    if (config->deadzone > GIMBAL_DEADZONE_MAX ||
+        config->d_filter_tau < 0.0f || config->d_filter_tau > GIMBAL_D_FILTER_MAX_S ||
+        config->motor_rpm < MOTOR_SPEED_MIN_RPM || config->motor_rpm > MOTOR_SPEED_MAX_RPM)
+    {
+        return 0;
+    }
+    
+    __disable_irq();
+    requested_config = *config;
+    config_requested = 1;
+    __enable_irq();
+    return 1;
+}
+
+
+/**
+ * @brief  请求切换轴的控制器形式
+ * @param  axis: 轴选择（水平/垂直）
+ * @param  params: 状态反馈参数，NULL=恢复PID
+ * @retval 1=已受理, 0=参数无效
+ * @note   可在中断中调用；在下一次控制任务开始时生效
+ */
+uint8_t Gimbal_RequestStateFb(GimbalAxis axis, const StateFbParams *params)
+{
+    if (params != NULL && !StateFb_CheckParams(params))
+    {
+        return 0;
+    }
+    
+    __disable_irq();
+    if (params != NULL)
+    {
+        requested_sf[axis] = *params;
+        sf_requested[axis] = 1;
+    }
+    else
+    {
+        sf_requested[axis] = 2;
+    }
+    __enable_irq();
+    return 1;
+}
+
+/**
+ * @brief  获取轴的状态反馈参数
+ * @param  axis: 轴选择（水平/垂直）
+ * @param  params: 参数（输出，仅在返回1时有效）
+ * @retval 1=该轴使用状态反馈, 0=使用PID
+ */
+uint8_t Gimbal_GetStateFb(GimbalAxis axis, StateFbParams *params)
+{
+    if (!sf_active[axis])
+    {
+        return 0;
+    }
+    *params = sf_ctrl[axis].p;
+    return 1;
+}
+
+/**
+ * @brief  设置控制频率
+ * @param  hz: 控制频率(Hz)，10~500
+ * @retval 1=成功, 0=超出范围
+ * @note   可在中断中调用，新周期在下一次控制任务开始时生效；
+ *         周期取整到1ms（tick分辨率），实际频率用Gimbal_GetRate()读取
+ */
+uint8_t Gimbal_SetRate(uint32_t hz)
+{
+    if (hz == 0) return 0;
+    
+    uint32_t period_ms = (1000 + hz / 2) / hz;
+    if (period_ms < CONTROL_PERIOD_MIN_MS || period_ms > CONTROL_PERIOD_MAX_MS) return 0;
+    
+    requested_period_ms = period_ms;
+    overrun_count = 0;
+    return 1;
+}
+
+/**
+ * @brief  获取实际控制频率
+ * @retval 控制频率(Hz)
+ */
+float Gimbal_GetRate(void)
+{
+    uint32_t period_ms = requested_period_ms ? requested_period_ms : control_period_ms;
+    return 1000.0f / period_ms;
+}
+
+/**
+ * @brief  获取控制周期
+ * @retval 控制周期(ms)
+ */
+uint32_t Gimbal_GetPeriodMs(void)
+{
+    return control_period_ms;
+}
+
+/**
+ * @brief  记录一次控制周期超时
+ * @retval None
+ * @note   由控制任务在错过唤醒时刻时调用
+ */
+void Gimbal_NotifyOverrun(void)
+{
+    overrun_count++;
+    
+    // 控制停止时的超时（如擦除Flash）不记录
+    if (gimbal_enabled && HAL_GetTick() - overrun_logged_tick >= OVERRUN_LOG_MS)
+    {
+        overrun_logged_tick = HAL_GetTick();
+        Journal_Log(JOURNAL_EV_OVERRUN, (int32_t)overrun_count, 0);
+    }
+}
+
+/**
+ * @brief  获取控制周期超时次数
+ * @retval 自上次设置频率以来的超时次数
+ */
+uint32_t Gimbal_GetOverrunCount(void)
+{
+    return overrun_count;
+}
+
+/**
+ * @brief  设置相机滚转角
+ * @param  deg: 相机相对云台的滚转角(度)，±45°以内
+ * @retval 1=成功, 0=超出范围
+ * @note   可在中断中调用，下一次测量时生效
+ */
+uint8_t Gimbal_SetCameraRoll(float deg)
+{
+    if (deg < -CAMERA_ROLL_MAX_DEG || deg > CAMERA_ROLL_MAX_DEG) return 0;
+    
+    float rad = deg * 0.01745329f;
+    camera_roll_deg = deg;
+    camera_roll_cos = cosf(rad);
+    camera_roll_sin = sinf(rad);
+    return 1;
+}
+
+/**
+ * @brief  请求开启/关闭/重置图像雅可比在线估计
+ * @param  mode: 1=开启, 0=关闭, 2=按名义值重新开始
+ * @retval 1=已受理, 0=参数无效
+ * @note   可在中断中调用；在下一次控制任务开始时生效
+ */
+uint8_t Gimbal_RequestImgJac(uint8_t mode)
+{
+    if (mode > 2) return 0;
+    
+    img_jac_requested = (mode == 1) ? 1 : (mode == 0) ? 2 : 3;
+    return 1;
+}
+
+/**
+ * @brief  获取图像雅可比估计
+ * @param  jac: 估计器副本（输出）
+ * @retval 1=已开启, 0=关闭
+ */
+uint8_t Gimbal_GetImgJac(ImgJac *jac)
+{
+    *jac = img_jac;
+    return img_jac_active;
+}
+
+/**
+ * @brief  请求开启/关闭自校正
+ * @param  enabled: 1=开启, 0=关闭
+ * @retval None
+ * @note   可在中断中调用；在下一次控制任务开始时生效
+ */
+void Gimbal_RequestSelfTune(uint8_t enabled)
+{
+    self_tune_requested = enabled ? 1 : 2;
+}
+
+/**
+ * @brief  获取轴的自校正状态
+ * @param  axis: 轴选择（水平/垂直）
+ * @param  st: 估计器副本（输出）
+ * @param  base_kp: 基准Kp（输出）
+ * @retval 1=已开启, 0=关闭
+ */
+uint8_t Gimbal_GetSelfTune(GimbalAxis axis, SelfTune *st, float *base_kp)
+{
+    *st = self_tune[axis];
+    *base_kp = self_tune_base_kp[axis];
+    return self_tune_active;
+}
+
+/**
+ * @brief  开启/关闭按目标运动状态调度增益和死区
+ * @param  enabled: 1=开启, 0=关闭
+ * @retval None
+ */
+void Gimbal_SetImm(uint8_t enabled)
+{
+    imm_enabled = enabled ? 1 : 0;
+}
+
+/**
+ * @brief  获取增益/死区调度开关
+ * @retval 1=开启, 0=关闭
+ */
+uint8_t Gimbal_GetImm(void)
+{
+    return imm_enabled;
+}
+
+/**
+ * @brief  设置载荷延迟（提前量）
+ * @param  ms: 载荷延迟(ms)，0~LEAD_LATENCY_MAX_MS，0=瞄准图像中心
+ * @retval 1=成功, 0=超出范围
+ */
+uint8_t Gimbal_SetLeadLatency(uint32_t ms)
+{
+    if (ms > LEAD_LATENCY_MAX_MS)
+    {
+        return 0;
+    }
+    lead_latency_ms = ms;
+    return 1;
+}
+
+/**
+ * @brief  获取载荷延迟
+ * @retval 载荷延迟(ms)
+ */
+uint32_t Gimbal_GetLeadLatency(void)
+{
+    return lead_latency_ms;
+}
+
+/**
+ * @brief  获取目标运动估计
+ * @param  axis: 轴选择（水平/垂直）
+ * @param  motion: 估计结果（输出）
+ * @retval None
+ * @note   控制任务可能正在更新，各字段不保证属于同一次测量（仅供显示）
+ */
+void Gimbal_GetTargetMotion(GimbalAxis axis, GimbalTargetMotion *motion)
+{
+    const ImmFilter *imm = (axis == GIMBAL_AXIS_H) ? &imm_h : &imm_v;
+    const PID_Controller *pid = (axis == GIMBAL_AXIS_H) ? &pid_h : &pid_v;
+    
+    for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++)
+    {
+        motion->mu[j] = imm->mu[j];
+    }
+    motion->velocity = imm->xc[1];
+    motion->accel = imm->xc[2];
+    motion->gain_scale = pid->gain_scale;
+    motion->deadzone_scale = pid->deadzone_scale;
+    motion->lead = (axis == GIMBAL_AXIS_H) ? lead_h : lead_v;
+    motion->valid = imm->initialized;
+}
+
+/**
+ * @brief  获取云台指向
+ * @param  pan: 水平轴指向（度，输出）
+ * @param  tilt: 垂直轴指向（度，输出）
+ * @retval 1=两轴读数均有效, 0=无效（未使能或最近一次读取失败）
+ * @note   返回控制任务每周期交替读取的缓存（两轴读数相差一个控制周期），不访问电机串口；
+ *         仅在控制任务中调用
+ */
+uint8_t Gimbal_GetPointing(float *pan, float *tilt)
+{
+    if (!gimbal_enabled || !pointing_valid)
+    {
+        return 0;
+    }
+    *pan = pointing[GIMBAL_AXIS_H];
+    *tilt = pointing[GIMBAL_AXIS_V];
+    return 1;
+}
+
+/**
+ * @brief  获取相机滚转角
+ * @retval 滚转角(度)
+ */
+float Gimbal_GetCameraRoll(void)
+{
+    return camera_roll_deg;
+}
 
 /**
  * @brief  设置调试输出开关
@@ -11,6 +11,10 @@
 
 #include "stm32f4xx_hal.h"
 #include "PID.h"
+#include "StateFb.h"
+#include "Imm.h"
+#include "ImgJac.h"
+#include "SelfTune.h"
 
 /**
  * @brief 云台状态枚举
@@ -29,6 +33,35 @@ typedef enum {
     GIMBAL_AXIS_V = 1   ///< 垂直轴
 } GimbalAxis;
 
+#define GIMBAL_DEADZONE_MAX      50      ///< 死区上限（像素）
+#define GIMBAL_D_FILTER_MAX_S    1.0f    ///< 微分低通时间常数上限(s)
+
+/**
+ * @brief 控制器完整配置（参数档案的内容）
+ */
+typedef struct {
+    float kp[2];          ///< 比例系数，按GimbalAxis索引
+    float ki[2];          ///< 积分系数（1/s）
+    float kd[2];          ///< 微分系数（s）
+    float d_filter_tau;   ///< 微分低通时间常数(s)，两轴相同
+    uint16_t motor_rpm;   ///< 位置模式转速(RPM)
+    uint8_t deadzone;     ///< 死区（像素），两轴相同
+    uint8_t reserved;
+} GimbalConfig;
+
+/**
+ * @brief 目标运动估计（IMM输出）
+ */
+typedef struct {
+    float mu[IMM_MODEL_COUNT];  ///< 模型概率，按ImmModel索引
+    float velocity;             ///< 目标角速度（度/秒）
+    float accel;                ///< 目标角加速度（度/秒²）
+    float gain_scale;           ///< 当前增益调度倍率
+    float deadzone_scale;       ///< 当前死区调度倍率
+    float lead;                 ///< 当前提前量（度，瞄准点在目标运动方向前方的角度）
+    uint8_t valid;              ///< 1=正在估计（已捕获目标）
+} GimbalTargetMotion;
+
 /**
  * @brief  云台初始化
  * @retval None
@@ -37,9 +70,9 @@ void Gimbal_Init(void);
 
 /**
  * @brief  启用云台跟踪
- * @retval None
+ * @retval 1=已启用, 0=电机串口被后台任务占用（见Gimbal_ClaimMotorBus）
  */
-void Gimbal_Enable(void);
+uint8_t Gimbal_Enable(void);
 
 /**
  * @brief  禁用云台跟踪
@@ -50,29 +83,70 @@ void Gimbal_Disable(void);
 /**
  * @brief  云台控制任务
  * @retval None
- * @note   在FreeRTOS任务中以50Hz频率调用
+ * @note   在FreeRTOS任务中按Gimbal_GetPeriodMs()周期调用
  */
 void Gimbal_ControlTask(void);
 
 /**
  * @brief  云台自检测试
  * @retval None
- * @note   测试序列：左30° → 右30° → 上15° → 下15°
+ * @note   测试序列：左30° → 右30° → 上15° → 下15°；在任务中调用（osDelay等待）
  */
 void Gimbal_SelfTest(void);
 
+/**
+ * @brief  请求自检（test命令调用）
+ * @retval 1=已接受, 0=上一次自检未完成
+ * @note   须先disable，自检在默认任务中执行
+ */
+uint8_t Gimbal_RequestSelfTest(void);
+
+/**
+ * @brief  执行挂起的自检
+ * @retval None
+ * @note   在默认任务中调用
+ */
+void Gimbal_ProcessSelfTest(void);
+
 /**
  * @brief  获取云台状态
  * @retval 云台状态
  */
 GimbalState Gimbal_GetState(void);
 
+/**
+ * @brief  获取跟踪使能状态
+ * @retval 1=跟踪中（控制任务在发送电机指令）, 0=已禁用
+ */
+uint8_t Gimbal_IsEnabled(void);
+
+/**
+ * @brief  为后台任务占用电机串口（drv show/sync、latency、calib、test）
+ * @retval 1=已占用, 0=跟踪中或已被其他后台任务占用
+ * @note   可在中断中调用；提交请求时占用，任务结束时由任务释放，占用期间enable被拒绝。
+ *         Flash擦除（journal、profile）同样占用，擦除停顿不会落在控制运行中
+ */
+uint8_t Gimbal_ClaimMotorBus(void);
+
+/**
+ * @brief  释放电机串口
+ * @retval None
+ */
+void Gimbal_ReleaseMotorBus(void);
+
+/**
+ * @brief  电机串口是否被后台任务占用
+ * @retval 1=已占用, 0=空闲
+ * @note   手动move/stop在占用期间被拒绝
+ */
+uint8_t Gimbal_IsMotorBusClaimed(void);
+
 /**
  * @brief  设置PID参数
  * @param  axis: 轴选择（水平/垂直）
  * @param  kp: 比例系数
- * @param  ki: 积分系数
- * @param  kd: 微分系数
+ * @param  ki: 积分系数（1/s）
+ * @param  kd: 微分系数（s）
  * @retval None
  */
 void Gimbal_SetPID(GimbalAxis axis, float kp, float ki, float kd);
@@ -87,6 +161,166 @@ void Gimbal_SetPID(GimbalAxis axis, float kp, float ki, float kd);
  */
 void Gimbal_GetPID(GimbalAxis axis, float *kp, float *ki, float *kd);
 
+/**
+ * @brief  获取当前控制器配置
+ * @param  config: 配置（输出）
+ * @retval None
+ * @note   有待生效的请求时返回请求的配置
+ */
+void Gimbal_GetConfig(GimbalConfig *config);
+
+/**
+ * @brief  请求切换控制器配置
+ * @param  config: 新配置
+ * @retval 1=已受理, 0=参数超出范围
+ * @note   可在中断中调用；在下一次控制任务开始时整体生效，PID增益无扰切换
+ */
+uint8_t Gimbal_RequestConfig(const GimbalConfig *config);
+
+/**
+ * @brief  请求切换轴的控制器形式
+ * @param  axis: 轴选择（水平/垂直）
+ * @param  params: 状态反馈参数（上位机综合），NULL=恢复PID
+ * @retval 1=已受理, 0=参数无效
+ * @note   可在中断中调用；在下一次控制任务开始时生效，切换时清除控制器状态；
+ *         参数只在RAM中，不随参数档案保存
+ */
+uint8_t Gimbal_RequestStateFb(GimbalAxis axis, const StateFbParams *params);
+
+/**
+ * @brief  获取轴的状态反馈参数
+ * @param  axis: 轴选择（水平/垂直）
+ * @param  params: 参数（输出，仅在返回1时有效）
+ * @retval 1=该轴使用状态反馈, 0=使用PID
+ */
+uint8_t Gimbal_GetStateFb(GimbalAxis axis, StateFbParams *params);
+
+/**
+ * @brief  设置控制频率
+ * @param  hz: 控制频率(Hz)，10~500
+ * @retval 1=成功, 0=超出范围
+ * @note   新周期在下一次控制任务开始时生效，PID和滤波器自动重新离散化
+ */
+uint8_t Gimbal_SetRate(uint32_t hz);
+
+/**
+ * @brief  获取实际控制频率
+ * @retval 控制频率(Hz)（周期取整到1ms后的值）
+ */
+float Gimbal_GetRate(void);
+
+/**
+ * @brief  获取控制周期
+ * @retval 控制周期(ms)
+ */
+uint32_t Gimbal_GetPeriodMs(void);
+
+/**
+ * @brief  记录一次控制周期超时
+ * @retval None
+ */
+void Gimbal_NotifyOverrun(void);
+
+/**
+ * @brief  获取控制周期超时次数
+ * @retval 自上次设置频率以来的超时次数
+ */
+uint32_t Gimbal_GetOverrunCount(void);
+
+/**
+ * @brief  设置相机滚转角
+ * @param  deg: 相机相对云台的滚转角(度)，±45°以内
+ * @retval 1=成功, 0=超出范围
+ * @note   偏差向量按该角度逆旋转后送入PID；由calib命令标定写入
+ */
+uint8_t Gimbal_SetCameraRoll(float deg);
+
+/**
+ * @brief  获取相机滚转角
+ * @retval 滚转角(度)
+ */
+float Gimbal_GetCameraRoll(void);
+
+/**
+ * @brief  请求开启/关闭/重置图像雅可比在线估计
+ * @param  mode: 1=开启（从当前滚转角和名义像素/度开始估计）, 0=关闭（恢复固定滚转补偿）, 2=按名义值重新开始
+ * @retval 1=已受理, 0=参数无效
+ * @note   可在中断中调用；在下一次控制任务开始时生效
+ */
+uint8_t Gimbal_RequestImgJac(uint8_t mode);
+
+/**
+ * @brief  获取图像雅可比估计
+ * @param  jac: 估计器副本（输出）
+ * @retval 1=已开启, 0=关闭（副本为最后一次的估计值）
+ * @note   控制任务可能正在更新（仅供显示）
+ */
+uint8_t Gimbal_GetImgJac(ImgJac *jac);
+
+/**
+ * @brief  请求开启/关闭自校正
+ * @param  enabled: 1=开启（以当前PID增益为基准，从名义模型开始估计）, 0=关闭（恢复基准增益）
+ * @retval None
+ * @note   可在中断中调用；在下一次控制任务开始时生效。使用状态反馈的轴不调整
+ */
+void Gimbal_RequestSelfTune(uint8_t enabled);
+
+/**
+ * @brief  获取轴的自校正状态
+ * @param  axis: 轴选择（水平/垂直）
+ * @param  st: 估计器副本（输出）
+ * @param  base_kp: 基准Kp（输出）
+ * @retval 1=已开启, 0=关闭
+ * @note   控制任务可能正在更新（仅供显示）
+ */
+uint8_t Gimbal_GetSelfTune(GimbalAxis axis, SelfTune *st, float *base_kp);
+
+/**
+ * @brief  开启/关闭按目标运动状态调度增益和死区
+ * @param  enabled: 1=开启, 0=关闭（固定增益和死区，估计照常运行）
+ * @retval None
+ * @note   下一次测量时生效
+ */
+void Gimbal_SetImm(uint8_t enabled);
+
+/**
+ * @brief  获取增益/死区调度开关
+ * @retval 1=开启, 0=关闭
+ */
+uint8_t Gimbal_GetImm(void);
+
+/**
+ * @brief  设置载荷延迟（提前量）
+ * @param  ms: 载荷响应延迟(ms)，0~1000，0=瞄准图像中心
+ * @retval 1=成功, 0=超出范围
+ * @note   每次测量按目标运动估计计算提前量v·T+a·T²/2（限幅±10°），
+ *         作为设定值代替图像中心送入PID；下一次测量时生效
+ */
+uint8_t Gimbal_SetLeadLatency(uint32_t ms);
+
+/**
+ * @brief  获取载荷延迟
+ * @retval 载荷延迟(ms)，0=未启用提前量
+ */
+uint32_t Gimbal_GetLeadLatency(void);
+
+/**
+ * @brief  获取目标运动估计
+ * @param  axis: 轴选择（水平/垂直）
+ * @param  motion: 估计结果（输出）
+ * @retval None
+ */
+void Gimbal_GetTargetMotion(GimbalAxis axis, GimbalTargetMotion *motion);
+
+/**
+ * @brief  获取云台指向
+ * @param  pan: 水平轴指向（度，输出）
+ * @param  tilt: 垂直轴指向（度，输出）
+ * @retval 1=两轴读数均有效, 0=无效
+ * @note   返回控制任务读取的指向缓存，不访问电机串口；仅在控制任务中调用
+ */
+uint8_t Gimbal_GetPointing(float *pan, float *tilt);
+
 /**
  * @brief  设置调试输出开关
  * @param  enabled: 1=开启, 0=关闭
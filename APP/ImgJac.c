@@ -0,0 +1,252 @@
+/**
+ * @file    ImgJac.c
+ * @brief   图像雅可比在线估计实现
+ * @details 每个区间两个标量观测依次更新（x、y两行），回归量：
+ *              x: φ = [-Δq_h,  Δq_v, Δt, 0 ]
+ *              y: φ = [-Δq_v, -Δq_h, 0,  Δt]
+ *          k = P·φ / (r + φ'·P·φ)，θ += k·(y - θ·φ)，P -= k·(P·φ)'，之后按随机游走模型加过程噪声。
+ *          只有4维，直接展开计算，不使用CMSIS-DSP
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "ImgJac.h"
+#include "Imm.h"
+#include <math.h>
+#include <string.h>
+
+#define IMGJAC_P0_J            4.0f     ///< 初始协方差：J参数(像素/度)²，约名义值的一半
+#define IMGJAC_P0_DRIFT        400.0f   ///< 初始协方差：漂移(像素/秒)²
+#define IMGJAC_Q_J             0.0001f  ///< 过程噪声：J参数每个区间(像素/度)²
+#define IMGJAC_Q_DRIFT         100.0f   ///< 过程噪声：漂移每秒(像素/秒)²
+#define IMGJAC_R_PX2           1.0f     ///< 观测噪声(像素²)：坐标取整和指向回推误差
+#define IMGJAC_OUTLIER_PX      20.0f    ///< 新息上限：固定部分（像素）
+#define IMGJAC_OUTLIER_RATIO   0.5f     ///< 新息上限：按预测变化量的比例
+
+/**
+ * @brief  由参数计算J和逆矩阵
+ * @retval None
+ */
+static void ImgJac_SetJ(ImgJac *jac)
+{
+    float a = jac->theta[0];
+    float b = jac->theta[1];
+    float det = a * a + b * b;
+
+    jac->J[0] = a;
+    jac->J[1] = -b;
+    jac->J[2] = b;
+    jac->J[3] = a;
+    jac->Jinv[0] = a / det;
+    jac->Jinv[1] = b / det;
+    jac->Jinv[2] = -b / det;
+    jac->Jinv[3] = a / det;
+}
+
+/**
+ * @brief  检查参数是否在安全范围内
+ * @retval 1=可用
+ */
+static uint8_t ImgJac_IsSane(const float theta[4])
+{
+    float scale = sqrtf(theta[0] * theta[0] + theta[1] * theta[1]) / IMM_PIXELS_PER_DEG;
+    float roll = atan2f(theta[1], theta[0]) * 180.0f / 3.14159265f;
+
+    // 比较写成"在范围内"的形式，NaN时返回0
+    return (scale >= IMGJAC_SCALE_MIN && scale <= IMGJAC_SCALE_MAX &&
+            fabsf(roll) <= IMGJAC_ROLL_MAX_DEG &&
+            fabsf(theta[2]) < 1e6f && fabsf(theta[3]) < 1e6f);
+}
+
+/**
+ * @brief  一个标量观测的递推最小二乘更新
+ * @param  theta: 参数（原地更新）
+ * @param  P: 协方差（原地更新）
+ * @param  phi: 回归量
+ * @param  y: 观测
+ * @retval None
+ */
+static void ImgJac_ScalarUpdate(float theta[4], float P[16], const float phi[4], float y)
+{
+    float Pphi[4];
+    float den = IMGJAC_R_PX2;
+    float e = y;
+
+    for (uint8_t r = 0; r < 4; r++)
+    {
+        Pphi[r] = P[4 * r] * phi[0] + P[4 * r + 1] * phi[1] + P[4 * r + 2] * phi[2] + P[4 * r + 3] * phi[3];
+        den += phi[r] * Pphi[r];
+        e -= theta[r] * phi[r];
+    }
+    for (uint8_t r = 0; r < 4; r++)
+    {
+        float k = Pphi[r] / den;
+        theta[r] += k * e;
+        for (uint8_t c = 0; c < 4; c++)
+        {
+            P[4 * r + c] -= k * Pphi[c];
+        }
+    }
+}
+
+/**
+ * @brief  以当前测量作为区间起点
+ * @retval None
+ */
+static void ImgJac_Anchor(ImgJac *jac, float dx, float dy, float q_h, float q_v)
+{
+    jac->d0[0] = dx;
+    jac->d0[1] = dy;
+    jac->q0[0] = q_h;
+    jac->q0[1] = q_v;
+    jac->t = 0.0f;
+    jac->anchored = 1;
+}
+
+/**
+ * @brief  按名义值初始化
+ * @param  jac: 估计器
+ * @param  roll_deg: 相机滚转角(度)
+ * @retval None
+ */
+void ImgJac_Init(ImgJac *jac, float roll_deg)
+{
+    float rad = roll_deg * 3.14159265f / 180.0f;
+
+    memset(jac, 0, sizeof(*jac));
+
+    // 与滚转补偿一致：d = R(roll)·e，e为云台坐标系偏差
+    jac->theta[0] = cosf(rad) * IMM_PIXELS_PER_DEG;
+    jac->theta[1] = sinf(rad) * IMM_PIXELS_PER_DEG;
+    ImgJac_SetJ(jac);
+
+    jac->P[0] = IMGJAC_P0_J;
+    jac->P[5] = IMGJAC_P0_J;
+    jac->P[10] = IMGJAC_P0_DRIFT;
+    jac->P[15] = IMGJAC_P0_DRIFT;
+}
+
+/**
+ * @brief  放弃当前区间
+ * @param  jac: 估计器
+ * @retval None
+ */
+void ImgJac_Restart(ImgJac *jac)
+{
+    jac->anchored = 0;
+}
+
+/**
+ * @brief  输入一次测量
+ * @retval 1=更新了J, 0=未更新
+ */
+uint8_t ImgJac_Update(ImgJac *jac, float dx, float dy, float q_h, float q_v, float dt)
+{
+    float theta[4], P[16];
+    float phi_x[4], phi_y[4], y[2], pred[2];
+    float dq_h, dq_v, t;
+    uint8_t gated;
+
+    if (!jac->anchored)
+    {
+        ImgJac_Anchor(jac, dx, dy, q_h, q_v);
+        return 0;
+    }
+
+    // 激励检查：转角不足时继续累计，超过窗口时长则以本次测量为新的起点
+    jac->t += dt;
+    dq_h = q_h - jac->q0[0];
+    dq_v = q_v - jac->q0[1];
+    if (sqrtf(dq_h * dq_h + dq_v * dq_v) < IMGJAC_MIN_STEP_DEG)
+    {
+        if (jac->t > IMGJAC_WINDOW_MAX_S) ImgJac_Anchor(jac, dx, dy, q_h, q_v);
+        return 0;
+    }
+
+    t = jac->t;
+    y[0] = dx - jac->d0[0];
+    y[1] = dy - jac->d0[1];
+    ImgJac_Anchor(jac, dx, dy, q_h, q_v);   // 本次测量作为下一区间的起点
+
+    // 云台转动造成的图像变化 -J·Δq
+    pred[0] = -(jac->theta[0] * dq_h - jac->theta[1] * dq_v);
+    pred[1] = -(jac->theta[1] * dq_h + jac->theta[0] * dq_v);
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        float expect = pred[i] + jac->theta[2 + i] * t;
+        if (fabsf(y[i] - expect) > IMGJAC_OUTLIER_PX + IMGJAC_OUTLIER_RATIO * fabsf(expect))
+        {
+            jac->rejected++;
+            return 0;
+        }
+    }
+
+    // 目标漂移与云台转动造成的图像变化相当时无法区分，只更新漂移
+    gated = sqrtf(jac->theta[2] * jac->theta[2] + jac->theta[3] * jac->theta[3]) * t >
+            IMGJAC_DRIFT_GATE * sqrtf(pred[0] * pred[0] + pred[1] * pred[1]);
+
+    memcpy(theta, jac->theta, sizeof(theta));
+    memcpy(P, jac->P, sizeof(P));
+    memset(phi_x, 0, sizeof(phi_x));
+    memset(phi_y, 0, sizeof(phi_y));
+    phi_x[2] = t;
+    phi_y[3] = t;
+    if (gated)
+    {
+        y[0] -= pred[0];
+        y[1] -= pred[1];
+    }
+    else
+    {
+        phi_x[0] = -dq_h;
+        phi_x[1] = dq_v;
+        phi_y[0] = -dq_v;
+        phi_y[1] = -dq_h;
+    }
+    ImgJac_ScalarUpdate(theta, P, phi_x, y[0]);
+    ImgJac_ScalarUpdate(theta, P, phi_y, y[1]);
+
+    // 越界回退：估计值和协方差都不变
+    if (!ImgJac_IsSane(theta))
+    {
+        jac->rejected++;
+        return 0;
+    }
+
+    P[0] += IMGJAC_Q_J;
+    P[5] += IMGJAC_Q_J;
+    P[10] += IMGJAC_Q_DRIFT * t;
+    P[15] += IMGJAC_Q_DRIFT * t;
+    memcpy(jac->theta, theta, sizeof(theta));
+    memcpy(jac->P, P, sizeof(P));
+    ImgJac_SetJ(jac);
+
+    if (gated)
+    {
+        jac->gated++;
+        return 0;
+    }
+    jac->updates++;
+    return 1;
+}
+
+/**
+ * @brief  图像偏差换算为名义像素偏差
+ * @retval None
+ */
+void ImgJac_Correct(const ImgJac *jac, float dx, float dy, float *err_h, float *err_v)
+{
+    *err_h = IMM_PIXELS_PER_DEG * (jac->Jinv[0] * dx + jac->Jinv[1] * dy);
+    *err_v = IMM_PIXELS_PER_DEG * (jac->Jinv[2] * dx + jac->Jinv[3] * dy);
+}
+
+/**
+ * @brief  等效尺度和旋转
+ * @retval None
+ */
+void ImgJac_GetScaleRoll(const ImgJac *jac, float *scale, float *roll_deg)
+{
+    *scale = sqrtf(jac->theta[0] * jac->theta[0] + jac->theta[1] * jac->theta[1]);
+    *roll_deg = atan2f(jac->theta[1], jac->theta[0]) * 180.0f / 3.14159265f;
+}
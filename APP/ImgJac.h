@@ -0,0 +1,100 @@
+/**
+ * @file    ImgJac.h
+ * @brief   图像雅可比在线估计头文件
+ * @details 固定的"像素/度"和一次性的滚转标定在镜头变焦、目标距离或安装改变后失配，
+ *          环路增益随之变化。本模块在跟踪过程中持续估计2×2图像雅可比J（像素/度）：
+ *              Δd = -J·Δq + ḋ·Δt
+ *          Δd为一段区间内的图像偏差变化，Δq为同一区间的云台实际转角（编码器），
+ *          ḋ为目标运动造成的图像漂移（像素/秒），与J一起估计。
+ *          视轴附近两轴正交，J取尺度×旋转的形式 J = [a -b; b a]（尺度sqrt(a²+b²)，旋转atan2(b,a)），
+ *          单轴转动即可同时辨识两个参数；完整4参数在只有一个轴运动时不可辨识，会沿未激励方向漂移。
+ *          参数 [a b ḋx ḋy] 用递推最小二乘估计，协方差按随机游走模型增长（卡尔曼形式，代替统一遗忘因子，
+ *          协方差有界，长时间无激励也不会发散），漂移的过程噪声远大于J，残差优先归到目标运动上：
+ *          - 激励检查：转角累计到阈值才更新，超过窗口时长仍不足则丢弃该段；
+ *            目标漂移在区间内造成的图像变化与云台转动造成的相当时（平稳跟踪运动目标，两者共线，
+ *            闭环下J会被低估），只更新漂移，J保持不变
+ *          - 新息过大（目标跳变、坏帧）不更新
+ *          - 更新后尺度须在名义值的1/4~4倍之间、旋转不超过±45°，否则回退
+ *          控制时偏差按 名义像素/度·J⁻¹·d 换算，下游（PID、死区、IMM、提前量）仍按名义像素计
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _IMG_JAC_H
+#define _IMG_JAC_H
+
+#include <stdint.h>
+
+#define IMGJAC_MIN_STEP_DEG    0.5f     ///< 激励阈值：区间内两轴转角的模(度)
+#define IMGJAC_WINDOW_MAX_S    0.5f     ///< 区间最长时间(s)，超过仍不足激励则重新开始
+#define IMGJAC_DRIFT_GATE      0.25f    ///< 漂移造成的图像变化超过云台转动造成的该比例时只更新漂移
+#define IMGJAC_SCALE_MIN       0.25f    ///< 尺度下限（相对名义像素/度）
+#define IMGJAC_SCALE_MAX       4.0f     ///< 尺度上限
+#define IMGJAC_ROLL_MAX_DEG    45.0f    ///< 旋转上限(度)
+
+/**
+ * @brief 图像雅可比估计器
+ */
+typedef struct {
+    float theta[4];         ///< 参数 [a b ḋx ḋy]（像素/度，像素/秒）
+    float P[16];            ///< 协方差（行优先）
+    float J[4];             ///< 雅可比（像素/度，行优先：[dx/dh dx/dv; dy/dh dy/dv]）
+    float Jinv[4];          ///< 逆（度/像素）
+    float d0[2];            ///< 区间起点的图像偏差（像素）
+    float q0[2];            ///< 区间起点的云台转角（度）
+    float t;                ///< 区间已累计时间(s)
+    uint8_t anchored;       ///< 1=已有区间起点
+    uint32_t updates;       ///< 更新J的次数
+    uint32_t gated;         ///< 只更新漂移的次数
+    uint32_t rejected;      ///< 新息过大或越界被拒绝的次数
+} ImgJac;
+
+/**
+ * @brief  按名义值初始化
+ * @param  jac: 估计器
+ * @param  roll_deg: 相机相对云台的滚转角(度)，J = 名义像素/度 · R(roll)
+ * @retval None
+ */
+void ImgJac_Init(ImgJac *jac, float roll_deg);
+
+/**
+ * @brief  放弃当前区间
+ * @param  jac: 估计器
+ * @retval None
+ * @note   目标丢失、跟踪停止时调用，估计值保留
+ */
+void ImgJac_Restart(ImgJac *jac);
+
+/**
+ * @brief  输入一次测量
+ * @param  jac: 估计器
+ * @param  dx: 图像偏差x（像素）
+ * @param  dy: 图像偏差y（像素）
+ * @param  q_h: 相机成像时刻的水平转角（度）
+ * @param  q_v: 垂直转角（度）
+ * @param  dt: 距上一次测量的时间(s)
+ * @retval 1=本次更新了J, 0=未更新
+ */
+uint8_t ImgJac_Update(ImgJac *jac, float dx, float dy, float q_h, float q_v, float dt);
+
+/**
+ * @brief  图像偏差换算为云台坐标系的名义像素偏差
+ * @param  jac: 估计器
+ * @param  dx: 图像偏差x（像素）
+ * @param  dy: 图像偏差y（像素）
+ * @param  err_h: 输出水平偏差（名义像素）
+ * @param  err_v: 输出垂直偏差（名义像素）
+ * @retval None
+ */
+void ImgJac_Correct(const ImgJac *jac, float dx, float dy, float *err_h, float *err_v);
+
+/**
+ * @brief  等效尺度和旋转
+ * @param  jac: 估计器
+ * @param  scale: 输出尺度（像素/度）
+ * @param  roll_deg: 输出旋转角(度)
+ * @retval None
+ */
+void ImgJac_GetScaleRoll(const ImgJac *jac, float *scale, float *roll_deg);
+
+#endif
@@ -0,0 +1,243 @@
+/**
+ * @file    Imm.c
+ * @brief   交互多模型(IMM)目标运动估计实现
+ * @details 每次测量依次执行：
+ *          1. 交互：按模型转移概率混合上一时刻各模型的状态和协方差，作为各模型的初值
+ *          2. 预测：x = F·x，P = F·P·F' + Q（arm_mat_mult_f32/arm_mat_trans_f32/arm_mat_add_f32）
+ *          3. 更新：测量只有角度一维，新息方差为标量，卡尔曼增益K = P·H'/S 无需求逆，
+ *             P = P - K·(H·P)（外积用arm_mat_mult_f32，相减用arm_mat_sub_f32）
+ *          4. 概率：按新息的高斯似然度更新模型概率，输出按概率混合的状态
+ *          噪声参数按目标运动量级手工整定：测量噪声约1像素，
+ *          匀速模型允许约5度/秒²的加速度扰动，匀加速模型允许端点急停/反向的加速度突变
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "Imm.h"
+#include "arm_math.h"
+#include <math.h>
+#include <string.h>
+
+#define N IMM_STATE_DIM
+
+// 测量噪声：1像素对应的角度方差(度²)
+#define IMM_MEAS_SIGMA_DEG  (1.0f / IMM_PIXELS_PER_DEG)
+#define IMM_R               (IMM_MEAS_SIGMA_DEG * IMM_MEAS_SIGMA_DEG)
+
+// 过程噪声谱密度
+#define IMM_Q_STATIONARY    0.01f    // 静止：角度随机游走(度²/s)
+#define IMM_Q_CV            25.0f    // 匀速：白噪声加速度((度/s²)²·s)
+#define IMM_Q_CA            2000.0f  // 匀加速：白噪声加加速度((度/s³)²·s)
+
+// 初始化时速度、加速度的标准差
+#define IMM_INIT_SIGMA_V    20.0f    // 度/秒
+#define IMM_INIT_SIGMA_A    50.0f    // 度/秒²
+
+// 测量间隔限幅（丢帧时避免协方差预测过大）
+#define IMM_DT_MIN          0.001f
+#define IMM_DT_MAX          0.1f
+
+// 模型转移概率（每次测量，行=当前模型，列=下一模型）
+static const float imm_transition[IMM_MODEL_COUNT][IMM_MODEL_COUNT] = {
+    { 0.90f, 0.08f, 0.02f },   // 静止 → 起动多为匀速
+    { 0.05f, 0.90f, 0.05f },
+    { 0.05f, 0.10f, 0.85f },   // 机动持续时间短
+};
+
+// 初始模型概率
+static const float imm_mu_init[IMM_MODEL_COUNT] = { 0.8f, 0.15f, 0.05f };
+
+/**
+ * @brief  生成模型的状态转移矩阵和过程噪声矩阵
+ * @param  model: 模型
+ * @param  dt: 时间间隔(s)
+ * @param  F: 输出状态转移矩阵（行优先）
+ * @param  Q: 输出过程噪声矩阵（行优先）
+ * @retval None
+ */
+static void Imm_ModelMatrices(ImmModel model, float dt, float F[N * N], float Q[N * N])
+{
+    float dt2 = dt * dt;
+    float dt3 = dt2 * dt;
+
+    memset(F, 0, sizeof(float) * N * N);
+    memset(Q, 0, sizeof(float) * N * N);
+    F[0] = 1.0f;
+
+    switch (model) {
+    case IMM_MODEL_STATIONARY:
+        // 速度、加速度清零
+        Q[0] = IMM_Q_STATIONARY * dt;
+        break;
+
+    case IMM_MODEL_CV:
+        F[1] = dt;
+        F[4] = 1.0f;
+        Q[0] = IMM_Q_CV * dt3 / 3.0f;
+        Q[1] = Q[3] = IMM_Q_CV * dt2 / 2.0f;
+        Q[4] = IMM_Q_CV * dt;
+        break;
+
+    default:
+        F[1] = dt;
+        F[2] = dt2 / 2.0f;
+        F[4] = 1.0f;
+        F[5] = dt;
+        F[8] = 1.0f;
+        Q[0] = IMM_Q_CA * dt3 * dt2 / 20.0f;
+        Q[1] = Q[3] = IMM_Q_CA * dt2 * dt2 / 8.0f;
+        Q[2] = Q[6] = IMM_Q_CA * dt3 / 6.0f;
+        Q[4] = IMM_Q_CA * dt3 / 3.0f;
+        Q[5] = Q[7] = IMM_Q_CA * dt2 / 2.0f;
+        Q[8] = IMM_Q_CA * dt;
+        break;
+    }
+}
+
+/**
+ * @brief  用第一次测量初始化
+ * @param  f: 估计器
+ * @param  z: 目标方位角（度）
+ * @retval None
+ */
+static void Imm_Start(ImmFilter *f, float z)
+{
+    for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) {
+        memset(f->P[j], 0, sizeof(f->P[j]));
+        f->x[j][0] = z;
+        f->x[j][1] = 0.0f;
+        f->x[j][2] = 0.0f;
+        f->P[j][0] = IMM_R;
+        f->P[j][4] = IMM_INIT_SIGMA_V * IMM_INIT_SIGMA_V;
+        f->P[j][8] = IMM_INIT_SIGMA_A * IMM_INIT_SIGMA_A;
+        f->mu[j] = imm_mu_init[j];
+    }
+    f->xc[0] = z;
+    f->xc[1] = 0.0f;
+    f->xc[2] = 0.0f;
+    f->innovation = 0.0f;
+    f->initialized = 1;
+}
+
+/**
+ * @brief  重置估计器
+ * @param  f: 估计器
+ * @retval None
+ */
+void Imm_Reset(ImmFilter *f)
+{
+    f->initialized = 0;
+    f->xc[1] = 0.0f;
+    f->xc[2] = 0.0f;
+    for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) {
+        f->mu[j] = imm_mu_init[j];
+    }
+}
+
+/**
+ * @brief  输入一次测量
+ * @param  f: 估计器
+ * @param  z: 目标方位角（度）
+ * @param  dt: 距上一次测量的时间(s)
+ * @retval None
+ */
+void Imm_Update(ImmFilter *f, float z, float dt)
+{
+    float x0[IMM_MODEL_COUNT][N];
+    float P0[IMM_MODEL_COUNT][N * N];
+    float c[IMM_MODEL_COUNT];
+    float lik[IMM_MODEL_COUNT];
+    float F[N * N], Ft[N * N], Q[N * N], T1[N * N], T2[N * N];
+    float K[N], HP[N], KHP[N * N];
+    arm_matrix_instance_f32 mF, mFt, mQ, mT1, mT2, mP, mP0, mK, mHP, mKHP;
+    float total = 0.0f;
+
+    if (!f->initialized) {
+        Imm_Start(f, z);
+        return;
+    }
+    if (dt < IMM_DT_MIN) dt = IMM_DT_MIN;
+    if (dt > IMM_DT_MAX) dt = IMM_DT_MAX;
+
+    arm_mat_init_f32(&mF, N, N, F);
+    arm_mat_init_f32(&mFt, N, N, Ft);
+    arm_mat_init_f32(&mQ, N, N, Q);
+    arm_mat_init_f32(&mT1, N, N, T1);
+    arm_mat_init_f32(&mT2, N, N, T2);
+    arm_mat_init_f32(&mK, N, 1, K);
+    arm_mat_init_f32(&mHP, 1, N, HP);
+    arm_mat_init_f32(&mKHP, N, N, KHP);
+
+    // 1. 交互：c[j]为预测的模型概率，各模型初值为上一时刻状态按条件概率的加权
+    for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) {
+        c[j] = 0.0f;
+        for (uint8_t i = 0; i < IMM_MODEL_COUNT; i++) {
+            c[j] += imm_transition[i][j] * f->mu[i];
+        }
+    }
+    for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) {
+        memset(x0[j], 0, sizeof(x0[j]));
+        memset(P0[j], 0, sizeof(P0[j]));
+        for (uint8_t i = 0; i < IMM_MODEL_COUNT; i++) {
+            float w = imm_transition[i][j] * f->mu[i] / c[j];
+            for (uint8_t k = 0; k < N; k++) x0[j][k] += w * f->x[i][k];
+        }
+        for (uint8_t i = 0; i < IMM_MODEL_COUNT; i++) {
+            float w = imm_transition[i][j] * f->mu[i] / c[j];
+            float d[N];
+            for (uint8_t k = 0; k < N; k++) d[k] = f->x[i][k] - x0[j][k];
+            for (uint8_t r = 0; r < N; r++) {
+                for (uint8_t k = 0; k < N; k++) {
+                    P0[j][r * N + k] += w * (f->P[i][r * N + k] + d[r] * d[k]);
+                }
+            }
+        }
+    }
+
+    // 混合预测的新息（诊断用）
+    f->innovation = z - (f->xc[0] + f->xc[1] * dt + f->xc[2] * dt * dt * 0.5f);
+
+    for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) {
+        float *x = f->x[j];
+
+        // 2. 预测
+        Imm_ModelMatrices((ImmModel)j, dt, F, Q);
+        for (uint8_t r = 0; r < N; r++) {
+            x[r] = F[r * N] * x0[j][0] + F[r * N + 1] * x0[j][1] + F[r * N + 2] * x0[j][2];
+        }
+        arm_mat_init_f32(&mP0, N, N, P0[j]);
+        arm_mat_init_f32(&mP, N, N, f->P[j]);
+        arm_mat_trans_f32(&mF, &mFt);
+        arm_mat_mult_f32(&mF, &mP0, &mT1);
+        arm_mat_mult_f32(&mT1, &mFt, &mT2);
+        arm_mat_add_f32(&mT2, &mQ, &mT1);
+
+        // 3. 更新（H = [1 0 0]，S为标量）
+        float S = T1[0] + IMM_R;
+        float nu = z - x[0];
+        for (uint8_t r = 0; r < N; r++) {
+            K[r] = T1[r * N] / S;
+            HP[r] = T1[r];
+            x[r] += K[r] * nu;
+        }
+        arm_mat_mult_f32(&mK, &mHP, &mKHP);
+        arm_mat_sub_f32(&mT1, &mKHP, &mP);
+
+        // 4. 似然度
+        lik[j] = expf(-0.5f * nu * nu / S) / sqrtf(2.0f * PI * S);
+        total += lik[j] * c[j];
+    }
+
+    // 模型概率；所有模型都不符合（似然度下溢）时沿用预测概率
+    for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) {
+        f->mu[j] = (total > 1e-30f) ? lik[j] * c[j] / total : c[j];
+    }
+
+    // 输出按概率混合的状态
+    for (uint8_t k = 0; k < N; k++) {
+        f->xc[k] = 0.0f;
+        for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) {
+            f->xc[k] += f->mu[j] * f->x[j][k];
+        }
+    }
+}
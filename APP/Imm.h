@@ -0,0 +1,63 @@
+/**
+ * @file    Imm.h
+ * @brief   交互多模型(IMM)目标运动估计头文件
+ * @details 每轴一个估计器，输入目标方位角（云台指令角+图像偏差换算的角度），
+ *          并行运行三个运动模型并按似然度混合：
+ *          - 静止: 位置不变
+ *          - 匀速: 速度不变（白噪声加速度）
+ *          - 匀加速: 加速度不变（白噪声加加速度），目标在行程端点急停/反向时占优
+ *          输出各模型概率和混合后的角度/角速度/角加速度，控制任务据此调度增益和死区；
+ *          矩阵运算使用CMSIS-DSP（arm_mat_*_f32），状态为3维（角度、角速度、角加速度）
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _IMM_H
+#define _IMM_H
+
+#include <stdint.h>
+
+#define IMM_STATE_DIM       3       ///< 状态维数：角度(度)、角速度(度/秒)、角加速度(度/秒²)
+#define IMM_PIXELS_PER_DEG  4.0f    ///< 图像像素/度（与maixcam.py PIXELS_PER_DEGREE一致）
+
+/**
+ * @brief 运动模型
+ */
+typedef enum {
+    IMM_MODEL_STATIONARY = 0,   ///< 静止
+    IMM_MODEL_CV,               ///< 匀速
+    IMM_MODEL_CA,               ///< 匀加速（机动）
+    IMM_MODEL_COUNT
+} ImmModel;
+
+/**
+ * @brief IMM估计器（每轴一个）
+ */
+typedef struct {
+    float x[IMM_MODEL_COUNT][IMM_STATE_DIM];                  ///< 各模型状态
+    float P[IMM_MODEL_COUNT][IMM_STATE_DIM * IMM_STATE_DIM];  ///< 各模型协方差（行优先）
+    float mu[IMM_MODEL_COUNT];                                ///< 模型概率
+    float xc[IMM_STATE_DIM];                                  ///< 按概率混合的状态
+    float innovation;                                         ///< 最近一次新息（度，混合预测与测量之差）
+    uint8_t initialized;                                      ///< 0=等待第一次测量
+} ImmFilter;
+
+/**
+ * @brief  重置估计器
+ * @param  f: 估计器
+ * @retval None
+ * @note   下一次Imm_Update用测量值初始化（目标丢失后重新捕获时调用）
+ */
+void Imm_Reset(ImmFilter *f);
+
+/**
+ * @brief  输入一次测量
+ * @param  f: 估计器
+ * @param  z: 目标方位角（度）
+ * @param  dt: 距上一次测量的时间(s)
+ * @retval None
+ * @note   在控制任务中每收到一帧相机数据调用一次；每个模型两次3×3矩阵乘法加一次外积，无矩阵求逆
+ */
+void Imm_Update(ImmFilter *f, float z, float dt);
+
+#endif
@@ -0,0 +1,490 @@
+/**
+ * @file    Journal.c
+ * @brief   Flash事件日志实现
+ * @details 两个128KB扇区轮换使用，每个扇区: 16字节扇区头（标识、序号）+ 8191条16字节记录。
+ *          - 追加写入：记录按字编程，校验字最后写入；写到一半断电的记录校验不符，导出时跳过，
+ *            后续记录从下一个位置继续写
+ *          - 上电扫描：序号较大的有效扇区为当前扇区，第一个全0xFF的位置为写入位置；
+ *            上电序号取已有记录的最大值+1
+ *          - 轮换：当前扇区写满时切换到已擦除的另一个扇区（序号+1）。另一个扇区保存着较早的日志，
+ *            当前扇区用到3/4后，在上电初始化或控制停止（disable）时擦除它；擦除期间占用电机总线
+ *            （Gimbal_ClaimMotorBus），enable被拒绝，擦除停顿不会落在控制运行中；
+ *            写满时另一个扇区仍未擦除则丢弃新记录并计数（提示"disable to rotate"），恢复写入后补一条DROPPED
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "Journal.h"
+#include "FlashStore.h"
+#include "GimbalControl.h"
+#include "SerialDebug.h"
+#include "cmsis_os.h"
+#include <string.h>
+
+// ==================== 日志参数 ====================
+
+#define JOURNAL_MAGIC           0x4C4E524AU   // "JRNL"
+#define JOURNAL_RECORD_SIZE     16U
+#define JOURNAL_SLOTS           (FLASH_STORE_AREA_SIZE / JOURNAL_RECORD_SIZE - 1U)   // 第一个位置为扇区头
+#define JOURNAL_PREERASE_SLOTS  (JOURNAL_SLOTS * 3U / 4U)   // 当前扇区用到该位置后预擦除另一个扇区
+#define JOURNAL_QUEUE_SIZE      32U                         // RAM队列（2的幂）
+
+#define JOURNAL_OTHER(area)     ((area) == FLASH_STORE_JOURNAL_A ? FLASH_STORE_JOURNAL_B : FLASH_STORE_JOURNAL_A)
+
+/**
+ * @brief 扇区头
+ */
+typedef struct {
+    uint32_t magic;      ///< JOURNAL_MAGIC
+    uint32_t seq;        ///< 扇区序号（越大越新）
+    uint32_t seq_inv;    ///< ~seq
+    uint32_t reserved;
+} JournalHeader;
+
+/**
+ * @brief Flash中的记录（16字节，4个字）
+ */
+typedef struct {
+    uint32_t tick;       ///< 本次上电以来的时间(ms)
+    uint16_t boot;       ///< 上电序号
+    uint8_t event;       ///< JournalEvent
+    uint8_t reserved;
+    int32_t arg0;        ///< 参数0
+    int16_t arg1;        ///< 参数1
+    uint16_t check;      ///< 前14字节的CRC16（最后写入）
+} JournalRecord;
+
+/**
+ * @brief RAM队列中的事件
+ */
+typedef struct {
+    uint32_t tick;
+    int32_t arg0;
+    int16_t arg1;
+    uint8_t event;
+} JournalEntry;
+
+// RAM队列（Journal_Log写入，默认任务取出）
+static JournalEntry journal_queue[JOURNAL_QUEUE_SIZE];
+static volatile uint32_t queue_head = 0;
+static volatile uint32_t queue_tail = 0;
+static volatile uint32_t queue_dropped = 0;   // 队列满丢弃
+
+// Flash状态（默认任务）
+static FlashStoreArea active_area = FLASH_STORE_JOURNAL_A;
+static uint32_t active_seq = 0;
+static uint32_t write_slot = 0;        // 当前扇区下一个写入位置
+static uint8_t spare_blank = 0;        // 另一个扇区已擦除
+static uint8_t erase_failed = 0;       // 擦除失败后不再自动重试（下次上电再试）
+static uint8_t journal_ready = 0;
+static uint16_t journal_boot = 0;
+static uint32_t pending_dropped = 0;   // 待补记的丢弃条数（队列满+日志满）
+static uint8_t journal_full = 0;       // 日志满，正在丢弃（已提示）
+
+// 挂起的请求（串口命令写入，默认任务执行）
+static volatile uint8_t dump_requested = 0;
+static volatile uint32_t dump_last = 0;
+static volatile uint8_t clear_requested = 0;
+
+static const char *const journal_event_names[JOURNAL_EV_COUNT] = {
+    "?", "BOOT", "LOCKED", "LOST", "CAM_TIMEOUT", "CAM_RESTORED", "CUE_TIMEOUT",
+    "CUE_RESTORED", "CUE_SLEW", "MOTOR_TIMEOUT", "MOTOR_RESTORED", "OVERRUN", "DROPPED", "CLEARED",
+    "PROFILE", "FAULT"
+};
+
+// ==================== 内部函数 ====================
+
+static const JournalRecord *Journal_Slot(FlashStoreArea area, uint32_t slot)
+{
+    return (const JournalRecord *)(FlashStore_Base(area) + JOURNAL_RECORD_SIZE * (slot + 1U));
+}
+
+static uint8_t Journal_IsErased(const JournalRecord *r)
+{
+    const uint32_t *w = (const uint32_t *)r;
+
+    return (w[0] & w[1] & w[2] & w[3]) == 0xFFFFFFFFU;
+}
+
+static uint8_t Journal_IsValid(const JournalRecord *r)
+{
+    return !Journal_IsErased(r) && r->check == FlashStore_Crc16((const uint8_t *)r, JOURNAL_RECORD_SIZE - 2U);
+}
+
+/**
+ * @brief  读取扇区头
+ * @param  area: 扇区
+ * @param  seq: 扇区序号（输出）
+ * @retval 1=有效, 0=未初始化或损坏
+ */
+static uint8_t Journal_ReadHeader(FlashStoreArea area, uint32_t *seq)
+{
+    const JournalHeader *h = (const JournalHeader *)FlashStore_Base(area);
+
+    if (h->magic != JOURNAL_MAGIC || h->seq != ~h->seq_inv) return 0;
+    *seq = h->seq;
+    return 1;
+}
+
+/**
+ * @brief  查找第一个未写入的位置
+ * @retval 位置，JOURNAL_SLOTS=已满
+ */
+static uint32_t Journal_FindEnd(FlashStoreArea area)
+{
+    uint32_t slot = 0;
+
+    while (slot < JOURNAL_SLOTS && !Journal_IsErased(Journal_Slot(area, slot))) slot++;
+    return slot;
+}
+
+/**
+ * @brief  在已擦除的扇区写入扇区头并设为当前扇区
+ * @retval 1=成功, 0=失败
+ */
+static uint8_t Journal_StartSector(FlashStoreArea area, uint32_t seq)
+{
+    JournalHeader h = { JOURNAL_MAGIC, seq, ~seq, 0xFFFFFFFFU };
+
+    if (!FlashStore_Program(area, 0, (const uint32_t *)&h, sizeof(h) / 4U)) return 0;
+    active_area = area;
+    active_seq = seq;
+    write_slot = 0;
+    return 1;
+}
+
+/**
+ * @brief  擦除另一个扇区（阻塞1~2s，CPU停顿）
+ * @retval None
+ */
+static void Journal_EraseSpare(void)
+{
+    FlashStoreArea spare = JOURNAL_OTHER(active_area);
+
+    spare_blank = FlashStore_Erase(spare) && FlashStore_IsBlank(spare);
+    if (!spare_blank) erase_failed = 1;
+}
+
+/**
+ * @brief  扇区中记录的最大上电序号
+ */
+static uint16_t Journal_MaxBoot(FlashStoreArea area)
+{
+    uint16_t max_boot = 0;
+
+    for (uint32_t slot = 0; slot < JOURNAL_SLOTS; slot++) {
+        const JournalRecord *r = Journal_Slot(area, slot);
+        if (Journal_IsErased(r)) break;
+        if (Journal_IsValid(r) && r->boot > max_boot) max_boot = r->boot;
+    }
+    return max_boot;
+}
+
+/**
+ * @brief  写入一条记录
+ * @retval 1=已写入（或写入位置已消耗）, 0=日志满
+ */
+static uint8_t Journal_Write(uint8_t event, uint32_t tick, int32_t arg0, int16_t arg1)
+{
+    JournalRecord r;
+
+    if (write_slot >= JOURNAL_SLOTS) {
+        // 当前扇区已满：切换到已擦除的另一个扇区
+        if (!spare_blank || !Journal_StartSector(JOURNAL_OTHER(active_area), active_seq + 1U)) {
+            return 0;
+        }
+        spare_blank = 0;
+    }
+
+    memset(&r, 0, sizeof(r));
+    r.tick = tick;
+    r.boot = journal_boot;
+    r.event = event;
+    r.arg0 = arg0;
+    r.arg1 = arg1;
+    r.check = FlashStore_Crc16((const uint8_t *)&r, JOURNAL_RECORD_SIZE - 2U);
+
+    // 编程失败时该位置已部分写入，同样跳过
+    FlashStore_Program(active_area, JOURNAL_RECORD_SIZE * (write_slot + 1U), (const uint32_t *)&r, 4);
+    write_slot++;
+    return 1;
+}
+
+/**
+ * @brief  取出队列中的一条事件写入Flash
+ * @retval None
+ */
+static void Journal_WriteOne(void)
+{
+    if (queue_tail == queue_head) return;
+
+    __disable_irq();
+    pending_dropped += queue_dropped;
+    queue_dropped = 0;
+    __enable_irq();
+
+    // 先补记丢弃的条数
+    if (pending_dropped != 0 &&
+        Journal_Write(JOURNAL_EV_DROPPED, HAL_GetTick(), (int32_t)pending_dropped, 0)) {
+        pending_dropped = 0;
+        return;
+    }
+
+    const JournalEntry *e = &journal_queue[queue_tail % JOURNAL_QUEUE_SIZE];
+    if (Journal_Write(e->event, e->tick, e->arg0, e->arg1)) {
+        journal_full = 0;
+    } else {
+        // 日志满且另一个扇区未擦除：跟踪中不擦除，提示一次
+        pending_dropped++;
+        if (!journal_full) {
+            journal_full = 1;
+            SerialDebug_Printf(erase_failed ? "Journal: full, spare erase failed (run 'journal clear')\r\n"
+                                            : "Journal: full, disable to rotate\r\n");
+        }
+    }
+    queue_tail++;
+}
+
+/**
+ * @brief  打印一条记录
+ */
+static void Journal_PrintRecord(const JournalRecord *r)
+{
+    const char *name = (r->event < JOURNAL_EV_COUNT) ? journal_event_names[r->event] : "?";
+
+    if (r->event == JOURNAL_EV_BOOT) {
+        // RCC_CSR[31:24]: LPWR WWDG IWDG SFT POR PIN BOR
+        SerialDebug_Printf("%5u %8lu.%03lu %-14s %s%s%s%s%s%s%s\r\n", r->boot,
+                           (unsigned long)(r->tick / 1000U), (unsigned long)(r->tick % 1000U), name,
+                           (r->arg0 & 0x80) ? "LPWR " : "", (r->arg0 & 0x40) ? "WWDG " : "",
+                           (r->arg0 & 0x20) ? "IWDG " : "", (r->arg0 & 0x10) ? "SFT " : "",
+                           (r->arg0 & 0x08) ? "POR " : "", (r->arg0 & 0x04) ? "PIN " : "",
+                           (r->arg0 & 0x02) ? "BOR" : "");
+    } else {
+        SerialDebug_Printf("%5u %8lu.%03lu %-14s %ld %d\r\n", r->boot,
+                           (unsigned long)(r->tick / 1000U), (unsigned long)(r->tick % 1000U), name,
+                           (long)r->arg0, r->arg1);
+    }
+}
+
+/**
+ * @brief  导出日志（较早的扇区在前）
+ * @param  last: 只导出最近的条数，0=全部
+ * @retval None
+ */
+static void Journal_Dump(uint32_t last)
+{
+    FlashStoreArea areas[2];
+    uint32_t ends[2] = { 0, 0 };
+    uint32_t count = 0, corrupt = 0, skip = 0;
+    uint32_t seq;
+
+    if (!journal_ready) {
+        SerialDebug_Printf("Journal: not available\r\n");
+        return;
+    }
+
+    // 另一个扇区有有效扇区头且未擦除时保存着较早的日志
+    areas[0] = JOURNAL_OTHER(active_area);
+    areas[1] = active_area;
+    if (Journal_ReadHeader(areas[0], &seq) && seq != active_seq) ends[0] = Journal_FindEnd(areas[0]);
+    ends[1] = write_slot;
+
+    for (uint8_t a = 0; a < 2; a++) {
+        for (uint32_t slot = 0; slot < ends[a]; slot++) {
+            if (Journal_IsValid(Journal_Slot(areas[a], slot))) count++;
+            else corrupt++;
+        }
+    }
+
+    SerialDebug_Printf("Journal: %lu records, %lu corrupt, sector %c %lu/%lu used, boot %u%s\r\n",
+                       (unsigned long)count, (unsigned long)corrupt, (active_area == FLASH_STORE_JOURNAL_A) ? 'A' : 'B',
+                       (unsigned long)write_slot, (unsigned long)JOURNAL_SLOTS, journal_boot,
+                       journal_full ? ", FULL (disable to rotate)" : "");
+    SerialDebug_Printf(" boot     time(s) event          args\r\n");
+
+    if (last != 0 && last < count) skip = count - last;
+    for (uint8_t a = 0; a < 2; a++) {
+        for (uint32_t slot = 0; slot < ends[a]; slot++) {
+            const JournalRecord *r = Journal_Slot(areas[a], slot);
+            if (!Journal_IsValid(r)) continue;
+            if (skip != 0) {
+                skip--;
+                continue;
+            }
+            Journal_PrintRecord(r);
+        }
+    }
+    SerialDebug_Printf("Journal: end\r\n");
+}
+
+/**
+ * @brief  清空日志（擦除两个扇区）
+ * @retval None
+ * @note   提交请求时已占用电机总线（enable被拒绝），结束时释放
+ */
+static void Journal_Clear(void)
+{
+    uint32_t seq = active_seq + 1U;
+
+    SerialDebug_Printf("Journal: erasing...\r\n");
+    osDelay(20);   // 等待提示发完（擦除期间串口中断停顿）
+
+    if (!FlashStore_Erase(FLASH_STORE_JOURNAL_A) || !FlashStore_Erase(FLASH_STORE_JOURNAL_B) ||
+        !Journal_StartSector(FLASH_STORE_JOURNAL_A, seq)) {
+        journal_ready = 0;
+        Gimbal_ReleaseMotorBus();
+        SerialDebug_Printf("Journal: erase FAILED\r\n");
+        return;
+    }
+    Gimbal_ReleaseMotorBus();
+    spare_blank = FlashStore_IsBlank(FLASH_STORE_JOURNAL_B);
+    erase_failed = 0;
+    journal_full = 0;
+    journal_ready = 1;
+    Journal_Log(JOURNAL_EV_CLEARED, 0, 0);
+    SerialDebug_Printf("Journal cleared\r\n");
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  初始化事件日志
+ * @retval None
+ */
+void Journal_Init(void)
+{
+    uint32_t seq_a = 0, seq_b = 0, seq;
+    uint8_t valid_a = Journal_ReadHeader(FLASH_STORE_JOURNAL_A, &seq_a);
+    uint8_t valid_b = Journal_ReadHeader(FLASH_STORE_JOURNAL_B, &seq_b);
+    int32_t reset_flags = (int32_t)(RCC->CSR >> 24);
+    uint16_t max_boot = 0;
+    FlashStoreArea spare;
+
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+    journal_ready = 0;
+
+    if (!valid_a && !valid_b) {
+        // 首次使用或两个扇区都已损坏
+        if ((!FlashStore_IsBlank(FLASH_STORE_JOURNAL_A) && !FlashStore_Erase(FLASH_STORE_JOURNAL_A)) ||
+            !Journal_StartSector(FLASH_STORE_JOURNAL_A, 1)) {
+            return;
+        }
+    } else {
+        // 序号比较允许回绕
+        if (valid_a && (!valid_b || (int32_t)(seq_a - seq_b) > 0)) {
+            active_area = FLASH_STORE_JOURNAL_A;
+            active_seq = seq_a;
+        } else {
+            active_area = FLASH_STORE_JOURNAL_B;
+            active_seq = seq_b;
+        }
+        write_slot = Journal_FindEnd(active_area);
+        max_boot = Journal_MaxBoot(active_area);
+    }
+
+    spare = JOURNAL_OTHER(active_area);
+    if (Journal_ReadHeader(spare, &seq)) {
+        uint16_t b = Journal_MaxBoot(spare);
+        if (b > max_boot) max_boot = b;
+    }
+    spare_blank = FlashStore_IsBlank(spare);
+
+    // 控制尚未启动，可以擦除：另一个扇区损坏（擦除时断电等），或当前扇区已用到3/4
+    if (!spare_blank && (!Journal_ReadHeader(spare, &seq) || write_slot >= JOURNAL_PREERASE_SLOTS)) {
+        Journal_EraseSpare();
+    }
+
+    journal_boot = max_boot + 1U;
+    journal_ready = 1;
+    Journal_Log(JOURNAL_EV_BOOT, reset_flags, 0);
+}
+
+/**
+ * @brief  记录一个事件
+ * @param  event: 事件码
+ * @param  arg0: 参数0
+ * @param  arg1: 参数1
+ * @retval None
+ */
+void Journal_Log(JournalEvent event, int32_t arg0, int16_t arg1)
+{
+    uint32_t tick = HAL_GetTick();
+
+    __disable_irq();
+    if (queue_head - queue_tail >= JOURNAL_QUEUE_SIZE) {
+        queue_dropped++;
+    } else {
+        JournalEntry *e = &journal_queue[queue_head % JOURNAL_QUEUE_SIZE];
+        e->tick = tick;
+        e->arg0 = arg0;
+        e->arg1 = arg1;
+        e->event = (uint8_t)event;
+        queue_head++;
+    }
+    __enable_irq();
+}
+
+/**
+ * @brief  提交导出请求
+ * @param  last: 只导出最近的条数，0=全部
+ * @retval 1=已受理, 0=上一个请求未完成
+ */
+uint8_t Journal_RequestDump(uint32_t last)
+{
+    if (dump_requested || clear_requested) return 0;
+
+    dump_last = last;
+    dump_requested = 1;
+    return 1;
+}
+
+/**
+ * @brief  提交清空请求
+ * @retval 1=已受理, 0=上一个请求未完成
+ */
+uint8_t Journal_RequestClear(void)
+{
+    if (dump_requested || clear_requested) return 0;
+
+    clear_requested = 1;
+    return 1;
+}
+
+/**
+ * @brief  日志后台处理
+ * @retval None
+ */
+void Journal_Process(void)
+{
+    if (clear_requested) {
+        Journal_Clear();
+        clear_requested = 0;
+    }
+
+    if (!journal_ready) {
+        // Flash不可用：丢弃队列，导出请求直接应答
+        queue_tail = queue_head;
+        if (dump_requested) {
+            Journal_Dump(0);
+            dump_requested = 0;
+        }
+        return;
+    }
+
+    // 先写完队列再导出，导出内容包含此前的所有事件
+    if (dump_requested && queue_tail == queue_head) {
+        Journal_Dump(dump_last);
+        dump_requested = 0;
+    }
+
+    Journal_WriteOne();
+
+    // 控制停止时预擦除另一个扇区（为下次切换做准备）；占用电机总线到擦除结束，期间enable被拒绝
+    if (!spare_blank && !erase_failed && write_slot >= JOURNAL_PREERASE_SLOTS && Gimbal_ClaimMotorBus()) {
+        SerialDebug_Printf("Journal: erasing old sector...\r\n");
+        osDelay(20);
+        Journal_EraseSpare();
+        Gimbal_ReleaseMotorBus();
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * @file    Journal.h
+ * @brief   Flash事件日志头文件
+ * @details 目标丢失、链路超时、控制超时、电机无应答、复位等事件写入Flash保留扇区（扇区10/11轮换），
+ *          断电后保留，设备返厂后用journal命令导出。
+ *          - 记录16字节: 上电序号、上电以来的时间、事件码、两个参数、校验
+ *          - Journal_Log只写RAM队列（可在中断中调用），默认任务每次最多写入一条（约64us停顿）
+ *          - 擦除（约1~2s，CPU停顿）只在上电初始化时或控制停止（disable）时进行，从不打断控制
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _JOURNAL_H
+#define _JOURNAL_H
+
+#include "stm32f4xx_hal.h"
+
+/**
+ * @brief 事件码
+ */
+typedef enum {
+    JOURNAL_EV_BOOT = 1,          ///< 上电/复位，arg0=复位标志(RCC_CSR[31:24])
+    JOURNAL_EV_TARGET_LOCKED,     ///< 锁定目标，arg0=捕获到锁定的时间(ms)
+    JOURNAL_EV_TARGET_LOST,       ///< 丢失目标，arg0=持有目标的时间(ms)，arg1=1表示曾锁定
+    JOURNAL_EV_CAMERA_TIMEOUT,    ///< 相机串口无数据超时
+    JOURNAL_EV_CAMERA_RESTORED,   ///< 相机串口恢复，arg0=中断时间(ms)
+    JOURNAL_EV_CUE_TIMEOUT,       ///< 相邻云台引导帧超时
+    JOURNAL_EV_CUE_RESTORED,      ///< 引导帧恢复，arg0=中断时间(ms)
+    JOURNAL_EV_CUE_SLEW,          ///< 按引导转向，arg0=水平角(0.01度)，arg1=垂直角(0.1度)
+    JOURNAL_EV_MOTOR_TIMEOUT,     ///< 电机位置读取无应答，arg0=电机ID
+    JOURNAL_EV_MOTOR_RESTORED,    ///< 电机恢复应答，arg0=电机ID
+    JOURNAL_EV_OVERRUN,           ///< 控制周期超时（每秒最多一条），arg0=累计次数
+    JOURNAL_EV_DROPPED,           ///< 队列满或日志满丢弃的条数，arg0=条数
+    JOURNAL_EV_CLEARED,           ///< journal clear清空日志
+    JOURNAL_EV_PROFILE,           ///< 切换参数档案，arg0=档案序号，arg1=1表示按距离自动切换
+    JOURNAL_EV_FAULT,             ///< 故障注入设置/解除，arg0=串口号或16+轴（-1=全部解除），arg1=1设置 0解除
+    JOURNAL_EV_COUNT
+} JournalEvent;
+
+/**
+ * @brief  初始化事件日志
+ * @retval None
+ * @note   在默认任务中、控制任务启动之前调用：扫描两个扇区找到写入位置，
+ *         必要时擦除（阻塞），然后记录BOOT事件
+ */
+void Journal_Init(void);
+
+/**
+ * @brief  记录一个事件
+ * @param  event: 事件码
+ * @param  arg0: 参数0
+ * @param  arg1: 参数1
+ * @retval None
+ * @note   只写入RAM队列，可在中断中调用；队列满时丢弃并计数
+ */
+void Journal_Log(JournalEvent event, int32_t arg0, int16_t arg1);
+
+/**
+ * @brief  提交导出请求
+ * @param  last: 只导出最近的条数，0=全部
+ * @retval 1=已受理, 0=上一个请求未完成
+ * @note   可在中断中调用，默认任务执行
+ */
+uint8_t Journal_RequestDump(uint32_t last);
+
+/**
+ * @brief  提交清空请求
+ * @retval 1=已受理, 0=上一个请求未完成
+ * @note   可在中断中调用；擦除两个扇区（CPU停顿数秒），调用前需disable并占用电机总线
+ *         （Gimbal_ClaimMotorBus），擦除结束后释放
+ */
+uint8_t Journal_RequestClear(void);
+
+/**
+ * @brief  日志后台处理
+ * @retval None
+ * @note   在默认任务中周期调用：执行导出/清空请求，写入一条队列中的记录，控制停止时预擦除
+ */
+void Journal_Process(void);
+
+#endif
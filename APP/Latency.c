@@ -0,0 +1,407 @@
+/**
+ * @file    Latency.c
+ * @brief   端到端执行延迟测量实现
+ * @details 每次试验:
+ *          1. 收集基线帧，确认目标静止
+ *          2. 读取电机实时位置，发出±LATENCY_STEP_DEG的位置指令（正负交替，云台回到原位）
+ *          3. 轮询电机实时位置（每次约1ms）并接收相机坐标，直到检测到全部事件或超时
+ *          4. 等待云台静止，由静止后的坐标变化/步进角得到像素比例，
+ *             换算出图像阈值对应的转角，相机延迟从电机走到该转角的时刻算起
+ *             （扣除了加速过程，只剩曝光、相机处理和串口传输）
+ *
+ * @note    时间基准为指令帧发完的时刻（Motor_FlushTx返回），使用DWT周期计数；
+ *          电机位置事件的分辨率为一次位置读取的收发时间（约1ms），
+ *          相机事件的时间为坐标帧行尾后USART1空闲线中断的时刻（比行尾晚约一个字节时间）
+ */
+
+#include "Latency.h"
+#include "GimbalControl.h"
+#include "Motor.h"
+#include "Camera.h"
+#include "Timing.h"
+#include "SerialDebug.h"
+#include "cmsis_os.h"
+#include <math.h>
+#include <stdlib.h>
+
+// ==================== 测量参数 ====================
+
+#define LATENCY_STEP_DEG         2.0f   // 测试步进(度)，约8像素
+#define LATENCY_MOVE_DEG         0.05f  // 实时位置变化超过该值视为开始运动(度)
+#define LATENCY_RISE_RATIO       0.9f   // 上升时间终点（行程比例）
+#define LATENCY_IMAGE_PX         3      // 坐标变化超过该值视为图像运动(像素)
+#define LATENCY_BASELINE_FRAMES  5      // 基线帧数
+#define LATENCY_BASELINE_TIMEOUT 1000   // 基线等待超时(ms)
+#define LATENCY_ACK_TIMEOUT      5      // 驱动应答等待(ms)
+#define LATENCY_TRIAL_TIMEOUT    500    // 单次试验超时(ms)
+#define LATENCY_SETTLE_MS        300    // 试验间隔（等待云台和图像静止）(ms)
+#define LATENCY_SAMPLES_MAX      256    // 单次试验记录的位置采样数
+
+// 单项延迟统计（us）
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+} LatencyStat;
+
+typedef enum {
+    LATENCY_ACK = 0,
+    LATENCY_DRIVER,
+    LATENCY_RISE,
+    LATENCY_CAMERA,
+    LATENCY_STAT_COUNT
+} LatencyStatIndex;
+
+static const char *const latency_stat_names[LATENCY_STAT_COUNT] = {
+    "ack", "driver", "rise", "camera"
+};
+
+static LatencyStat latency_stats[LATENCY_STAT_COUNT];
+
+// 单次试验的位置采样（时间戳, 距起点的转角）
+static uint32_t sample_cycles[LATENCY_SAMPLES_MAX];
+static float sample_deg[LATENCY_SAMPLES_MAX];
+static uint32_t sample_count;
+
+// 挂起的请求（串口命令写入，默认任务执行）
+static volatile uint8_t pending_id = 0;
+static volatile uint32_t pending_trials = 0;
+
+// ==================== 内部函数 ====================
+
+static void Latency_StatReset(void)
+{
+    for (uint32_t i = 0; i < LATENCY_STAT_COUNT; i++)
+    {
+        latency_stats[i].count = 0;
+        latency_stats[i].min = 0xFFFFFFFFU;
+        latency_stats[i].max = 0;
+        latency_stats[i].sum = 0;
+    }
+}
+
+static void Latency_StatAdd(LatencyStatIndex idx, uint32_t us)
+{
+    LatencyStat *s = &latency_stats[idx];
+
+    s->count++;
+    s->sum += us;
+    if (us < s->min) s->min = us;
+    if (us > s->max) s->max = us;
+}
+
+/**
+ * @brief  目标在被测轴方向上的像素坐标
+ */
+static int16_t Latency_AxisCoord(uint8_t motor_id, int16_t x, int16_t y)
+{
+    return (motor_id == MOTOR_ID_HORIZONTAL) ? x : y;
+}
+
+/**
+ * @brief  收集基线帧
+ * @param  motor_id: 电机地址
+ * @param  base: 基线坐标输出（被测轴方向）
+ * @retval 1=目标静止, 0=帧数不足或目标抖动超过阈值
+ */
+static uint8_t Latency_Baseline(uint8_t motor_id, int16_t *base)
+{
+    int16_t x, y, c, lo = 0, hi = 0;
+    int32_t sum = 0;
+    uint32_t cycles;
+    uint32_t frames = 0;
+    uint32_t start = HAL_GetTick();
+
+    // 丢弃等待期间的旧帧
+    while (Camera_TryGetSample(&x, &y, &cycles)) {}
+
+    while (frames < LATENCY_BASELINE_FRAMES)
+    {
+        if (HAL_GetTick() - start >= LATENCY_BASELINE_TIMEOUT) return 0;
+
+        if (!Camera_TryGetSample(&x, &y, &cycles))
+        {
+            osDelay(1);
+            continue;
+        }
+
+        c = Latency_AxisCoord(motor_id, x, y);
+        if (frames == 0 || c < lo) lo = c;
+        if (frames == 0 || c > hi) hi = c;
+        sum += c;
+        frames++;
+    }
+
+    *base = (int16_t)(sum / (int32_t)frames);
+    return (hi - lo) < LATENCY_IMAGE_PX;
+}
+
+/**
+ * @brief  等待一帧新坐标
+ * @param  motor_id: 电机地址
+ * @param  coord: 坐标输出（被测轴方向）
+ * @retval 1=收到, 0=超时
+ */
+static uint8_t Latency_NextFrame(uint8_t motor_id, int16_t *coord)
+{
+    int16_t x, y;
+    uint32_t cycles;
+    uint32_t start = HAL_GetTick();
+
+    while (Camera_TryGetSample(&x, &y, &cycles)) {}
+
+    while (HAL_GetTick() - start < LATENCY_BASELINE_TIMEOUT)
+    {
+        if (Camera_TryGetSample(&x, &y, &cycles))
+        {
+            *coord = Latency_AxisCoord(motor_id, x, y);
+            return 1;
+        }
+        osDelay(1);
+    }
+    return 0;
+}
+
+/**
+ * @brief  查找位置采样中首次达到指定转角的时刻
+ * @param  deg: 转角
+ * @param  cycles: 时间戳输出
+ * @retval 1=找到, 0=未达到
+ */
+static uint8_t Latency_FindCrossing(float deg, uint32_t *cycles)
+{
+    for (uint32_t i = 0; i < sample_count; i++)
+    {
+        if (sample_deg[i] >= deg)
+        {
+            *cycles = sample_cycles[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief  执行一次试验
+ * @param  index: 试验序号（用于打印）
+ * @param  motor_id: 电机地址
+ * @param  step: 步进角度（带符号）
+ * @retval 1=已发出位置指令, 0=电机无应答或目标不稳定（已打印原因，未运动）
+ */
+static uint8_t Latency_Trial(uint32_t index, uint8_t motor_id, float step)
+{
+    int16_t base, final, x, y;
+    float p0, p;
+    uint32_t t_sent, t_ack = 0, t_move = 0, t_rise = 0, t_img = 0, t_match = 0;
+    uint32_t cycles, before;
+    uint8_t acked, moved = 0, risen = 0, seen = 0, matched = 0;
+    uint32_t start;
+    float scale = 0.0f;
+
+    if (!Latency_Baseline(motor_id, &base))
+    {
+        SerialDebug_Printf("#%lu: target missing or not static, skipped\r\n", (unsigned long)index);
+        return 0;
+    }
+
+    if (!Motor_ReadPosition(motor_id, &p0))
+    {
+        SerialDebug_Printf("#%lu: no position response\r\n", (unsigned long)index);
+        return 0;
+    }
+
+    if (motor_id == MOTOR_ID_HORIZONTAL)
+    {
+        Motor_MoveHorizontal(step);
+    }
+    else
+    {
+        Motor_MoveVertical(step);
+    }
+    Motor_FlushTx(motor_id);
+    t_sent = Timing_GetCycles();
+    sample_count = 0;
+
+    acked = Motor_WaitAck(motor_id, LATENCY_ACK_TIMEOUT);
+    if (acked) t_ack = Timing_GetCycles();
+
+    start = HAL_GetTick();
+    while (HAL_GetTick() - start < LATENCY_TRIAL_TIMEOUT && !(risen && seen))
+    {
+        if (!risen)
+        {
+            before = Timing_GetCycles();
+            if (Motor_ReadPosition(motor_id, &p))
+            {
+                // 驱动在收到读取命令时采样，取收发区间中点
+                cycles = before + (Timing_GetCycles() - before) / 2;
+                float d = fabsf(p - p0);
+                if (sample_count < LATENCY_SAMPLES_MAX)
+                {
+                    sample_cycles[sample_count] = cycles;
+                    sample_deg[sample_count] = d;
+                    sample_count++;
+                }
+                if (!moved && d >= LATENCY_MOVE_DEG)
+                {
+                    t_move = cycles;
+                    moved = 1;
+                }
+                if (moved && d >= fabsf(step) * LATENCY_RISE_RATIO)
+                {
+                    t_rise = cycles;
+                    risen = 1;
+                }
+            }
+        }
+        else
+        {
+            osDelay(1);
+        }
+
+        while (Camera_TryGetSample(&x, &y, &cycles))
+        {
+            int16_t c = Latency_AxisCoord(motor_id, x, y);
+            if (!seen && (c - base >= LATENCY_IMAGE_PX || base - c >= LATENCY_IMAGE_PX))
+            {
+                t_img = cycles;
+                seen = 1;
+            }
+        }
+    }
+
+    // 静止后的坐标变化得到像素比例，图像阈值（坐标取整，按半像素计）换算为转角
+    osDelay(LATENCY_SETTLE_MS);
+    if (seen && Latency_NextFrame(motor_id, &final))
+    {
+        scale = (float)abs(final - base) / fabsf(step);
+        if (scale > 0.0f)
+        {
+            matched = Latency_FindCrossing(((float)LATENCY_IMAGE_PX - 0.5f) / scale, &t_match);
+        }
+    }
+
+    SerialDebug_Printf("#%lu %+.1f: ", (unsigned long)index, step);
+    if (acked)
+    {
+        Latency_StatAdd(LATENCY_ACK, Timing_CyclesToUs(t_ack - t_sent));
+        SerialDebug_Printf("ack=%luus ", (unsigned long)Timing_CyclesToUs(t_ack - t_sent));
+    }
+    if (moved)
+    {
+        Latency_StatAdd(LATENCY_DRIVER, Timing_CyclesToUs(t_move - t_sent));
+        SerialDebug_Printf("driver=%luus ", (unsigned long)Timing_CyclesToUs(t_move - t_sent));
+    }
+    else
+    {
+        SerialDebug_Printf("no motion ");
+    }
+    if (risen)
+    {
+        Latency_StatAdd(LATENCY_RISE, Timing_CyclesToUs(t_rise - t_move));
+        SerialDebug_Printf("rise=%luus ", (unsigned long)Timing_CyclesToUs(t_rise - t_move));
+    }
+    if (matched)
+    {
+        // 位置采样间隔内到达的相机帧可能早于采样时刻，此时记为0
+        uint32_t us = ((int32_t)(t_img - t_match) > 0) ? Timing_CyclesToUs(t_img - t_match) : 0;
+        Latency_StatAdd(LATENCY_CAMERA, us);
+        SerialDebug_Printf("camera=%luus (%.1fpx/deg)", (unsigned long)us, scale);
+    }
+    else if (!seen)
+    {
+        SerialDebug_Printf("no image motion");
+    }
+    else
+    {
+        SerialDebug_Printf("camera n/a");
+    }
+    SerialDebug_Printf("\r\n");
+
+    return 1;
+}
+
+/**
+ * @brief  打印统计结果
+ */
+static void Latency_PrintStats(uint32_t trials)
+{
+    SerialDebug_Printf("\r\n=== Latency (%lu trials, us) ===\r\n", (unsigned long)trials);
+    for (uint32_t i = 0; i < LATENCY_STAT_COUNT; i++)
+    {
+        const LatencyStat *s = &latency_stats[i];
+        if (s->count == 0)
+        {
+            SerialDebug_Printf("  %-7s n=0\r\n", latency_stat_names[i]);
+            continue;
+        }
+        SerialDebug_Printf("  %-7s n=%-3lu min=%-7lu avg=%-7lu max=%lu\r\n", latency_stat_names[i],
+                           (unsigned long)s->count, (unsigned long)s->min, (unsigned long)(s->sum / s->count),
+                           (unsigned long)s->max);
+    }
+    SerialDebug_Printf("==============================\r\n\n");
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  提交延迟测量请求
+ * @param  motor_id: 电机地址
+ * @param  trials: 试验次数
+ * @retval 1=已受理, 0=参数无效或忙
+ */
+uint8_t Latency_Request(uint8_t motor_id, uint32_t trials)
+{
+    if (motor_id != MOTOR_ID_HORIZONTAL && motor_id != MOTOR_ID_VERTICAL) return 0;
+    if (trials == 0 || trials > LATENCY_TRIALS_MAX) return 0;
+    if (pending_trials != 0) return 0;
+
+    pending_id = motor_id;
+    pending_trials = trials;
+    return 1;
+}
+
+/**
+ * @brief  执行挂起的测量
+ * @retval None
+ */
+void Latency_Process(void)
+{
+    uint32_t trials = pending_trials;
+    uint8_t motor_id = pending_id;
+    uint32_t done = 0;
+    float offset = 0.0f;
+
+    if (trials == 0) return;
+
+    SerialDebug_Printf("Latency test: %s axis, %lu trials, step %.1f deg\r\n",
+                       (motor_id == MOTOR_ID_HORIZONTAL) ? "H" : "V", (unsigned long)trials, LATENCY_STEP_DEG);
+    Latency_StatReset();
+
+    for (uint32_t i = 0; i < trials; i++)
+    {
+        // 正负交替，云台在原位和原位+1步之间往返
+        float step = (offset > 0.0f) ? -LATENCY_STEP_DEG : LATENCY_STEP_DEG;
+        if (Latency_Trial(i + 1, motor_id, step))
+        {
+            offset += step;
+            done++;
+        }
+        else if (i == 0)
+        {
+            break;   // 第一次就失败，多半是没有目标或电机无应答
+        }
+    }
+
+    // 回到原位
+    if (offset > 0.0f)
+    {
+        if (motor_id == MOTOR_ID_HORIZONTAL) Motor_MoveHorizontal(-offset);
+        else Motor_MoveVertical(-offset);
+    }
+
+    Latency_PrintStats(done);
+    pending_trials = 0;
+    Gimbal_ReleaseMotorBus();
+}
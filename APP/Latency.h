@@ -0,0 +1,39 @@
+/**
+ * @file    Latency.h
+ * @brief   端到端执行延迟测量头文件
+ * @details 对静止目标发出小幅位置指令，用DWT时间戳测量：
+ *          - 应答：指令帧发完到驱动应答帧收完
+ *          - 驱动延迟：指令帧发完到电机实时位置开始变化
+ *          - 上升时间：开始运动到走完90%行程
+ *          - 相机延迟：电机转到图像阈值对应的角度，到第一帧坐标出现变化
+ *            （含曝光、相机处理和串口传输，不含电机加速时间）
+ *          多次试验后输出最小/平均/最大值
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _LATENCY_H
+#define _LATENCY_H
+
+#include "stm32f4xx_hal.h"
+
+#define LATENCY_TRIALS_DEFAULT 10    ///< 默认试验次数
+#define LATENCY_TRIALS_MAX     50    ///< 最大试验次数
+
+/**
+ * @brief  提交延迟测量请求
+ * @param  motor_id: 电机地址（MOTOR_ID_HORIZONTAL/MOTOR_ID_VERTICAL）
+ * @param  trials: 试验次数（1~LATENCY_TRIALS_MAX）
+ * @retval 1=已受理, 0=参数无效或上一次测量尚未完成
+ * @note   可在中断中调用；调用前需关闭跟踪（disable），视野中需有静止目标
+ */
+uint8_t Latency_Request(uint8_t motor_id, uint32_t trials);
+
+/**
+ * @brief  执行挂起的测量
+ * @retval None
+ * @note   在默认任务中周期调用（电机串口为阻塞收发，单次试验约0.5~1s）
+ */
+void Latency_Process(void);
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file    LockOut.c
+ * @brief   锁定事件输出实现
+ * @details GPIO直接写BSRR，不经过HAL函数调用；事件帧在关中断下拷入字节环形缓冲区后使能TXE中断，
+ *          开中断时TXE已置位，立即进入中断发出第一个字节，之后每个字节一次中断。
+ *          UART5只有本模块使用，不经过HAL的发送状态机，也不与USART2的阻塞输出争用。
+ *          PC0（LOCK_OUT）、UART5（PC12 TX，921600bps，只发）和中断优先级在PTU.ioc中配置，
+ *          由MX_GPIO_Init/MX_UART5_Init初始化
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "LockOut.h"
+#include "Timing.h"
+#include "main.h"
+#include "usart.h"
+
+#define LOCK_OUT_RING_LEN      128U      // 发送缓冲区（2的幂，可排队7帧）
+#define LOCK_OUT_PAYLOAD_LEN   14U
+#define LOCK_OUT_ERR_SCALE     10.0f     // 残差单位0.1像素
+
+static uint8_t lock_ring[LOCK_OUT_RING_LEN];
+static volatile uint32_t lock_head = 0;   // 写入位置（控制任务）
+static volatile uint32_t lock_tail = 0;   // 读取位置（UART5中断）
+
+static uint8_t lock_state = 0;
+static uint8_t lock_seq = 0;
+static LockOutStats lock_stats;
+
+/**
+ * @brief  残差换算为0.1像素并限幅到int16
+ */
+static int16_t LockOut_PackErr(float err)
+{
+    float v = err * LOCK_OUT_ERR_SCALE;
+
+    if (v > 32767.0f) v = 32767.0f;
+    if (v < -32768.0f) v = -32768.0f;
+    return (int16_t)v;
+}
+
+/**
+ * @brief  写入小端多字节字段
+ */
+static void LockOut_PutLe(uint8_t *p, uint32_t value, uint32_t bytes)
+{
+    for (uint32_t i = 0; i < bytes; i++)
+    {
+        p[i] = (uint8_t)(value >> (8U * i));
+    }
+}
+
+/**
+ * @brief  初始化锁定输出状态
+ * @retval None
+ * @note   引脚和UART5已由MX_GPIO_Init/MX_UART5_Init初始化，这里只把输出复位为未锁定
+ */
+void LockOut_Init(void)
+{
+    LOCK_OUT_GPIO_Port->BSRR = (uint32_t)LOCK_OUT_Pin << 16U;
+    lock_state = 0;
+}
+
+/**
+ * @brief  发布锁定状态
+ * @param  locked: 1=锁定, 0=解锁
+ * @param  err_h: 水平残差（像素）
+ * @param  err_v: 垂直残差（像素）
+ * @retval None
+ */
+void LockOut_Set(uint8_t locked, float err_h, float err_v)
+{
+    uint8_t frame[LOCK_OUT_FRAME_LEN];
+    uint8_t *payload = &frame[2];
+    uint8_t sum = 0;
+    uint32_t cycles;
+
+    locked = locked ? 1U : 0U;
+    if (locked == lock_state) return;
+
+    // 先翻转引脚，时间戳取翻转前一刻
+    cycles = Timing_GetCycles();
+    LOCK_OUT_GPIO_Port->BSRR = locked ? (uint32_t)LOCK_OUT_Pin : (uint32_t)LOCK_OUT_Pin << 16U;
+    lock_state = locked;
+
+    frame[0] = 0xFFU;
+    frame[1] = LOCK_OUT_PAYLOAD_LEN;
+    payload[0] = locked;
+    payload[1] = lock_seq++;
+    LockOut_PutLe(&payload[2], cycles, 4);
+    LockOut_PutLe(&payload[6], HAL_GetTick(), 4);
+    LockOut_PutLe(&payload[10], (uint16_t)LockOut_PackErr(err_h), 2);
+    LockOut_PutLe(&payload[12], (uint16_t)LockOut_PackErr(err_v), 2);
+    for (uint32_t i = 0; i < LOCK_OUT_PAYLOAD_LEN; i++)
+    {
+        sum += payload[i];
+    }
+    frame[LOCK_OUT_FRAME_LEN - 1] = (uint8_t)~sum;
+
+    __disable_irq();
+    if (LOCK_OUT_RING_LEN - (lock_head - lock_tail) < LOCK_OUT_FRAME_LEN)
+    {
+        lock_stats.dropped++;
+    }
+    else
+    {
+        for (uint32_t i = 0; i < LOCK_OUT_FRAME_LEN; i++)
+        {
+            lock_ring[(lock_head + i) & (LOCK_OUT_RING_LEN - 1U)] = frame[i];
+        }
+        lock_head += LOCK_OUT_FRAME_LEN;
+        __HAL_UART_ENABLE_IT(&huart5, UART_IT_TXE);
+    }
+    lock_stats.locked = locked;
+    lock_stats.events++;
+    lock_stats.last_cycles = cycles;
+    lock_stats.last_err_h = err_h;
+    lock_stats.last_err_v = err_v;
+    __enable_irq();
+}
+
+/**
+ * @brief  读取统计
+ * @param  stats: 输出
+ * @retval None
+ */
+void LockOut_GetStats(LockOutStats *stats)
+{
+    __disable_irq();
+    *stats = lock_stats;
+    __enable_irq();
+}
+
+/**
+ * @brief  UART5中断处理
+ * @retval None
+ */
+void LockOut_IRQHandler(void)
+{
+    if (__HAL_UART_GET_FLAG(&huart5, UART_FLAG_TXE) == RESET ||
+        __HAL_UART_GET_IT_SOURCE(&huart5, UART_IT_TXE) == RESET)
+    {
+        return;
+    }
+
+    if (lock_tail != lock_head)
+    {
+        huart5.Instance->DR = lock_ring[lock_tail & (LOCK_OUT_RING_LEN - 1U)];
+        lock_tail++;
+    }
+    if (lock_tail == lock_head)
+    {
+        __HAL_UART_DISABLE_IT(&huart5, UART_IT_TXE);
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ * @file    LockOut.h
+ * @brief   锁定事件输出头文件
+ * @details 下游设备（触发、记录等）需要准确知道云台锁定目标的时刻，DATA行和日志文本
+ *          要经过阻塞的USART2输出，延迟不确定。锁定/解锁由控制任务直接发布到独立的低延迟通道：
+ *          - PC0 推挽输出，高电平=已锁定，在判定锁定/解锁的同一处写BSRR翻转（微秒级）
+ *          - UART5_TX PC12 921600bps，只发不收，发出事件帧（TXE中断逐字节发送，
+ *            翻转GPIO后几微秒内开始发出，17字节约185us发完）
+ *
+ *          事件帧: 0xFF len payload checksum（与BinLog帧格式一致，len=14）
+ *          - payload = 类型(1=锁定,0=解锁) 序号 DWT周期(4) tick(4) 水平残差(2) 垂直残差(2)
+ *          - 多字节字段小端，残差为翻转时刻的图像偏差（云台坐标系，0.1像素，有符号）
+ *          - DWT周期为写GPIO前一刻的计数，下游可用相邻两帧换算事件间隔
+ *          - checksum = payload各字节之和取反
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _LOCK_OUT_H
+#define _LOCK_OUT_H
+
+#include "stm32f4xx_hal.h"
+
+#define LOCK_OUT_FRAME_LEN     17        ///< 事件帧总长度（字节）
+
+/**
+ * @brief 锁定事件输出统计
+ */
+typedef struct {
+    uint8_t locked;         ///< 当前输出电平：1=已锁定
+    uint32_t events;        ///< 已发布的事件数
+    uint32_t dropped;       ///< 发送缓冲区满丢弃的事件帧数（GPIO仍翻转）
+    uint32_t last_cycles;   ///< 最近一次事件的DWT周期计数
+    float last_err_h;       ///< 最近一次事件的水平残差（像素）
+    float last_err_v;       ///< 最近一次事件的垂直残差（像素）
+} LockOutStats;
+
+/**
+ * @brief  初始化锁定输出状态
+ * @retval None
+ * @note   在Gimbal_Init中调用，输出复位为低（未锁定）；引脚和UART5由CubeMX生成的代码初始化
+ */
+void LockOut_Init(void);
+
+/**
+ * @brief  发布锁定状态
+ * @param  locked: 1=锁定, 0=解锁
+ * @param  err_h: 水平残差（像素，云台坐标系）
+ * @param  err_v: 垂直残差（像素，云台坐标系）
+ * @retval None
+ * @note   在控制任务中调用；状态未变化时直接返回，变化时先翻转GPIO再排队事件帧。
+ *         偏差超出死区时解锁并带当时的残差，目标丢失或停用时解锁残差为0
+ */
+void LockOut_Set(uint8_t locked, float err_h, float err_v);
+
+/**
+ * @brief  读取统计
+ * @param  stats: 输出
+ * @retval None
+ */
+void LockOut_GetStats(LockOutStats *stats);
+
+/**
+ * @brief  UART5中断处理（发出排队的事件帧字节）
+ * @retval None
+ * @note   在UART5_IRQHandler中调用
+ */
+void LockOut_IRQHandler(void);
+
+#endif
@@ -12,16 +12,25 @@
  *          - 速度: 1200 RPM
  *          - 加速度: 5级
  *          - 校验: 固定0x6B
+ *          - 运动命令可切换为定时器STEP/DIR脉冲输出（MotorStep.c），串口仍用于配置和位置读取
+ *          - 命令帧经UartFast以DMA发送，不等待线路发完；两轴命令在两个串口上并行发出
+ *          - 故障注入（fault命令）：卡死的轴不下发运动/停止命令，冻结的轴位置读取返回冻结值
  */
 
 #include "Motor.h"
+#include "MotorStep.h"
+#include "Journal.h"
+#include "FaultInject.h"
+#include "UartFast.h"
+#include "cmsis_os.h"
+#include "FreeRTOS.h"
+#include "timers.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
 // ==================== 电机配置 ====================
-#define MOTOR_ID_VERTICAL   1    // Y轴（垂直）电机ID
-#define MOTOR_ID_HORIZONTAL 2    // X轴（水平）电机ID
 
 // 电机参数
 #define MOTOR_STEPS_PER_REV 3200  // 16细分下，3200脉冲=1圈
@@ -45,6 +54,7 @@
 #define CMD_SPEED_CONTROL    0xF6  // 速度模式控制
 #define CMD_STOP             0xFE  // 立即停止
 #define CMD_ENABLE           0xF3  // 电机使能控制
+#define CMD_READ_POSITION    0x36  // 读取电机实时位置
 
 // 校验字节（固定）
 #define CHECKSUM 0x6B
@@ -52,12 +62,26 @@
 // 位置模式：相对位置
 #define MODE_RELATIVE 0x00
 
+// 实时位置：一圈65536，应答 地址 0x36 符号 位置[4] 0x6B
+#define POSITION_COUNTS_PER_REV 65536.0f
+#define POSITION_REPLY_LEN      8
+#define POSITION_TIMEOUT        10    // 应答超时(ms)
+static uint8_t position_no_reply[2] = {0, 0};  // 位置读取无应答状态（事件日志只记录变化），[0]=水平 [1]=垂直
+static float position_last[2] = {0.0f, 0.0f};  // 最近一次读到的位置（冻结故障时返回），[0]=水平 [1]=垂直
+
 // 多机同步标志：不启用
 #define SYNC_DISABLE 0x00
 
 // 控制模式选择
 #define USE_SPEED_MODE 0  // 0=使用位置模式（推荐，精确且平滑），1=使用速度模式
 
+// 运动命令输出方式（output命令在线切换）
+#define MOTOR_OUTPUT_DEFAULT MOTOR_OUTPUT_UART
+static volatile MotorOutput motor_output = MOTOR_OUTPUT_DEFAULT;
+
+// 位置模式转速（参数档案切换时由控制任务修改）
+static volatile uint16_t motor_speed_rpm = MOTOR_DEFAULT_SPEED;
+
 // ==================== 内部函数声明 ====================
 
 static void Motor_SendSpeedCommand(uint8_t motor_id, uint8_t direction, uint16_t speed, uint8_t acc);
@@ -65,8 +89,23 @@ static void Motor_SendPositionCommand(uint8_t motor_id, int32_t pulses, uint16_t
 static void Motor_SendStopCommand(uint8_t motor_id);
 static void Motor_SendEnableCommand(uint8_t motor_id, uint8_t enable);
 
+#if USE_SPEED_MODE
+// 速度模式：运动时间到后由软件定时器发送停止命令，调用者不等待
+static TimerHandle_t speed_stop_timer_h = NULL;
+static TimerHandle_t speed_stop_timer_v = NULL;
+static void Motor_ScheduleStop(uint8_t motor_id, uint32_t delay_ms);
+#endif
+
 // ==================== 内部函数实现 ====================
 
+/**
+ * @brief  电机ID对应的串口
+ */
+static UartFastPort Motor_GetPort(uint8_t motor_id)
+{
+    return (motor_id == MOTOR_ID_VERTICAL) ? UART_FAST_MOTOR_V : UART_FAST_MOTOR_H;
+}
+
 /**
  * @brief 发送速度控制命令（平滑模式）
  * @param motor_id: 电机ID (1=垂直, 2=水平)
@@ -92,11 +131,11 @@ static void Motor_SendSpeedCommand(uint8_t motor_id, uint8_t direction, uint16_t
     // 根据电机ID选择串口发送
     if (motor_id == MOTOR_ID_VERTICAL)
     {
-        HAL_UART_Transmit(&huart6, cmd, index, 100);
+        UartFast_Send(UART_FAST_MOTOR_V, cmd, index);
     }
     else if (motor_id == MOTOR_ID_HORIZONTAL)
     {
-        HAL_UART_Transmit(&huart3, cmd, index, 100);
+        UartFast_Send(UART_FAST_MOTOR_H, cmd, index);
     }
 }
 
@@ -134,11 +173,11 @@ static void Motor_SendPositionCommand(uint8_t motor_id, int32_t pulses, uint16_t
     // 根据电机ID选择串口发送
     if (motor_id == MOTOR_ID_VERTICAL)
     {
-        HAL_UART_Transmit(&huart6, cmd, index, 100);
+        UartFast_Send(UART_FAST_MOTOR_V, cmd, index);
     }
     else if (motor_id == MOTOR_ID_HORIZONTAL)
     {
-        HAL_UART_Transmit(&huart3, cmd, index, 100);
+        UartFast_Send(UART_FAST_MOTOR_H, cmd, index);
     }
 }
 
@@ -159,11 +198,11 @@ static void Motor_SendStopCommand(uint8_t motor_id)
     // 根据电机ID选择串口发送
     if (motor_id == MOTOR_ID_VERTICAL)
     {
-        HAL_UART_Transmit(&huart6, cmd, 5, 100);
+        UartFast_Send(UART_FAST_MOTOR_V, cmd, 5);
     }
     else if (motor_id == MOTOR_ID_HORIZONTAL)
     {
-        HAL_UART_Transmit(&huart3, cmd, 5, 100);
+        UartFast_Send(UART_FAST_MOTOR_H, cmd, 5);
     }
 }
 
@@ -186,29 +225,82 @@ static void Motor_SendEnableCommand(uint8_t motor_id, uint8_t enable)
     // 根据电机ID选择串口发送
     if (motor_id == MOTOR_ID_VERTICAL)
     {
-        HAL_UART_Transmit(&huart6, cmd, 6, 100);
+        UartFast_Send(UART_FAST_MOTOR_V, cmd, 6);
     }
     else if (motor_id == MOTOR_ID_HORIZONTAL)
     {
-        HAL_UART_Transmit(&huart3, cmd, 6, 100);
+        UartFast_Send(UART_FAST_MOTOR_H, cmd, 6);
     }
 }
 
+#if USE_SPEED_MODE
+/**
+ * @brief  速度模式停止定时器到时（定时器任务中执行）
+ * @param  timer: 定时器，ID为电机ID
+ */
+static void Motor_SpeedStopCallback(TimerHandle_t timer)
+{
+    Motor_SendStopCommand((uint8_t)(uintptr_t)pvTimerGetTimerID(timer));
+}
+
+/**
+ * @brief  延时发送停止命令
+ * @param  motor_id: 电机ID
+ * @param  delay_ms: 延时(ms)
+ * @note   重新设置周期即重新计时：连续的运动命令只在最后一条走完后停止；
+ *         串口命令在中断中调用，使用FromISR接口
+ */
+static void Motor_ScheduleStop(uint8_t motor_id, uint32_t delay_ms)
+{
+    TimerHandle_t timer = (motor_id == MOTOR_ID_VERTICAL) ? speed_stop_timer_v : speed_stop_timer_h;
+    TickType_t ticks = pdMS_TO_TICKS(delay_ms);
+    
+    if (timer == NULL)
+    {
+        Motor_SendStopCommand(motor_id);
+        return;
+    }
+    if (ticks == 0) ticks = 1;
+    
+    if (__get_IPSR() != 0U)
+    {
+        BaseType_t woken = pdFALSE;
+        xTimerChangePeriodFromISR(timer, ticks, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    else
+    {
+        xTimerChangePeriod(timer, ticks, 0);
+    }
+}
+#endif
+
 /**
  * @brief  电机初始化
  * @retval None
- * @note   等待电机上电稳定后使能两个电机
+ * @note   等待电机上电稳定后使能两个电机；在任务中调用（osDelay等待）
  */
 void Motor_Init(void)
 {
     // 等待电机上电稳定
-    HAL_Delay(100);
+    osDelay(100);
     
     // 使能两个电机
     Motor_SendEnableCommand(MOTOR_ID_VERTICAL, 1);
-    HAL_Delay(50);
+    osDelay(50);
     Motor_SendEnableCommand(MOTOR_ID_HORIZONTAL, 1);
-    HAL_Delay(50);
+    osDelay(50);
+    
+#if USE_SPEED_MODE
+    if (speed_stop_timer_h == NULL)
+    {
+        speed_stop_timer_h = xTimerCreate("StopH", 1, pdFALSE, (void *)(uintptr_t)MOTOR_ID_HORIZONTAL, Motor_SpeedStopCallback);
+        speed_stop_timer_v = xTimerCreate("StopV", 1, pdFALSE, (void *)(uintptr_t)MOTOR_ID_VERTICAL, Motor_SpeedStopCallback);
+    }
+#endif
+    
+    // 脉冲输出常驻运行（空闲段），切换输出方式时无需重新初始化
+    MotorStep_Init();
 }
 
 /**
@@ -219,6 +311,16 @@ void Motor_Init(void)
  */
 void Motor_MoveHorizontal(float angle)
 {
+    if (FaultInject_GetAxis(MOTOR_ID_HORIZONTAL) == FAULT_AXIS_STALL) return;
+    
+    if (motor_output == MOTOR_OUTPUT_STEP)
+    {
+        // 脉冲输出：与串口一致，角度太小时停止（控制环靠它消除残余行程），按减速曲线停下
+        if (fabsf(angle) < 0.1f) MotorStep_Decelerate(MOTOR_ID_HORIZONTAL);
+        else MotorStep_Move(MOTOR_ID_HORIZONTAL, angle);
+        return;
+    }
+    
     if (fabsf(angle) < 0.1f)
     {
         // 角度太小，停止电机
@@ -242,14 +344,13 @@ void Motor_MoveHorizontal(float angle)
     // 计算运动时间（修正公式）
     // 时间(ms) = 角度 / (速度RPM * 360度/圈 / 60000ms/分钟)
     float time_ms = fabsf(angle) * 60000.0f / (speed * 360.0f);
-    HAL_Delay((uint32_t)time_ms + 100);  // 加100ms余量
     
-    // 停止
-    Motor_SendStopCommand(MOTOR_ID_HORIZONTAL);
+    // 到时停止（加100ms余量）
+    Motor_ScheduleStop(MOTOR_ID_HORIZONTAL, (uint32_t)time_ms + 100);
 #else
     // 位置模式：快速但可能有冲击
     int32_t pulses = (int32_t)(angle * PULSES_PER_DEGREE);
-    Motor_SendPositionCommand(MOTOR_ID_HORIZONTAL, pulses, MOTOR_DEFAULT_SPEED, MOTOR_DEFAULT_ACC);
+    Motor_SendPositionCommand(MOTOR_ID_HORIZONTAL, pulses, motor_speed_rpm, MOTOR_DEFAULT_ACC);
 #endif
 }
 
@@ -261,6 +362,16 @@ void Motor_MoveHorizontal(float angle)
  */
 void Motor_MoveVertical(float angle)
 {
+    if (FaultInject_GetAxis(MOTOR_ID_VERTICAL) == FAULT_AXIS_STALL) return;
+    
+    if (motor_output == MOTOR_OUTPUT_STEP)
+    {
+        // 脉冲输出：与串口一致，角度太小时停止（控制环靠它消除残余行程），按减速曲线停下
+        if (fabsf(angle) < 0.1f) MotorStep_Decelerate(MOTOR_ID_VERTICAL);
+        else MotorStep_Move(MOTOR_ID_VERTICAL, angle);
+        return;
+    }
+    
     if (fabsf(angle) < 0.1f)
     {
         // 角度太小，停止电机
@@ -283,14 +394,13 @@ void Motor_MoveVertical(float angle)
     
     // 计算运动时间（修正公式）
     float time_ms = fabsf(angle) * 60000.0f / (speed * 360.0f);
-    HAL_Delay((uint32_t)time_ms + 100);  // 加100ms余量
     
-    // 停止
-    Motor_SendStopCommand(MOTOR_ID_VERTICAL);
+    // 到时停止（加100ms余量）
+    Motor_ScheduleStop(MOTOR_ID_VERTICAL, (uint32_t)time_ms + 100);
 #else
     // 位置模式：快速但可能有冲击
     int32_t pulses = (int32_t)(angle * PULSES_PER_DEGREE);
-    Motor_SendPositionCommand(MOTOR_ID_VERTICAL, pulses, MOTOR_DEFAULT_SPEED, MOTOR_DEFAULT_ACC);
+    Motor_SendPositionCommand(MOTOR_ID_VERTICAL, pulses, motor_speed_rpm, MOTOR_DEFAULT_ACC);
 #endif
 }
 
@@ -300,21 +410,42 @@ void Motor_MoveVertical(float angle)
  */
 void Motor_Stop(void)
 {
+    uint8_t stall_h = (FaultInject_GetAxis(MOTOR_ID_HORIZONTAL) == FAULT_AXIS_STALL);
+    uint8_t stall_v = (FaultInject_GetAxis(MOTOR_ID_VERTICAL) == FAULT_AXIS_STALL);
+    
+    if (motor_output == MOTOR_OUTPUT_STEP)
+    {
+        if (!stall_h) MotorStep_Stop(MOTOR_ID_HORIZONTAL);
+        if (!stall_v) MotorStep_Stop(MOTOR_ID_VERTICAL);
+        return;
+    }
+    
     // 停止两个电机
-    Motor_SendStopCommand(MOTOR_ID_HORIZONTAL);
-    Motor_SendStopCommand(MOTOR_ID_VERTICAL);
+    if (!stall_h) Motor_SendStopCommand(MOTOR_ID_HORIZONTAL);
+    if (!stall_v) Motor_SendStopCommand(MOTOR_ID_VERTICAL);
 }
 
 /**
  * @brief  设置电机速度
- * @param  speed_rpm: 速度（RPM）
- * @retval None
- * @note   可选功能，暂未实现
+ * @param  speed_rpm: 速度（RPM），MOTOR_SPEED_MIN_RPM~MOTOR_SPEED_MAX_RPM
+ * @retval 1=成功, 0=超出范围
+ * @note   串口位置模式命令的转速，下一条运动命令生效
  */
-void Motor_SetSpeed(uint16_t speed_rpm)
+uint8_t Motor_SetSpeed(uint16_t speed_rpm)
 {
-    // 可以在这里保存速度设置，在下次移动时使用
-    // 暂时使用默认速度
+    if (speed_rpm < MOTOR_SPEED_MIN_RPM || speed_rpm > MOTOR_SPEED_MAX_RPM) return 0;
+    
+    motor_speed_rpm = speed_rpm;
+    return 1;
+}
+
+/**
+ * @brief  获取电机速度
+ * @retval 速度（RPM）
+ */
+uint16_t Motor_GetSpeed(void)
+{
+    return motor_speed_rpm;
 }
 
 /**
@@ -327,3 +458,99 @@ void Motor_Disable(void)
     Motor_SendEnableCommand(MOTOR_ID_HORIZONTAL, 0);
     Motor_SendEnableCommand(MOTOR_ID_VERTICAL, 0);
 }
+
+/**
+ * @brief  读取电机实时位置
+ * @param  motor_id: 电机ID
+ * @param  angle: 角度输出（度，相对上电/清零位置，CW为正）
+ * @retval 1=成功, 0=无应答或帧错误
+ * @note   阻塞收发（约1ms），只能在任务中调用
+ */
+uint8_t Motor_ReadPosition(uint8_t motor_id, float *angle)
+{
+    UartFastPort port = Motor_GetPort(motor_id);
+    uint8_t cmd[3] = {motor_id, CMD_READ_POSITION, CHECKSUM};
+    uint8_t reply[POSITION_REPLY_LEN];
+    
+    uint8_t *no_reply = &position_no_reply[motor_id == MOTOR_ID_VERTICAL];
+    float *last = &position_last[motor_id == MOTOR_ID_VERTICAL];
+    
+    // 上一条命令可能仍在DMA发送，等它发完再丢弃积压的应答
+    UartFast_Flush(port);
+    UartFast_DiscardRx(port);
+    
+    if (!UartFast_Send(port, cmd, sizeof(cmd)) ||
+        !UartFast_Read(port, reply, sizeof(reply), POSITION_TIMEOUT) ||
+        reply[0] != motor_id || reply[1] != CMD_READ_POSITION || reply[7] != CHECKSUM) {
+        if (!*no_reply) {
+            *no_reply = 1;
+            Journal_Log(JOURNAL_EV_MOTOR_TIMEOUT, motor_id, 0);
+        }
+        return 0;
+    }
+    if (*no_reply) {
+        *no_reply = 0;
+        Journal_Log(JOURNAL_EV_MOTOR_RESTORED, motor_id, 0);
+    }
+    
+    uint32_t counts = ((uint32_t)reply[3] << 24) | ((uint32_t)reply[4] << 16) |
+                      ((uint32_t)reply[5] << 8) | reply[6];
+    *angle = (float)counts * MOTOR_DEGREES_PER_REV / POSITION_COUNTS_PER_REV;
+    if (reply[2]) *angle = -*angle;
+    
+    // 冻结故障：通信照常，读数保持冻结前的值
+    if (FaultInject_GetAxis(motor_id) == FAULT_AXIS_FREEZE) *angle = *last;
+    else *last = *angle;
+    
+    return 1;
+}
+
+/**
+ * @brief  等待控制命令应答
+ * @param  motor_id: 电机ID
+ * @param  timeout: 超时(ms)
+ * @retval 1=收到"地址 功能码 0x02 0x6B", 0=超时或帧错误
+ * @note   驱动"控制命令应答"参数为1（收到即应答）时，每条运动命令都有应答；
+ *         需要紧接运动命令后读取串口时先调用本函数取走应答帧
+ */
+uint8_t Motor_WaitAck(uint8_t motor_id, uint32_t timeout)
+{
+    uint8_t reply[4];
+    
+    if (!UartFast_Read(Motor_GetPort(motor_id), reply, sizeof(reply), timeout)) return 0;
+    
+    return reply[0] == motor_id && reply[2] == 0x02 && reply[3] == CHECKSUM;
+}
+
+/**
+ * @brief  等待命令帧发完
+ * @param  motor_id: 电机ID
+ * @retval None
+ * @note   运动命令DMA发送后立即返回，需要"指令帧发完"时刻时调用（约1ms）
+ */
+void Motor_FlushTx(uint8_t motor_id)
+{
+    UartFast_Flush(Motor_GetPort(motor_id));
+}
+
+/**
+ * @brief  切换运动命令输出方式
+ * @param  output: 输出方式
+ * @retval None
+ */
+void Motor_SetOutput(MotorOutput output)
+{
+    if (output == motor_output) return;
+    
+    Motor_Stop();
+    motor_output = output;
+}
+
+/**
+ * @brief  获取运动命令输出方式
+ * @retval 当前输出方式
+ */
+MotorOutput Motor_GetOutput(void)
+{
+    return motor_output;
+}
@@ -12,10 +12,26 @@
 #include "stm32f4xx_hal.h"
 #include "usart.h"
 
+// 电机地址
+#define MOTOR_ID_VERTICAL   1    ///< Y轴（垂直）电机ID，USART6
+#define MOTOR_ID_HORIZONTAL 2    ///< X轴（水平）电机ID，USART3
+
+// 位置模式转速范围(RPM)
+#define MOTOR_SPEED_MIN_RPM 50
+#define MOTOR_SPEED_MAX_RPM 3000
+
+/**
+ * @brief 运动命令输出方式（参数配置和位置读取始终走串口）
+ */
+typedef enum {
+    MOTOR_OUTPUT_UART = 0,  ///< 串口位置模式命令
+    MOTOR_OUTPUT_STEP       ///< 定时器STEP/DIR脉冲（MotorStep）
+} MotorOutput;
+
 /**
  * @brief  电机初始化
  * @retval None
- * @note   自动使能两个电机（ID=1垂直轴, ID=2水平轴）
+ * @note   自动使能两个电机（ID=1垂直轴, ID=2水平轴）；在任务中调用
  */
 void Motor_Init(void);
 
@@ -40,11 +56,18 @@ void Motor_MoveVertical(float angle);
 void Motor_Stop(void);
 
 /**
- * @brief  设置电机速度（可选）
- * @param  speed_rpm: 速度（RPM）
- * @retval None
+ * @brief  设置电机速度
+ * @param  speed_rpm: 速度（RPM），MOTOR_SPEED_MIN_RPM~MOTOR_SPEED_MAX_RPM
+ * @retval 1=成功, 0=超出范围
+ * @note   只影响串口位置模式命令，脉冲输出的最高转速为MOTOR_STEP_MAX_RPM
  */
-void Motor_SetSpeed(uint16_t speed_rpm);
+uint8_t Motor_SetSpeed(uint16_t speed_rpm);
+
+/**
+ * @brief  获取电机速度
+ * @retval 速度（RPM）
+ */
+uint16_t Motor_GetSpeed(void);
 
 /**
  * @brief  电机失能（可选）
@@ -52,4 +75,44 @@ void Motor_SetSpeed(uint16_t speed_rpm);
  */
 void Motor_Disable(void);
 
+/**
+ * @brief  读取电机实时位置
+ * @param  motor_id: 电机ID
+ * @param  angle: 角度输出（度）
+ * @retval 1=成功, 0=无应答
+ * @note   阻塞收发，只能在任务中调用
+ */
+uint8_t Motor_ReadPosition(uint8_t motor_id, float *angle);
+
+/**
+ * @brief  等待控制命令应答
+ * @param  motor_id: 电机ID
+ * @param  timeout: 超时(ms)
+ * @retval 1=收到应答, 0=超时
+ * @note   驱动开启"收到即应答"时使用，阻塞接收
+ */
+uint8_t Motor_WaitAck(uint8_t motor_id, uint32_t timeout);
+
+/**
+ * @brief  等待命令帧发完
+ * @param  motor_id: 电机ID
+ * @retval None
+ * @note   运动命令以DMA发送、不等待线路发完，测量需要发完时刻时先调用本函数
+ */
+void Motor_FlushTx(uint8_t motor_id);
+
+/**
+ * @brief  切换运动命令输出方式
+ * @param  output: MOTOR_OUTPUT_UART / MOTOR_OUTPUT_STEP
+ * @retval None
+ * @note   切换前停止两轴；STEP方式下运动命令没有串口应答
+ */
+void Motor_SetOutput(MotorOutput output);
+
+/**
+ * @brief  获取运动命令输出方式
+ * @retval 当前输出方式
+ */
+MotorOutput Motor_GetOutput(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,639 @@
+/**
+ * @file    MotorConfig.c
+ * @brief   电机驱动参数管理实现
+ * @details 读取/比较/写入张大头闭环驱动的驱动参数和位置环PID
+ * @version 1.0
+ * @date    2026-02-25
+ *
+ * @note    协议（地址 + 功能码 + 数据 + 0x6B）:
+ *          - 读取驱动参数: addr 42 6C 6B → addr 42 21 15 <28字节参数> 6B
+ *          - 修改驱动参数: addr 48 D1 <存储> <28字节参数> 6B → addr 48 02 6B
+ *          - 读取位置环PID: addr 21 6B → addr 21 Kp(4) Ki(4) Kd(4) 6B
+ *          - 修改位置环PID: addr 4A C3 <存储> Kp(4) Ki(4) Kd(4) 6B → addr 4A 02 6B
+ *          多字节参数均为大端
+ */
+
+#include "MotorConfig.h"
+#include "GimbalControl.h"
+#include "Motor.h"
+#include "SerialDebug.h"
+#include "UartFast.h"
+#include "Profile.h"
+#include <stddef.h>
+#include <string.h>
+
+// 命令码
+#define CMD_READ_CONFIG      0x42
+#define CMD_READ_CONFIG_SUB  0x6C
+#define CMD_WRITE_CONFIG     0x48
+#define CMD_WRITE_CONFIG_SUB 0xD1
+#define CMD_READ_PID         0x21
+#define CMD_WRITE_PID        0x4A
+#define CMD_WRITE_PID_SUB    0xC3
+#define CMD_ACK_OK           0x02
+#define CHECKSUM             0x6B
+
+#define STORE_TO_EEPROM      0x01   // 写入后掉电保存
+
+#define CONFIG_PARAM_BYTES   28     // 驱动参数区长度
+#define CONFIG_PARAM_COUNT   0x15   // 驱动参数个数
+#define CONFIG_FRAME_LEN     (4 + CONFIG_PARAM_BYTES + 1)
+#define PID_FRAME_LEN        15
+#define ACK_FRAME_LEN        4
+
+#define MOTOR_CONFIG_TIMEOUT 50     // 应答超时(ms)
+
+// 参数属性
+#define PARAM_RW     0   // 可通过串口命令修改，同步时写入
+#define PARAM_FIXED  1   // 与Motor.c的换算相关（细分等），同步时写入但不允许修改
+#define PARAM_LINK   2   // 通讯相关（地址、波特率等），只校验不写入，避免写错后失联
+
+/**
+ * @brief 参数描述（顺序与协议一致）
+ */
+typedef struct {
+    const char *name;
+    uint8_t offset;   ///< 在MotorDriverConfig中的偏移
+    uint8_t size;     ///< 1或2字节
+    uint8_t attr;     ///< PARAM_RW/PARAM_FIXED/PARAM_LINK
+} MotorParamDesc;
+
+#define PARAM(n, field, attr) { n, offsetof(MotorDriverConfig, field), sizeof(((MotorDriverConfig *)0)->field), attr }
+
+static const MotorParamDesc param_table[] = {
+    PARAM("type",      motor_type,      PARAM_FIXED),
+    PARAM("pulse",     pulse_mode,      PARAM_FIXED),
+    PARAM("comm",      comm_mode,       PARAM_LINK),
+    PARAM("en",        en_level,        PARAM_RW),
+    PARAM("dir",       dir,             PARAM_RW),
+    PARAM("mstep",     microstep,       PARAM_FIXED),
+    PARAM("interp",    interp,          PARAM_RW),
+    PARAM("screen",    auto_screen_off, PARAM_RW),
+    PARAM("ocur",      open_current,    PARAM_RW),
+    PARAM("mcur",      max_current,     PARAM_RW),
+    PARAM("mvolt",     max_voltage,     PARAM_RW),
+    PARAM("baud",      baud,            PARAM_LINK),
+    PARAM("can",       can_rate,        PARAM_LINK),
+    PARAM("id",        id,              PARAM_LINK),
+    PARAM("cksum",     checksum_mode,   PARAM_LINK),
+    PARAM("resp",      response,        PARAM_RW),
+    PARAM("stall",     stall_protect,   PARAM_RW),
+    PARAM("stall_rpm", stall_rpm,       PARAM_RW),
+    PARAM("stall_ma",  stall_current,   PARAM_RW),
+    PARAM("stall_ms",  stall_time,      PARAM_RW),
+    PARAM("window",    pos_window,      PARAM_RW),
+};
+#define PARAM_TABLE_SIZE (sizeof(param_table) / sizeof(param_table[0]))
+
+/**
+ * @brief 本机参数表（[0]=垂直ID1，[1]=水平ID2），初值为固件默认值，Flash中有保存的参数表时由其覆盖
+ * @note  细分必须为16，与Motor.c的3200脉冲/圈一致
+ */
+static MotorDriverConfig profile[2] = {
+    {
+        .motor_type = 0x19, .pulse_mode = 2, .comm_mode = 2, .en_level = 2, .dir = 0,
+        .microstep = 16, .interp = 1, .auto_screen_off = 0,
+        .open_current = 1200, .max_current = 3000, .max_voltage = 5000,
+        .baud = 5, .can_rate = 7, .id = MOTOR_ID_VERTICAL, .checksum_mode = 0,
+        .response = 1, .stall_protect = 1,
+        .stall_rpm = 8, .stall_current = 2400, .stall_time = 2000, .pos_window = 3,
+    },
+    {
+        .motor_type = 0x19, .pulse_mode = 2, .comm_mode = 2, .en_level = 2, .dir = 0,
+        .microstep = 16, .interp = 1, .auto_screen_off = 0,
+        .open_current = 1200, .max_current = 3000, .max_voltage = 5000,
+        .baud = 5, .can_rate = 7, .id = MOTOR_ID_HORIZONTAL, .checksum_mode = 0,
+        .response = 1, .stall_protect = 1,
+        .stall_rpm = 8, .stall_current = 2400, .stall_time = 2000, .pos_window = 3,
+    },
+};
+
+static MotorDriverPID profile_pid[2] = {
+    { 18000, 10, 18000 },
+    { 18000, 10, 18000 },
+};
+
+static uint8_t profile_saved = 0;   // 1=参数表来自Flash（或已保存）
+
+// 挂起的请求（串口命令写入，默认任务执行）
+static volatile MotorConfigRequest pending_req = MOTOR_CONFIG_REQ_NONE;
+static volatile uint8_t pending_id = 0;
+
+// ==================== 内部函数 ====================
+
+/**
+ * @brief  地址转参数表下标
+ * @param  motor_id: 电机地址
+ * @retval 下标，-1=地址无效
+ */
+static int MotorConfig_Index(uint8_t motor_id)
+{
+    if (motor_id == MOTOR_ID_VERTICAL) return 0;
+    if (motor_id == MOTOR_ID_HORIZONTAL) return 1;
+    return -1;
+}
+
+static UartFastPort MotorConfig_GetPort(uint8_t motor_id)
+{
+    return (motor_id == MOTOR_ID_VERTICAL) ? UART_FAST_MOTOR_V : UART_FAST_MOTOR_H;
+}
+
+static const char *MotorConfig_AxisName(uint8_t motor_id)
+{
+    return (motor_id == MOTOR_ID_VERTICAL) ? "V" : "H";
+}
+
+static uint16_t MotorConfig_GetField(const MotorDriverConfig *cfg, const MotorParamDesc *desc)
+{
+    const uint8_t *base = (const uint8_t *)cfg + desc->offset;
+    if (desc->size == 1) return *base;
+    return *(const uint16_t *)base;
+}
+
+static void MotorConfig_SetField(MotorDriverConfig *cfg, const MotorParamDesc *desc, uint16_t value)
+{
+    uint8_t *base = (uint8_t *)cfg + desc->offset;
+    if (desc->size == 1) *base = (uint8_t)value;
+    else *(uint16_t *)base = value;
+}
+
+static const MotorParamDesc *MotorConfig_FindParam(const char *name)
+{
+    for (uint32_t i = 0; i < PARAM_TABLE_SIZE; i++)
+    {
+        if (strcmp(param_table[i].name, name) == 0) return &param_table[i];
+    }
+    return NULL;
+}
+
+static void MotorConfig_PutU32(uint8_t *p, uint32_t v)
+{
+    p[0] = (v >> 24) & 0xFF;
+    p[1] = (v >> 16) & 0xFF;
+    p[2] = (v >> 8) & 0xFF;
+    p[3] = v & 0xFF;
+}
+
+static uint32_t MotorConfig_GetU32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief  发送命令并接收固定长度应答
+ * @param  motor_id: 电机地址
+ * @param  tx: 命令帧
+ * @param  tx_len: 命令长度
+ * @param  rx: 应答缓冲区
+ * @param  rx_len: 应答长度
+ * @retval 1=收到地址、功能码和校验均正确的应答, 0=超时或帧错误
+ * @note   电机串口平时只发不收，先清掉积压的应答和溢出标志
+ */
+static uint8_t MotorConfig_Transact(uint8_t motor_id, const uint8_t *tx, uint16_t tx_len,
+                                    uint8_t *rx, uint16_t rx_len)
+{
+    UartFastPort port = MotorConfig_GetPort(motor_id);
+
+    UartFast_Flush(port);
+    UartFast_DiscardRx(port);
+
+    UartFast_Write(port, tx, tx_len);
+    if (!UartFast_Read(port, rx, rx_len, MOTOR_CONFIG_TIMEOUT)) return 0;
+
+    return rx[0] == motor_id && rx[1] == tx[1] && rx[rx_len - 1] == CHECKSUM;
+}
+
+/**
+ * @brief  参数区编码/解码（按参数表顺序，大端）
+ */
+static void MotorConfig_Pack(const MotorDriverConfig *cfg, uint8_t *p)
+{
+    for (uint32_t i = 0; i < PARAM_TABLE_SIZE; i++)
+    {
+        uint16_t v = MotorConfig_GetField(cfg, &param_table[i]);
+        if (param_table[i].size == 2) *p++ = (v >> 8) & 0xFF;
+        *p++ = v & 0xFF;
+    }
+}
+
+static void MotorConfig_Unpack(MotorDriverConfig *cfg, const uint8_t *p)
+{
+    for (uint32_t i = 0; i < PARAM_TABLE_SIZE; i++)
+    {
+        uint16_t v = *p++;
+        if (param_table[i].size == 2) v = (v << 8) | *p++;
+        MotorConfig_SetField(cfg, &param_table[i], v);
+    }
+}
+
+/**
+ * @brief  比较驱动参数与参数表
+ * @param  motor_id: 电机地址
+ * @param  cfg: 驱动当前参数
+ * @param  verbose: 1=打印差异
+ * @retval 需要写入的参数个数（不含只校验的通讯参数）
+ */
+static uint32_t MotorConfig_Compare(uint8_t motor_id, const MotorDriverConfig *cfg, uint8_t verbose)
+{
+    const MotorDriverConfig *want = &profile[MotorConfig_Index(motor_id)];
+    uint32_t diff = 0;
+
+    for (uint32_t i = 0; i < PARAM_TABLE_SIZE; i++)
+    {
+        const MotorParamDesc *desc = &param_table[i];
+        uint16_t have = MotorConfig_GetField(cfg, desc);
+        uint16_t need = MotorConfig_GetField(want, desc);
+        if (have == need) continue;
+
+        if (desc->attr != PARAM_LINK) diff++;
+        if (verbose)
+        {
+            SerialDebug_Printf("  %-9s driver=%-5u profile=%u%s\r\n", desc->name, have, need,
+                               desc->attr == PARAM_LINK ? " (link, not written)" : "");
+        }
+    }
+    return diff;
+}
+
+/**
+ * @brief  同步单台驱动
+ * @param  motor_id: 电机地址
+ * @param  write: 1=写入差异, 0=只报告
+ * @retval 1=一致或写入成功, 0=失败或不一致
+ */
+static uint8_t MotorConfig_SyncOne(uint8_t motor_id, uint8_t write)
+{
+    int idx = MotorConfig_Index(motor_id);
+    MotorDriverConfig cfg;
+    MotorDriverPID pid;
+    uint32_t diff;
+    uint8_t ok = 1;
+
+    if (!MotorConfig_Read(motor_id, &cfg))
+    {
+        SerialDebug_Printf("Motor %s: no config response\r\n", MotorConfig_AxisName(motor_id));
+        return 0;
+    }
+
+    diff = MotorConfig_Compare(motor_id, &cfg, 1);
+    if (diff > 0 && !write)
+    {
+        SerialDebug_Printf("Motor %s: config differs (not written)\r\n", MotorConfig_AxisName(motor_id));
+        ok = 0;
+    }
+    else if (diff > 0)
+    {
+        // 通讯参数保持驱动当前值，其余按参数表写入
+        MotorDriverConfig target = profile[idx];
+        for (uint32_t i = 0; i < PARAM_TABLE_SIZE; i++)
+        {
+            if (param_table[i].attr == PARAM_LINK)
+            {
+                MotorConfig_SetField(&target, &param_table[i], MotorConfig_GetField(&cfg, &param_table[i]));
+            }
+        }
+
+        if (MotorConfig_Write(motor_id, &target) && MotorConfig_Read(motor_id, &cfg) &&
+            MotorConfig_Compare(motor_id, &cfg, 0) == 0)
+        {
+            SerialDebug_Printf("Motor %s: config written\r\n", MotorConfig_AxisName(motor_id));
+        }
+        else
+        {
+            SerialDebug_Printf("Motor %s: config write failed\r\n", MotorConfig_AxisName(motor_id));
+            ok = 0;
+        }
+    }
+
+    if (!MotorConfig_ReadPID(motor_id, &pid))
+    {
+        SerialDebug_Printf("Motor %s: no PID response\r\n", MotorConfig_AxisName(motor_id));
+        return 0;
+    }
+
+    if (memcmp(&pid, &profile_pid[idx], sizeof(pid)) != 0)
+    {
+        SerialDebug_Printf("  pid       driver=%lu/%lu/%lu profile=%lu/%lu/%lu\r\n",
+                           (unsigned long)pid.kp, (unsigned long)pid.ki, (unsigned long)pid.kd,
+                           (unsigned long)profile_pid[idx].kp, (unsigned long)profile_pid[idx].ki,
+                           (unsigned long)profile_pid[idx].kd);
+        if (!write)
+        {
+            SerialDebug_Printf("Motor %s: PID differs (not written)\r\n", MotorConfig_AxisName(motor_id));
+            ok = 0;
+        }
+        else if (MotorConfig_WritePID(motor_id, &profile_pid[idx]))
+        {
+            SerialDebug_Printf("Motor %s: PID written\r\n", MotorConfig_AxisName(motor_id));
+        }
+        else
+        {
+            SerialDebug_Printf("Motor %s: PID write failed\r\n", MotorConfig_AxisName(motor_id));
+            ok = 0;
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief  读取并打印单台驱动参数
+ * @param  motor_id: 电机地址
+ * @retval None
+ */
+static void MotorConfig_ShowOne(uint8_t motor_id)
+{
+    int idx = MotorConfig_Index(motor_id);
+    MotorDriverConfig cfg;
+    MotorDriverPID pid;
+
+    SerialDebug_Printf("=== Motor %s (ID %u) ===\r\n", MotorConfig_AxisName(motor_id), motor_id);
+    if (!MotorConfig_Read(motor_id, &cfg))
+    {
+        SerialDebug_Printf("No config response\r\n");
+        return;
+    }
+
+    for (uint32_t i = 0; i < PARAM_TABLE_SIZE; i++)
+    {
+        const MotorParamDesc *desc = &param_table[i];
+        uint16_t have = MotorConfig_GetField(&cfg, desc);
+        uint16_t need = MotorConfig_GetField(&profile[idx], desc);
+        SerialDebug_Printf("  %-9s %-5u%s\r\n", desc->name, have, have == need ? "" : " *");
+    }
+
+    if (MotorConfig_ReadPID(motor_id, &pid))
+    {
+        SerialDebug_Printf("  pid       %lu/%lu/%lu%s\r\n",
+                           (unsigned long)pid.kp, (unsigned long)pid.ki, (unsigned long)pid.kd,
+                           memcmp(&pid, &profile_pid[idx], sizeof(pid)) == 0 ? "" : " *");
+    }
+    SerialDebug_Printf("(* = differs from profile)\r\n");
+}
+
+// ==================== 接口函数 ====================
+
+/**
+ * @brief  读取驱动参数
+ * @param  motor_id: 电机地址
+ * @param  cfg: 参数输出
+ * @retval 1=成功, 0=无应答或帧错误
+ */
+uint8_t MotorConfig_Read(uint8_t motor_id, MotorDriverConfig *cfg)
+{
+    uint8_t tx[4] = { motor_id, CMD_READ_CONFIG, CMD_READ_CONFIG_SUB, CHECKSUM };
+    uint8_t rx[CONFIG_FRAME_LEN];
+
+    if (!MotorConfig_Transact(motor_id, tx, sizeof(tx), rx, sizeof(rx))) return 0;
+    if (rx[2] != CONFIG_FRAME_LEN || rx[3] != CONFIG_PARAM_COUNT) return 0;
+
+    MotorConfig_Unpack(cfg, &rx[4]);
+    return 1;
+}
+
+/**
+ * @brief  写入驱动参数
+ * @param  motor_id: 电机地址
+ * @param  cfg: 参数
+ * @retval 1=驱动确认, 0=失败
+ */
+uint8_t MotorConfig_Write(uint8_t motor_id, const MotorDriverConfig *cfg)
+{
+    uint8_t tx[CONFIG_FRAME_LEN];
+    uint8_t rx[ACK_FRAME_LEN];
+
+    tx[0] = motor_id;
+    tx[1] = CMD_WRITE_CONFIG;
+    tx[2] = CMD_WRITE_CONFIG_SUB;
+    tx[3] = STORE_TO_EEPROM;
+    MotorConfig_Pack(cfg, &tx[4]);
+    tx[CONFIG_FRAME_LEN - 1] = CHECKSUM;
+
+    return MotorConfig_Transact(motor_id, tx, sizeof(tx), rx, sizeof(rx)) && rx[2] == CMD_ACK_OK;
+}
+
+/**
+ * @brief  读取驱动位置环PID
+ * @param  motor_id: 电机地址
+ * @param  pid: 参数输出
+ * @retval 1=成功, 0=失败
+ */
+uint8_t MotorConfig_ReadPID(uint8_t motor_id, MotorDriverPID *pid)
+{
+    uint8_t tx[3] = { motor_id, CMD_READ_PID, CHECKSUM };
+    uint8_t rx[PID_FRAME_LEN];
+
+    if (!MotorConfig_Transact(motor_id, tx, sizeof(tx), rx, sizeof(rx))) return 0;
+
+    pid->kp = MotorConfig_GetU32(&rx[2]);
+    pid->ki = MotorConfig_GetU32(&rx[6]);
+    pid->kd = MotorConfig_GetU32(&rx[10]);
+    return 1;
+}
+
+/**
+ * @brief  写入驱动位置环PID
+ * @param  motor_id: 电机地址
+ * @param  pid: 参数
+ * @retval 1=驱动确认, 0=失败
+ */
+uint8_t MotorConfig_WritePID(uint8_t motor_id, const MotorDriverPID *pid)
+{
+    uint8_t tx[17];
+    uint8_t rx[ACK_FRAME_LEN];
+
+    tx[0] = motor_id;
+    tx[1] = CMD_WRITE_PID;
+    tx[2] = CMD_WRITE_PID_SUB;
+    tx[3] = STORE_TO_EEPROM;
+    MotorConfig_PutU32(&tx[4], pid->kp);
+    MotorConfig_PutU32(&tx[8], pid->ki);
+    MotorConfig_PutU32(&tx[12], pid->kd);
+    tx[16] = CHECKSUM;
+
+    return MotorConfig_Transact(motor_id, tx, sizeof(tx), rx, sizeof(rx)) && rx[2] == CMD_ACK_OK;
+}
+
+/**
+ * @brief  上电同步所有驱动参数
+ * @retval 1=两台驱动均与参数表一致（或已写入成功）, 0=有驱动无应答或写入失败
+ */
+uint8_t MotorConfig_SyncAll(void)
+{
+    uint8_t ok_v = MotorConfig_SyncOne(MOTOR_ID_VERTICAL, 1);
+    uint8_t ok_h = MotorConfig_SyncOne(MOTOR_ID_HORIZONTAL, 1);
+
+    SerialDebug_Printf("Driver config: %s\r\n", (ok_v && ok_h) ? "OK" : "FAILED");
+    return ok_v && ok_h;
+}
+
+/**
+ * @brief  使用Flash中保存的参数表
+ * @param  table: 保存的参数表
+ * @retval None
+ */
+void MotorConfig_LoadTable(const MotorDriverTable *table)
+{
+    for (uint32_t m = 0; m < 2; m++)
+    {
+        for (uint32_t i = 0; i < PARAM_TABLE_SIZE; i++)
+        {
+            if (param_table[i].attr == PARAM_RW)
+            {
+                MotorConfig_SetField(&profile[m], &param_table[i],
+                                     MotorConfig_GetField(&table->config[m], &param_table[i]));
+            }
+        }
+        profile_pid[m] = table->pid[m];
+    }
+    profile_saved = 1;
+}
+
+/**
+ * @brief  上电检查所有驱动参数
+ * @retval 1=两台驱动均与参数表一致（或已写入成功）, 0=有驱动无应答、不一致或写入失败
+ */
+uint8_t MotorConfig_BootCheck(void)
+{
+    uint8_t ok_v, ok_h;
+
+    if (profile_saved) return MotorConfig_SyncAll();
+
+    // 固件默认参数表不写入：现场用drv set/pid调好但未保存的参数留在驱动EEPROM中
+    ok_v = MotorConfig_SyncOne(MOTOR_ID_VERTICAL, 0);
+    ok_h = MotorConfig_SyncOne(MOTOR_ID_HORIZONTAL, 0);
+    SerialDebug_Printf("Driver config: %s\r\n", (ok_v && ok_h) ? "OK" :
+                       "MISMATCH (no saved profile, not written; 'drv sync' to write, 'drv save' to keep)");
+    return ok_v && ok_h;
+}
+
+/**
+ * @brief  参数表保存到Flash
+ * @retval None
+ */
+static void MotorConfig_Save(void)
+{
+    MotorDriverTable table;
+
+    // 参数表由串口命令在中断中修改，整体复制
+    __disable_irq();
+    memcpy(table.config, profile, sizeof(table.config));
+    memcpy(table.pid, profile_pid, sizeof(table.pid));
+    __enable_irq();
+
+    if (Profile_StoreDriverTable(&table))
+    {
+        profile_saved = 1;
+        SerialDebug_Printf("Driver profile saved\r\n");
+    }
+}
+
+/**
+ * @brief  修改参数表中的一项
+ * @param  motor_id: 电机地址
+ * @param  name: 参数名
+ * @param  value: 新值
+ * @retval 1=成功, 0=参数名无效/只读/超出范围
+ */
+uint8_t MotorConfig_SetParam(uint8_t motor_id, const char *name, uint32_t value)
+{
+    int idx = MotorConfig_Index(motor_id);
+    const MotorParamDesc *desc = MotorConfig_FindParam(name);
+
+    if (idx < 0 || desc == NULL || desc->attr != PARAM_RW) return 0;
+    if (value > (desc->size == 1 ? 0xFFu : 0xFFFFu)) return 0;
+
+    MotorConfig_SetField(&profile[idx], desc, (uint16_t)value);
+    return 1;
+}
+
+/**
+ * @brief  修改参数表中的位置环PID
+ * @param  motor_id: 电机地址
+ * @param  pid: 新参数
+ * @retval 1=成功, 0=地址无效
+ */
+uint8_t MotorConfig_SetPID(uint8_t motor_id, const MotorDriverPID *pid)
+{
+    int idx = MotorConfig_Index(motor_id);
+    if (idx < 0) return 0;
+
+    profile_pid[idx] = *pid;
+    return 1;
+}
+
+/**
+ * @brief  打印可修改的参数名和参数表当前值
+ * @param  motor_id: 电机地址
+ * @retval None
+ */
+void MotorConfig_PrintProfile(uint8_t motor_id)
+{
+    int idx = MotorConfig_Index(motor_id);
+    if (idx < 0) return;
+
+    SerialDebug_Printf("=== Profile %s (ID %u, %s) ===\r\n", MotorConfig_AxisName(motor_id), motor_id,
+                       profile_saved ? "saved" : "firmware defaults");
+    for (uint32_t i = 0; i < PARAM_TABLE_SIZE; i++)
+    {
+        const MotorParamDesc *desc = &param_table[i];
+        SerialDebug_Printf("  %-9s %-5u%s\r\n", desc->name, MotorConfig_GetField(&profile[idx], desc),
+                           desc->attr == PARAM_RW ? "" : " (fixed)");
+    }
+    SerialDebug_Printf("  pid       %lu/%lu/%lu\r\n",
+                       (unsigned long)profile_pid[idx].kp, (unsigned long)profile_pid[idx].ki,
+                       (unsigned long)profile_pid[idx].kd);
+}
+
+/**
+ * @brief  提交驱动参数管理请求
+ * @param  req: 请求类型
+ * @param  motor_id: 电机地址，0=全部
+ * @retval 1=已受理, 0=上一个请求尚未完成
+ */
+uint8_t MotorConfig_Request(MotorConfigRequest req, uint8_t motor_id)
+{
+    if (pending_req != MOTOR_CONFIG_REQ_NONE) return 0;
+
+    pending_id = motor_id;
+    pending_req = req;
+    return 1;
+}
+
+/**
+ * @brief  执行挂起的请求
+ * @retval None
+ */
+void MotorConfig_Process(void)
+{
+    MotorConfigRequest req = pending_req;
+    uint8_t motor_id = pending_id;
+
+    if (req == MOTOR_CONFIG_REQ_NONE) return;
+
+    if (req == MOTOR_CONFIG_REQ_SHOW)
+    {
+        if (motor_id == 0 || motor_id == MOTOR_ID_VERTICAL) MotorConfig_ShowOne(MOTOR_ID_VERTICAL);
+        if (motor_id == 0 || motor_id == MOTOR_ID_HORIZONTAL) MotorConfig_ShowOne(MOTOR_ID_HORIZONTAL);
+    }
+    else if (req == MOTOR_CONFIG_REQ_SYNC)
+    {
+        if (motor_id == 0)
+        {
+            MotorConfig_SyncAll();
+        }
+        else
+        {
+            SerialDebug_Printf("Driver config %s: %s\r\n", MotorConfig_AxisName(motor_id),
+                               MotorConfig_SyncOne(motor_id, 1) ? "OK" : "FAILED");
+        }
+    }
+    else if (req == MOTOR_CONFIG_REQ_SAVE)
+    {
+        MotorConfig_Save();
+    }
+
+    if (req != MOTOR_CONFIG_REQ_SAVE) Gimbal_ReleaseMotorBus();   // show/sync提交时占用了电机串口
+
+    pending_req = MOTOR_CONFIG_REQ_NONE;
+}
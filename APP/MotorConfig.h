@@ -0,0 +1,167 @@
+/**
+ * @file    MotorConfig.h
+ * @brief   电机驱动参数管理头文件
+ * @details 读取张大头闭环驱动的驱动参数和位置环PID，与本机保存的参数表比较，
+ *          不一致时写回驱动（存储到驱动EEPROM），保证每台云台的驱动设置一致。
+ *          参数表随参数档案保存在Flash（drv save），上电时Flash中没有保存的参数表则只比较不写入
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _MOTOR_CONFIG_H
+#define _MOTOR_CONFIG_H
+
+#include "stm32f4xx_hal.h"
+
+/**
+ * @brief 驱动参数（读取/修改驱动参数命令0x42 0x6C / 0x48 0xD1，字段顺序与协议一致）
+ */
+typedef struct {
+    uint8_t  motor_type;        ///< 电机类型（0x19=1.8°，0x32=0.9°）
+    uint8_t  pulse_mode;        ///< 脉冲端口控制模式（0=关闭,1=开环,2=闭环FOC）
+    uint8_t  comm_mode;         ///< 通讯端口复用模式（2=UART）
+    uint8_t  en_level;          ///< En引脚有效电平（0=L,1=H,2=Hold）
+    uint8_t  dir;               ///< 正方向（0=CW,1=CCW）
+    uint8_t  microstep;         ///< 细分（0=256）
+    uint8_t  interp;            ///< 细分插补（0/1）
+    uint8_t  auto_screen_off;   ///< 自动熄屏（0/1）
+    uint16_t open_current;      ///< 开环模式工作电流(mA)
+    uint16_t max_current;       ///< 闭环模式最大电流(mA)
+    uint16_t max_voltage;       ///< 闭环模式最大输出电压(mV)
+    uint8_t  baud;              ///< 串口波特率档位（5=115200）
+    uint8_t  can_rate;          ///< CAN通讯速率档位
+    uint8_t  id;                ///< 地址
+    uint8_t  checksum_mode;     ///< 通讯校验方式（0=固定0x6B）
+    uint8_t  response;          ///< 控制命令应答（0=无,1=收到即应答,2=到位应答）
+    uint8_t  stall_protect;     ///< 堵转保护（0/1）
+    uint16_t stall_rpm;         ///< 堵转保护转速阈值(RPM)
+    uint16_t stall_current;     ///< 堵转保护电流阈值(mA)
+    uint16_t stall_time;        ///< 堵转保护检测时间阈值(ms)
+    uint16_t pos_window;        ///< 位置到达窗口(0.1°)
+} MotorDriverConfig;
+
+/**
+ * @brief 驱动位置环PID参数（读取0x21 / 修改0x4A 0xC3）
+ */
+typedef struct {
+    uint32_t kp;
+    uint32_t ki;
+    uint32_t kd;
+} MotorDriverPID;
+
+/**
+ * @brief 本机参数表（随参数档案保存在Flash，见Profile_StoreDriverTable）
+ */
+typedef struct {
+    MotorDriverConfig config[2];    ///< [0]=垂直ID1，[1]=水平ID2
+    MotorDriverPID pid[2];
+} MotorDriverTable;
+
+/**
+ * @brief 驱动参数管理请求（由串口命令发起，在默认任务中执行）
+ */
+typedef enum {
+    MOTOR_CONFIG_REQ_NONE = 0,
+    MOTOR_CONFIG_REQ_SHOW,      ///< 读取并显示与参数表的差异
+    MOTOR_CONFIG_REQ_SYNC,      ///< 比较并写入差异
+    MOTOR_CONFIG_REQ_SAVE       ///< 参数表保存到Flash
+} MotorConfigRequest;
+
+/**
+ * @brief  使用Flash中保存的参数表
+ * @param  table: 保存的参数表
+ * @retval None
+ * @note   由Profile_Load调用；只取可修改的参数和PID，细分、地址等固定参数保持固件值
+ */
+void MotorConfig_LoadTable(const MotorDriverTable *table);
+
+/**
+ * @brief  上电检查所有驱动参数
+ * @retval 1=两台驱动均与参数表一致（或已写入成功）, 0=有驱动无应答、不一致或写入失败
+ * @note   在默认任务中、Profile_Load之后、控制任务创建前调用。Flash中有保存的参数表时同MotorConfig_SyncAll；
+ *         没有时参数表只是固件默认值，只读取并报告差异，不覆盖驱动EEPROM中已调好的参数
+ */
+uint8_t MotorConfig_BootCheck(void);
+
+/**
+ * @brief  上电同步所有驱动参数
+ * @retval 1=两台驱动均与参数表一致（或已写入成功）, 0=有驱动无应答或写入失败
+ * @note   阻塞执行（每台驱动数百ms），只能在任务中调用：上电时在默认任务中、
+ *         控制任务创建前调用；运行中由drv sync命令经MotorConfig_Process调用
+ */
+uint8_t MotorConfig_SyncAll(void);
+
+/**
+ * @brief  读取驱动参数
+ * @param  motor_id: 电机地址
+ * @param  cfg: 参数输出
+ * @retval 1=成功, 0=无应答或帧错误
+ */
+uint8_t MotorConfig_Read(uint8_t motor_id, MotorDriverConfig *cfg);
+
+/**
+ * @brief  写入驱动参数
+ * @param  motor_id: 电机地址
+ * @param  cfg: 参数
+ * @retval 1=驱动确认, 0=失败
+ */
+uint8_t MotorConfig_Write(uint8_t motor_id, const MotorDriverConfig *cfg);
+
+/**
+ * @brief  读取驱动位置环PID
+ * @param  motor_id: 电机地址
+ * @param  pid: 参数输出
+ * @retval 1=成功, 0=失败
+ */
+uint8_t MotorConfig_ReadPID(uint8_t motor_id, MotorDriverPID *pid);
+
+/**
+ * @brief  写入驱动位置环PID
+ * @param  motor_id: 电机地址
+ * @param  pid: 参数
+ * @retval 1=驱动确认, 0=失败
+ */
+uint8_t MotorConfig_WritePID(uint8_t motor_id, const MotorDriverPID *pid);
+
+/**
+ * @brief  修改参数表中的一项
+ * @param  motor_id: 电机地址
+ * @param  name: 参数名（见MotorConfig_PrintParamNames）
+ * @param  value: 新值
+ * @retval 1=成功, 0=参数名无效/只读/超出范围
+ * @note   只修改本机参数表，下次同步时写入驱动；drv save后掉电保存
+ */
+uint8_t MotorConfig_SetParam(uint8_t motor_id, const char *name, uint32_t value);
+
+/**
+ * @brief  修改参数表中的位置环PID
+ * @param  motor_id: 电机地址
+ * @param  pid: 新参数
+ * @retval 1=成功, 0=地址无效
+ */
+uint8_t MotorConfig_SetPID(uint8_t motor_id, const MotorDriverPID *pid);
+
+/**
+ * @brief  打印可修改的参数名和参数表当前值
+ * @param  motor_id: 电机地址
+ * @retval None
+ */
+void MotorConfig_PrintProfile(uint8_t motor_id);
+
+/**
+ * @brief  提交驱动参数管理请求
+ * @param  req: 请求类型
+ * @param  motor_id: 电机地址，0=全部
+ * @retval 1=已受理, 0=上一个请求尚未完成
+ * @note   可在中断中调用
+ */
+uint8_t MotorConfig_Request(MotorConfigRequest req, uint8_t motor_id);
+
+/**
+ * @brief  执行挂起的请求
+ * @retval None
+ * @note   在默认任务中周期调用（串口收发为阻塞方式）
+ */
+void MotorConfig_Process(void);
+
+#endif
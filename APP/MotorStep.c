@@ -0,0 +1,256 @@
+/**
+ * @file    MotorStep.c
+ * @brief   STEP/DIR脉冲输出实现
+ * @details 定时器PWM1模式，ARR/RCR/CCR均开启预装载；DMA为双缓冲循环模式，
+ *          每个更新事件突发写入一段（ARR RCR CCR1 CCR2 CCR3，共5个半字），
+ *          写入的值在下一个更新事件生效。一块缓冲区取完后在传输完成中断中重填，
+ *          此时该块最后一段还在预装载寄存器中等待，另一块尚未开始，留有至少一段的时间
+ *
+ * @note    中断没有在一段时间内完成重填时，DMA会重复发送旧缓冲区，位置计数不再准确，
+ *          记为欠载（output命令显示）。中断优先级4，不受FreeRTOS临界区屏蔽。
+ *          STEP/DIR引脚、TIM1/TIM8和DMA2_Stream5/Stream1在PTU.ioc中配置，
+ *          由MX_GPIO_Init/MX_DMA_Init/MX_TIM1_Init/MX_TIM8_Init初始化，本模块只改写寄存器
+ */
+
+#include "MotorStep.h"
+#include "StepGen.h"
+#include "Motor.h"
+#include "main.h"
+#include "tim.h"
+
+#define STEP_PULSES_PER_REV   3200    // 16细分，与Motor.c一致
+#define STEP_PULSES_PER_DEG   (STEP_PULSES_PER_REV / 360.0f)
+
+// DIR电平：正角度（Motor.c中的DIR_CW）为高
+#define STEP_DIR_LEVEL_POS    GPIO_PIN_SET
+#define STEP_DIR_LEVEL_NEG    GPIO_PIN_RESET
+
+// DMA突发：从ARR(0x2C)开始连续5个寄存器
+#define STEP_DMA_BURST        5U
+#define STEP_DMA_BASE         (0x2CU / 4U)
+
+typedef struct {
+    TIM_TypeDef *tim;
+    DMA_HandleTypeDef *hdma;
+    GPIO_TypeDef *dir_port;
+    uint16_t dir_pin;
+    uint8_t channel;            // STEP输出通道
+    StepGen gen;
+    float remainder;            // 不足一个脉冲的部分（脉冲）
+    volatile uint32_t underruns;
+} StepAxis;
+
+static StepAxis axis_h = { TIM1, &hdma_tim1_up, STEP_DIR_H_GPIO_Port, STEP_DIR_H_Pin, 1 };
+static StepAxis axis_v = { TIM8, &hdma_tim8_up, STEP_DIR_V_GPIO_Port, STEP_DIR_V_Pin, 3 };
+static uint8_t step_initialized = 0;
+
+// ==================== 内部函数 ====================
+
+static StepAxis *MotorStep_Axis(uint8_t motor_id)
+{
+    return (motor_id == MOTOR_ID_HORIZONTAL) ? &axis_h : &axis_v;
+}
+
+static StepAxis *MotorStep_AxisOfDma(DMA_HandleTypeDef *hdma)
+{
+    return (hdma == &hdma_tim1_up) ? &axis_h : &axis_v;
+}
+
+/**
+ * @brief  一块缓冲区取完：检查欠载、切换DIR、重填
+ * @param  a: 轴
+ * @param  done: 取完的缓冲区
+ */
+static void MotorStep_BufferDone(StepAxis *a, uint32_t done)
+{
+    // 正常情况下DMA此时正在使用另一块（CT指向done^1）
+    uint32_t current = (a->hdma->Instance->CR & DMA_SxCR_CT) ? 1U : 0U;
+    if (current == done) a->underruns++;
+
+    int8_t dir = StepGen_OnBufferDone(&a->gen, done);
+    if (dir != 0)
+    {
+        HAL_GPIO_WritePin(a->dir_port, a->dir_pin, (dir > 0) ? STEP_DIR_LEVEL_POS : STEP_DIR_LEVEL_NEG);
+    }
+}
+
+static void MotorStep_M0Done(DMA_HandleTypeDef *hdma)
+{
+    MotorStep_BufferDone(MotorStep_AxisOfDma(hdma), 0);
+}
+
+static void MotorStep_M1Done(DMA_HandleTypeDef *hdma)
+{
+    MotorStep_BufferDone(MotorStep_AxisOfDma(hdma), 1);
+}
+
+/**
+ * @brief  DMA错误：停止定时器（否则会一直重复最后一段的脉冲）
+ */
+static void MotorStep_DmaError(DMA_HandleTypeDef *hdma)
+{
+    StepAxis *a = MotorStep_AxisOfDma(hdma);
+
+    a->tim->CR1 &= ~TIM_CR1_CEN;
+    a->tim->CCER = 0;
+    a->underruns++;
+}
+
+/**
+ * @brief  设置DMA回调（通道已由MX_TIMx_Init配置为存储器→TIMx_DMAR，半字，循环）
+ */
+static void MotorStep_DmaInit(DMA_HandleTypeDef *hdma)
+{
+    hdma->XferCpltCallback = MotorStep_M0Done;
+    hdma->XferM1CpltCallback = MotorStep_M1Done;
+    hdma->XferErrorCallback = MotorStep_DmaError;
+}
+
+/**
+ * @brief  配置定时器并启动一个轴
+ * @param  a: 轴
+ * @param  timer_clk: 定时器输入时钟(Hz)
+ */
+static void MotorStep_AxisStart(StepAxis *a, uint32_t timer_clk)
+{
+    TIM_TypeDef *tim = a->tim;
+    StepGenConfig cfg;
+
+    cfg.tick_hz = MOTOR_STEP_TICK_HZ;
+    cfg.pulse_ticks = MOTOR_STEP_TICK_HZ / 1000000U * MOTOR_STEP_PULSE_US;
+    cfg.channel = a->channel;
+    cfg.max_pps = MOTOR_STEP_MAX_RPM / 60.0f * STEP_PULSES_PER_REV;
+    cfg.accel_pps2 = MOTOR_STEP_ACCEL_DEG_S2 * STEP_PULSES_PER_DEG;
+    StepGen_Init(&a->gen, &cfg);
+    a->remainder = 0.0f;
+
+    // PWM1，CCR=0时无输出；先以空闲段启动
+    tim->CR1 = TIM_CR1_ARPE;
+    tim->PSC = timer_clk / MOTOR_STEP_TICK_HZ - 1U;
+    tim->ARR = a->gen.segment_ticks - 1U;
+    tim->RCR = 0;
+    tim->CCR1 = 0;
+    tim->CCR2 = 0;
+    tim->CCR3 = 0;
+    if (a->channel == 1)
+    {
+        tim->CCMR1 = TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE;
+        tim->CCER = TIM_CCER_CC1E;
+    }
+    else
+    {
+        tim->CCMR2 = TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1 | TIM_CCMR2_OC3PE;
+        tim->CCER = TIM_CCER_CC3E;
+    }
+    tim->BDTR = TIM_BDTR_MOE;
+    tim->DCR = ((STEP_DMA_BURST - 1U) << TIM_DCR_DBL_Pos) | STEP_DMA_BASE;
+    tim->EGR = TIM_EGR_UG;
+    tim->SR = 0;
+
+    if (HAL_DMAEx_MultiBufferStart_IT(a->hdma, (uint32_t)a->gen.buf[0], (uint32_t)&tim->DMAR,
+                                      (uint32_t)a->gen.buf[1], STEPGEN_BUF_SEGMENTS * STEP_DMA_BURST) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    tim->DIER = TIM_DIER_UDE;
+    tim->CR1 |= TIM_CR1_CEN;
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  开始输出空闲段
+ * @retval None
+ * @note   自检和Gimbal_Init都会调用Motor_Init，只在第一次初始化，避免打断正在输出的脉冲
+ */
+void MotorStep_Init(void)
+{
+    uint32_t timer_clk;
+
+    if (step_initialized) return;
+    step_initialized = 1;
+
+    MotorStep_DmaInit(&hdma_tim1_up);
+    MotorStep_DmaInit(&hdma_tim8_up);
+
+    // TIM1/TIM8在APB2，APB2分频不为1时定时器时钟为PCLK2×2
+    timer_clk = HAL_RCC_GetPCLK2Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1) timer_clk *= 2U;
+
+    MotorStep_AxisStart(&axis_h, timer_clk);
+    MotorStep_AxisStart(&axis_v, timer_clk);
+}
+
+/**
+ * @brief  相对移动
+ * @param  motor_id: 电机ID
+ * @param  angle: 角度（度）
+ * @retval None
+ */
+void MotorStep_Move(uint8_t motor_id, float angle)
+{
+    StepAxis *a = MotorStep_Axis(motor_id);
+    float p = angle * STEP_PULSES_PER_DEG + a->remainder;
+    int32_t pulses = (int32_t)p;
+
+    a->remainder = p - (float)pulses;
+    if (pulses != 0) StepGen_Move(&a->gen, pulses);
+}
+
+/**
+ * @brief  立即停止
+ * @param  motor_id: 电机ID
+ * @retval None
+ */
+void MotorStep_Stop(uint8_t motor_id)
+{
+    StepAxis *a = MotorStep_Axis(motor_id);
+
+    StepGen_Stop(&a->gen);
+    a->remainder = 0.0f;
+}
+
+/**
+ * @brief  按减速曲线停下
+ * @param  motor_id: 电机ID
+ * @retval None
+ */
+void MotorStep_Decelerate(uint8_t motor_id)
+{
+    StepAxis *a = MotorStep_Axis(motor_id);
+
+    StepGen_Decelerate(&a->gen);
+    a->remainder = 0.0f;
+}
+
+/**
+ * @brief  读取已输出的位置
+ * @param  motor_id: 电机ID
+ * @retval 累计角度（度）
+ */
+float MotorStep_GetPosition(uint8_t motor_id)
+{
+    return MotorStep_Axis(motor_id)->gen.position / STEP_PULSES_PER_DEG;
+}
+
+/**
+ * @brief  是否正在运动
+ * @param  motor_id: 电机ID
+ * @retval 1=未到达目标, 0=静止
+ */
+uint8_t MotorStep_IsMoving(uint8_t motor_id)
+{
+    StepAxis *a = MotorStep_Axis(motor_id);
+
+    return (a->gen.target != a->gen.position || a->gen.velocity != 0.0f) ? 1 : 0;
+}
+
+/**
+ * @brief  DMA欠载次数
+ * @param  motor_id: 电机ID
+ * @retval 次数
+ */
+uint32_t MotorStep_GetUnderruns(uint8_t motor_id)
+{
+    return MotorStep_Axis(motor_id)->underruns;
+}
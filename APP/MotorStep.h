@@ -0,0 +1,78 @@
+/**
+ * @file    MotorStep.h
+ * @brief   STEP/DIR脉冲输出头文件
+ * @details 驱动的脉冲端口（闭环FOC模式，见MotorConfig参数表pulse=2）由定时器直接输出脉冲，
+ *          运动命令不经过串口，串口只用于参数配置和位置读取：
+ *          - 水平轴(ID=2): TIM1_CH1 PA8=STEP, PB0=DIR, DMA2_Stream5(TIM1_UP)
+ *          - 垂直轴(ID=1): TIM8_CH3 PC8=STEP, PB1=DIR, DMA2_Stream1(TIM8_UP)
+ *          定时器计数8MHz，每次更新事件DMA突发写入下一段的ARR/RCR/CCR（StepGen规划），
+ *          一段内用重复计数器连续发出n个等间隔脉冲；空闲时定时器照常运行，输出空闲段
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _MOTOR_STEP_H
+#define _MOTOR_STEP_H
+
+#include "stm32f4xx_hal.h"
+
+#define MOTOR_STEP_TICK_HZ       8000000U   ///< 定时器计数频率(Hz)
+#define MOTOR_STEP_PULSE_US      2          ///< STEP高电平宽度(us)
+#define MOTOR_STEP_MAX_RPM       1200.0f    ///< 最高转速（与串口位置模式一致）
+#define MOTOR_STEP_ACCEL_DEG_S2  2000.0f     ///< 加速度(度/s^2)，脉冲模式下驱动不再加曲线，只受此限制
+
+/**
+ * @brief  开始输出空闲段
+ * @retval None
+ * @note   在Motor_Init中调用；引脚、定时器、DMA和中断优先级（4，高于串口，不调用RTOS接口）
+ *         在PTU.ioc中配置，由CubeMX生成的初始化代码在main中完成
+ */
+void MotorStep_Init(void);
+
+/**
+ * @brief  相对移动
+ * @param  motor_id: 电机ID
+ * @param  angle: 角度（度，正方向与Motor_MoveHorizontal/Vertical一致）
+ * @retval None
+ * @note   不足一个脉冲的部分累计到下次，长期位置无舍入误差
+ */
+void MotorStep_Move(uint8_t motor_id, float angle);
+
+/**
+ * @brief  立即停止（丢弃未走完的行程）
+ * @param  motor_id: 电机ID
+ * @retval None
+ */
+void MotorStep_Stop(uint8_t motor_id);
+
+/**
+ * @brief  按减速曲线停下（丢弃未走完的行程）
+ * @param  motor_id: 电机ID
+ * @retval None
+ * @note   从当前速度按加速度限制减到零，多走的行程计入位置；静止时与MotorStep_Stop相同
+ */
+void MotorStep_Decelerate(uint8_t motor_id);
+
+/**
+ * @brief  读取已输出的位置
+ * @param  motor_id: 电机ID
+ * @retval 自初始化以来的累计角度（度），由脉冲计数换算
+ * @note   计入已写入DMA缓冲区的脉冲，实际输出最多滞后两块缓冲区（约1ms）
+ */
+float MotorStep_GetPosition(uint8_t motor_id);
+
+/**
+ * @brief  是否正在运动
+ * @param  motor_id: 电机ID
+ * @retval 1=未到达目标, 0=静止
+ */
+uint8_t MotorStep_IsMoving(uint8_t motor_id);
+
+/**
+ * @brief  DMA欠载次数
+ * @param  motor_id: 电机ID
+ * @retval 重填不及时（或DMA错误）的次数，非0时位置计数不再准确
+ */
+uint32_t MotorStep_GetUnderruns(uint8_t motor_id);
+
+#endif
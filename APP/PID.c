@@ -2,6 +2,7 @@
  * @file    PID.c
  * @brief   PID控制器实现
  * @details 标准PID算法实现，包含死区处理、积分限幅和输出限幅
+ *          积分按误差×dt累积，微分按误差变化/dt计算，改变采样周期不影响整定结果
  * @version 1.0
  * @date    2026-02-25
  */
@@ -9,6 +10,16 @@
 #include "PID.h"
 #include <math.h>
 
+/**
+ * @brief  根据采样周期和时间常数计算微分低通系数
+ * @param  pid: PID控制器指针
+ * @retval None
+ */
+static void PID_UpdateCoefficients(PID_Controller *pid)
+{
+    pid->d_alpha = pid->dt / (pid->d_filter_tau + pid->dt);
+}
+
 /**
  * @brief  初始化PID控制器
  * @param  pid: PID控制器指针
@@ -27,10 +38,17 @@ void PID_Init(PID_Controller *pid, float kp, float ki, float kd)
     pid->last_error = 0.0f;
     pid->integral = 0.0f;
     pid->derivative = 0.0f;
+    pid->bump = 0.0f;
+    
+    pid->dt = PID_DEFAULT_DT;
+    pid->d_filter_tau = 0.0f;    // 默认不滤波
+    PID_UpdateCoefficients(pid);
     
-    pid->integral_max = 100.0f;  // 积分限幅，防止积分饱和
+    pid->integral_max = 2.0f;    // 积分限幅（像素·秒，等于原50Hz下累加100），防止积分饱和
     pid->output_max = 200.0f;    // 输出限幅
     pid->deadzone = 8;           // 死区8像素，避免微小抖动
+    pid->gain_scale = 1.0f;
+    pid->deadzone_scale = 1.0f;
 }
 
 /**
@@ -43,7 +61,7 @@ void PID_Init(PID_Controller *pid, float kp, float ki, float kd)
 float PID_Calculate(PID_Controller *pid, float error)
 {
     // 死区处理
-    if (fabsf(error) < pid->deadzone) {
+    if (fabsf(error) < pid->deadzone * pid->deadzone_scale) {
         PID_Reset(pid);
         return 0.0f;
     }
@@ -51,20 +69,25 @@ float PID_Calculate(PID_Controller *pid, float error)
     pid->error = error;
     
     // 积分项（带限幅防止积分饱和）
-    pid->integral += error;
+    pid->integral += error * pid->dt;
     if (pid->integral > pid->integral_max) {
         pid->integral = pid->integral_max;
     } else if (pid->integral < -pid->integral_max) {
         pid->integral = -pid->integral_max;
     }
     
-    // 微分项
-    pid->derivative = error - pid->last_error;
+    // 微分项（一阶低通）
+    float raw_derivative = (error - pid->last_error) / pid->dt;
+    pid->derivative += pid->d_alpha * (raw_derivative - pid->derivative);
     
     // PID输出
-    float output = pid->kp * error + 
-                   pid->ki * pid->integral + 
-                   pid->kd * pid->derivative;
+    float output = (pid->kp * error + 
+                    pid->ki * pid->integral + 
+                    pid->kd * pid->derivative) * pid->gain_scale;
+    
+    // 切换参数时的输出差值，按PID_BUMPLESS_TAU衰减
+    output += pid->bump;
+    pid->bump -= pid->bump * pid->dt / (PID_BUMPLESS_TAU + pid->dt);
     
     // 输出限幅
     if (output > pid->output_max) {
@@ -90,14 +113,15 @@ void PID_Reset(PID_Controller *pid)
     pid->last_error = 0.0f;
     pid->integral = 0.0f;
     pid->derivative = 0.0f;
+    pid->bump = 0.0f;
 }
 
 /**
  * @brief  设置PID参数
  * @param  pid: PID控制器指针
  * @param  kp: 比例系数
- * @param  ki: 积分系数
- * @param  kd: 微分系数
+ * @param  ki: 积分系数（1/s）
+ * @param  kd: 微分系数（s）
  * @retval None
  */
 void PID_SetParams(PID_Controller *pid, float kp, float ki, float kd)
@@ -106,3 +130,79 @@ void PID_SetParams(PID_Controller *pid, float kp, float ki, float kd)
     pid->ki = ki;
     pid->kd = kd;
 }
+
+/**
+ * @brief  设置采样周期并重新离散化
+ * @param  pid: PID控制器指针
+ * @param  dt: 采样周期(s)
+ * @retval None
+ * @note   积分和微分状态按连续时间单位保存，切换周期时无需清零
+ */
+void PID_SetSampleTime(PID_Controller *pid, float dt)
+{
+    if (dt <= 0.0f) return;
+    
+    pid->dt = dt;
+    PID_UpdateCoefficients(pid);
+}
+
+/**
+ * @brief  设置微分低通滤波时间常数
+ * @param  pid: PID控制器指针
+ * @param  tau: 时间常数(s)，0=不滤波
+ * @retval None
+ */
+void PID_SetDerivativeFilter(PID_Controller *pid, float tau)
+{
+    if (tau < 0.0f) tau = 0.0f;
+    
+    pid->d_filter_tau = tau;
+    PID_UpdateCoefficients(pid);
+}
+
+/**
+ * @brief  无扰切换PID参数
+ * @param  pid: PID控制器指针
+ * @param  kp: 比例系数
+ * @param  ki: 积分系数（1/s）
+ * @param  kd: 微分系数（s）
+ * @retval None
+ * @note   按切换前的误差和微分状态，新参数下的输出与切换前相同：
+ *         先调整积分项吸收差值（ki>0时，受积分限幅约束），剩余差值逐步衰减
+ */
+void PID_SetParamsBumpless(PID_Controller *pid, float kp, float ki, float kd)
+{
+    float g = pid->gain_scale;
+    float before = (pid->kp * pid->last_error + pid->ki * pid->integral +
+                    pid->kd * pid->derivative) * g + pid->bump;
+    float after = (kp * pid->last_error + kd * pid->derivative) * g;
+    
+    if (ki > 0.0f && g > 0.0f) {
+        float integral = (before - after) / (ki * g);
+        if (integral > pid->integral_max) {
+            integral = pid->integral_max;
+        } else if (integral < -pid->integral_max) {
+            integral = -pid->integral_max;
+        }
+        pid->integral = integral;
+        after += ki * integral * g;
+    }
+    
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    pid->bump = before - after;
+}
+
+/**
+ * @brief  设置增益/死区调度倍率
+ * @param  pid: PID控制器指针
+ * @param  gain_scale: 输出倍率
+ * @param  deadzone_scale: 死区倍率
+ * @retval None
+ */
+void PID_SetSchedule(PID_Controller *pid, float gain_scale, float deadzone_scale)
+{
+    pid->gain_scale = gain_scale;
+    pid->deadzone_scale = deadzone_scale;
+}
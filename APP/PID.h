@@ -2,6 +2,7 @@
  * @file    PID.h
  * @brief   PID控制器头文件
  * @details 实现标准PID控制算法，支持死区、积分限幅和输出限幅
+ *          增益按连续时间单位给出（Ki: 1/s，Kd: s），由采样周期自动离散化
  * @version 1.0
  * @date    2026-02-25
  */
@@ -11,23 +12,34 @@
 
 #include <stdint.h>
 
+#define PID_DEFAULT_DT    0.02f   ///< 默认采样周期(s)，对应50Hz
+#define PID_BUMPLESS_TAU  0.3f    ///< 无扰切换残余输出的衰减时间常数(s)
+
 /**
  * @brief PID控制器结构体
  */
 typedef struct {
     float kp;           ///< 比例系数
-    float ki;           ///< 积分系数
-    float kd;           ///< 微分系数
+    float ki;           ///< 积分系数（1/s）
+    float kd;           ///< 微分系数（s）
+    
+    float dt;           ///< 采样周期(s)
+    float d_filter_tau; ///< 微分低通时间常数(s)，0=不滤波
+    float d_alpha;      ///< 微分低通离散系数（由dt和d_filter_tau计算）
     
     float error;        ///< 当前误差
     float last_error;   ///< 上次误差
-    float integral;     ///< 积分累积
-    float derivative;   ///< 微分项
+    float integral;     ///< 积分累积（误差×秒）
+    float derivative;   ///< 微分项（误差/秒，已滤波）
+    float bump;         ///< 无扰切换残余输出（逐步衰减到0）
     
     float integral_max; ///< 积分限幅（防止积分饱和）
     float output_max;   ///< 输出限幅
     
     uint8_t deadzone;   ///< 死区（像素），小于此值不响应
+    
+    float gain_scale;     ///< 增益调度倍率（作用于P/I/D输出之和），默认1
+    float deadzone_scale; ///< 死区调度倍率，默认1
 } PID_Controller;
 
 /**
@@ -59,10 +71,47 @@ void PID_Reset(PID_Controller *pid);
  * @brief  设置PID参数
  * @param  pid: PID控制器指针
  * @param  kp: 比例系数
- * @param  ki: 积分系数
- * @param  kd: 微分系数
+ * @param  ki: 积分系数（1/s）
+ * @param  kd: 微分系数（s）
  * @retval None
  */
 void PID_SetParams(PID_Controller *pid, float kp, float ki, float kd);
 
+/**
+ * @brief  设置采样周期并重新离散化
+ * @param  pid: PID控制器指针
+ * @param  dt: 采样周期(s)
+ * @retval None
+ */
+void PID_SetSampleTime(PID_Controller *pid, float dt);
+
+/**
+ * @brief  设置微分低通滤波时间常数
+ * @param  pid: PID控制器指针
+ * @param  tau: 时间常数(s)，0=不滤波
+ * @retval None
+ */
+void PID_SetDerivativeFilter(PID_Controller *pid, float tau);
+
+/**
+ * @brief  无扰切换PID参数
+ * @param  pid: PID控制器指针
+ * @param  kp: 比例系数
+ * @param  ki: 积分系数（1/s）
+ * @param  kd: 微分系数（s）
+ * @retval None
+ * @note   切换瞬间输出不跳变：积分项吸收差值，剩余部分按PID_BUMPLESS_TAU衰减
+ */
+void PID_SetParamsBumpless(PID_Controller *pid, float kp, float ki, float kd);
+
+/**
+ * @brief  设置增益/死区调度倍率
+ * @param  pid: PID控制器指针
+ * @param  gain_scale: 输出倍率
+ * @param  deadzone_scale: 死区倍率
+ * @retval None
+ * @note   由控制任务按目标运动状态（IMM模型概率）每次测量前设置，不改变整定的基准参数
+ */
+void PID_SetSchedule(PID_Controller *pid, float gain_scale, float deadzone_scale);
+
 #endif
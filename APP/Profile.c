@@ -0,0 +1,506 @@
+/**
+ * @file    Profile.c
+ * @brief   控制器参数档案实现
+ * @details 档案表（8个档案+上电档案+自动切换开关+电机驱动参数表，共508字节）整体追加写入扇区9：
+ *          - 上电扫描：最后一份校验正确的档案表为当前内容；写到一半断电的档案表校验不符，保留上一份
+ *          - 修改后写入下一个空位，约250次修改后扇区写满，下次修改时擦除（需先disable）；
+ *            擦除前占用电机总线到擦除结束，期间enable被拒绝
+ *          - 自动切换：当前档案的距离区间放宽10%后仍包含距离估计时保持，否则选第一个包含它的档案
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "Profile.h"
+#include "FlashStore.h"
+#include "GimbalControl.h"
+#include "Journal.h"
+#include "Cue.h"
+#include "SerialDebug.h"
+#include "cmsis_os.h"
+#include <string.h>
+
+// ==================== 参数 ====================
+
+#define PROFILE_MAGIC          0x32465250U   // "PRF2"（含驱动参数表）
+#define PROFILE_NONE           0xFF
+#define PROFILE_AUTO_PERIOD_MS 200           // 自动切换检查周期
+#define PROFILE_RANGE_HYST     0.1f          // 当前档案区间放宽比例（避免在边界来回切换）
+
+/**
+ * @brief 单个档案
+ */
+typedef struct {
+    char name[PROFILE_NAME_LEN];   ///< 名称，空字符串=空位
+    GimbalConfig config;           ///< 控制器配置
+    float range_min;               ///< 自动切换距离区间(m)
+    float range_max;               ///< max=0表示不参与自动切换
+} ProfileEntry;
+
+/**
+ * @brief Flash中的档案表（按字写入，校验字最后写入）
+ */
+typedef struct {
+    uint32_t magic;                     ///< PROFILE_MAGIC
+    uint8_t boot_index;                 ///< 上电档案，PROFILE_NONE=固件默认参数
+    uint8_t auto_enabled;               ///< 上电时自动切换开关
+    uint16_t reserved;
+    ProfileEntry entries[PROFILE_MAX];
+    MotorDriverTable drivers;           ///< 电机驱动参数表
+    uint8_t drivers_valid;              ///< 1=drivers已保存
+    uint8_t reserved2;
+    uint16_t check;                     ///< 之前所有字节的CRC16
+} ProfileTable;
+
+#define PROFILE_SLOTS  (FLASH_STORE_AREA_SIZE / sizeof(ProfileTable))
+
+/**
+ * @brief 请求类型
+ */
+typedef enum {
+    PROFILE_OP_NONE = 0,
+    PROFILE_OP_LIST,
+    PROFILE_OP_USE,
+    PROFILE_OP_SAVE,
+    PROFILE_OP_DELETE,
+    PROFILE_OP_RANGE,
+    PROFILE_OP_AUTO,
+    PROFILE_OP_BOOT
+} ProfileOp;
+
+// 档案表（默认任务）
+static ProfileTable profile_table;
+static uint32_t next_slot = 0;            // 下一个写入位置，PROFILE_SLOTS=已满
+static uint8_t active_index = PROFILE_NONE;
+static uint8_t auto_enabled = 0;
+static uint32_t auto_tick = 0;
+
+// 挂起的请求（串口命令写入，默认任务执行）
+static volatile uint8_t request_op = PROFILE_OP_NONE;
+static char request_name[PROFILE_NAME_LEN];
+static float request_a = 0.0f;
+static float request_b = 0.0f;
+
+// ==================== 内部函数 ====================
+
+static const ProfileTable *Profile_Slot(uint32_t slot)
+{
+    return (const ProfileTable *)(FlashStore_Base(FLASH_STORE_PROFILES) + slot * sizeof(ProfileTable));
+}
+
+static uint16_t Profile_Check(const ProfileTable *t)
+{
+    return FlashStore_Crc16((const uint8_t *)t, sizeof(ProfileTable) - 2U);
+}
+
+/**
+ * @brief  检查名称：1~11个字母、数字、'_'、'-'
+ */
+static uint8_t Profile_IsValidName(const char *name)
+{
+    uint32_t len = strlen(name);
+
+    if (len == 0 || len >= PROFILE_NAME_LEN) return 0;
+    for (uint32_t i = 0; i < len; i++) {
+        char c = name[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+              c == '_' || c == '-')) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief  按名称查找档案
+ * @retval 序号，PROFILE_NONE=不存在
+ */
+static uint8_t Profile_Find(const char *name)
+{
+    for (uint8_t i = 0; i < PROFILE_MAX; i++) {
+        if (profile_table.entries[i].name[0] != '\0' &&
+            strncmp(profile_table.entries[i].name, name, PROFILE_NAME_LEN) == 0) {
+            return i;
+        }
+    }
+    return PROFILE_NONE;
+}
+
+/**
+ * @brief  读取Flash中最后一份有效的档案表
+ * @retval None
+ */
+void Profile_Load(void)
+{
+    const ProfileTable *latest = NULL;
+    uint32_t slot;
+
+    for (slot = 0; slot < PROFILE_SLOTS; slot++) {
+        const ProfileTable *t = Profile_Slot(slot);
+        const uint32_t *w = (const uint32_t *)t;
+        uint8_t erased = 1;
+
+        for (uint32_t i = 0; i < sizeof(ProfileTable) / 4U; i++) {
+            if (w[i] != 0xFFFFFFFFU) {
+                erased = 0;
+                break;
+            }
+        }
+        if (erased) break;
+        if (t->magic == PROFILE_MAGIC && t->check == Profile_Check(t)) latest = t;
+    }
+    next_slot = slot;
+
+    if (latest != NULL) {
+        profile_table = *latest;
+        if (profile_table.drivers_valid == 1) MotorConfig_LoadTable(&profile_table.drivers);
+    } else {
+        memset(&profile_table, 0, sizeof(profile_table));
+        profile_table.magic = PROFILE_MAGIC;
+        profile_table.boot_index = PROFILE_NONE;
+    }
+}
+
+/**
+ * @brief  检查是否可以写入（扇区写满时需要擦除，擦除要求控制已停止）
+ * @retval 1=可以写入（之后必须调用Profile_Store）, 0=不能写入（已输出错误信息）
+ * @note   需要擦除时在这里占用电机总线（与enable互斥的原子检查），Profile_Store擦除后释放
+ */
+static uint8_t Profile_CanStore(void)
+{
+    if (next_slot < PROFILE_SLOTS) return 1;
+    if (!Gimbal_ClaimMotorBus()) {
+        SerialDebug_Printf(Gimbal_IsEnabled()
+                           ? "Error: Profile area full, run 'disable' first (flash erase stalls the CPU)\r\n"
+                           : "Error: Profile area full, motor bus busy (background job running)\r\n");
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief  档案表写入Flash
+ * @retval 1=成功, 0=失败
+ */
+static uint8_t Profile_Store(void)
+{
+    if (next_slot >= PROFILE_SLOTS) {
+        SerialDebug_Printf("Profile: erasing...\r\n");
+        osDelay(20);   // 等待提示发完（擦除期间串口中断停顿）
+        uint8_t erased = FlashStore_Erase(FLASH_STORE_PROFILES);
+        Gimbal_ReleaseMotorBus();   // Profile_CanStore中占用
+        if (!erased) {
+            SerialDebug_Printf("Error: Profile erase FAILED\r\n");
+            return 0;
+        }
+        next_slot = 0;
+    }
+
+    profile_table.magic = PROFILE_MAGIC;
+    profile_table.check = Profile_Check(&profile_table);
+    uint8_t ok = FlashStore_Program(FLASH_STORE_PROFILES, next_slot * sizeof(ProfileTable),
+                                    (const uint32_t *)&profile_table, sizeof(ProfileTable) / 4U);
+    next_slot++;   // 失败时该位置已部分写入，同样跳过
+    if (!ok) SerialDebug_Printf("Error: Profile write FAILED\r\n");
+    return ok;
+}
+
+/**
+ * @brief  切换到指定档案
+ * @param  index: 档案序号
+ * @param  automatic: 1=自动切换
+ * @retval None
+ */
+static void Profile_Activate(uint8_t index, uint8_t automatic)
+{
+    if (!Gimbal_RequestConfig(&profile_table.entries[index].config)) {
+        SerialDebug_Printf("Error: Profile '%s' has invalid parameters\r\n", profile_table.entries[index].name);
+        return;
+    }
+    active_index = index;
+    Journal_Log(JOURNAL_EV_PROFILE, index, automatic);
+}
+
+/**
+ * @brief  输出档案列表
+ * @retval None
+ */
+static void Profile_PrintList(void)
+{
+    const char *boot = (profile_table.boot_index < PROFILE_MAX) ?
+                       profile_table.entries[profile_table.boot_index].name : "-";
+
+    SerialDebug_Printf("Profiles: active %s, boot %s, auto %s (range %.1f m), %lu/%lu writes left\r\n",
+                       Profile_GetActiveName(), boot, auto_enabled ? "ON" : "OFF", Cue_GetRange(),
+                       (unsigned long)(PROFILE_SLOTS - next_slot), (unsigned long)PROFILE_SLOTS);
+
+    for (uint8_t i = 0; i < PROFILE_MAX; i++) {
+        const ProfileEntry *e = &profile_table.entries[i];
+        const GimbalConfig *c = &e->config;
+        if (e->name[0] == '\0') continue;
+
+        SerialDebug_Printf("%c %-11s Kp %.1f/%.1f Ki %.3f/%.3f Kd %.3f/%.3f dz %u filt %.0f ms %u rpm",
+                           (i == active_index) ? '*' : ' ', e->name,
+                           c->kp[GIMBAL_AXIS_H], c->kp[GIMBAL_AXIS_V], c->ki[GIMBAL_AXIS_H], c->ki[GIMBAL_AXIS_V],
+                           c->kd[GIMBAL_AXIS_H], c->kd[GIMBAL_AXIS_V], c->deadzone,
+                           c->d_filter_tau * 1000.0f, c->motor_rpm);
+        if (e->range_max > 0.0f) {
+            SerialDebug_Printf(" range %.0f-%.0f m\r\n", e->range_min, e->range_max);
+        } else {
+            SerialDebug_Printf("\r\n");
+        }
+    }
+}
+
+/**
+ * @brief  执行挂起的请求
+ * @param  op: 请求类型
+ * @retval None
+ */
+static void Profile_Execute(ProfileOp op)
+{
+    uint8_t index = Profile_Find(request_name);
+
+    if (op == PROFILE_OP_LIST) {
+        Profile_PrintList();
+        return;
+    }
+
+    // 需要已有档案的请求
+    if ((op == PROFILE_OP_USE || op == PROFILE_OP_DELETE || op == PROFILE_OP_RANGE ||
+         (op == PROFILE_OP_BOOT && request_name[0] != '\0')) && index == PROFILE_NONE) {
+        SerialDebug_Printf("Error: No profile named '%s'\r\n", request_name);
+        return;
+    }
+
+    if (op == PROFILE_OP_USE) {
+        Profile_Activate(index, 0);
+        if (auto_enabled) {
+            auto_enabled = 0;
+            SerialDebug_Printf("Profile: %s (auto switching paused, 'profile auto on' to resume)\r\n", request_name);
+        } else {
+            SerialDebug_Printf("Profile: %s\r\n", request_name);
+        }
+        return;
+    }
+
+    if (op == PROFILE_OP_SAVE && index == PROFILE_NONE) {
+        for (index = 0; index < PROFILE_MAX && profile_table.entries[index].name[0] != '\0'; index++) {
+        }
+        if (index == PROFILE_MAX) {
+            SerialDebug_Printf("Error: All %d profiles in use, delete one first\r\n", PROFILE_MAX);
+            return;
+        }
+    }
+
+    // 通过检查后必须写入（需要擦除时已占用电机总线，由Profile_Store释放）
+    if (!Profile_CanStore()) return;
+
+    switch (op) {
+    case PROFILE_OP_SAVE:
+        if (profile_table.entries[index].name[0] == '\0') {
+            memset(&profile_table.entries[index], 0, sizeof(ProfileEntry));
+            strncpy(profile_table.entries[index].name, request_name, PROFILE_NAME_LEN - 1);
+        }
+        Gimbal_GetConfig(&profile_table.entries[index].config);
+        active_index = index;
+        break;
+    case PROFILE_OP_DELETE:
+        memset(&profile_table.entries[index], 0, sizeof(ProfileEntry));
+        if (active_index == index) active_index = PROFILE_NONE;   // 当前参数保持不变
+        if (profile_table.boot_index == index) profile_table.boot_index = PROFILE_NONE;
+        break;
+    case PROFILE_OP_RANGE:
+        profile_table.entries[index].range_min = request_a;
+        profile_table.entries[index].range_max = request_b;
+        break;
+    case PROFILE_OP_AUTO:
+        auto_enabled = (request_a != 0.0f);
+        profile_table.auto_enabled = auto_enabled;
+        auto_tick = HAL_GetTick() - PROFILE_AUTO_PERIOD_MS;   // 立即检查一次
+        break;
+    case PROFILE_OP_BOOT:
+        profile_table.boot_index = index;
+        break;
+    default:
+        break;   // LIST/USE已在前面返回
+    }
+
+    if (Profile_Store()) SerialDebug_Printf("Profile saved\r\n");
+}
+
+/**
+ * @brief  按距离估计自动选择档案
+ * @retval None
+ */
+static void Profile_AutoSelect(void)
+{
+    float range = Cue_GetRange();
+
+    if (active_index < PROFILE_MAX) {
+        const ProfileEntry *e = &profile_table.entries[active_index];
+        if (e->range_max > 0.0f &&
+            range >= e->range_min * (1.0f - PROFILE_RANGE_HYST) && range <= e->range_max * (1.0f + PROFILE_RANGE_HYST)) {
+            return;
+        }
+    }
+
+    for (uint8_t i = 0; i < PROFILE_MAX; i++) {
+        const ProfileEntry *e = &profile_table.entries[i];
+        if (e->name[0] != '\0' && e->range_max > 0.0f && range >= e->range_min && range <= e->range_max) {
+            if (i != active_index) {
+                Profile_Activate(i, 1);
+                SerialDebug_Printf("Profile: %s (auto, range %.1f m)\r\n", e->name, range);
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief  提交请求
+ * @retval 1=已受理, 0=上一个请求未完成
+ */
+static uint8_t Profile_Submit(ProfileOp op, const char *name, float a, float b)
+{
+    if (request_op != PROFILE_OP_NONE) return 0;
+
+    memset(request_name, 0, sizeof(request_name));
+    if (name != NULL) strncpy(request_name, name, PROFILE_NAME_LEN - 1);
+    request_a = a;
+    request_b = b;
+    request_op = op;
+    return 1;
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  初始化参数档案
+ * @retval None
+ */
+void Profile_Init(void)
+{
+    auto_enabled = profile_table.auto_enabled;
+    active_index = PROFILE_NONE;
+
+    if (profile_table.boot_index < PROFILE_MAX && profile_table.entries[profile_table.boot_index].name[0] != '\0') {
+        Profile_Activate(profile_table.boot_index, 0);
+        SerialDebug_Printf("Profile: %s (boot)\r\n", profile_table.entries[active_index].name);
+    }
+    auto_tick = HAL_GetTick();
+}
+
+/**
+ * @brief  保存电机驱动参数表
+ * @param  table: 参数表
+ * @retval 1=成功, 0=失败
+ */
+uint8_t Profile_StoreDriverTable(const MotorDriverTable *table)
+{
+    if (!Profile_CanStore()) return 0;
+
+    profile_table.drivers = *table;
+    profile_table.drivers_valid = 1;
+    return Profile_Store();
+}
+
+/**
+ * @brief  提交列表请求
+ * @retval 1=已受理, 0=上一个请求未完成
+ */
+uint8_t Profile_RequestList(void)
+{
+    return Profile_Submit(PROFILE_OP_LIST, NULL, 0.0f, 0.0f);
+}
+
+/**
+ * @brief  提交切换请求
+ * @param  name: 档案名称
+ * @retval 1=已受理, 0=名称无效或上一个请求未完成
+ */
+uint8_t Profile_RequestUse(const char *name)
+{
+    return Profile_IsValidName(name) && Profile_Submit(PROFILE_OP_USE, name, 0.0f, 0.0f);
+}
+
+/**
+ * @brief  提交保存请求
+ * @param  name: 档案名称
+ * @retval 1=已受理, 0=名称无效或上一个请求未完成
+ */
+uint8_t Profile_RequestSave(const char *name)
+{
+    return Profile_IsValidName(name) && Profile_Submit(PROFILE_OP_SAVE, name, 0.0f, 0.0f);
+}
+
+/**
+ * @brief  提交删除请求
+ * @param  name: 档案名称
+ * @retval 1=已受理, 0=名称无效或上一个请求未完成
+ */
+uint8_t Profile_RequestDelete(const char *name)
+{
+    return Profile_IsValidName(name) && Profile_Submit(PROFILE_OP_DELETE, name, 0.0f, 0.0f);
+}
+
+/**
+ * @brief  提交距离区间设置请求
+ * @param  name: 档案名称
+ * @param  min_m: 区间下限(m)
+ * @param  max_m: 区间上限(m)，0=不参与自动切换
+ * @retval 1=已受理, 0=参数无效或上一个请求未完成
+ */
+uint8_t Profile_RequestRange(const char *name, float min_m, float max_m)
+{
+    if (!Profile_IsValidName(name) || min_m < 0.0f || max_m < min_m || max_m > PROFILE_RANGE_MAX_M) return 0;
+
+    return Profile_Submit(PROFILE_OP_RANGE, name, min_m, max_m);
+}
+
+/**
+ * @brief  提交自动切换开关请求
+ * @param  enabled: 1=开启, 0=关闭
+ * @retval 1=已受理, 0=上一个请求未完成
+ */
+uint8_t Profile_RequestAuto(uint8_t enabled)
+{
+    return Profile_Submit(PROFILE_OP_AUTO, NULL, enabled ? 1.0f : 0.0f, 0.0f);
+}
+
+/**
+ * @brief  提交上电档案设置请求
+ * @param  name: 档案名称，NULL=固件默认参数
+ * @retval 1=已受理, 0=名称无效或上一个请求未完成
+ */
+uint8_t Profile_RequestBoot(const char *name)
+{
+    if (name != NULL && !Profile_IsValidName(name)) return 0;
+
+    return Profile_Submit(PROFILE_OP_BOOT, name, 0.0f, 0.0f);
+}
+
+/**
+ * @brief  参数档案后台处理
+ * @retval None
+ */
+void Profile_Process(void)
+{
+    if (request_op != PROFILE_OP_NONE) {
+        Profile_Execute((ProfileOp)request_op);
+        request_op = PROFILE_OP_NONE;
+    }
+
+    if (auto_enabled && HAL_GetTick() - auto_tick >= PROFILE_AUTO_PERIOD_MS) {
+        auto_tick = HAL_GetTick();
+        Profile_AutoSelect();
+    }
+}
+
+/**
+ * @brief  获取当前档案名称
+ * @retval 名称，未使用档案时为"-"
+ */
+const char *Profile_GetActiveName(void)
+{
+    return (active_index < PROFILE_MAX) ? profile_table.entries[active_index].name : "-";
+}
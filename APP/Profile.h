@@ -0,0 +1,111 @@
+/**
+ * @file    Profile.h
+ * @brief   控制器参数档案头文件
+ * @details 把完整的控制器配置（两轴PID、死区、微分滤波、电机转速）按名称保存在Flash（扇区9），
+ *          不同场景（远/近目标、室内/室外、三脚架/车载）一条命令切换：
+ *          - profile use <名称>: 手动切换
+ *          - profile auto on: 按目标距离估计（cue range）落在哪个档案的距离区间自动切换
+ *          - 切换在控制周期边界整体生效，PID增益无扰切换（见Gimbal_RequestConfig）
+ *          所有命令在默认任务中执行，Flash写入只追加，扇区写满后需在控制停止时擦除。
+ *          电机驱动参数表（drv save）与档案同表保存
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+#include "stm32f4xx_hal.h"
+#include "MotorConfig.h"
+
+#define PROFILE_MAX          8       ///< 档案数量上限
+#define PROFILE_NAME_LEN     12      ///< 名称长度（含结尾'\0'，最长11个字符）
+#define PROFILE_RANGE_MAX_M  5000.0f ///< 距离区间上限(m)
+
+/**
+ * @brief  读取Flash中的档案表
+ * @retval None
+ * @note   在默认任务中、MotorConfig_BootCheck之前调用：保存过的驱动参数表交给MotorConfig
+ */
+void Profile_Load(void);
+
+/**
+ * @brief  初始化参数档案
+ * @retval None
+ * @note   在默认任务中、Profile_Load和Gimbal_Init之后调用：应用上电档案
+ */
+void Profile_Init(void);
+
+/**
+ * @brief  保存电机驱动参数表
+ * @param  table: 参数表
+ * @retval 1=成功, 0=扇区已满且控制未停止，或写入失败（已输出错误信息）
+ * @note   在默认任务中调用（MotorConfig_Process）
+ */
+uint8_t Profile_StoreDriverTable(const MotorDriverTable *table);
+
+/**
+ * @brief  提交列表请求
+ * @retval 1=已受理, 0=上一个请求未完成
+ */
+uint8_t Profile_RequestList(void);
+
+/**
+ * @brief  提交切换请求
+ * @param  name: 档案名称
+ * @retval 1=已受理, 0=名称无效或上一个请求未完成
+ * @note   手动切换后暂停自动切换
+ */
+uint8_t Profile_RequestUse(const char *name);
+
+/**
+ * @brief  提交保存请求（当前配置存为指定名称，已存在则覆盖）
+ * @param  name: 档案名称（字母、数字、'_'、'-'）
+ * @retval 1=已受理, 0=名称无效或上一个请求未完成
+ */
+uint8_t Profile_RequestSave(const char *name);
+
+/**
+ * @brief  提交删除请求
+ * @param  name: 档案名称
+ * @retval 1=已受理, 0=名称无效或上一个请求未完成
+ */
+uint8_t Profile_RequestDelete(const char *name);
+
+/**
+ * @brief  提交距离区间设置请求
+ * @param  name: 档案名称
+ * @param  min_m: 区间下限(m)
+ * @param  max_m: 区间上限(m)，min_m=max_m=0表示不参与自动切换
+ * @retval 1=已受理, 0=参数无效或上一个请求未完成
+ */
+uint8_t Profile_RequestRange(const char *name, float min_m, float max_m);
+
+/**
+ * @brief  提交自动切换开关请求
+ * @param  enabled: 1=开启, 0=关闭
+ * @retval 1=已受理, 0=上一个请求未完成
+ */
+uint8_t Profile_RequestAuto(uint8_t enabled);
+
+/**
+ * @brief  提交上电档案设置请求
+ * @param  name: 档案名称，NULL=使用固件默认参数
+ * @retval 1=已受理, 0=名称无效或上一个请求未完成
+ */
+uint8_t Profile_RequestBoot(const char *name);
+
+/**
+ * @brief  参数档案后台处理
+ * @retval None
+ * @note   在默认任务中周期调用：执行挂起的请求，自动切换开启时按距离选择档案
+ */
+void Profile_Process(void);
+
+/**
+ * @brief  获取当前档案名称
+ * @retval 名称，未使用档案时为"-"
+ */
+const char *Profile_GetActiveName(void);
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file    SelfTune.c
+ * @brief   自校正调节器实现
+ * @details 回归量 φ = [Δq[k-1], u[k-1], u[k-2]]，观测 y = Δq[k]：
+ *              k = P·φ / (λ + φ'·P·φ)，θ += k·(y - θ·φ)，P = (P - k·(P·φ)') / λ
+ *          只有3维，直接展开计算
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "SelfTune.h"
+#include <math.h>
+#include <string.h>
+
+#define SELFTUNE_P0            0.25f    ///< 初始协方差（三个参数相同）
+#define SELFTUNE_P_TRACE_MAX   10.0f    ///< 协方差迹上限
+#define SELFTUNE_OUTLIER_DEG   2.0f     ///< 新息上限（度）：指向读取错误、丢步
+#define SELFTUNE_DT_ALPHA      0.05f    ///< 平均测量间隔的滤波系数
+
+/**
+ * @brief  初始化
+ * @param  st: 估计器
+ * @retval None
+ */
+void SelfTune_Init(SelfTune *st)
+{
+    memset(st, 0, sizeof(*st));
+    st->theta[1] = 1.0f;
+    st->P[0] = SELFTUNE_P0;
+    st->P[4] = SELFTUNE_P0;
+    st->P[8] = SELFTUNE_P0;
+    st->scale = 1.0f;
+}
+
+/**
+ * @brief  清除指向和下发历史
+ * @param  st: 估计器
+ * @retval None
+ */
+void SelfTune_Restart(SelfTune *st)
+{
+    st->valid = 0;
+    st->history = 0;
+    st->u_hist[0] = 0.0f;
+    st->u_hist[1] = 0.0f;
+}
+
+/**
+ * @brief  输入一次测量
+ * @retval 1=更新了估计, 0=冻结
+ */
+uint8_t SelfTune_Update(SelfTune *st, float q, float dt, uint8_t allowed)
+{
+    float phi[3], Pphi[3];
+    float y, den, e, trace;
+    uint8_t ready = st->valid >= 2 && st->history >= 2;
+
+    y = q - st->q_prev;
+    phi[0] = st->dq_prev;
+    phi[1] = st->u_hist[0];
+    phi[2] = st->u_hist[1];
+    if (st->valid >= 1)
+    {
+        st->dt_mean = (st->dt_mean > 0.0f) ? st->dt_mean + SELFTUNE_DT_ALPHA * (dt - st->dt_mean) : dt;
+        st->dq_prev = y;
+    }
+    st->q_prev = q;
+    if (st->valid < 2) st->valid++;
+    if (!ready)
+    {
+        return 0;
+    }
+
+    // 激励检查：平稳跟踪时 Δq[k-1]≈u[k-1]≈u[k-2]，回归量共线，只能确定稳态增益，惯性和延迟无法区分
+    e = y - (st->theta[0] * phi[0] + st->theta[1] * phi[1] + st->theta[2] * phi[2]);
+    if (!allowed || fabsf(phi[1] - phi[2]) + fabsf(phi[1] - phi[0]) < SELFTUNE_MIN_STEP_DEG ||
+        fabsf(e) > SELFTUNE_OUTLIER_DEG)
+    {
+        st->frozen++;
+        return 0;
+    }
+
+    // 递推最小二乘
+    den = SELFTUNE_LAMBDA;
+    for (uint8_t r = 0; r < 3; r++)
+    {
+        Pphi[r] = st->P[3 * r] * phi[0] + st->P[3 * r + 1] * phi[1] + st->P[3 * r + 2] * phi[2];
+        den += phi[r] * Pphi[r];
+    }
+
+    trace = 0.0f;
+    for (uint8_t r = 0; r < 3; r++)
+    {
+        float k = Pphi[r] / den;
+        st->theta[r] += k * e;
+        for (uint8_t c = 0; c < 3; c++)
+        {
+            st->P[3 * r + c] -= k * Pphi[c];
+        }
+        trace += st->P[4 * r];
+    }
+    if (trace * (1.0f / SELFTUNE_LAMBDA) < SELFTUNE_P_TRACE_MAX)
+    {
+        for (uint8_t r = 0; r < 9; r++)
+        {
+            st->P[r] *= 1.0f / SELFTUNE_LAMBDA;
+        }
+    }
+
+    st->updates++;
+    st->pending++;
+    return 1;
+}
+
+/**
+ * @brief  记录本次实际下发的角度
+ * @retval None
+ */
+void SelfTune_Commit(SelfTune *st, float u)
+{
+    st->u_hist[1] = st->u_hist[0];
+    st->u_hist[0] = u;
+    if (st->history < 2) st->history++;
+}
+
+/**
+ * @brief  按当前估计重新计算增益倍数
+ * @retval 1=已设计, 0=保持原增益
+ */
+uint8_t SelfTune_Design(SelfTune *st)
+{
+    float a = st->theta[0];
+    float b0 = st->theta[1];
+    float b1 = st->theta[2];
+    float dc = (b0 + b1) / (1.0f - a);
+    float delay;
+
+    if (st->pending < SELFTUNE_MIN_UPDATES || st->updates < SELFTUNE_FIRST_UPDATES)
+    {
+        return 0;
+    }
+    st->pending = 0;
+
+    // 驱动饱和：增益倍数取0，由调用方按每次最大变化和下限降低
+    if (a >= SELFTUNE_A_MAX && a < 1.5f)
+    {
+        st->delay = 0.0f;
+        st->scale = 0.0f;
+        return 1;
+    }
+
+    // 模型可信：惯性稳定、稳态增益接近1，b两项都不严重为负（比较写成"在范围内"的形式，NaN时不设计）
+    if (!(a > -SELFTUNE_A_MAX && a < SELFTUNE_A_MAX &&
+          dc >= SELFTUNE_DC_MIN && dc <= SELFTUNE_DC_MAX &&
+          b0 >= -0.5f * (b0 + b1) && b1 >= -0.5f * (b0 + b1)))
+    {
+        return 0;
+    }
+
+    // 平均延迟：b0在1次测量后、b1在2次后（测量时刻与下发时刻不同步，略为负的一项按0计），惯性拖尾再加 a/(1-a) 次
+    if (b0 < 0.0f) b0 = 0.0f;
+    if (b1 < 0.0f) b1 = 0.0f;
+    delay = ((b0 + 2.0f * b1) / (b0 + b1) + a / (1.0f - a)) * st->dt_mean;
+    if (!(delay > 0.0f))
+    {
+        return 0;
+    }
+    st->delay = delay;
+    st->scale = SELFTUNE_DELAY_NOMINAL_S / delay;
+    return 1;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file    SelfTune.h
+ * @brief   自校正调节器（单轴模型在线估计）头文件
+ * @details 载荷更换、线缆牵扯等改变轴的动态后，固定的PID增益变得迟缓或振荡。
+ *          本模块在跟踪过程中用带遗忘因子的递推最小二乘在线估计低阶ARX轴模型（一阶惯性加一拍延迟）：
+ *              Δq[k] = a·Δq[k-1] + b0·u[k-1] + b1·u[k-2]
+ *          u为每次测量实际下发的相对角度（度），Δq为相邻两帧成像时刻之间轴的实际转角（编码器回推到成像时刻，
+ *          即图像偏差中由云台转动造成的部分，与目标运动无关，闭环下也不会被目标运动带偏）。
+ *          a描述驱动加减速造成的拖尾（负载加重时变大），b0/b1描述延迟；驱动最终走完下发的角度，
+ *          稳态增益(b0+b1)/(1-a)应接近1。
+ *          下发角度在驱动中累加，轴相当于积分环节，模型给出它的等效延迟（脉冲响应的平均延迟）：
+ *              θ = ((b0 + 2·b1)/(b0 + b1) + a/(1 - a)) · 平均测量间隔
+ *          积分对象的比例增益与等效延迟成反比（SIMC整定），基准增益（出厂/技术员整定）对应名义驱动的
+ *          等效延迟SELFTUNE_DELAY_NOMINAL_S，按 θnom/θ 缩放：负载加重时拖尾变长、增益降低，恢复后增益回升。
+ *          a超过上限时驱动已跟不上下发（加速度饱和的极限环，b很小，模型不再线性），按最低倍数处理。
+ *          - 冻结：下发角度变化不足（锁定、死区内、平稳跟踪）、指向读取失败、新息过大时不更新估计
+ *          - 协方差迹超过上限时不再遗忘，长时间冻结后不会发散
+ *          - 上次设计后更新次数不足、稳态增益不在范围内或系数严重为负时不重新设计
+ *          PID增益的安全限幅（相对基准增益、每次变化倍数）在GimbalControl中完成
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _SELF_TUNE_H
+#define _SELF_TUNE_H
+
+#include <stdint.h>
+
+#define SELFTUNE_LAMBDA        0.98f    ///< 遗忘因子（每次更新，记忆约50次有效更新）
+#define SELFTUNE_MIN_STEP_DEG  0.1f     ///< 激励阈值：u[k-1]与u[k-2]、Δq[k-1]之差的绝对值之和(度)
+#define SELFTUNE_MIN_UPDATES   15U      ///< 两次设计之间至少的更新次数
+#define SELFTUNE_FIRST_UPDATES 30U      ///< 首次设计前至少的更新次数（初始模型不参与设计）
+#define SELFTUNE_DELAY_NOMINAL_S 0.07f  ///< 名义驱动（额定负载、出厂加速度档位）的等效延迟(s)
+#define SELFTUNE_DC_MIN        0.5f     ///< 模型稳态增益(b0+b1)/(1-a)下限
+#define SELFTUNE_DC_MAX        2.0f     ///< 稳态增益上限
+#define SELFTUNE_A_MAX         0.95f    ///< 惯性系数上限，超过视为驱动饱和
+
+/**
+ * @brief 单轴自校正估计器
+ */
+typedef struct {
+    float theta[3];         ///< 模型参数 [a b0 b1]
+    float P[9];             ///< 协方差（行优先）
+    float q_prev;           ///< 上一帧成像时刻的指向（度）
+    float dq_prev;          ///< 上一个间隔的实际转角（度）
+    float u_hist[2];        ///< 已下发角度 u[k-1] u[k-2]（度）
+    uint8_t valid;          ///< 重新开始后已收到的指向次数（0~2）
+    uint8_t history;        ///< 重新开始后已下发的次数（0~2）
+    float dt_mean;          ///< 平均测量间隔(s)
+    float delay;            ///< 最近一次设计时的等效延迟θ(s)，0=尚未设计或驱动饱和
+    float scale;            ///< 增益倍数 θnom/θ（相对基准增益）
+    uint32_t updates;       ///< 估计更新次数
+    uint32_t frozen;        ///< 冻结（未更新）次数
+    uint32_t pending;       ///< 上次设计后的更新次数
+} SelfTune;
+
+/**
+ * @brief  初始化
+ * @param  st: 估计器
+ * @retval None
+ * @note   初始模型 a=0, b0=1, b1=0：下发的角度在一个测量间隔内走完
+ */
+void SelfTune_Init(SelfTune *st);
+
+/**
+ * @brief  清除指向和下发历史
+ * @param  st: 估计器
+ * @retval None
+ * @note   目标丢失、跟踪停止、指向读取失败时调用，估计值保留
+ */
+void SelfTune_Restart(SelfTune *st);
+
+/**
+ * @brief  输入一次测量（在计算本次下发角度之前）
+ * @param  st: 估计器
+ * @param  q: 成像时刻的轴指向（度）
+ * @param  dt: 测量间隔(s)
+ * @param  allowed: 0=外部条件不满足（状态反馈控制中等），只记录历史
+ * @retval 1=更新了估计, 0=冻结
+ */
+uint8_t SelfTune_Update(SelfTune *st, float q, float dt, uint8_t allowed);
+
+/**
+ * @brief  记录本次实际下发的角度
+ * @param  st: 估计器
+ * @param  u: 下发角度（度，锁定时为0）
+ * @retval None
+ */
+void SelfTune_Commit(SelfTune *st, float u);
+
+/**
+ * @brief  按当前估计重新计算增益倍数
+ * @param  st: 估计器
+ * @retval 1=已设计（结果在st->scale）, 0=激励不足或模型不可信，保持原增益
+ * @note   低频调用（每秒一次）
+ */
+uint8_t SelfTune_Design(SelfTune *st);
+
+#endif
@@ -13,45 +13,76 @@
  *          - enable/disable: 启用/禁用跟踪
  *          - test: 运行自检
  *          - debug/log/cam: 调试输出控制
+ *          - camstat: 显示相机端分阶段耗时
+ *          - rate: 查看/设置控制频率
+ *          - drv: 电机驱动参数读取/同步/修改
+ *          - latency: 端到端执行延迟测量
+ *          - calib/roll: 相机-云台旋转标定/查看/设置
+ *          - stress: 最坏I/O负载下的控制周期抖动测试
+ *          - output: 运动命令输出方式（串口/STEP脉冲）
+ *          - cue: 云台间目标引导（开关/机间几何/距离估计）
+ *          - journal: 导出/清空Flash事件日志
+ *          - deadzone/filter/speed: 死区、微分滤波、电机转速
+ *          - profile: 控制器参数档案（保存/切换/按距离自动切换）
+ *          - ident/sf: 模型辨识数据采集、状态反馈(LQR/LQG)参数上传与切换
+ *          - fault: 链路/执行机构故障注入
+ *
+ *          命令行在USART2接收中断中拼接，排队后由默认任务执行（SerialDebug_Process）：
+ *          命令输出阻塞轮询发送，不在中断中进行，不会推迟同优先级的相机接收中断。
+ *          停止类命令（stop、disable、stress stop）在中断中立即执行，默认任务忙于长任务时同样有效
  */
 
 #include "SerialDebug.h"
 #include "GimbalControl.h"
 #include "Motor.h"
 #include "Camera.h"
+#include "MotorConfig.h"
+#include "Latency.h"
+#include "CamCalib.h"
+#include "Stress.h"
+#include "MotorStep.h"
+#include "Cue.h"
+#include "Journal.h"
+#include "Profile.h"
+#include "LockOut.h"
+#include "SysId.h"
+#include "FaultInject.h"
+#include "UartFast.h"
 #include "usart.h"
+#include "cmsis_os.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 
 #define RX_BUFFER_SIZE 128
+#define CMD_QUEUE_LEN  4    // 等待默认任务执行的命令行（2的幂）
 static uint8_t rx_buffer[RX_BUFFER_SIZE];
 static uint8_t rx_index = 0;
-static uint8_t rx_char = 0;  // 当前接收的字符
+
+// 命令队列（接收中断写入，默认任务取出）
+static char cmd_queue[CMD_QUEUE_LEN][RX_BUFFER_SIZE];
+static volatile uint32_t cmd_head = 0;
+static volatile uint32_t cmd_tail = 0;
+static volatile uint32_t cmd_dropped = 0;
+static volatile uint8_t cmd_too_long = 0;
 
 // 数据回传控制
 static uint8_t data_feedback_enabled = 0;
 static uint32_t feedback_counter = 0;
 
 /**
- * @brief  串口调试初始化
+ * @brief  打印命令列表（启动提示与help命令共用）
  * @retval None
  */
-void SerialDebug_Init(void)
+static void PrintHelp(void)
 {
-    rx_index = 0;
-    
-    // 启动UART2接收中断，接收单个字符
-    HAL_UART_Receive_IT(&huart2, &rx_char, 1);
-    
-    HAL_Delay(100);  // 等待串口稳定
-    
-    SerialDebug_Printf("\r\n=== Gimbal Serial Debug ===\r\n");
     SerialDebug_Printf("Commands:\r\n");
     SerialDebug_Printf("  help          - Show this help\r\n");
     SerialDebug_Printf("  status        - Show system status\r\n");
     SerialDebug_Printf("  pid h <kp> <ki> <kd> - Set horizontal PID\r\n");
     SerialDebug_Printf("  pid v <kp> <ki> <kd> - Set vertical PID\r\n");
+    SerialDebug_Printf("  deadzone <value>     - Set deadzone (pixels)\r\n");
     SerialDebug_Printf("  move h <angle>       - Move horizontal (degrees)\r\n");
     SerialDebug_Printf("  move v <angle>       - Move vertical (degrees)\r\n");
     SerialDebug_Printf("  stop          - Stop motors\r\n");
@@ -61,6 +92,51 @@ void SerialDebug_Init(void)
     SerialDebug_Printf("  debug on/off  - Enable/disable data feedback\r\n");
     SerialDebug_Printf("  log on/off    - Enable/disable debug output\r\n");
     SerialDebug_Printf("  cam on/off    - Enable/disable camera debug\r\n");
+    SerialDebug_Printf("  camstat       - Show camera stage timing\r\n");
+    SerialDebug_Printf("  rate [hz]     - Show/set control rate (10-500)\r\n");
+    SerialDebug_Printf("  drv <show|sync|profile> [h|v] - Driver config\r\n");
+    SerialDebug_Printf("  drv set <h|v> <name> <value>  - Set driver profile\r\n");
+    SerialDebug_Printf("  drv pid <h|v> <kp> <ki> <kd>  - Set driver PID profile\r\n");
+    SerialDebug_Printf("  drv save                      - Save driver profile to flash\r\n");
+    SerialDebug_Printf("  latency [h|v] [n] - Measure actuation latency\r\n");
+    SerialDebug_Printf("  calib [step]  - Calibrate camera roll (degrees)\r\n");
+    SerialDebug_Printf("  roll [deg]    - Show/set camera roll\r\n");
+    SerialDebug_Printf("  imm [on|off]  - Show target motion / switch gain scheduling\r\n");
+    SerialDebug_Printf("  jac [on|off|reset] - Show/switch online image Jacobian\r\n");
+    SerialDebug_Printf("  str [on|off]  - Show/switch self-tuning PID gains\r\n");
+    SerialDebug_Printf("  lead [ms]     - Show/set payload latency for lead aim (0=off)\r\n");
+    SerialDebug_Printf("  stress [s] [cpu%%] / stress stop - I/O stress test\r\n");
+    SerialDebug_Printf("  output [uart|step] - Show/set motion output\r\n");
+    SerialDebug_Printf("  cue [on|off]  - Show/switch inter-unit cueing\r\n");
+    SerialDebug_Printf("  cue geo <dx> <dy> <dz> <yaw> - Set peer offset (m, deg)\r\n");
+    SerialDebug_Printf("  cue range <m> - Set target range estimate\r\n");
+    SerialDebug_Printf("  journal [n] / journal clear - Dump last n events / erase\r\n");
+    SerialDebug_Printf("  filter <ms>   - Set PID derivative filter (0-1000)\r\n");
+    SerialDebug_Printf("  speed <rpm>   - Set motor speed (%d-%d)\r\n", MOTOR_SPEED_MIN_RPM, MOTOR_SPEED_MAX_RPM);
+    SerialDebug_Printf("  profile [use|save|del] <name> - List/switch/store gain profiles\r\n");
+    SerialDebug_Printf("  profile range <name> <min> <max> / auto on|off / boot <name|none>\r\n");
+    SerialDebug_Printf("  ident <h|v> [n] [amp] - Capture identification data (PRBS)\r\n");
+    SerialDebug_Printf("  sf [h|v <k|b|l> ...|on|off] - Show/upload/switch state feedback\r\n");
+    SerialDebug_Printf("  fault [clear] - Show/clear injected faults\r\n");
+    SerialDebug_Printf("  fault <cam|motH|motV|cue> <rx|tx> <drop|corrupt|dup|delay> <permille> [ms]\r\n");
+    SerialDebug_Printf("  fault <h|v> <stall|freeze|off> [ms] - Actuator fault\r\n");
+}
+
+/**
+ * @brief  串口调试初始化
+ * @retval None
+ */
+void SerialDebug_Init(void)
+{
+    rx_index = 0;
+    
+    // 启动UART2 DMA接收，逐字符交给命令解析
+    UartFast_StartRx(UART_FAST_DEBUG, SerialDebug_ProcessCommand);
+    
+    osDelay(100);  // 等待串口稳定
+    
+    SerialDebug_Printf("\r\n=== Gimbal Serial Debug ===\r\n");
+    PrintHelp();
     SerialDebug_Printf("===========================\r\n\n");
 }
 
@@ -80,7 +156,422 @@ void SerialDebug_Printf(const char *format, ...)
     
     if (len > 0)
     {
-        HAL_UART_Transmit(&huart2, (uint8_t*)buffer, len, 1000);
+        UartFast_Write(UART_FAST_DEBUG, (const uint8_t*)buffer, (uint16_t)len);
+    }
+}
+
+/**
+ * @brief  发送原始字节
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval None
+ */
+void SerialDebug_Write(const uint8_t *data, uint16_t len)
+{
+    UartFast_Write(UART_FAST_DEBUG, data, len);
+}
+
+/**
+ * @brief  轴字符转电机地址
+ * @param  axis: 'h'/'v'
+ * @retval 电机地址，0=无效
+ */
+static uint8_t ParseMotorAxis(char axis)
+{
+    if (axis == 'h' || axis == 'H') return MOTOR_ID_HORIZONTAL;
+    if (axis == 'v' || axis == 'V') return MOTOR_ID_VERTICAL;
+    return 0;
+}
+
+// 状态反馈参数暂存（sf命令分多行上传，sf <h|v> on时整体提交）
+static StateFbParams sf_staging[2] = {{0, {0}, {0}, 1.0f}, {0, {0}, {0}, 1.0f}};
+
+/**
+ * @brief  解析空格分隔的浮点数列表
+ * @param  args: 字符串
+ * @param  values: 输出
+ * @param  max: 最多个数
+ * @retval 个数，多于max个或含非数字时返回0
+ */
+static uint8_t ParseFloatList(const char *args, float *values, uint8_t max)
+{
+    uint8_t count = 0;
+    char *end;
+
+    while (1)
+    {
+        while (*args == ' ') args++;
+        if (*args == '\0') return count;
+        if (count >= max) return 0;
+        values[count] = strtof(args, &end);
+        if (end == args) return 0;
+        count++;
+        args = end;
+    }
+}
+
+/**
+ * @brief  打印一个轴的状态反馈参数
+ * @param  name: 轴名称
+ * @param  params: 参数
+ * @retval None
+ */
+static void PrintStateFb(char name, const StateFbParams *params)
+{
+    SerialDebug_Printf("%c: n=%u L=%.3f K=[", name, params->order, params->l);
+    for (uint8_t i = 0; i <= params->order; i++)
+    {
+        SerialDebug_Printf("%s%.4g", i ? " " : "", params->k[i]);
+    }
+    SerialDebug_Printf("] b=[");
+    for (uint8_t i = 0; i <= params->order; i++)
+    {
+        SerialDebug_Printf("%s%.4g", i ? " " : "", params->b[i]);
+    }
+    SerialDebug_Printf("]\r\n");
+}
+
+/**
+ * @brief  处理sf子命令
+ * @param  args: "sf "之后的参数
+ * @retval None
+ * @note   k决定阶数n（n+1个增益），b必须在k之后给出且个数相同
+ */
+static void ProcessStateFbCommand(const char *args)
+{
+    uint8_t motor_id = ParseMotorAxis(args[0]);
+    GimbalAxis axis = (motor_id == MOTOR_ID_VERTICAL) ? GIMBAL_AXIS_V : GIMBAL_AXIS_H;
+    StateFbParams *params = &sf_staging[axis];
+    char name = (axis == GIMBAL_AXIS_V) ? 'V' : 'H';
+    float values[STATEFB_ORDER_MAX + 1];
+    uint8_t count;
+
+    if (motor_id == 0 || args[1] != ' ')
+    {
+        SerialDebug_Printf("Error: Usage: sf <h|v> <k|b|l|on|off> ...\r\n");
+        return;
+    }
+    args += 2;
+
+    if (strncmp(args, "k ", 2) == 0)
+    {
+        count = ParseFloatList(args + 2, values, STATEFB_ORDER_MAX + 1);
+        if (count == 0)
+        {
+            SerialDebug_Printf("Error: Usage: sf <h|v> k <k0> ... <kn> (n<=%d)\r\n", STATEFB_ORDER_MAX);
+            return;
+        }
+        params->order = count - 1;
+        memcpy(params->k, values, count * sizeof(float));
+        memset(params->b, 0, sizeof(params->b));
+        SerialDebug_Printf("Staged %c: n=%u, K set (set b next)\r\n", name, params->order);
+    }
+    else if (strncmp(args, "b ", 2) == 0)
+    {
+        count = ParseFloatList(args + 2, values, STATEFB_ORDER_MAX + 1);
+        if (count != params->order + 1)
+        {
+            SerialDebug_Printf("Error: Usage: sf <h|v> b <b0> ... <bn> (%u values after 'k')\r\n",
+                               params->order + 1);
+            return;
+        }
+        memcpy(params->b, values, count * sizeof(float));
+        SerialDebug_Printf("Staged %c: b set\r\n", name);
+    }
+    else if (strncmp(args, "l ", 2) == 0)
+    {
+        if (sscanf(args + 2, "%f", &values[0]) != 1 || values[0] <= 0.0f || values[0] > 1.0f)
+        {
+            SerialDebug_Printf("Error: Usage: sf <h|v> l <0-1> (1=no estimator)\r\n");
+            return;
+        }
+        params->l = values[0];
+        SerialDebug_Printf("Staged %c: L=%.3f\r\n", name, params->l);
+    }
+    else if (strcmp(args, "on") == 0)
+    {
+        if (!Gimbal_RequestStateFb(axis, params))
+        {
+            SerialDebug_Printf("Error: Invalid staged parameters\r\n");
+            return;
+        }
+        SerialDebug_Printf("Axis %c: state feedback\r\n", name);
+        PrintStateFb(name, params);
+    }
+    else if (strcmp(args, "off") == 0)
+    {
+        Gimbal_RequestStateFb(axis, NULL);
+        SerialDebug_Printf("Axis %c: PID\r\n", name);
+    }
+    else
+    {
+        SerialDebug_Printf("Error: Usage: sf <h|v> <k|b|l|on|off> ...\r\n");
+    }
+}
+
+/**
+ * @brief  处理fault子命令
+ * @param  args: "fault "之后的参数
+ * @retval None
+ * @note   fault <cam|motH|motV|cue> <rx|tx> <drop|corrupt|dup|delay> <0-1000> [ms]
+ *         fault <h|v> <stall|freeze|off> [ms]
+ */
+static void ProcessFaultCommand(const char *args)
+{
+    static const char *const kinds[FAULT_KIND_COUNT] = { "drop", "corrupt", "dup", "delay" };
+    char target[8], dir[4], kind[8];
+    unsigned long permille = 0, ms = 0;
+    int n = sscanf(args, "%7s %3s %7s %lu %lu", target, dir, kind, &permille, &ms);
+    uint8_t motor_id = (n >= 2 && target[1] == '\0') ? ParseMotorAxis(target[0]) : 0;
+
+    if (n < 2)
+    {
+        SerialDebug_Printf("Error: Usage: fault clear | fault <port> <rx|tx> <kind> <permille> [ms] | fault <h|v> <stall|freeze|off> [ms]\r\n");
+        return;
+    }
+
+    // 执行机构：fault <h|v> <stall|freeze|off> [ms]
+    if (motor_id != 0)
+    {
+        FaultAxisMode mode = FAULT_AXIS_NONE;
+        char name[8];
+
+        ms = 0;
+        if (sscanf(args + 2, "%7s %lu", name, &ms) < 1) motor_id = 0;
+        else if (strcmp(name, "stall") == 0) mode = FAULT_AXIS_STALL;
+        else if (strcmp(name, "freeze") == 0) mode = FAULT_AXIS_FREEZE;
+        else if (strcmp(name, "off") != 0) motor_id = 0;
+
+        if (motor_id == 0 || !FaultInject_SetAxis(motor_id, mode, ms))
+        {
+            SerialDebug_Printf("Error: Usage: fault <h|v> <stall|freeze|off> [0-%d ms]\r\n", FAULT_DURATION_MAX_MS);
+            return;
+        }
+        SerialDebug_Printf("Axis %c: %s", (motor_id == MOTOR_ID_VERTICAL) ? 'V' : 'H', (mode == FAULT_AXIS_NONE) ? "no fault" : name);
+        if (mode != FAULT_AXIS_NONE && ms) SerialDebug_Printf(" for %lums", ms);
+        SerialDebug_Printf("\r\n");
+        return;
+    }
+
+    // 链路
+    {
+        UartFastPort port = UART_FAST_PORT_COUNT;
+        FaultKind fk = FAULT_KIND_COUNT;
+
+        for (uint32_t i = 0; i < UART_FAST_PORT_COUNT; i++)
+        {
+            if (strcmp(target, FaultInject_PortName((UartFastPort)i)) == 0) port = (UartFastPort)i;
+        }
+        for (uint32_t i = 0; i < FAULT_KIND_COUNT; i++)
+        {
+            if (n >= 3 && strcmp(kind, kinds[i]) == 0) fk = (FaultKind)i;
+        }
+
+        if (n < 4 || port == UART_FAST_PORT_COUNT || fk == FAULT_KIND_COUNT ||
+            (strcmp(dir, "rx") != 0 && strcmp(dir, "tx") != 0) || permille > FAULT_PERMILLE_MAX ||
+            ms > FAULT_DELAY_MAX_MS ||
+            !FaultInject_SetLink(port, (dir[0] == 'r') ? FAULT_DIR_RX : FAULT_DIR_TX, fk, (uint16_t)permille, (uint16_t)ms))
+        {
+            SerialDebug_Printf("Error: Usage: fault <cam|motH|motV|cue> <rx|tx> <drop|corrupt|dup|delay> <0-%d> [1-%d ms]\r\n",
+                               FAULT_PERMILLE_MAX, FAULT_DELAY_MAX_MS);
+            SerialDebug_Printf("       (motor rx: drop/corrupt only; delay needs ms)\r\n");
+            return;
+        }
+        SerialDebug_Printf("%s %s %s: %lu/1000", target, dir, kind, permille);
+        if (fk == FAULT_DELAY && permille) SerialDebug_Printf(", %lums", ms);
+        SerialDebug_Printf("\r\n");
+    }
+}
+
+/**
+ * @brief  为后台电机串口任务占用总线
+ * @retval 1=已占用（提交请求失败时须释放）, 0=不能占用（已输出错误信息）
+ * @note   占用持续到任务结束，期间enable被拒绝，不会与控制任务争用电机串口
+ */
+static uint8_t ClaimMotorBus(void)
+{
+    if (Gimbal_IsEnabled())
+    {
+        SerialDebug_Printf("Error: Run 'disable' first (motor bus in use)\r\n");
+        return 0;
+    }
+    if (!Gimbal_ClaimMotorBus())
+    {
+        SerialDebug_Printf("Error: Motor bus busy (background job running)\r\n");
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief  处理drv子命令
+ * @param  args: "drv "之后的参数
+ * @retval None
+ * @note   show/sync需要收发电机串口，提交给默认任务执行，且要求先disable；save写Flash，同样在默认任务中执行
+ */
+static void ProcessDriverCommand(const char *args)
+{
+    char sub[8];
+    char axis = 0;
+    char name[12];
+    unsigned long value;
+    unsigned long kp, ki, kd;
+    int n = sscanf(args, "%7s %c", sub, &axis);
+    uint8_t motor_id = (n == 2) ? ParseMotorAxis(axis) : 0;
+
+    if (n < 1 || (n == 2 && motor_id == 0))
+    {
+        SerialDebug_Printf("Error: Usage: drv <show|sync|profile|set|pid|save> [h|v] ...\r\n");
+    }
+    else if (strcmp(sub, "show") == 0 || strcmp(sub, "sync") == 0)
+    {
+        MotorConfigRequest req = (strcmp(sub, "show") == 0) ? MOTOR_CONFIG_REQ_SHOW : MOTOR_CONFIG_REQ_SYNC;
+        if (ClaimMotorBus() && !MotorConfig_Request(req, motor_id))
+        {
+            Gimbal_ReleaseMotorBus();
+            SerialDebug_Printf("Error: Driver config busy\r\n");
+        }
+    }
+    else if (strcmp(sub, "save") == 0)
+    {
+        if (!MotorConfig_Request(MOTOR_CONFIG_REQ_SAVE, 0))
+        {
+            SerialDebug_Printf("Error: Driver config busy\r\n");
+        }
+    }
+    else if (strcmp(sub, "profile") == 0)
+    {
+        if (motor_id == 0 || motor_id == MOTOR_ID_VERTICAL) MotorConfig_PrintProfile(MOTOR_ID_VERTICAL);
+        if (motor_id == 0 || motor_id == MOTOR_ID_HORIZONTAL) MotorConfig_PrintProfile(MOTOR_ID_HORIZONTAL);
+    }
+    else if (strcmp(sub, "set") == 0)
+    {
+        if (motor_id != 0 && sscanf(args, "%*s %*c %11s %lu", name, &value) == 2 &&
+            MotorConfig_SetParam(motor_id, name, value))
+        {
+            SerialDebug_Printf("Profile %c.%s = %lu (run 'drv sync' to apply, 'drv save' to keep)\r\n", axis, name, value);
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Usage: drv set <h|v> <name> <value> (see 'drv profile')\r\n");
+        }
+    }
+    else if (strcmp(sub, "pid") == 0)
+    {
+        if (motor_id != 0 && sscanf(args, "%*s %*c %lu %lu %lu", &kp, &ki, &kd) == 3)
+        {
+            MotorDriverPID pid = { kp, ki, kd };
+            MotorConfig_SetPID(motor_id, &pid);
+            SerialDebug_Printf("Profile %c.pid = %lu/%lu/%lu (run 'drv sync' to apply, 'drv save' to keep)\r\n", axis, kp, ki, kd);
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Usage: drv pid <h|v> <kp> <ki> <kd>\r\n");
+        }
+    }
+    else
+    {
+        SerialDebug_Printf("Error: Usage: drv <show|sync|profile|set|pid|save> [h|v] ...\r\n");
+    }
+}
+
+/**
+ * @brief  处理cue子命令
+ * @param  args: "cue "之后的参数
+ * @retval None
+ */
+static void ProcessCueCommand(const char *args)
+{
+    float dx, dy, dz, yaw, range;
+
+    if (strcmp(args, "on") == 0)
+    {
+        Cue_SetEnabled(1);
+        SerialDebug_Printf("Cueing ON\r\n");
+    }
+    else if (strcmp(args, "off") == 0)
+    {
+        Cue_SetEnabled(0);
+        SerialDebug_Printf("Cueing OFF\r\n");
+    }
+    else if (strncmp(args, "geo ", 4) == 0)
+    {
+        if (sscanf(args + 4, "%f %f %f %f", &dx, &dy, &dz, &yaw) == 4 && Cue_SetGeometry(dx, dy, dz, yaw))
+        {
+            SerialDebug_Printf("Peer at (%.2f, %.2f, %.2f) m, yaw %+.1f deg\r\n", dx, dy, dz, yaw);
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Usage: cue geo <dx> <dy> <dz> <yaw> (|d|<=%.0f m, |yaw|<=180)\r\n",
+                               CUE_BASELINE_MAX_M);
+        }
+    }
+    else if (strncmp(args, "range ", 6) == 0)
+    {
+        if (sscanf(args + 6, "%f", &range) == 1 && Cue_SetRange(range))
+        {
+            SerialDebug_Printf("Target range estimate: %.1f m\r\n", range);
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Usage: cue range <%.0f-%.0f>\r\n", CUE_RANGE_MIN_M, CUE_RANGE_MAX_M);
+        }
+    }
+    else
+    {
+        SerialDebug_Printf("Error: Usage: cue [on|off|geo|range] ...\r\n");
+    }
+}
+
+/**
+ * @brief  处理profile子命令
+ * @param  args: "profile "之后的参数
+ * @retval None
+ */
+static void ProcessProfileCommand(const char *args)
+{
+    char name[PROFILE_NAME_LEN + 1];
+    float min_m, max_m;
+    uint8_t ok;
+
+    if (strncmp(args, "use ", 4) == 0)
+    {
+        ok = Profile_RequestUse(args + 4);
+    }
+    else if (strncmp(args, "save ", 5) == 0)
+    {
+        ok = Profile_RequestSave(args + 5);
+    }
+    else if (strncmp(args, "del ", 4) == 0)
+    {
+        ok = Profile_RequestDelete(args + 4);
+    }
+    else if (strncmp(args, "range ", 6) == 0)
+    {
+        ok = sscanf(args + 6, "%12s %f %f", name, &min_m, &max_m) == 3 && Profile_RequestRange(name, min_m, max_m);
+    }
+    else if (strcmp(args, "auto on") == 0 || strcmp(args, "auto off") == 0)
+    {
+        ok = Profile_RequestAuto(args[6] == 'n');
+    }
+    else if (strcmp(args, "boot none") == 0)
+    {
+        ok = Profile_RequestBoot(NULL);
+    }
+    else if (strncmp(args, "boot ", 5) == 0)
+    {
+        ok = Profile_RequestBoot(args + 5);
+    }
+    else
+    {
+        SerialDebug_Printf("Error: Usage: profile [use|save|del|range|auto|boot] ...\r\n");
+        return;
+    }
+
+    if (!ok)
+    {
+        SerialDebug_Printf("Error: Invalid name/range (name: 1-%d of A-Z a-z 0-9 _ -) or profile busy\r\n",
+                           PROFILE_NAME_LEN - 1);
     }
 }
 
@@ -104,28 +595,24 @@ static void ProcessCommand(char *cmd)
     // help命令
     if (strcmp(cmd, "help") == 0)
     {
-        SerialDebug_Printf("Commands:\r\n");
-        SerialDebug_Printf("  help          - Show this help\r\n");
-        SerialDebug_Printf("  status        - Show system status\r\n");
-        SerialDebug_Printf("  pid h <kp> <ki> <kd> - Set horizontal PID\r\n");
-        SerialDebug_Printf("  pid v <kp> <ki> <kd> - Set vertical PID\r\n");
-        SerialDebug_Printf("  deadzone <value>     - Set deadzone (pixels)\r\n");
-        SerialDebug_Printf("  move h <angle>       - Move horizontal (degrees)\r\n");
-        SerialDebug_Printf("  move v <angle>       - Move vertical (degrees)\r\n");
-        SerialDebug_Printf("  stop          - Stop motors\r\n");
-        SerialDebug_Printf("  enable        - Enable gimbal control\r\n");
-        SerialDebug_Printf("  disable       - Disable gimbal control\r\n");
-        SerialDebug_Printf("  test          - Run self test\r\n");
-        SerialDebug_Printf("  debug on/off  - Enable/disable data feedback\r\n");
-        SerialDebug_Printf("  log on/off    - Enable/disable debug output\r\n");
-        SerialDebug_Printf("  cam on/off    - Enable/disable camera debug\r\n");
+        PrintHelp();
     }
     // status命令
     else if (strcmp(cmd, "status") == 0)
     {
         float kp_h, ki_h, kd_h, kp_v, ki_v, kd_v;
+        GimbalConfig config;
+        LockOutStats lock_out;
+        UartFastStats uart;
+        StateFbParams sf;
+        ImgJac jac;
+        float jac_scale, jac_roll;
+        SelfTune st;
+        float st_base;
+        static const char *const uart_names[UART_FAST_PORT_COUNT] = {"cam", "dbg", "motH", "motV", "cue"};
         Gimbal_GetPID(GIMBAL_AXIS_H, &kp_h, &ki_h, &kd_h);
         Gimbal_GetPID(GIMBAL_AXIS_V, &kp_v, &ki_v, &kd_v);
+        Gimbal_GetConfig(&config);
         
         GimbalState state = Gimbal_GetState();
         const char *state_str[] = {"IDLE", "TRACKING", "LOCKED"};
@@ -134,6 +621,37 @@ static void ProcessCommand(char *cmd)
         SerialDebug_Printf("State: %s\r\n", state_str[state]);
         SerialDebug_Printf("PID_H: Kp=%.2f Ki=%.3f Kd=%.2f\r\n", kp_h, ki_h, kd_h);
         SerialDebug_Printf("PID_V: Kp=%.2f Ki=%.3f Kd=%.2f\r\n", kp_v, ki_v, kd_v);
+        SerialDebug_Printf("Rate: %.1f Hz (%lu ms)\r\n", Gimbal_GetRate(), (unsigned long)Gimbal_GetPeriodMs());
+        SerialDebug_Printf("Camera roll: %+.2f deg\r\n", Gimbal_GetCameraRoll());
+        SerialDebug_Printf("Deadzone: %u px, D filter: %.0f ms, Motor speed: %u rpm\r\n",
+                           config.deadzone, config.d_filter_tau * 1000.0f, config.motor_rpm);
+        SerialDebug_Printf("Profile: %s\r\n", Profile_GetActiveName());
+        SerialDebug_Printf("Gain scheduling: %s\r\n", Gimbal_GetImm() ? "ON" : "OFF");
+        if (Gimbal_GetImgJac(&jac))
+        {
+            ImgJac_GetScaleRoll(&jac, &jac_scale, &jac_roll);
+            SerialDebug_Printf("Image Jacobian: ON, %.2f px/deg, rotation %+.2f deg\r\n", jac_scale, jac_roll);
+        }
+        else
+        {
+            SerialDebug_Printf("Image Jacobian: OFF\r\n");
+        }
+        SerialDebug_Printf("Self-tuning: %s\r\n", Gimbal_GetSelfTune(GIMBAL_AXIS_H, &st, &st_base) ? "ON" : "OFF");
+        SerialDebug_Printf("Controller: H=%s V=%s\r\n", Gimbal_GetStateFb(GIMBAL_AXIS_H, &sf) ? "SF" : "PID",
+                           Gimbal_GetStateFb(GIMBAL_AXIS_V, &sf) ? "SF" : "PID");
+        LockOut_GetStats(&lock_out);
+        SerialDebug_Printf("Lock output: %s, %lu events (%lu frames dropped), last err [%+.1f,%+.1f] px\r\n",
+                           lock_out.locked ? "HIGH" : "LOW", (unsigned long)lock_out.events,
+                           (unsigned long)lock_out.dropped,
+                           lock_out.last_err_h, lock_out.last_err_v);
+        SerialDebug_Printf("UART rx bytes/irqs/errors, tx bytes/dropped:\r\n");
+        for (uint8_t i = 0; i < UART_FAST_PORT_COUNT; i++)
+        {
+            UartFast_GetStats((UartFastPort)i, &uart);
+            SerialDebug_Printf("  %-4s %lu/%lu/%lu, %lu/%lu\r\n", uart_names[i],
+                               (unsigned long)uart.rx_bytes, (unsigned long)uart.rx_irqs, (unsigned long)uart.rx_errors,
+                               (unsigned long)uart.tx_bytes, (unsigned long)uart.tx_dropped);
+        }
         SerialDebug_Printf("====================\r\n");
     }
     // pid命令
@@ -170,7 +688,11 @@ static void ProcessCommand(char *cmd)
         float angle;
         if (sscanf(cmd + 5, "%c %f", &axis, &angle) == 2)
         {
-            if (axis == 'h' || axis == 'H')
+            if (Gimbal_IsMotorBusClaimed())
+            {
+                SerialDebug_Printf("Error: Motor bus busy (background job running)\r\n");
+            }
+            else if (axis == 'h' || axis == 'H')
             {
                 Motor_MoveHorizontal(angle);
                 SerialDebug_Printf("Moving horizontal: %.2f degrees\r\n", angle);
@@ -193,14 +715,27 @@ static void ProcessCommand(char *cmd)
     // stop命令
     else if (strcmp(cmd, "stop") == 0)
     {
-        Motor_Stop();
-        SerialDebug_Printf("Motors stopped\r\n");
+        if (Gimbal_IsMotorBusClaimed())
+        {
+            SerialDebug_Printf("Error: Motor bus busy (background job running)\r\n");
+        }
+        else
+        {
+            Motor_Stop();
+            SerialDebug_Printf("Motors stopped\r\n");
+        }
     }
     // enable命令
     else if (strcmp(cmd, "enable") == 0)
     {
-        Gimbal_Enable();
-        SerialDebug_Printf("Gimbal control enabled\r\n");
+        if (Gimbal_Enable())
+        {
+            SerialDebug_Printf("Gimbal control enabled\r\n");
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Motor bus busy (background job running), try again when it finishes\r\n");
+        }
     }
     // disable命令
     else if (strcmp(cmd, "disable") == 0)
@@ -211,9 +746,11 @@ static void ProcessCommand(char *cmd)
     // test命令
     else if (strcmp(cmd, "test") == 0)
     {
-        SerialDebug_Printf("Running self test...\r\n");
-        Gimbal_SelfTest();
-        SerialDebug_Printf("Self test completed\r\n");
+        if (ClaimMotorBus() && !Gimbal_RequestSelfTest())
+        {
+            Gimbal_ReleaseMotorBus();
+            SerialDebug_Printf("Error: Self test busy\r\n");
+        }
     }
     // debug命令 - 开启/关闭实时数据回传
     else if (strcmp(cmd, "debug on") == 0)
@@ -248,27 +785,458 @@ static void ProcessCommand(char *cmd)
         Camera_SetDebugOutput(0);
         SerialDebug_Printf("Camera debug output disabled\r\n");
     }
+    // camstat命令 - 显示相机端分阶段耗时
+    else if (strcmp(cmd, "camstat") == 0)
+    {
+        CameraStats stats;
+        if (!Camera_GetStats(&stats))
+        {
+            SerialDebug_Printf("No camera stats received\r\n");
+        }
+        else
+        {
+            SerialDebug_Printf("=== Camera Stages (us) ===\r\n");
+            SerialDebug_Printf("Frames: %lu  FPS: %lu.%lu  Age: %lums\r\n",
+                               (unsigned long)stats.frames, (unsigned long)(stats.fps_x10 / 10),
+                               (unsigned long)(stats.fps_x10 % 10),
+                               (unsigned long)(HAL_GetTick() - stats.received_tick));
+            for (uint8_t i = 0; i < CAMERA_STAGE_COUNT; i++)
+            {
+                SerialDebug_Printf("  %-6s min=%-6lu avg=%-6lu max=%lu\r\n",
+                                   Camera_GetStageName((CameraStage)i),
+                                   (unsigned long)stats.stage[i].min, (unsigned long)stats.stage[i].avg,
+                                   (unsigned long)stats.stage[i].max);
+            }
+            SerialDebug_Printf("==========================\r\n");
+        }
+    }
+    // rate命令 - 查看/设置控制频率
+    else if (strcmp(cmd, "rate") == 0)
+    {
+        SerialDebug_Printf("Control rate: %.1f Hz (%lu ms), overruns: %lu\r\n",
+                           Gimbal_GetRate(), (unsigned long)Gimbal_GetPeriodMs(),
+                           (unsigned long)Gimbal_GetOverrunCount());
+    }
+    else if (strncmp(cmd, "rate ", 5) == 0)
+    {
+        unsigned long hz;
+        if (sscanf(cmd + 5, "%lu", &hz) == 1 && Gimbal_SetRate(hz))
+        {
+            SerialDebug_Printf("Control rate set: %.1f Hz\r\n", Gimbal_GetRate());
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Usage: rate <10-500>\r\n");
+        }
+    }
+    // drv命令 - 电机驱动参数管理（收发在默认任务中执行）
+    else if (strncmp(cmd, "drv ", 4) == 0)
+    {
+        ProcessDriverCommand(cmd + 4);
+    }
+    // latency命令 - 执行延迟测量（在默认任务中执行）
+    else if (strcmp(cmd, "latency") == 0 || strncmp(cmd, "latency ", 8) == 0)
+    {
+        const char *args = cmd + 7;
+        uint8_t motor_id = MOTOR_ID_HORIZONTAL;
+        unsigned long trials = LATENCY_TRIALS_DEFAULT;
+        uint8_t valid = 1;
+
+        while (*args == ' ') args++;
+        if (ParseMotorAxis(*args))
+        {
+            motor_id = ParseMotorAxis(*args);
+            args++;
+        }
+        if (*args != '\0' && sscanf(args, "%lu", &trials) != 1) valid = 0;
+
+        if (!valid || trials == 0 || trials > LATENCY_TRIALS_MAX)
+        {
+            SerialDebug_Printf("Error: Usage: latency [h|v] [1-%d]\r\n", LATENCY_TRIALS_MAX);
+        }
+        else if (ClaimMotorBus() && !Latency_Request(motor_id, trials))
+        {
+            Gimbal_ReleaseMotorBus();
+            SerialDebug_Printf("Error: Latency test busy\r\n");
+        }
+    }
+    // calib命令 - 相机-云台旋转标定（在默认任务中执行）
+    else if (strcmp(cmd, "calib") == 0 || strncmp(cmd, "calib ", 6) == 0)
+    {
+        float step = CAMCALIB_STEP_DEFAULT;
+        
+        if (cmd[5] != '\0' && sscanf(cmd + 6, "%f", &step) != 1) step = 0.0f;
+        
+        if (step < CAMCALIB_STEP_MIN || step > CAMCALIB_STEP_MAX)
+        {
+            SerialDebug_Printf("Error: Usage: calib [%.0f-%.0f]\r\n", CAMCALIB_STEP_MIN, CAMCALIB_STEP_MAX);
+        }
+        else if (ClaimMotorBus() && !CamCalib_Request(step))
+        {
+            Gimbal_ReleaseMotorBus();
+            SerialDebug_Printf("Error: Calibration busy\r\n");
+        }
+    }
+    // roll命令 - 查看/设置相机滚转角
+    else if (strcmp(cmd, "roll") == 0)
+    {
+        SerialDebug_Printf("Camera roll: %+.2f deg\r\n", Gimbal_GetCameraRoll());
+    }
+    else if (strncmp(cmd, "roll ", 5) == 0)
+    {
+        float deg;
+        if (sscanf(cmd + 5, "%f", &deg) == 1 && Gimbal_SetCameraRoll(deg))
+        {
+            SerialDebug_Printf("Camera roll set: %+.2f deg\r\n", Gimbal_GetCameraRoll());
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Usage: roll <-45~45>\r\n");
+        }
+    }
+    // imm命令 - 目标运动估计与增益/死区调度
+    else if (strcmp(cmd, "imm") == 0)
+    {
+        static const char *const axis_name[2] = {"H", "V"};
+        GimbalTargetMotion motion;
+        
+        SerialDebug_Printf("Gain scheduling: %s\r\n", Gimbal_GetImm() ? "ON" : "OFF");
+        for (uint8_t axis = 0; axis < 2; axis++)
+        {
+            Gimbal_GetTargetMotion((GimbalAxis)axis, &motion);
+            SerialDebug_Printf("%s: still=%.2f cv=%.2f man=%.2f v=%+.1fdeg/s a=%+.1fdeg/s2 gain x%.2f deadzone x%.2f lead %+.2fdeg%s\r\n",
+                               axis_name[axis], motion.mu[IMM_MODEL_STATIONARY], motion.mu[IMM_MODEL_CV],
+                               motion.mu[IMM_MODEL_CA], motion.velocity, motion.accel,
+                               motion.gain_scale, motion.deadzone_scale, motion.lead,
+                               motion.valid ? "" : " (no target)");
+        }
+    }
+    else if (strcmp(cmd, "imm on") == 0 || strcmp(cmd, "imm off") == 0)
+    {
+        Gimbal_SetImm(cmd[5] == 'n');
+        SerialDebug_Printf("Gain scheduling: %s\r\n", Gimbal_GetImm() ? "ON" : "OFF");
+    }
+    else if (strncmp(cmd, "imm ", 4) == 0)
+    {
+        SerialDebug_Printf("Error: Usage: imm [on|off]\r\n");
+    }
+    // jac命令 - 图像雅可比在线估计
+    else if (strcmp(cmd, "jac") == 0)
+    {
+        ImgJac jac;
+        float scale, roll;
+        uint8_t active = Gimbal_GetImgJac(&jac);
+        
+        ImgJac_GetScaleRoll(&jac, &scale, &roll);
+        SerialDebug_Printf("Image Jacobian: %s\r\n", active ? "ON" : "OFF (fixed roll compensation)");
+        SerialDebug_Printf("J = [%+.2f %+.2f; %+.2f %+.2f] px/deg\r\n", jac.J[0], jac.J[1], jac.J[2], jac.J[3]);
+        SerialDebug_Printf("Scale %.2f px/deg (nominal %.1f), rotation %+.2f deg, drift [%+.1f,%+.1f] px/s\r\n",
+                           scale, IMM_PIXELS_PER_DEG, roll, jac.theta[2], jac.theta[3]);
+        SerialDebug_Printf("Updates %lu, drift only %lu, rejected %lu\r\n", (unsigned long)jac.updates,
+                           (unsigned long)jac.gated, (unsigned long)jac.rejected);
+    }
+    else if (strcmp(cmd, "jac on") == 0 || strcmp(cmd, "jac off") == 0 || strcmp(cmd, "jac reset") == 0)
+    {
+        uint8_t mode = (cmd[4] == 'r') ? 2 : (cmd[5] == 'n');
+        Gimbal_RequestImgJac(mode);
+        SerialDebug_Printf("Image Jacobian: %s\r\n", (mode == 2) ? "reset to nominal" : mode ? "ON" : "OFF");
+    }
+    else if (strncmp(cmd, "jac ", 4) == 0)
+    {
+        SerialDebug_Printf("Error: Usage: jac [on|off|reset]\r\n");
+    }
+    // str命令 - 自校正
+    else if (strcmp(cmd, "str") == 0)
+    {
+        static const char *const axis_name[2] = {"H", "V"};
+        SelfTune st;
+        float base, kp, ki, kd;
+        uint8_t active = Gimbal_GetSelfTune(GIMBAL_AXIS_H, &st, &base);
+        
+        SerialDebug_Printf("Self-tuning: %s\r\n", active ? "ON" : "OFF");
+        for (uint8_t axis = 0; axis < 2; axis++)
+        {
+            Gimbal_GetSelfTune((GimbalAxis)axis, &st, &base);
+            Gimbal_GetPID((GimbalAxis)axis, &kp, &ki, &kd);
+            SerialDebug_Printf("%s: model a=%.2f b0=%.2f b1=%.2f, delay %.0f ms, Kp=%.2f (base %.2f), updates %lu frozen %lu\r\n",
+                               axis_name[axis], st.theta[0], st.theta[1], st.theta[2], st.delay * 1000.0f,
+                               kp, base, (unsigned long)st.updates, (unsigned long)st.frozen);
+        }
+    }
+    else if (strcmp(cmd, "str on") == 0 || strcmp(cmd, "str off") == 0)
+    {
+        Gimbal_RequestSelfTune(cmd[5] == 'n');
+        SerialDebug_Printf("Self-tuning: %s\r\n", (cmd[5] == 'n') ? "ON" : "OFF");
+    }
+    else if (strncmp(cmd, "str ", 4) == 0)
+    {
+        SerialDebug_Printf("Error: Usage: str [on|off]\r\n");
+    }
+    // lead命令 - 载荷延迟提前量
+    else if (strcmp(cmd, "lead") == 0)
+    {
+        GimbalTargetMotion motion_h, motion_v;
+        
+        Gimbal_GetTargetMotion(GIMBAL_AXIS_H, &motion_h);
+        Gimbal_GetTargetMotion(GIMBAL_AXIS_V, &motion_v);
+        SerialDebug_Printf("Payload latency: %lu ms%s\r\n", (unsigned long)Gimbal_GetLeadLatency(),
+                           Gimbal_GetLeadLatency() ? "" : " (aim at image centre)");
+        SerialDebug_Printf("Lead: H=%+.2f V=%+.2f deg\r\n", motion_h.lead, motion_v.lead);
+    }
+    else if (strncmp(cmd, "lead ", 5) == 0)
+    {
+        unsigned long ms;
+        if (sscanf(cmd + 5, "%lu", &ms) == 1 && Gimbal_SetLeadLatency((uint32_t)ms))
+        {
+            SerialDebug_Printf("Payload latency: %lu ms\r\n", (unsigned long)Gimbal_GetLeadLatency());
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Usage: lead <0-1000 ms>\r\n");
+        }
+    }
+    // output命令 - 运动命令输出方式
+    else if (strcmp(cmd, "output") == 0)
+    {
+        SerialDebug_Printf("Motion output: %s\r\n", (Motor_GetOutput() == MOTOR_OUTPUT_STEP) ? "STEP" : "UART");
+        SerialDebug_Printf("Step position: H=%+.3f V=%+.3f deg%s\r\n",
+                           MotorStep_GetPosition(MOTOR_ID_HORIZONTAL), MotorStep_GetPosition(MOTOR_ID_VERTICAL),
+                           (MotorStep_IsMoving(MOTOR_ID_HORIZONTAL) || MotorStep_IsMoving(MOTOR_ID_VERTICAL)) ? " (moving)" : "");
+        SerialDebug_Printf("Step underruns: H=%lu V=%lu\r\n",
+                           (unsigned long)MotorStep_GetUnderruns(MOTOR_ID_HORIZONTAL),
+                           (unsigned long)MotorStep_GetUnderruns(MOTOR_ID_VERTICAL));
+    }
+    else if (strcmp(cmd, "output uart") == 0)
+    {
+        Motor_SetOutput(MOTOR_OUTPUT_UART);
+        SerialDebug_Printf("Motion output: UART\r\n");
+    }
+    else if (strcmp(cmd, "output step") == 0)
+    {
+        Motor_SetOutput(MOTOR_OUTPUT_STEP);
+        SerialDebug_Printf("Motion output: STEP\r\n");
+    }
+    else if (strncmp(cmd, "output ", 7) == 0)
+    {
+        SerialDebug_Printf("Error: Usage: output [uart|step]\r\n");
+    }
+    // stress命令 - 压力测试（在默认任务中执行）
+    else if (strcmp(cmd, "stress stop") == 0)
+    {
+        Stress_Stop();
+    }
+    else if (strcmp(cmd, "stress") == 0 || strncmp(cmd, "stress ", 7) == 0)
+    {
+        unsigned long seconds = STRESS_SECONDS_DEFAULT;
+        unsigned long cpu_pct = 0;
+        
+        if (cmd[6] != '\0' && sscanf(cmd + 7, "%lu %lu", &seconds, &cpu_pct) < 1) seconds = 0;
+        
+        if (seconds == 0 || seconds > STRESS_SECONDS_MAX || cpu_pct > STRESS_CPU_MAX)
+        {
+            SerialDebug_Printf("Error: Usage: stress [1-%d] [0-%d]\r\n", STRESS_SECONDS_MAX, STRESS_CPU_MAX);
+        }
+        else if (!Stress_Request(seconds, cpu_pct))
+        {
+            SerialDebug_Printf("Error: Stress test running\r\n");
+        }
+    }
+    // ident命令 - 辨识数据采集（控制任务叠加激励，默认任务输出）
+    else if (strncmp(cmd, "ident ", 6) == 0)
+    {
+        uint8_t motor_id = ParseMotorAxis(cmd[6]);
+        unsigned long samples = SYSID_SAMPLES_DEFAULT;
+        float amp = SYSID_AMP_DEFAULT;
+        
+        if (motor_id == 0 || (cmd[7] != '\0' && cmd[7] != ' ') ||
+            (cmd[7] == ' ' && sscanf(cmd + 8, "%lu %f", &samples, &amp) < 1))
+        {
+            samples = 0;
+        }
+        
+        if (samples == 0 || samples > SYSID_SAMPLES_MAX || amp < SYSID_AMP_MIN || amp > SYSID_AMP_MAX)
+        {
+            SerialDebug_Printf("Error: Usage: ident <h|v> [1-%d] [%.2f-%.1f]\r\n",
+                               SYSID_SAMPLES_MAX, SYSID_AMP_MIN, SYSID_AMP_MAX);
+        }
+        else if (!Gimbal_IsEnabled())
+        {
+            SerialDebug_Printf("Error: Run 'enable' first (closed-loop capture)\r\n");
+        }
+        else if (!SysId_Request((motor_id == MOTOR_ID_HORIZONTAL) ? GIMBAL_AXIS_H : GIMBAL_AXIS_V,
+                                samples, amp))
+        {
+            SerialDebug_Printf("Error: Capture busy\r\n");
+        }
+    }
+    // sf命令 - 状态反馈参数
+    else if (strcmp(cmd, "sf") == 0)
+    {
+        StateFbParams params;
+        
+        for (uint8_t axis = 0; axis < 2; axis++)
+        {
+            if (Gimbal_GetStateFb((GimbalAxis)axis, &params))
+            {
+                PrintStateFb(axis ? 'V' : 'H', &params);
+            }
+            else
+            {
+                SerialDebug_Printf("%c: PID\r\n", axis ? 'V' : 'H');
+            }
+        }
+    }
+    else if (strncmp(cmd, "sf ", 3) == 0)
+    {
+        ProcessStateFbCommand(cmd + 3);
+    }
+    // fault命令 - 故障注入
+    else if (strcmp(cmd, "fault") == 0)
+    {
+        SerialDebug_Printf("=== Fault Injection ===\r\n");
+        FaultInject_PrintStatus();
+    }
+    else if (strcmp(cmd, "fault clear") == 0)
+    {
+        FaultInject_Clear();
+        SerialDebug_Printf("All faults cleared\r\n");
+    }
+    else if (strncmp(cmd, "fault ", 6) == 0)
+    {
+        ProcessFaultCommand(cmd + 6);
+    }
+    // cue命令 - 云台间目标引导
+    else if (strcmp(cmd, "cue") == 0)
+    {
+        Cue_PrintStatus();
+    }
+    else if (strncmp(cmd, "cue ", 4) == 0)
+    {
+        ProcessCueCommand(cmd + 4);
+    }
+    // deadzone/filter/speed命令 - 修改当前配置（下一控制周期整体生效）
+    else if (strncmp(cmd, "deadzone ", 9) == 0 || strncmp(cmd, "filter ", 7) == 0 || strncmp(cmd, "speed ", 6) == 0)
+    {
+        GimbalConfig config;
+        unsigned long value = 0;
+        uint8_t valid;
+        
+        Gimbal_GetConfig(&config);
+        valid = (sscanf(strchr(cmd, ' ') + 1, "%lu", &value) == 1);
+        if (cmd[0] == 'd')
+        {
+            valid = valid && value <= GIMBAL_DEADZONE_MAX;
+            config.deadzone = (uint8_t)value;
+        }
+        else if (cmd[0] == 'f')
+        {
+            config.d_filter_tau = value * 0.001f;
+        }
+        else
+        {
+            valid = valid && value <= MOTOR_SPEED_MAX_RPM;
+            config.motor_rpm = (uint16_t)value;
+        }
+        
+        if (valid && Gimbal_RequestConfig(&config))
+        {
+            SerialDebug_Printf("Deadzone: %u px, D filter: %.0f ms, Motor speed: %u rpm\r\n",
+                               config.deadzone, config.d_filter_tau * 1000.0f, config.motor_rpm);
+        }
+        else
+        {
+            SerialDebug_Printf("Error: Usage: deadzone <0-%d> | filter <0-%.0f> | speed <%d-%d>\r\n",
+                               GIMBAL_DEADZONE_MAX, GIMBAL_D_FILTER_MAX_S * 1000.0f,
+                               MOTOR_SPEED_MIN_RPM, MOTOR_SPEED_MAX_RPM);
+        }
+    }
+    // profile命令 - 控制器参数档案（在默认任务中执行）
+    else if (strcmp(cmd, "profile") == 0)
+    {
+        if (!Profile_RequestList())
+        {
+            SerialDebug_Printf("Error: Profile busy\r\n");
+        }
+    }
+    else if (strncmp(cmd, "profile ", 8) == 0)
+    {
+        ProcessProfileCommand(cmd + 8);
+    }
+    // journal命令 - Flash事件日志（在默认任务中执行）
+    else if (strcmp(cmd, "journal clear") == 0)
+    {
+        if (Gimbal_IsEnabled())
+        {
+            SerialDebug_Printf("Error: Run 'disable' first (flash erase stalls the CPU)\r\n");
+        }
+        else if (!Gimbal_ClaimMotorBus())
+        {
+            SerialDebug_Printf("Error: Motor bus busy (background job running)\r\n");
+        }
+        else if (!Journal_RequestClear())
+        {
+            Gimbal_ReleaseMotorBus();
+            SerialDebug_Printf("Error: Journal busy\r\n");
+        }
+    }
+    else if (strcmp(cmd, "journal") == 0 || strncmp(cmd, "journal ", 8) == 0)
+    {
+        unsigned long last = 0;
+        
+        if (cmd[7] != '\0' && (sscanf(cmd + 8, "%lu", &last) != 1 || last == 0))
+        {
+            SerialDebug_Printf("Error: Usage: journal [n] | journal clear\r\n");
+        }
+        else if (!Journal_RequestDump(last))
+        {
+            SerialDebug_Printf("Error: Journal busy\r\n");
+        }
+    }
     else
     {
         SerialDebug_Printf("Unknown command. Type 'help' for available commands.\r\n");
     }
 }
 
+/**
+ * @brief  是否为立即执行的停止类命令
+ * @param  cmd: 命令字符串
+ * @retval 1=在中断中立即执行, 0=排队由默认任务执行
+ * @note   只设置标志或发出停止帧，输出一行；默认任务在压力测试、延迟测量、Flash擦除中阻塞时仍能停止
+ */
+static uint8_t IsImmediateCommand(const char *cmd)
+{
+    return strcmp(cmd, "stop") == 0 || strcmp(cmd, "disable") == 0 || strcmp(cmd, "stress stop") == 0;
+}
+
 /**
  * @brief  处理接收到的命令
+ * @param  rx_char: 收到的字符
  * @retval None
- * @note   在USART2中断中调用
+ * @note   由UartFast在USART2空闲线/DMA中断中逐字符调用；收到行尾时整行排队，
+ *         队列满时丢弃（默认任务随后提示）
  */
-void SerialDebug_ProcessCommand(void)
+void SerialDebug_ProcessCommand(uint8_t rx_char)
 {
-    // 这个函数在UART接收完成中断中调用
     // 将接收到的字符存入缓冲区
     if (rx_char == '\n' || rx_char == '\r')
     {
         if (rx_index > 0)  // 只有当缓冲区有内容时才处理
         {
             rx_buffer[rx_index] = '\0';
-            ProcessCommand((char*)rx_buffer);
+            if (IsImmediateCommand((char*)rx_buffer))
+            {
+                ProcessCommand((char*)rx_buffer);
+            }
+            else if (cmd_head - cmd_tail >= CMD_QUEUE_LEN)
+            {
+                cmd_dropped++;
+            }
+            else
+            {
+                memcpy(cmd_queue[cmd_head % CMD_QUEUE_LEN], rx_buffer, rx_index + 1U);
+                cmd_head++;
+            }
             rx_index = 0;
         }
     }
@@ -281,12 +1249,9 @@ void SerialDebug_ProcessCommand(void)
         else
         {
             rx_index = 0;
-            SerialDebug_Printf("\r\nError: Command too long\r\n");
+            cmd_too_long = 1;   // 由默认任务提示
         }
     }
-    
-    // 继续接收下一个字符
-    HAL_UART_Receive_IT(&huart2, &rx_char, 1);
 }
 
 /**
@@ -315,7 +1280,57 @@ void SerialDebug_SendFeedback(int16_t target_x, int16_t target_y, int16_t dx, in
     char buffer[128];
     snprintf(buffer, sizeof(buffer), "DATA,%d,%d,%d,%d,%.1f,%.1f,%d\r\n",
              target_x, target_y, dx, dy, pid_h, pid_v, state);
-    HAL_UART_Transmit(&huart2, (uint8_t*)buffer, strlen(buffer), 100);
+    UartFast_Write(UART_FAST_DEBUG, (const uint8_t*)buffer, (uint16_t)strlen(buffer));
+}
+
+/**
+ * @brief  执行排队的命令，转发相机端分阶段耗时统计到上位机
+ * @retval None
+ * @note   每次执行一条命令：命令提交的后台请求在下一轮默认任务循环中先于下一条命令处理。
+ *         统计格式: CAMS,frames,fps_x10,<min,avg,max>*阶段（单位us）
+ */
+void SerialDebug_Process(void)
+{
+    CameraStats cam_stats;
+    const CameraStats *stats = &cam_stats;
+    
+    if (cmd_dropped != 0)
+    {
+        uint32_t dropped;
+        
+        __disable_irq();
+        dropped = cmd_dropped;
+        cmd_dropped = 0;
+        __enable_irq();
+        SerialDebug_Printf("Error: %lu command(s) dropped (busy, queue full)\r\n", (unsigned long)dropped);
+    }
+    if (cmd_too_long)
+    {
+        cmd_too_long = 0;
+        SerialDebug_Printf("\r\nError: Command too long\r\n");
+    }
+    if (cmd_tail != cmd_head)
+    {
+        ProcessCommand(cmd_queue[cmd_tail % CMD_QUEUE_LEN]);
+        cmd_tail++;
+    }
+    
+    // 每个统计帧只取一次；回传关闭时同样取走，开启后不补发旧统计
+    if (!Camera_TryGetStats(&cam_stats) || !data_feedback_enabled) return;
+    
+    char buffer[256];
+    int len = snprintf(buffer, sizeof(buffer), "CAMS,%lu,%lu", (unsigned long)stats->frames,
+                       (unsigned long)stats->fps_x10);
+    for (uint8_t i = 0; i < CAMERA_STAGE_COUNT && len < (int)sizeof(buffer); i++)
+    {
+        len += snprintf(buffer + len, sizeof(buffer) - len, ",%lu,%lu,%lu",
+                        (unsigned long)stats->stage[i].min, (unsigned long)stats->stage[i].avg,
+                        (unsigned long)stats->stage[i].max);
+    }
+    if (len > (int)sizeof(buffer) - 3) len = sizeof(buffer) - 3;
+    buffer[len++] = '\r';
+    buffer[len++] = '\n';
+    UartFast_Write(UART_FAST_DEBUG, (const uint8_t*)buffer, (uint16_t)len);
 }
 
 /**
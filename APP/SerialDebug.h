@@ -10,20 +10,23 @@
 #define _SERIAL_DEBUG_H
 
 #include "stm32f4xx_hal.h"
+#include "Camera.h"
 
 /**
  * @brief  串口调试初始化
  * @retval None
- * @note   启动USART2接收中断，显示欢迎信息
+ * @note   启动USART2 DMA接收，显示欢迎信息；在任务中调用（osDelay等待）
  */
 void SerialDebug_Init(void);
 
 /**
  * @brief  处理接收到的命令
+ * @param  rx_char: 收到的字符
  * @retval None
- * @note   在USART2中断中调用
+ * @note   由UartFast在USART2空闲线/DMA中断中逐字符调用；整行排队由SerialDebug_Process执行，
+ *         停止类命令（stop、disable、stress stop）立即执行
  */
-void SerialDebug_ProcessCommand(void);
+void SerialDebug_ProcessCommand(uint8_t rx_char);
 
 /**
  * @brief  发送调试信息
@@ -31,7 +34,16 @@ void SerialDebug_ProcessCommand(void);
  * @param  ...: 可变参数
  * @retval None
  */
-void SerialDebug_Printf(const char *format, ...);
+void SerialDebug_Printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief  发送原始字节
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval None
+ * @note   阻塞发送，用于二进制日志帧
+ */
+void SerialDebug_Write(const uint8_t *data, uint16_t len);
 
 /**
  * @brief  发送实时数据到上位机
@@ -48,6 +60,14 @@ void SerialDebug_Printf(const char *format, ...);
 void SerialDebug_SendFeedback(int16_t target_x, int16_t target_y, int16_t dx, int16_t dy, 
                                float pid_h, float pid_v, uint8_t state);
 
+/**
+ * @brief  执行排队的串口命令，转发相机端分阶段耗时统计到上位机
+ * @retval None
+ * @note   每次调用执行一条命令；统计格式: CAMS,frames,fps_x10,<min,avg,max>*阶段（单位us）；
+ *         在默认任务中周期调用（命令输出和约100字节统计均为阻塞发送，不放在中断和控制任务中）
+ */
+void SerialDebug_Process(void);
+
 /**
  * @brief  获取数据回传状态
  * @retval 1=开启, 0=关闭
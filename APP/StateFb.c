@@ -0,0 +1,140 @@
+/**
+ * @file    StateFb.c
+ * @brief   状态反馈（LQR/LQG）控制器实现
+ * @details 每次测量：按模型预测偏差 → 卡尔曼更正 → u = -K·x̂ → 输入历史移位。
+ *          增益、模型和L都按测量间隔离散，采样周期应与辨识时一致（rate命令和相机帧率不变）
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "StateFb.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief  检查参数
+ * @param  params: 参数
+ * @retval 1=有效, 0=无效
+ */
+uint8_t StateFb_CheckParams(const StateFbParams *params)
+{
+    if (params->order > STATEFB_ORDER_MAX) return 0;
+    if (!isfinite(params->l) || params->l <= 0.0f || params->l > 1.0f) return 0;
+
+    for (uint8_t i = 0; i <= params->order; i++)
+    {
+        if (!isfinite(params->k[i]) || !isfinite(params->b[i])) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief  初始化控制器
+ * @param  sf: 控制器
+ * @param  params: 参数
+ * @retval None
+ * @note   阶数以上的系数清零，预测和控制律按固定长度循环也不受影响
+ */
+void StateFb_Init(StateFb_Controller *sf, const StateFbParams *params)
+{
+    sf->p = *params;
+    for (uint8_t i = params->order + 1; i <= STATEFB_ORDER_MAX; i++)
+    {
+        sf->p.k[i] = 0.0f;
+        sf->p.b[i] = 0.0f;
+    }
+    sf->dt = 0.02f;
+    sf->deadzone = 0.0f;
+    StateFb_Reset(sf);
+}
+
+/**
+ * @brief  清除估计和输入历史
+ * @param  sf: 控制器
+ * @retval None
+ */
+void StateFb_Reset(StateFb_Controller *sf)
+{
+    sf->e_hat = 0.0f;
+    memset(sf->u_hist, 0, sizeof(sf->u_hist));
+    sf->initialized = 0;
+}
+
+/**
+ * @brief  设置采样周期
+ * @param  sf: 控制器
+ * @param  dt: 本次测量间隔(s)
+ * @retval None
+ */
+void StateFb_SetSampleTime(StateFb_Controller *sf, float dt)
+{
+    if (dt <= 0.0f) return;
+
+    sf->dt = dt;
+}
+
+/**
+ * @brief  计算本次下发角度
+ * @param  sf: 控制器
+ * @param  error: 测量偏差（像素）
+ * @retval 下发角度（度）
+ */
+float StateFb_Calculate(StateFb_Controller *sf, float error)
+{
+    uint8_t n = sf->p.order;
+    float u;
+
+    // 估计：上次估计减去已下发角度的作用，再按L向测量值更正
+    if (!sf->initialized)
+    {
+        sf->e_hat = error;
+        sf->initialized = 1;
+    }
+    else
+    {
+        float predicted = sf->e_hat;
+        for (uint8_t i = 0; i <= n; i++)
+        {
+            predicted -= sf->p.b[i] * sf->u_hist[i];
+        }
+        sf->e_hat = predicted + sf->p.l * (error - predicted);
+    }
+
+    // 控制律：u = -(K0·ê + K1·u[k-1] + ... + Kn·u[k-n])
+    if (fabsf(error) < sf->deadzone)
+    {
+        u = 0.0f;
+    }
+    else
+    {
+        float step_max = STATEFB_RATE_MAX * sf->dt;
+
+        u = -sf->p.k[0] * sf->e_hat;
+        for (uint8_t i = 1; i <= n; i++)
+        {
+            u -= sf->p.k[i] * sf->u_hist[i - 1];
+        }
+        if (u > step_max) u = step_max;
+        if (u < -step_max) u = -step_max;
+    }
+
+    // 输入历史移位（保留n+1项，预测用到u[k-1-n]）
+    for (uint8_t i = n; i > 0; i--)
+    {
+        sf->u_hist[i] = sf->u_hist[i - 1];
+    }
+    sf->u_hist[0] = u;
+
+    return u;
+}
+
+/**
+ * @brief  更正本次实际下发的角度
+ * @param  sf: 控制器
+ * @param  step: 实际下发角度（度）
+ * @retval None
+ */
+void StateFb_SetApplied(StateFb_Controller *sf, float step)
+{
+    sf->u_hist[0] = step;
+}
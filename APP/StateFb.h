@@ -0,0 +1,93 @@
+/**
+ * @file    StateFb.h
+ * @brief   状态反馈（LQR/LQG）控制器头文件
+ * @details PID_Calculate的替代：增益由上位机按辨识的单轴模型综合（host/tools/sf_design.py）。
+ *          模型以测量（相机帧）为采样点，输入为每次下发的相对角度u（度），输出为图像偏差e（像素）：
+ *              e[k+1] = e[k] - (b0·u[k] + b1·u[k-1] + ... + bn·u[k-n])
+ *          系数b的分布同时描述相机/驱动延迟（前几项接近0）和电机加减速（后几项拖尾）。
+ *          状态 x[k] = [e[k], u[k-1], ..., u[k-n]]，控制律 u[k] = -K·x̂[k]；
+ *          输入历史为已知量，只有e需要估计：稳态卡尔曼滤波（当前估计形式）
+ *              ê⁻ = ê[k-1] - Σ b_i·u[k-1-i]，  ê[k] = ê⁻ + L·(e测量 - ê⁻)
+ *          L=1时直接使用测量值（纯LQR）
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _STATE_FB_H
+#define _STATE_FB_H
+
+#include <stdint.h>
+
+#define STATEFB_ORDER_MAX      6        ///< 模型阶数上限（输入历史长度）
+#define STATEFB_RATE_MAX       100.0f   ///< 输出角速度限幅(度/秒)，与PID输出限幅200×0.5相同
+
+/**
+ * @brief 状态反馈参数（上位机综合结果）
+ */
+typedef struct {
+    uint8_t order;                      ///< 阶数n（0~STATEFB_ORDER_MAX）
+    float k[STATEFB_ORDER_MAX + 1];     ///< 反馈增益K[0..n]：K[0]作用于ê（度/像素），K[i]作用于u[k-i]
+    float b[STATEFB_ORDER_MAX + 1];     ///< 模型系数b[0..n]（像素/度）
+    float l;                            ///< 稳态卡尔曼增益（0~1，1=纯LQR）
+} StateFbParams;
+
+/**
+ * @brief 状态反馈控制器
+ */
+typedef struct {
+    StateFbParams p;                        ///< 参数
+    float e_hat;                            ///< 偏差估计ê（像素）
+    float u_hist[STATEFB_ORDER_MAX + 1];    ///< 已下发角度，u_hist[j]=u[k-1-j]（度）
+    uint8_t initialized;                    ///< 0=下一次测量直接作为ê
+    float dt;                               ///< 采样周期(s)，只用于输出限幅
+    float deadzone;                         ///< 死区（像素），由控制任务按PID死区和调度倍率设置
+} StateFb_Controller;
+
+/**
+ * @brief  检查参数
+ * @param  params: 参数
+ * @retval 1=有效, 0=阶数超限、L不在(0,1]或含非有限值
+ */
+uint8_t StateFb_CheckParams(const StateFbParams *params);
+
+/**
+ * @brief  初始化控制器
+ * @param  sf: 控制器
+ * @param  params: 参数（调用前用StateFb_CheckParams检查）
+ * @retval None
+ */
+void StateFb_Init(StateFb_Controller *sf, const StateFbParams *params);
+
+/**
+ * @brief  清除估计和输入历史
+ * @param  sf: 控制器
+ * @retval None
+ */
+void StateFb_Reset(StateFb_Controller *sf);
+
+/**
+ * @brief  设置采样周期
+ * @param  sf: 控制器
+ * @param  dt: 本次测量间隔(s)
+ * @retval None
+ */
+void StateFb_SetSampleTime(StateFb_Controller *sf, float dt);
+
+/**
+ * @brief  计算本次下发角度
+ * @param  sf: 控制器
+ * @param  error: 测量偏差（像素）
+ * @retval 下发角度（度），按STATEFB_RATE_MAX×dt限幅；偏差在死区内时为0（估计照常更新）
+ * @note   返回值记入输入历史；实际下发不同时（锁定停止、辨识激励）用StateFb_SetApplied更正
+ */
+float StateFb_Calculate(StateFb_Controller *sf, float error);
+
+/**
+ * @brief  更正本次实际下发的角度
+ * @param  sf: 控制器
+ * @param  step: 实际下发角度（度）
+ * @retval None
+ */
+void StateFb_SetApplied(StateFb_Controller *sf, float step);
+
+#endif
@@ -0,0 +1,191 @@
+/**
+ * @file    StepGen.c
+ * @brief   STEP脉冲序列规划实现
+ * @details 每段按剩余行程计算期望速度 v = min(最高速度, sqrt(2·a·剩余))，
+ *          实际速度以加速度a向其靠拢（与驱动位置模式的梯形曲线一致），
+ *          段内脉冲数 = |v|·段时长 + 上段余量，到达目标时截断，保证位置精确
+ */
+
+#include "StepGen.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STEPGEN_DT  (STEPGEN_SEGMENT_US * 1e-6f)
+
+// ==================== 内部函数 ====================
+
+/**
+ * @brief  填写一段
+ * @param  g: 规划状态
+ * @param  seg: 段
+ * @param  n: 脉冲数（0=空闲段）
+ */
+static void StepGen_SetSegment(const StepGen *g, StepSegment *seg, uint32_t n)
+{
+    memset(seg->ccr, 0, sizeof(seg->ccr));
+    if (n == 0)
+    {
+        seg->arr = (uint16_t)(g->segment_ticks - 1U);
+        seg->rcr = 0;
+        return;
+    }
+    seg->arr = (uint16_t)(g->segment_ticks / n - 1U);
+    seg->rcr = (uint16_t)(n - 1U);
+    seg->ccr[g->cfg.channel - 1U] = (uint16_t)g->cfg.pulse_ticks;
+}
+
+/**
+ * @brief  规划并填写一块缓冲区
+ * @param  g: 规划状态
+ * @param  b: 缓冲区（0/1），前一块为b^1
+ */
+static void StepGen_Fill(StepGen *g, uint32_t b)
+{
+    uint32_t prev = b ^ 1U;
+    int8_t d = g->buf_dir[prev];
+    uint8_t can_flip = (g->buf_pulses[prev] == 0);
+    int32_t sum = 0;
+    float dv = g->cfg.accel_pps2 * STEPGEN_DT;
+
+    for (uint32_t i = 0; i < STEPGEN_BUF_SEGMENTS; i++)
+    {
+        int32_t remaining = g->target - g->position;
+        float v = g->velocity;
+        float v_goal = 0.0f;
+        uint32_t n;
+
+        if (remaining != 0)
+        {
+            v_goal = sqrtf(2.0f * g->cfg.accel_pps2 * (float)abs(remaining));
+            if (v_goal > g->cfg.max_pps) v_goal = g->cfg.max_pps;
+            if (remaining < 0) v_goal = -v_goal;
+        }
+
+        if (v_goal > v + dv) v += dv;
+        else if (v_goal < v - dv) v -= dv;
+        else v = v_goal;
+
+        // 与本块方向相反：本块还没有脉冲且前一块空闲时换向，否则先停在零速
+        if (v * d < 0.0f)
+        {
+            if (can_flip && sum == 0)
+            {
+                d = (v > 0.0f) ? 1 : -1;
+            }
+            else
+            {
+                v = 0.0f;
+                g->frac = 0.0f;
+            }
+        }
+
+        float pf = fabsf(v) * STEPGEN_DT + g->frac;
+        n = (uint32_t)pf;
+        g->frac = pf - (float)n;
+        if (n > STEPGEN_RCR_MAX) n = STEPGEN_RCR_MAX;
+
+        // 目标在前方且本段会越过：截断到目标并停止
+        if (d * remaining >= 0 && n >= (uint32_t)(d * remaining))
+        {
+            n = (uint32_t)(d * remaining);
+            v = 0.0f;
+            g->frac = 0.0f;
+        }
+
+        g->velocity = v;
+        g->position += d * (int32_t)n;
+        sum += d * (int32_t)n;
+        StepGen_SetSegment(g, &g->buf[b][i], n);
+    }
+
+    g->buf_dir[b] = d;
+    g->buf_pulses[b] = sum;
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  初始化规划状态，两块缓冲区填空闲段
+ * @param  g: 规划状态
+ * @param  cfg: 规划参数
+ * @retval None
+ */
+void StepGen_Init(StepGen *g, const StepGenConfig *cfg)
+{
+    memset(g, 0, sizeof(*g));
+    g->cfg = *cfg;
+    g->segment_ticks = (uint16_t)((uint64_t)cfg->tick_hz * STEPGEN_SEGMENT_US / 1000000U);
+    g->dir = 1;
+    g->buf_dir[0] = 1;
+    g->buf_dir[1] = 1;
+    for (uint32_t i = 0; i < STEPGEN_BUF_SEGMENTS; i++)
+    {
+        StepGen_SetSegment(g, &g->buf[0][i], 0);
+        StepGen_SetSegment(g, &g->buf[1][i], 0);
+    }
+}
+
+/**
+ * @brief  目标位置增加若干脉冲
+ * @param  g: 规划状态
+ * @param  pulses: 脉冲数（带符号）
+ * @retval None
+ */
+void StepGen_Move(StepGen *g, int32_t pulses)
+{
+    __disable_irq();
+    g->target += pulses;
+    __enable_irq();
+}
+
+/**
+ * @brief  立即停止
+ * @param  g: 规划状态
+ * @retval None
+ */
+void StepGen_Stop(StepGen *g)
+{
+    __disable_irq();
+    g->target = g->position;
+    g->velocity = 0.0f;
+    g->frac = 0.0f;
+    __enable_irq();
+}
+
+/**
+ * @brief  减速停止
+ * @param  g: 规划状态
+ * @retval None
+ * @note   刹车距离 v^2/(2a) 向上取整，规划按 sqrt(2a·剩余) 的期望速度正好减到零
+ */
+void StepGen_Decelerate(StepGen *g)
+{
+    __disable_irq();
+    float v = g->velocity;
+    int32_t dist = (int32_t)ceilf(v * v / (2.0f * g->cfg.accel_pps2));
+    g->target = g->position + ((v < 0.0f) ? -dist : dist);
+    __enable_irq();
+}
+
+/**
+ * @brief  一块缓冲区已被DMA取完，重填该缓冲区
+ * @param  g: 规划状态
+ * @param  done: 已取完的缓冲区（0/1）
+ * @retval 需要切换的DIR（+1/-1），0=不变
+ */
+int8_t StepGen_OnBufferDone(StepGen *g, uint32_t done)
+{
+    uint32_t next = done ^ 1U;
+    int8_t flip = 0;
+
+    // 下一块即将开始发出，done剩余的段没有脉冲时才会出现换向
+    if (g->buf_dir[next] != g->dir)
+    {
+        g->dir = g->buf_dir[next];
+        flip = g->dir;
+    }
+
+    StepGen_Fill(g, done);
+    return flip;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file    StepGen.h
+ * @brief   STEP脉冲序列规划头文件
+ * @details 与硬件无关的单轴脉冲规划：控制任务给出目标位置（脉冲数），中断中按加速度限制的
+ *          速度曲线逐段生成定时器参数表（周期、重复次数、比较值），供DMA突发写入定时器。
+ *          - 每段时长约STEPGEN_SEGMENT_US，段内脉冲等间隔，用重复计数器发出n个脉冲
+ *          - 两块缓冲区交替（DMA双缓冲），一块发出时重填另一块
+ *          - 每块缓冲区方向一致；换向时前一块必须没有脉冲，保证DIR在两段空闲之间切换
+ *          - 已规划的脉冲全部计入位置计数，不丢步、不多步
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _STEPGEN_H
+#define _STEPGEN_H
+
+#include "stm32f4xx_hal.h"
+
+#define STEPGEN_SEGMENT_US    500   ///< 每段时长(us)
+#define STEPGEN_BUF_SEGMENTS  2     ///< 每块缓冲区的段数
+#define STEPGEN_RCR_MAX       256   ///< 单段最多脉冲数（8位重复计数器）
+
+/**
+ * @brief 一段脉冲参数（与定时器ARR、RCR、CCR1~CCR3寄存器顺序一致，DMA突发写入）
+ * @note  CCRx=0时本段无脉冲（空闲段）
+ */
+typedef struct {
+    uint16_t arr;       ///< 脉冲周期-1（定时器计数）
+    uint16_t rcr;       ///< 脉冲个数-1
+    uint16_t ccr[3];    ///< CH1~CH3比较值（只使用配置的通道）
+} StepSegment;
+
+/**
+ * @brief 规划参数
+ */
+typedef struct {
+    uint32_t tick_hz;       ///< 定时器计数频率(Hz)
+    uint32_t pulse_ticks;   ///< STEP高电平宽度（定时器计数）
+    uint8_t  channel;       ///< 输出通道（1~3）
+    float    max_pps;       ///< 最高速度(脉冲/s)
+    float    accel_pps2;    ///< 加速度(脉冲/s^2)
+} StepGenConfig;
+
+/**
+ * @brief 单轴规划状态
+ */
+typedef struct {
+    StepGenConfig cfg;
+    StepSegment buf[2][STEPGEN_BUF_SEGMENTS];   ///< DMA双缓冲
+    int32_t buf_pulses[2];      ///< 各缓冲区的脉冲数（带符号）
+    int8_t  buf_dir[2];         ///< 各缓冲区的方向（+1/-1）
+    int8_t  dir;                ///< 当前DIR输出（+1/-1）
+    volatile int32_t target;    ///< 目标位置（脉冲）
+    volatile int32_t position;  ///< 已规划的位置（脉冲）
+    float   velocity;           ///< 当前速度（脉冲/s，带符号）
+    float   frac;               ///< 不足一个脉冲的余量
+    uint16_t segment_ticks;     ///< 一段的定时器计数
+} StepGen;
+
+/**
+ * @brief  初始化规划状态，两块缓冲区填空闲段
+ * @param  g: 规划状态
+ * @param  cfg: 规划参数
+ * @retval None
+ */
+void StepGen_Init(StepGen *g, const StepGenConfig *cfg);
+
+/**
+ * @brief  目标位置增加若干脉冲
+ * @param  g: 规划状态
+ * @param  pulses: 脉冲数（带符号）
+ * @retval None
+ * @note   在任务中调用；速度曲线连续衔接，不会先停再走
+ */
+void StepGen_Move(StepGen *g, int32_t pulses);
+
+/**
+ * @brief  立即停止：目标设为已规划位置，速度清零
+ * @param  g: 规划状态
+ * @retval None
+ * @note   已写入缓冲区的段（最多两块）仍会发出
+ */
+void StepGen_Stop(StepGen *g);
+
+/**
+ * @brief  减速停止：目标设为以当前速度按加速度减到零的位置
+ * @param  g: 规划状态
+ * @retval None
+ * @note   在任务中调用；速度曲线按规划的减速段下降，不会在高速时截断脉冲
+ */
+void StepGen_Decelerate(StepGen *g);
+
+/**
+ * @brief  一块缓冲区已被DMA取完，重填该缓冲区
+ * @param  g: 规划状态
+ * @param  done: 已取完的缓冲区（0/1）
+ * @retval 需要切换的DIR（+1/-1），0=不变
+ * @note   在DMA传输完成中断中调用；返回非0时调用者立即设置DIR引脚
+ *         （此时正在发出的是done中的最后几段，换向规则保证它们没有脉冲）
+ */
+int8_t StepGen_OnBufferDone(StepGen *g, uint32_t done);
+
+#endif
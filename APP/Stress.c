@@ -0,0 +1,355 @@
+/**
+ * @file    Stress.c
+ * @brief   压力测试模式实现
+ * @details 测试期间:
+ *          - 默认任务循环: 下发一帧USART1回环帧（中断发送），再阻塞发送一行USART2遥测
+ *            "STRESS,序号,已运行ms,最大周期us,最大执行us,超时次数"，两路串口始终满载
+ *          - 控制任务: 唤醒后先读取两轴实时位置（上一周期运动命令的应答此时已到，
+ *            读取前清除ORE即可丢弃），再执行Gimbal_ControlTask
+ *          - 负载任务（osPriorityRealtime）: 每个tick忙等随机时长，平均占用cpu_pct%
+ *          报告中附控制任务和默认任务的栈余量（上电以来的最小值，uxTaskGetStackHighWaterMark）
+ *
+ * @note    控制周期和执行时间用DWT计时；中断延迟取SysTick入口处的计数值
+ *          （LOAD-VAL），SysTick为最低优先级中断，测得的是其他中断和临界区造成的最坏阻塞。
+ *          USART2满载期间命令回显可能丢失，stress stop仍会执行
+ */
+
+#include "Stress.h"
+#include "GimbalControl.h"
+#include "Motor.h"
+#include "Camera.h"
+#include "Timing.h"
+#include "SerialDebug.h"
+#include "cmsis_os.h"
+#include <stdio.h>
+
+#define STRESS_LOAD_TICK_US  1000   // 负载任务节拍(us)，与1ms tick一致
+#define STRESS_LOAD_MAX_US   950    // 单次忙等上限(us)，每个tick至少让出一部分
+
+// 统计（周期、执行时间单位us；中断延迟单位CPU周期）
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} StressStat;
+
+static StressStat stat_period;
+static StressStat stat_exec;
+static StressStat stat_isr;
+static volatile uint32_t stress_misses = 0;
+static uint32_t poll_ok = 0;
+static uint32_t poll_fail = 0;
+static uint32_t ctrl_stack_free = 0;   // 控制任务栈最小余量(字节)，0=未采样
+
+// 控制任务计时
+static uint32_t wake_cycles = 0;
+static uint8_t wake_valid = 0;
+
+// 运行状态
+static volatile uint8_t stress_active = 0;
+static volatile uint8_t stop_requested = 0;
+static volatile uint32_t pending_seconds = 0;
+static volatile uint32_t pending_cpu = 0;
+
+// 负载任务
+static volatile uint8_t load_running = 0;
+static volatile uint8_t load_exited = 0;
+static uint32_t load_seed = 12345;
+static const osThreadAttr_t stress_load_attributes = {
+    .name = "StressLoad",
+    .stack_size = 128 * 4,
+    .priority = (osPriority_t) osPriorityRealtime,
+};
+
+// ==================== 内部函数 ====================
+
+static void Stress_StatReset(StressStat *s)
+{
+    s->count = 0;
+    s->min = 0xFFFFFFFFU;
+    s->max = 0;
+    s->sum = 0;
+}
+
+static void Stress_StatAdd(StressStat *s, uint32_t value)
+{
+    s->count++;
+    s->sum += value;
+    if (value < s->min) s->min = value;
+    if (value > s->max) s->max = value;
+}
+
+static uint32_t Stress_StatAvg(const StressStat *s)
+{
+    return s->count ? (uint32_t)(s->sum / s->count) : 0;
+}
+
+/**
+ * @brief  CPU周期换算为纳秒
+ */
+static uint32_t Stress_CyclesToNs(uint32_t cycles)
+{
+    return (uint32_t)((uint64_t)cycles * 1000U / (SystemCoreClock / 1000000U));
+}
+
+/**
+ * @brief  合成CPU负载任务
+ * @param  argument: 平均占用率(%)
+ * @note   每个tick忙等[0.5, 1.5]×平均时长的随机时间，测试结束后自行退出
+ */
+static void Stress_LoadTask(void *argument)
+{
+    uint32_t pct = (uint32_t)(uintptr_t)argument;
+    uint32_t mean_us = STRESS_LOAD_TICK_US * pct / 100U;
+
+    while (load_running)
+    {
+        load_seed = load_seed * 1103515245U + 12345U;
+        uint32_t burn_us = mean_us / 2U + ((load_seed >> 16) % (mean_us + 1U));
+        if (burn_us > STRESS_LOAD_MAX_US) burn_us = STRESS_LOAD_MAX_US;
+
+        uint32_t start = Timing_GetCycles();
+        while (Timing_CyclesToUs(Timing_GetCycles() - start) < burn_us) {}
+
+        osDelay(1);
+    }
+
+    load_exited = 1;
+    osThreadExit();
+}
+
+/**
+ * @brief  打印一项统计
+ */
+static void Stress_PrintStat(const char *name, const StressStat *s, const char *unit)
+{
+    if (s->count == 0)
+    {
+        SerialDebug_Printf("  %-7s n=0\r\n", name);
+        return;
+    }
+    SerialDebug_Printf("  %-7s n=%-6lu min=%-7lu avg=%-7lu max=%lu %s\r\n", name,
+                       (unsigned long)s->count, (unsigned long)s->min, (unsigned long)Stress_StatAvg(s),
+                       (unsigned long)s->max, unit);
+}
+
+/**
+ * @brief  打印测试结果
+ */
+static void Stress_PrintReport(uint32_t elapsed_ms, uint32_t cpu_pct, uint32_t usart2_bytes,
+                               uint32_t usart1_bytes, uint32_t loop_frames, uint32_t loop_sent)
+{
+    uint32_t nominal_us = Gimbal_GetPeriodMs() * 1000U;
+    StressStat isr_ns = stat_isr;
+
+    SerialDebug_Printf("\r\n=== Stress (%lu ms, cpu %lu%%, %.0f Hz) ===\r\n",
+                       (unsigned long)elapsed_ms, (unsigned long)cpu_pct, Gimbal_GetRate());
+    Stress_PrintStat("period", &stat_period, "us");
+    if (stat_period.count)
+    {
+        SerialDebug_Printf("  jitter  +%lu/-%lu us (nominal %lu us)\r\n",
+                           (unsigned long)((stat_period.max > nominal_us) ? stat_period.max - nominal_us : 0),
+                           (unsigned long)((stat_period.min < nominal_us) ? nominal_us - stat_period.min : 0),
+                           (unsigned long)nominal_us);
+    }
+    Stress_PrintStat("exec", &stat_exec, "us");
+
+    isr_ns.min = Stress_CyclesToNs(stat_isr.min);
+    isr_ns.max = Stress_CyclesToNs(stat_isr.max);
+    isr_ns.sum = Stress_CyclesToNs(Stress_StatAvg(&stat_isr)) * (uint64_t)stat_isr.count;
+    Stress_PrintStat("isr", &isr_ns, "ns");
+
+    SerialDebug_Printf("  misses  %lu\r\n", (unsigned long)stress_misses);
+    SerialDebug_Printf("  polls   ok=%lu fail=%lu\r\n", (unsigned long)poll_ok, (unsigned long)poll_fail);
+    SerialDebug_Printf("  usart2  %lu B/s\r\n", (unsigned long)(elapsed_ms ? usart2_bytes * 1000U / elapsed_ms : 0));
+    SerialDebug_Printf("  usart1  %lu B/s, loopback %lu/%lu\r\n",
+                       (unsigned long)(elapsed_ms ? usart1_bytes * 1000U / elapsed_ms : 0), (unsigned long)loop_frames,
+                       (unsigned long)loop_sent);
+    SerialDebug_Printf("  stack   ctrl %lu B free, default %lu B free (min since boot)\r\n",
+                       (unsigned long)ctrl_stack_free,
+                       (unsigned long)(uxTaskGetStackHighWaterMark(NULL) * sizeof(StackType_t)));
+    SerialDebug_Printf("====================================\r\n\n");
+}
+
+// ==================== 对外接口 ====================
+
+/**
+ * @brief  提交压力测试请求
+ * @param  seconds: 持续时间(s)
+ * @param  cpu_pct: 合成CPU负载(%)
+ * @retval 1=已受理, 0=参数无效或忙
+ */
+uint8_t Stress_Request(uint32_t seconds, uint32_t cpu_pct)
+{
+    if (seconds == 0 || seconds > STRESS_SECONDS_MAX || cpu_pct > STRESS_CPU_MAX) return 0;
+    if (pending_seconds != 0) return 0;
+
+    pending_cpu = cpu_pct;
+    pending_seconds = seconds;
+    return 1;
+}
+
+/**
+ * @brief  提前结束压力测试
+ * @retval None
+ */
+void Stress_Stop(void)
+{
+    stop_requested = 1;
+}
+
+/**
+ * @brief  是否正在进行压力测试
+ * @retval 1=进行中, 0=空闲
+ */
+uint8_t Stress_IsActive(void)
+{
+    return pending_seconds != 0;
+}
+
+/**
+ * @brief  执行挂起的压力测试
+ * @retval None
+ */
+void Stress_Process(void)
+{
+    uint32_t seconds = pending_seconds;
+    uint32_t cpu_pct = pending_cpu;
+    uint32_t seq = 0, usart2_bytes = 0, usart1_bytes = 0, loop_sent = 0;
+    uint32_t loop_base, start, elapsed;
+    char line[64];
+
+    if (seconds == 0) return;
+
+    SerialDebug_Printf("Stress test: %lu s, cpu %lu%%, tracking %s\r\n", (unsigned long)seconds, (unsigned long)cpu_pct,
+                       Gimbal_IsEnabled() ? "on" : "off (no position polling)");
+
+    Stress_StatReset(&stat_period);
+    Stress_StatReset(&stat_exec);
+    Stress_StatReset(&stat_isr);
+    stress_misses = 0;
+    poll_ok = 0;
+    poll_fail = 0;
+    wake_valid = 0;
+    stop_requested = 0;
+    loop_base = Camera_GetLoopbackCount();
+
+    if (cpu_pct > 0)
+    {
+        load_running = 1;
+        load_exited = 0;
+        if (osThreadNew(Stress_LoadTask, (void *)(uintptr_t)cpu_pct, &stress_load_attributes) == NULL)
+        {
+            SerialDebug_Printf("Warning: load task not created (heap), cpu load 0%%\r\n");
+            load_running = 0;
+            cpu_pct = 0;
+        }
+    }
+
+    stress_active = 1;
+    start = HAL_GetTick();
+    elapsed = 0;
+    while (!stop_requested && elapsed < seconds * 1000U)
+    {
+        uint32_t n = Camera_SendLoopback(seq);
+        if (n)
+        {
+            usart1_bytes += n;
+            loop_sent++;
+        }
+
+        int len = snprintf(line, sizeof(line), "STRESS,%lu,%lu,%lu,%lu,%lu\r\n",
+                           (unsigned long)seq, (unsigned long)elapsed, (unsigned long)stat_period.max,
+                           (unsigned long)stat_exec.max, (unsigned long)stress_misses);
+        if (len > 0 && len < (int)sizeof(line))
+        {
+            SerialDebug_Printf("%s", line);
+            usart2_bytes += (uint32_t)len;
+        }
+        seq++;
+        elapsed = HAL_GetTick() - start;
+    }
+    stress_active = 0;
+
+    if (cpu_pct > 0)
+    {
+        load_running = 0;
+        while (!load_exited) osDelay(1);
+    }
+
+    // 等最后一帧回环帧回送
+    osDelay(10);
+    Stress_PrintReport(elapsed, cpu_pct, usart2_bytes, usart1_bytes,
+                       Camera_GetLoopbackCount() - loop_base, loop_sent);
+    pending_seconds = 0;
+}
+
+/**
+ * @brief  控制任务唤醒钩子
+ * @retval None
+ */
+void Stress_OnControlWake(void)
+{
+    uint32_t now = Timing_GetCycles();
+    float angle;
+
+    if (!stress_active)
+    {
+        wake_valid = 0;
+        return;
+    }
+
+    if (wake_valid)
+    {
+        Stress_StatAdd(&stat_period, Timing_CyclesToUs(now - wake_cycles));
+    }
+    wake_cycles = now;
+    wake_valid = 1;
+
+    // 位置反馈轮询：仅跟踪时执行（关闭跟踪时电机串口可能被其他命令占用）
+    if (Gimbal_IsEnabled())
+    {
+        if (Motor_ReadPosition(MOTOR_ID_HORIZONTAL, &angle)) poll_ok++;
+        else poll_fail++;
+        if (Motor_ReadPosition(MOTOR_ID_VERTICAL, &angle)) poll_ok++;
+        else poll_fail++;
+    }
+}
+
+/**
+ * @brief  控制任务完成钩子
+ * @retval None
+ */
+void Stress_OnControlDone(void)
+{
+    if (!stress_active || !wake_valid) return;
+
+    Stress_StatAdd(&stat_exec, Timing_CyclesToUs(Timing_GetCycles() - wake_cycles));
+
+    // 栈余量扫描放在计时之后（在控制任务中取当前任务的值）
+    ctrl_stack_free = uxTaskGetStackHighWaterMark(NULL) * sizeof(StackType_t);
+}
+
+/**
+ * @brief  控制周期超时钩子
+ * @retval None
+ */
+void Stress_OnOverrun(void)
+{
+    if (!stress_active) return;
+
+    stress_misses++;
+}
+
+/**
+ * @brief  记录一次中断进入延迟
+ * @param  cycles: CPU周期数
+ * @retval None
+ */
+void Stress_RecordIsrLatency(uint32_t cycles)
+{
+    if (!stress_active) return;
+
+    Stress_StatAdd(&stat_isr, cycles);
+}
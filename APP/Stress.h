@@ -0,0 +1,81 @@
+/**
+ * @file    Stress.h
+ * @brief   压力测试模式头文件
+ * @details 在最坏I/O负载下测量控制环的实时性：
+ *          - USART2: 默认任务以最高速率连续发送STRESS遥测行
+ *          - USART3/6: 控制任务每周期开始时读取两轴实时位置（需先enable）
+ *          - USART1: 连续下发"L,..."回环帧，相机（或TX-RX短接）原样回送
+ *          - CPU: 最高优先级负载任务每个tick随机占用CPU，平均占用率可设
+ *          期间记录控制周期抖动、控制任务执行时间、SysTick中断进入延迟和超时次数
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _STRESS_H
+#define _STRESS_H
+
+#include "stm32f4xx_hal.h"
+
+#define STRESS_SECONDS_DEFAULT  10    ///< 默认持续时间(s)
+#define STRESS_SECONDS_MAX      600   ///< 最长持续时间(s)
+#define STRESS_CPU_MAX          90    ///< 合成CPU负载上限(%)
+
+/**
+ * @brief  提交压力测试请求
+ * @param  seconds: 持续时间(s)，1~STRESS_SECONDS_MAX
+ * @param  cpu_pct: 合成CPU负载(%)，0~STRESS_CPU_MAX
+ * @retval 1=已受理, 0=参数无效或测试进行中
+ * @note   可在中断中调用
+ */
+uint8_t Stress_Request(uint32_t seconds, uint32_t cpu_pct);
+
+/**
+ * @brief  提前结束压力测试
+ * @retval None
+ * @note   可在中断中调用；结果照常输出
+ */
+void Stress_Stop(void);
+
+/**
+ * @brief  是否正在进行压力测试
+ * @retval 1=进行中, 0=空闲
+ */
+uint8_t Stress_IsActive(void);
+
+/**
+ * @brief  执行挂起的压力测试
+ * @retval None
+ * @note   在默认任务中周期调用，测试期间阻塞（发送USART2/USART1负载），结束后输出结果
+ */
+void Stress_Process(void);
+
+/**
+ * @brief  控制任务唤醒钩子
+ * @retval None
+ * @note   在控制任务每周期开始时（Gimbal_ControlTask之前）调用：记录周期，测试期间读取两轴位置
+ */
+void Stress_OnControlWake(void);
+
+/**
+ * @brief  控制任务完成钩子
+ * @retval None
+ * @note   在Gimbal_ControlTask之后调用，记录本周期执行时间
+ */
+void Stress_OnControlDone(void);
+
+/**
+ * @brief  控制周期超时钩子
+ * @retval None
+ * @note   与Gimbal_NotifyOverrun一起调用
+ */
+void Stress_OnOverrun(void);
+
+/**
+ * @brief  记录一次中断进入延迟
+ * @param  cycles: 从中断触发到进入处理函数的CPU周期数
+ * @retval None
+ * @note   在SysTick_Handler入口调用（SysTick为最低优先级，反映其他中断和临界区造成的延迟）
+ */
+void Stress_RecordIsrLatency(uint32_t cycles);
+
+#endif
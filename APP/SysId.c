@@ -0,0 +1,133 @@
+/**
+ * @file    SysId.c
+ * @brief   单轴模型辨识数据采集实现
+ * @details 状态：空闲 → 已请求（串口中断）→ 采集中（控制任务）→ 采集完成（控制任务）→ 输出后空闲（默认任务）
+ *          激励为9位线性反馈移位寄存器（x^9+x^5+1，周期511）每次测量一位，±幅度，
+ *          频谱平坦，覆盖从测量频率的一半到很低的频率
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "SysId.h"
+#include "SerialDebug.h"
+#include <stdio.h>
+
+typedef enum {
+    SYSID_IDLE = 0,
+    SYSID_REQUESTED,
+    SYSID_RUNNING,
+    SYSID_DONE
+} SysIdState;
+
+typedef struct {
+    float error;        ///< 图像偏差（像素）
+    float step;         ///< 实际下发角度（度）
+    uint16_t dt_ms;     ///< 测量间隔(ms)
+    int8_t dither;      ///< 激励符号（±1）
+} SysIdSample;
+
+static volatile SysIdState sysid_state = SYSID_IDLE;
+static GimbalAxis sysid_axis = GIMBAL_AXIS_H;
+static uint32_t sysid_target = 0;     // 请求的样本数
+static float sysid_amp = SYSID_AMP_DEFAULT;
+static uint16_t sysid_lfsr = 1;
+static uint32_t sysid_count = 0;
+static SysIdSample sysid_samples[SYSID_SAMPLES_MAX];
+
+/**
+ * @brief  提交采集请求
+ * @param  axis: 激励的轴
+ * @param  samples: 样本数
+ * @param  amp: 激励幅度（度）
+ * @retval 1=已受理, 0=参数无效或忙
+ */
+uint8_t SysId_Request(GimbalAxis axis, uint32_t samples, float amp)
+{
+    if (samples == 0 || samples > SYSID_SAMPLES_MAX) return 0;
+    if (amp < SYSID_AMP_MIN || amp > SYSID_AMP_MAX) return 0;
+    if (sysid_state != SYSID_IDLE) return 0;
+
+    sysid_axis = axis;
+    sysid_target = samples;
+    sysid_amp = amp;
+    sysid_state = SYSID_REQUESTED;
+    return 1;
+}
+
+/**
+ * @brief  叠加激励并记录一次测量
+ * @retval 1=正在采集, 0=未采集
+ */
+uint8_t SysId_Step(float error_h, float error_v, uint32_t dt_ms, float *step_h, float *step_v)
+{
+    float *step = (sysid_axis == GIMBAL_AXIS_H) ? step_h : step_v;
+    SysIdSample *sample;
+    uint16_t bit;
+
+    if (sysid_state == SYSID_REQUESTED)
+    {
+        sysid_count = 0;
+        sysid_lfsr = 1;
+        sysid_state = SYSID_RUNNING;
+    }
+    if (sysid_state != SYSID_RUNNING) return 0;
+
+    bit = ((sysid_lfsr >> 8) ^ (sysid_lfsr >> 4)) & 1U;
+    sysid_lfsr = (uint16_t)(((sysid_lfsr << 1) | bit) & 0x1FFU);
+    *step += bit ? sysid_amp : -sysid_amp;
+
+    sample = &sysid_samples[sysid_count++];
+    sample->error = (sysid_axis == GIMBAL_AXIS_H) ? error_h : error_v;
+    sample->step = *step;
+    sample->dt_ms = (uint16_t)dt_ms;
+    sample->dither = bit ? 1 : -1;
+
+    if (sysid_count >= sysid_target)
+    {
+        sysid_state = SYSID_DONE;
+    }
+    return 1;
+}
+
+/**
+ * @brief  是否正在采集
+ * @retval 1=正在采集
+ */
+uint8_t SysId_IsRunning(void)
+{
+    return sysid_state == SYSID_RUNNING;
+}
+
+/**
+ * @brief  提前结束采集
+ * @retval None
+ */
+void SysId_Stop(void)
+{
+    if (sysid_state == SYSID_RUNNING || sysid_state == SYSID_REQUESTED)
+    {
+        if (sysid_state == SYSID_REQUESTED) sysid_count = 0;
+        sysid_state = SYSID_DONE;
+    }
+}
+
+/**
+ * @brief  输出采集结果
+ * @retval None
+ * @note   每行约30字节，500个样本在115200波特率下约1.3s，期间默认任务阻塞
+ */
+void SysId_Process(void)
+{
+    if (sysid_state != SYSID_DONE) return;
+
+    SerialDebug_Printf("ID begin %c n=%lu amp=%.3f rate=%.1f\r\n", (sysid_axis == GIMBAL_AXIS_H) ? 'h' : 'v',
+                       (unsigned long)sysid_count, sysid_amp, Gimbal_GetRate());
+    for (uint32_t i = 0; i < sysid_count; i++)
+    {
+        const SysIdSample *sample = &sysid_samples[i];
+        SerialDebug_Printf("ID %lu %u %.2f %.4f %+.3f\r\n", (unsigned long)i, sample->dt_ms, sample->error,
+                           sample->step, sample->dither * sysid_amp);
+    }
+    SerialDebug_Printf("ID end\r\n");
+    sysid_state = SYSID_IDLE;
+}
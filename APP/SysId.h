@@ -0,0 +1,68 @@
+/**
+ * @file    SysId.h
+ * @brief   单轴模型辨识数据采集头文件
+ * @details 跟踪静止目标时在一个轴的下发角度上叠加伪随机二值序列(PRBS)激励，
+ *          每次测量记录 (测量间隔, 图像偏差, 实际下发角度, 激励)，采满后在默认任务中输出：
+ *              ID begin <h|v> n=<样本数> amp=<幅度> rate=<控制频率>
+ *              ID <序号> <间隔ms> <偏差px> <下发角度deg> <激励deg>
+ *              ID end
+ *          闭环采集（当前控制器照常工作，目标不会移出视场），由host/tools/sf_design.py拟合模型；
+ *          闭环中下发角度与测量噪声相关，拟合以与噪声无关的激励序列作为工具变量
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _SYS_ID_H
+#define _SYS_ID_H
+
+#include "GimbalControl.h"
+
+#define SYSID_SAMPLES_DEFAULT  300      ///< 默认样本数（30fps约10s）
+#define SYSID_SAMPLES_MAX      500      ///< 最大样本数
+#define SYSID_AMP_DEFAULT      0.5f     ///< 默认激励幅度(度/次测量)
+#define SYSID_AMP_MIN          0.05f
+#define SYSID_AMP_MAX          2.0f
+
+/**
+ * @brief  提交采集请求
+ * @param  axis: 激励的轴
+ * @param  samples: 样本数（1~SYSID_SAMPLES_MAX）
+ * @param  amp: 激励幅度（度）
+ * @retval 1=已受理, 0=参数无效或上一次采集尚未输出完
+ * @note   可在中断中调用；跟踪开启且视野中有静止目标时，从下一次测量开始采集
+ */
+uint8_t SysId_Request(GimbalAxis axis, uint32_t samples, float amp);
+
+/**
+ * @brief  叠加激励并记录一次测量
+ * @param  error_h: 水平偏差（像素，滚转补偿后、不含提前量）
+ * @param  error_v: 垂直偏差（像素）
+ * @param  dt_ms: 测量间隔(ms)
+ * @param  step_h: 水平下发角度（度，输入控制器输出，返回叠加激励后的值）
+ * @param  step_v: 垂直下发角度（度）
+ * @retval 1=正在采集, 0=未采集（角度不变）
+ * @note   在控制任务中下发运动命令前调用
+ */
+uint8_t SysId_Step(float error_h, float error_v, uint32_t dt_ms, float *step_h, float *step_v);
+
+/**
+ * @brief  是否正在采集
+ * @retval 1=正在采集（控制任务不进入锁定停止，保证激励持续下发）
+ */
+uint8_t SysId_IsRunning(void);
+
+/**
+ * @brief  提前结束采集
+ * @retval None
+ * @note   在控制任务中调用（跟踪关闭、目标丢失），已采集的样本照常输出
+ */
+void SysId_Stop(void);
+
+/**
+ * @brief  输出采集结果
+ * @retval None
+ * @note   在默认任务中周期调用
+ */
+void SysId_Process(void);
+
+#endif
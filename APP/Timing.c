@@ -0,0 +1,43 @@
+/**
+ * @file    Timing.c
+ * @brief   高精度时间戳实现
+ * @details 使用Cortex-M4 DWT周期计数器，无需占用定时器
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "Timing.h"
+
+static uint32_t cycles_per_us = 168;
+
+/**
+ * @brief  使能DWT周期计数器
+ * @retval None
+ */
+void Timing_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    cycles_per_us = SystemCoreClock / 1000000U;
+}
+
+/**
+ * @brief  读取当前周期计数
+ * @retval CPU周期数
+ */
+uint32_t Timing_GetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief  周期数换算为微秒
+ * @param  cycles: 周期数
+ * @retval 微秒
+ */
+uint32_t Timing_CyclesToUs(uint32_t cycles)
+{
+    return cycles / cycles_per_us;
+}
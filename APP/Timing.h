@@ -0,0 +1,35 @@
+/**
+ * @file    Timing.h
+ * @brief   高精度时间戳头文件
+ * @details 基于DWT周期计数器(CYCCNT)，168MHz下分辨率约6ns，约25.5s回绕一次；
+ *          用于测量比1ms tick更短的时间间隔（差值按无符号减法计算，可跨回绕）
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _TIMING_H
+#define _TIMING_H
+
+#include "stm32f4xx_hal.h"
+
+/**
+ * @brief  使能DWT周期计数器
+ * @retval None
+ * @note   在HAL_Init/时钟配置之后调用一次
+ */
+void Timing_Init(void);
+
+/**
+ * @brief  读取当前周期计数
+ * @retval CPU周期数（可在中断中调用）
+ */
+uint32_t Timing_GetCycles(void);
+
+/**
+ * @brief  周期数换算为微秒
+ * @param  cycles: 周期数（通常为两次Timing_GetCycles的差）
+ * @retval 微秒
+ */
+uint32_t Timing_CyclesToUs(uint32_t cycles);
+
+#endif
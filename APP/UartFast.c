@@ -0,0 +1,576 @@
+/**
+ * @file    UartFast.c
+ * @brief   串口寄存器级快速收发实现
+ * @details CubeMX生成的MX_USARTx_UART_Init/HAL_UART_MspInit完成波特率、引脚、DMA通道和NVIC配置，
+ *          本模块只在其上开关中断/DMA请求并直接读写SR/DR：
+ *          - DMA接收：流配置为循环模式，中断中按NDTR算出写入位置，把上次位置之后的字节逐个交给处理函数。
+ *            IDLE在一帧结束后约一个字节时间置位；DMA半满/满中断保证连续数据时缓冲区不被覆盖。
+ *            中断被长时间推迟（临界区、更高优先级中断）时DMA可能已绕过读取位置一圈，只看NDTR无法区分：
+ *            每次取数据时同时取走HT/TC标志，与读取位置到写入位置之间应经过的半满/满边界比较，
+ *            多出的边界说明已绕圈，计入rx_errors并丢弃缓冲区中的数据
+ *          - RXNE接收：读SR一次、读DR一次（同时清除ORE），帧错误/噪声的字节丢弃
+ *          - 环形发送：关中断下整帧拷入后使能TXE，中断中每次写一个字节，空时关闭TXE
+ *          - DMA发送：普通模式，流EN位自动清零即表示数据已全部写入DR，下一帧开始前不需要中断；
+ *            启动前清除TC，UartFast_Flush等待TC确认最后一个字节发完
+ *          - 阻塞发送：轮询TXE写DR。调试串口的阻塞发送被中断打断时，中断中的输出写入暂存区，
+ *            由被打断的发送在返回前补发（整段输出之间不交错）
+ *          - 故障注入：接收字节、轮询接收结果和发送帧在对应方向设置了故障时先经过FaultInject
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "UartFast.h"
+#include "FaultInject.h"
+#include "stm32f4xx_ll_usart.h"
+#include "stm32f4xx_ll_dma.h"
+
+#define UART_FAST_RX_MASK      (UART_FAST_RX_RING_LEN - 1U)
+#define UART_FAST_TX_MASK      (UART_FAST_TX_RING_LEN - 1U)
+#define UART_FAST_PENDING_MASK (UART_FAST_WRITE_PENDING_LEN - 1U)
+
+static const uint8_t uart_fast_dropped_mark[] = "\r\n[output dropped]\r\n";
+
+// DMA流中断标志（FEIF/DMEIF/TEIF/HTIF/TCIF，按流号偏移）
+#define UART_FAST_DMA_FLAGS    0x3DU
+#define UART_FAST_DMA_HT       0x10U
+#define UART_FAST_DMA_TC       0x20U
+
+#define UART_FAST_RX_ERRORS    (USART_SR_ORE | USART_SR_NE | USART_SR_FE)
+
+/**
+ * @brief 串口硬件配置
+ */
+typedef struct {
+    USART_TypeDef *usart;
+    DMA_TypeDef *dma;          // 接收或发送DMA控制器，NULL=不用DMA
+    uint32_t stream;           // LL_DMA_STREAM_x
+    uint8_t *rx_ring;          // DMA循环接收缓冲区，NULL=RXNE中断接收
+    uint8_t *tx_ring;          // 环形发送缓冲区
+    uint8_t *dma_tx_buf;       // DMA发送缓冲区
+    uint8_t *write_pending;    // 阻塞发送期间中断输出的暂存区，NULL=丢弃
+} UartFastHw;
+
+/**
+ * @brief 串口运行状态
+ */
+typedef struct {
+    UartFastRxHandler handler;
+    uint32_t rx_pos;                // DMA接收缓冲区已处理位置
+    volatile uint32_t tx_head;      // 环形发送写入位置（任务）
+    volatile uint32_t tx_tail;      // 环形发送读取位置（TXE中断）
+    volatile uint8_t write_busy;    // 阻塞发送进行中
+    volatile uint32_t pending_head; // 暂存区写入位置（打断阻塞发送的中断）
+    uint32_t pending_tail;          // 暂存区读取位置（被打断的阻塞发送）
+    volatile uint8_t pending_lost;  // 暂存区满丢弃过输出，补发时输出标记
+    UartFastStats stats;
+} UartFastState;
+
+static uint8_t camera_rx_ring[UART_FAST_RX_RING_LEN];
+static uint8_t debug_rx_ring[UART_FAST_RX_RING_LEN];
+static uint8_t camera_tx_ring[UART_FAST_TX_RING_LEN];
+static uint8_t cue_tx_ring[UART_FAST_TX_RING_LEN];
+static uint8_t debug_write_pending[UART_FAST_WRITE_PENDING_LEN];
+static uint8_t motor_h_dma_buf[UART_FAST_DMA_TX_LEN];
+static uint8_t motor_v_dma_buf[UART_FAST_DMA_TX_LEN];
+
+// 与usart.c中各句柄的DMA流对应（USART2发送DMA未使用：调试输出轮询发送）
+static const UartFastHw uart_fast_hw[UART_FAST_PORT_COUNT] = {
+    [UART_FAST_CAMERA]  = { USART1, DMA2, LL_DMA_STREAM_2, camera_rx_ring, camera_tx_ring, NULL, NULL },
+    [UART_FAST_DEBUG]   = { USART2, DMA1, LL_DMA_STREAM_5, debug_rx_ring, NULL, NULL, debug_write_pending },
+    [UART_FAST_MOTOR_H] = { USART3, DMA1, LL_DMA_STREAM_3, NULL, NULL, motor_h_dma_buf, NULL },
+    [UART_FAST_MOTOR_V] = { USART6, DMA2, LL_DMA_STREAM_6, NULL, NULL, motor_v_dma_buf, NULL },
+    [UART_FAST_CUE]     = { UART4, NULL, 0, NULL, cue_tx_ring, NULL, NULL },
+};
+
+static UartFastState uart_fast_state[UART_FAST_PORT_COUNT];
+
+// ==================== DMA流标志 ====================
+
+static const uint8_t uart_fast_dma_shift[4] = { 0, 6, 16, 22 };
+
+/**
+ * @brief  读取DMA流的中断标志
+ */
+static uint32_t UartFast_DmaFlags(DMA_TypeDef *dma, uint32_t stream)
+{
+    uint32_t isr = (stream < 4U) ? dma->LISR : dma->HISR;
+    return (isr >> uart_fast_dma_shift[stream & 3U]) & UART_FAST_DMA_FLAGS;
+}
+
+/**
+ * @brief  清除DMA流的中断标志
+ * @param  flags: 要清除的标志（UART_FAST_DMA_FLAGS=全部，流使能前必须全部清除）
+ */
+static void UartFast_DmaClear(DMA_TypeDef *dma, uint32_t stream, uint32_t flags)
+{
+    uint32_t mask = flags << uart_fast_dma_shift[stream & 3U];
+
+    if (stream < 4U) dma->LIFCR = mask;
+    else dma->HIFCR = mask;
+}
+
+static void UartFast_DmaClearFlags(DMA_TypeDef *dma, uint32_t stream)
+{
+    UartFast_DmaClear(dma, stream, UART_FAST_DMA_FLAGS);
+}
+
+// ==================== 接收 ====================
+
+/**
+ * @brief  把一个字节交给处理函数（设置了接收故障时经过故障注入）
+ */
+static void UartFast_Deliver(UartFastPort port, UartFastState *st, uint8_t byte)
+{
+    st->stats.rx_bytes++;
+    if (st->handler == NULL) return;
+
+    if (FaultInject_IsActive(port, FAULT_DIR_RX)) FaultInject_Rx(port, byte, st->handler);
+    else st->handler(byte);
+}
+
+/**
+ * @brief  读取位置前进到写入位置时经过的半满/满边界
+ * @param  from: 读取位置
+ * @param  to: 写入位置（等于from表示没有新数据）
+ * @retval UART_FAST_DMA_HT/UART_FAST_DMA_TC的组合
+ */
+static uint32_t UartFast_DmaCrossed(uint32_t from, uint32_t to)
+{
+    uint32_t end = from + ((to - from) & UART_FAST_RX_MASK);
+    uint32_t crossed = 0;
+
+    if ((from < UART_FAST_RX_RING_LEN / 2U && end >= UART_FAST_RX_RING_LEN / 2U) ||
+        end >= UART_FAST_RX_RING_LEN * 3U / 2U)
+    {
+        crossed |= UART_FAST_DMA_HT;
+    }
+    if (end >= UART_FAST_RX_RING_LEN) crossed |= UART_FAST_DMA_TC;
+    return crossed;
+}
+
+/**
+ * @brief  把DMA已写入的字节交给处理函数
+ * @param  port: 串口
+ * @retval None
+ * @note   在USART和DMA中断中调用（同优先级，不会重入）；HT/TC标志在这里取走，
+ *         先读标志再读NDTR：读NDTR之前刚经过的边界按NDTR计入，其标志随后再次清除
+ */
+static void UartFast_DrainDma(UartFastPort port)
+{
+    const UartFastHw *hw = &uart_fast_hw[port];
+    UartFastState *st = &uart_fast_state[port];
+    uint32_t flags = UartFast_DmaFlags(hw->dma, hw->stream) & (UART_FAST_DMA_HT | UART_FAST_DMA_TC);
+    uint32_t pos, crossed;
+
+    UartFast_DmaClear(hw->dma, hw->stream, flags);
+    pos = (UART_FAST_RX_RING_LEN - LL_DMA_GetDataLength(hw->dma, hw->stream)) & UART_FAST_RX_MASK;
+    crossed = UartFast_DmaCrossed(st->rx_pos, pos);
+    UartFast_DmaClear(hw->dma, hw->stream, crossed & ~flags &
+                      UartFast_DmaFlags(hw->dma, hw->stream));
+
+    if (flags & ~crossed)
+    {
+        // 标志中有读取位置到写入位置之间不会经过的边界：DMA已绕过读取位置，缓冲区内容新旧混杂
+        st->stats.rx_errors++;
+        st->rx_pos = pos;
+        return;
+    }
+
+    while (st->rx_pos != pos)
+    {
+        uint8_t byte = hw->rx_ring[st->rx_pos];
+        st->rx_pos = (st->rx_pos + 1U) & UART_FAST_RX_MASK;
+        UartFast_Deliver(port, st, byte);
+    }
+}
+
+/**
+ * @brief  启动接收
+ * @param  port: 串口
+ * @param  handler: 字节处理函数
+ * @retval None
+ */
+void UartFast_StartRx(UartFastPort port, UartFastRxHandler handler)
+{
+    const UartFastHw *hw = &uart_fast_hw[port];
+    UartFastState *st = &uart_fast_state[port];
+
+    st->handler = handler;
+
+    if (hw->rx_ring != NULL)
+    {
+        LL_DMA_DisableStream(hw->dma, hw->stream);
+        while (LL_DMA_IsEnabledStream(hw->dma, hw->stream)) {}
+        UartFast_DmaClearFlags(hw->dma, hw->stream);
+
+        // 方向、通道、字节宽度由CubeMX初始化；循环模式在此显式设置
+        LL_DMA_SetMode(hw->dma, hw->stream, LL_DMA_MODE_CIRCULAR);
+        LL_DMA_SetPeriphAddress(hw->dma, hw->stream, (uint32_t)&hw->usart->DR);
+        LL_DMA_SetMemoryAddress(hw->dma, hw->stream, (uint32_t)hw->rx_ring);
+        LL_DMA_SetDataLength(hw->dma, hw->stream, UART_FAST_RX_RING_LEN);
+        LL_DMA_EnableIT_HT(hw->dma, hw->stream);
+        LL_DMA_EnableIT_TC(hw->dma, hw->stream);
+        st->rx_pos = 0;
+        LL_DMA_EnableStream(hw->dma, hw->stream);
+
+        LL_USART_ClearFlag_IDLE(hw->usart);   // 读SR、DR，同时丢弃启动前的旧字节
+        LL_USART_EnableDMAReq_RX(hw->usart);
+        LL_USART_EnableIT_IDLE(hw->usart);
+    }
+    else
+    {
+        (void)hw->usart->SR;
+        (void)hw->usart->DR;
+        LL_USART_EnableIT_RXNE(hw->usart);
+    }
+}
+
+/**
+ * @brief  轮询接收固定长度
+ * @param  port: 串口
+ * @param  data: 输出
+ * @param  len: 长度
+ * @param  timeout: 超时(ms)
+ * @retval 1=收满, 0=超时
+ */
+uint8_t UartFast_Read(UartFastPort port, uint8_t *data, uint16_t len, uint32_t timeout)
+{
+    USART_TypeDef *usart = uart_fast_hw[port].usart;
+    uint32_t start = HAL_GetTick();
+    uint16_t got = 0;
+
+    while (got < len)
+    {
+        if (usart->SR & USART_SR_RXNE)
+        {
+            data[got++] = (uint8_t)usart->DR;
+        }
+        else if (HAL_GetTick() - start >= timeout)
+        {
+            return 0;
+        }
+    }
+    if (FaultInject_IsActive(port, FAULT_DIR_RX)) return FaultInject_Read(port, data, len);
+    return 1;
+}
+
+/**
+ * @brief  丢弃接收寄存器中的旧字节并清除溢出标志
+ * @param  port: 串口
+ * @retval None
+ */
+void UartFast_DiscardRx(UartFastPort port)
+{
+    USART_TypeDef *usart = uart_fast_hw[port].usart;
+
+    (void)usart->SR;
+    (void)usart->DR;
+}
+
+// ==================== 发送 ====================
+
+/**
+ * @brief  启动一帧DMA发送
+ * @param  port: 串口
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval None
+ * @note   等待上一帧取完在临界区外进行，启动在临界区内（控制任务与定时器任务都会发电机命令）
+ */
+static void UartFast_StartDma(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    const UartFastHw *hw = &uart_fast_hw[port];
+
+    for (;;)
+    {
+        while (LL_DMA_IsEnabledStream(hw->dma, hw->stream)) {}
+
+        __disable_irq();
+        if (!LL_DMA_IsEnabledStream(hw->dma, hw->stream)) break;
+        __enable_irq();
+    }
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        hw->dma_tx_buf[i] = data[i];
+    }
+    UartFast_DmaClearFlags(hw->dma, hw->stream);
+    LL_DMA_SetPeriphAddress(hw->dma, hw->stream, (uint32_t)&hw->usart->DR);
+    LL_DMA_SetMemoryAddress(hw->dma, hw->stream, (uint32_t)hw->dma_tx_buf);
+    LL_DMA_SetDataLength(hw->dma, hw->stream, len);
+    LL_USART_ClearFlag_TC(hw->usart);
+    LL_USART_EnableDMAReq_TX(hw->usart);
+    LL_DMA_EnableStream(hw->dma, hw->stream);
+    uart_fast_state[port].stats.tx_bytes += len;
+    __enable_irq();
+}
+
+/**
+ * @brief  非阻塞发送一帧
+ * @param  port: 串口
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval 1=已排队, 0=缓冲区空间不足
+ */
+uint8_t UartFast_Send(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    if (FaultInject_IsActive(port, FAULT_DIR_TX)) return FaultInject_Send(port, data, len, 0);
+
+    return UartFast_SendRaw(port, data, len);
+}
+
+/**
+ * @brief  不经故障注入直接发送
+ * @param  port: 串口
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval 1=已排队, 0=缓冲区空间不足
+ */
+uint8_t UartFast_SendRaw(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    const UartFastHw *hw = &uart_fast_hw[port];
+    UartFastState *st = &uart_fast_state[port];
+
+    if (len == 0) return 1;
+
+    if (hw->dma_tx_buf != NULL)
+    {
+        if (len > UART_FAST_DMA_TX_LEN)
+        {
+            st->stats.tx_dropped++;
+            return 0;
+        }
+        UartFast_StartDma(port, data, len);
+        return 1;
+    }
+
+    if (hw->tx_ring == NULL)
+    {
+        UartFast_WriteRaw(port, data, len);
+        return 1;
+    }
+
+    __disable_irq();
+    if (UART_FAST_TX_RING_LEN - (st->tx_head - st->tx_tail) < len)
+    {
+        st->stats.tx_dropped++;
+        __enable_irq();
+        return 0;
+    }
+    for (uint16_t i = 0; i < len; i++)
+    {
+        hw->tx_ring[(st->tx_head + i) & UART_FAST_TX_MASK] = data[i];
+    }
+    st->tx_head += len;
+    st->stats.tx_bytes += len;
+    LL_USART_EnableIT_TXE(hw->usart);
+    __enable_irq();
+
+    return 1;
+}
+
+/**
+ * @brief  等待已排队的数据全部发完
+ * @param  port: 串口
+ * @retval None
+ */
+void UartFast_Flush(UartFastPort port)
+{
+    const UartFastHw *hw = &uart_fast_hw[port];
+    UartFastState *st = &uart_fast_state[port];
+
+    if (hw->dma_tx_buf != NULL)
+    {
+        while (LL_DMA_IsEnabledStream(hw->dma, hw->stream)) {}
+    }
+    while (st->tx_head != st->tx_tail) {}
+    while (!LL_USART_IsActiveFlag_TC(hw->usart)) {}
+}
+
+/**
+ * @brief  阻塞发送
+ * @param  port: 串口
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval None
+ */
+void UartFast_Write(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    if (FaultInject_IsActive(port, FAULT_DIR_TX))
+    {
+        (void)FaultInject_Send(port, data, len, 1);
+        return;
+    }
+    UartFast_WriteRaw(port, data, len);
+}
+
+/**
+ * @brief  不经故障注入阻塞发送
+ * @param  port: 串口
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval None
+ * @note   另一处正在阻塞发送时（任务输出被控制任务或停止命令打断）写入暂存区，由被打断的发送补发；
+ *         没有暂存区或暂存区已满时丢弃本次（计入tx_dropped，补发时输出标记）
+ */
+void UartFast_WriteRaw(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    const UartFastHw *hw = &uart_fast_hw[port];
+    USART_TypeDef *usart = hw->usart;
+    UartFastState *st = &uart_fast_state[port];
+
+    __disable_irq();
+    if (st->write_busy)
+    {
+        if (hw->write_pending != NULL &&
+            UART_FAST_WRITE_PENDING_LEN - (st->pending_head - st->pending_tail) >= len)
+        {
+            for (uint16_t i = 0; i < len; i++)
+            {
+                hw->write_pending[(st->pending_head + i) & UART_FAST_PENDING_MASK] = data[i];
+            }
+            st->pending_head += len;
+        }
+        else
+        {
+            st->stats.tx_dropped++;
+            st->pending_lost = 1;
+        }
+        __enable_irq();
+        return;
+    }
+    st->write_busy = 1;
+    __enable_irq();
+
+    if (hw->dma_tx_buf != NULL)
+    {
+        UartFast_Flush(port);
+    }
+    for (uint16_t i = 0; i < len; i++)
+    {
+        while (!(usart->SR & USART_SR_TXE)) {}
+        usart->DR = data[i];
+    }
+    st->stats.tx_bytes += len;
+
+    // 补发发送期间中断暂存的输出；检查暂存区为空与释放发送在关中断下完成，之后的输出直接发送
+    for (;;)
+    {
+        const uint8_t *mark = NULL;
+        uint8_t byte;
+
+        __disable_irq();
+        if (st->pending_tail == st->pending_head)
+        {
+            if (!st->pending_lost)
+            {
+                st->write_busy = 0;
+                __enable_irq();
+                break;
+            }
+            st->pending_lost = 0;
+            mark = uart_fast_dropped_mark;
+        }
+        __enable_irq();
+
+        if (mark != NULL)
+        {
+            for (uint16_t i = 0; i < sizeof(uart_fast_dropped_mark) - 1U; i++)
+            {
+                while (!(usart->SR & USART_SR_TXE)) {}
+                usart->DR = mark[i];
+            }
+            continue;
+        }
+
+        byte = hw->write_pending[st->pending_tail & UART_FAST_PENDING_MASK];
+        st->pending_tail++;
+        while (!(usart->SR & USART_SR_TXE)) {}
+        usart->DR = byte;
+        st->stats.tx_bytes++;
+    }
+    while (!(usart->SR & USART_SR_TC)) {}
+}
+
+/**
+ * @brief  读取统计
+ * @param  port: 串口
+ * @param  stats: 输出
+ * @retval None
+ */
+void UartFast_GetStats(UartFastPort port, UartFastStats *stats)
+{
+    __disable_irq();
+    *stats = uart_fast_state[port].stats;
+    __enable_irq();
+}
+
+// ==================== 中断 ====================
+
+/**
+ * @brief  USART中断处理
+ * @param  port: 串口
+ * @retval None
+ */
+void UartFast_IRQHandler(UartFastPort port)
+{
+    const UartFastHw *hw = &uart_fast_hw[port];
+    UartFastState *st = &uart_fast_state[port];
+    USART_TypeDef *usart = hw->usart;
+    uint32_t sr = usart->SR;
+
+    if (hw->rx_ring != NULL)
+    {
+        // DMA接收：读SR后读DR清除IDLE和错误标志，数据已由DMA取走
+        if (sr & (USART_SR_IDLE | UART_FAST_RX_ERRORS))
+        {
+            (void)usart->DR;
+            if (sr & UART_FAST_RX_ERRORS) st->stats.rx_errors++;
+            st->stats.rx_irqs++;
+            UartFast_DrainDma(port);
+        }
+    }
+    else if (sr & (USART_SR_RXNE | USART_SR_ORE))
+    {
+        uint8_t byte = (uint8_t)usart->DR;
+
+        st->stats.rx_irqs++;
+        if (sr & UART_FAST_RX_ERRORS) st->stats.rx_errors++;
+        if (!(sr & (USART_SR_NE | USART_SR_FE)))
+        {
+            UartFast_Deliver(port, st, byte);
+        }
+    }
+
+    if ((usart->CR1 & USART_CR1_TXEIE) && (sr & USART_SR_TXE))
+    {
+        if (st->tx_tail != st->tx_head)
+        {
+            usart->DR = hw->tx_ring[st->tx_tail & UART_FAST_TX_MASK];
+            st->tx_tail++;
+        }
+        if (st->tx_tail == st->tx_head)
+        {
+            LL_USART_DisableIT_TXE(usart);
+        }
+    }
+}
+
+/**
+ * @brief  接收DMA中断处理
+ * @param  port: 串口
+ * @retval None
+ */
+void UartFast_DmaIRQHandler(UartFastPort port)
+{
+    const UartFastHw *hw = &uart_fast_hw[port];
+    uint32_t flags = UartFast_DmaFlags(hw->dma, hw->stream);
+
+    // HT/TC留给UartFast_DrainDma取走（用于判断绕圈），其余错误标志在这里清除
+    UartFast_DmaClear(hw->dma, hw->stream, flags & ~(UART_FAST_DMA_HT | UART_FAST_DMA_TC));
+    if (flags & (UART_FAST_DMA_HT | UART_FAST_DMA_TC))
+    {
+        uart_fast_state[port].stats.rx_irqs++;
+        UartFast_DrainDma(port);
+    }
+}
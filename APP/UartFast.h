@@ -0,0 +1,152 @@
+/**
+ * @file    UartFast.h
+ * @brief   串口寄存器级快速收发头文件
+ * @details HAL的中断接收每个字节要经过HAL_UART_IRQHandler状态机、main.c的回调分支
+ *          和HAL_UART_Receive_IT重新启动（带加锁），每字节数百个周期。
+ *          本模块直接操作USART/DMA寄存器（LL内联函数），HAL只保留CubeMX生成的初始化：
+ *          - 相机USART1、调试USART2：循环DMA接收 + 空闲线(IDLE)中断，一帧一次中断，
+ *            DMA半满/满中断兜底连续数据；应用层仍按字节处理（直接函数调用）
+ *          - 电机USART3/USART6：DMA发送，不等待线路发完即返回；应答轮询RXNE读取
+ *          - 引导UART4：RXNE中断直接读DR（无DMA通道）
+ *          - 相机、引导的下发帧：字节环形缓冲区 + TXE中断
+ *          - 调试输出：轮询TXE直接写DR（命令在默认任务中执行，输出顺序与阻塞发送一致）
+ *
+ *          所有相关中断优先级相同（5），互不抢占；中断中不调用RTOS接口。
+ *          设置了故障注入（FaultInject.h）的方向改经故障注入层收发
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _UART_FAST_H
+#define _UART_FAST_H
+
+#include "stm32f4xx_hal.h"
+
+#define UART_FAST_RX_RING_LEN  256U   ///< DMA循环接收缓冲区（字节，2的幂）
+#define UART_FAST_TX_RING_LEN  128U   ///< 环形发送缓冲区（字节，2的幂）
+#define UART_FAST_DMA_TX_LEN   48U    ///< DMA发送缓冲区（单帧最大长度，驱动参数写入帧33字节）
+#define UART_FAST_WRITE_PENDING_LEN 512U  ///< 调试串口阻塞发送期间中断输出的暂存区（字节，2的幂）
+
+/**
+ * @brief 串口
+ */
+typedef enum {
+    UART_FAST_CAMERA = 0,   ///< USART1 相机：DMA接收，环形发送
+    UART_FAST_DEBUG,        ///< USART2 调试：DMA接收，轮询发送
+    UART_FAST_MOTOR_H,      ///< USART3 水平电机：DMA发送，轮询接收
+    UART_FAST_MOTOR_V,      ///< USART6 垂直电机：DMA发送，轮询接收
+    UART_FAST_CUE,          ///< UART4 引导：RXNE中断接收，环形发送
+    UART_FAST_PORT_COUNT
+} UartFastPort;
+
+/**
+ * @brief 接收字节处理函数（在中断中调用）
+ */
+typedef void (*UartFastRxHandler)(uint8_t byte);
+
+/**
+ * @brief 收发统计
+ */
+typedef struct {
+    uint32_t rx_bytes;      ///< 交给处理函数的字节数
+    uint32_t rx_irqs;       ///< 接收中断次数（DMA端口为IDLE和半满/满中断）
+    uint32_t rx_errors;     ///< 溢出/帧错误/噪声次数（DMA端口含接收缓冲区被绕圈覆盖的次数）
+    uint32_t tx_bytes;      ///< 发出（排队）的字节数
+    uint32_t tx_dropped;    ///< 发送缓冲区（调试串口为阻塞发送暂存区）满丢弃的帧数
+} UartFastStats;
+
+/**
+ * @brief  启动接收
+ * @param  port: 串口
+ * @param  handler: 字节处理函数
+ * @retval None
+ * @note   在各模块Init中调用（替代HAL_UART_Receive_IT）；电机串口不使用
+ */
+void UartFast_StartRx(UartFastPort port, UartFastRxHandler handler);
+
+/**
+ * @brief  非阻塞发送一帧
+ * @param  port: 串口
+ * @param  data: 数据（函数返回后即可复用）
+ * @param  len: 长度
+ * @retval 1=已排队, 0=缓冲区空间不足（整帧丢弃）
+ * @note   环形发送端口空间不足时丢弃；电机端口先等待上一帧DMA取完（最多一帧的线路时间），
+ *         再拷贝到DMA缓冲区启动发送，不会丢弃（超过UART_FAST_DMA_TX_LEN的帧丢弃返回0）
+ */
+uint8_t UartFast_Send(UartFastPort port, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  阻塞发送
+ * @param  port: 串口
+ * @param  data: 数据
+ * @param  len: 长度
+ * @retval None
+ * @note   轮询TXE写DR，返回时最后一个字节已发完（TC）；用于调试和电机串口，可在中断中调用。
+ *         调试串口上另一处阻塞发送正在进行时（任务输出被控制任务或停止命令打断），本次输出暂存，
+ *         由被打断的发送在其数据之后补发；暂存区满时丢弃，补发时输出"[output dropped]"标记
+ */
+void UartFast_Write(UartFastPort port, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  不经故障注入直接发送（UartFast_Send的实现）
+ * @note   供故障注入层使用
+ */
+uint8_t UartFast_SendRaw(UartFastPort port, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  不经故障注入阻塞发送（UartFast_Write的实现）
+ * @note   供故障注入层使用
+ */
+void UartFast_WriteRaw(UartFastPort port, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  等待已排队的数据全部发完
+ * @param  port: 串口
+ * @retval None
+ * @note   返回时线路空闲（TC），用于需要"指令帧发完"时刻的测量
+ */
+void UartFast_Flush(UartFastPort port);
+
+/**
+ * @brief  轮询接收固定长度
+ * @param  port: 串口（只用于未启动中断接收的电机串口）
+ * @param  data: 输出
+ * @param  len: 长度
+ * @param  timeout: 超时(ms)
+ * @retval 1=收满, 0=超时
+ */
+uint8_t UartFast_Read(UartFastPort port, uint8_t *data, uint16_t len, uint32_t timeout);
+
+/**
+ * @brief  丢弃接收寄存器中的旧字节并清除溢出标志
+ * @param  port: 串口（只用于电机串口）
+ * @retval None
+ */
+void UartFast_DiscardRx(UartFastPort port);
+
+/**
+ * @brief  读取统计
+ * @param  port: 串口
+ * @param  stats: 输出
+ * @retval None
+ */
+void UartFast_GetStats(UartFastPort port, UartFastStats *stats);
+
+/**
+ * @brief  USART中断处理
+ * @param  port: 串口
+ * @retval None
+ * @note   在stm32f4xx_it.c对应USARTx_IRQHandler的USER CODE段调用；PTU.ioc中这些中断已取消
+ *         "Call HAL handler"，不生成HAL_UART_IRQHandler调用
+ */
+void UartFast_IRQHandler(UartFastPort port);
+
+/**
+ * @brief  接收DMA中断处理（半满/满）
+ * @param  port: 串口（相机或调试）
+ * @retval None
+ * @note   在对应DMA Stream中断的USER CODE段调用（同样不调用HAL_DMA_IRQHandler）
+ */
+void UartFast_DmaIRQHandler(UartFastPort port);
+
+#endif
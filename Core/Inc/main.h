@@ -57,6 +57,12 @@ void Error_Handler(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
+#define LOCK_OUT_Pin GPIO_PIN_0
+#define LOCK_OUT_GPIO_Port GPIOC
+#define STEP_DIR_H_Pin GPIO_PIN_0
+#define STEP_DIR_H_GPIO_Port GPIOB
+#define STEP_DIR_V_Pin GPIO_PIN_1
+#define STEP_DIR_V_GPIO_Port GPIOB
 
 /* USER CODE BEGIN Private defines */
 
@@ -37,6 +37,10 @@ extern DMA_HandleTypeDef hdma_usart6_tx;
 	
 /* USER CODE END Includes */
 
+extern UART_HandleTypeDef huart4;
+
+extern UART_HandleTypeDef huart5;
+
 extern UART_HandleTypeDef huart1;
 
 extern UART_HandleTypeDef huart2;
@@ -50,6 +54,8 @@ extern UART_HandleTypeDef huart6;
 	
 /* USER CODE END Private defines */
 
+void MX_UART4_Init(void);
+void MX_UART5_Init(void);
 void MX_USART1_UART_Init(void);
 void MX_USART2_UART_Init(void);
 void MX_USART3_UART_Init(void);
@@ -26,6 +26,17 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "GimbalControl.h"
+#include "SerialDebug.h"
+#include "MotorConfig.h"
+#include "Latency.h"
+#include "CamCalib.h"
+#include "Stress.h"
+#include "Cue.h"
+#include "Journal.h"
+#include "Profile.h"
+#include "SysId.h"
+#include "FaultInject.h"
+#include "BinLog.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -35,7 +46,9 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+// 控制任务栈（字）：最深调用链Gimbal_ControlTask→Imm_Update约1KB，加异常压栈（含FPU）和
+// snprintf（SendFeedback），留约2倍余量；实际余量用stress命令报告的栈余量确认
+#define GIMBAL_TASK_STACK_WORDS  768
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -51,7 +64,7 @@
 osThreadId_t defaultTaskHandle;
 const osThreadAttr_t defaultTask_attributes = {
   .name = "defaultTask",
-  .stack_size = 128 * 4,
+  .stack_size = 1024 * 4,
   .priority = (osPriority_t) osPriorityNormal,
 };
 
@@ -64,6 +77,24 @@ void StartDefaultTask(void *argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void vApplicationStackOverflowHook(xTaskHandle xTask, signed char *pcTaskName);
+
+/* USER CODE BEGIN 4 */
+/**
+  * @brief  任务栈溢出钩子（configCHECK_FOR_STACK_OVERFLOW=2，任务切换时检查）
+  * @note   溢出后相邻内存已被破坏，不再尝试停电机或打印，直接复位；
+  *         复位原因（软件复位）由上电后的JOURNAL BOOT事件记录
+  */
+void vApplicationStackOverflowHook(xTaskHandle xTask, signed char *pcTaskName)
+{
+  (void)xTask;
+  (void)pcTaskName;
+  __disable_irq();
+  NVIC_SystemReset();
+}
+/* USER CODE END 4 */
+
 /**
   * @brief  FreeRTOS initialization
   * @param  None
@@ -97,7 +128,6 @@ void MX_FREERTOS_Init(void) {
   /* USER CODE BEGIN RTOS_THREADS */
   /* add threads, ... */
   /* USER CODE END RTOS_THREADS */
-	xTaskCreate(StartGimbalTask, "Gimbal", 256, NULL, osPriorityHigh, NULL);
   /* USER CODE BEGIN RTOS_EVENTS */
   /* add events, ... */
   /* USER CODE END RTOS_EVENTS */
@@ -114,9 +144,33 @@ void MX_FREERTOS_Init(void) {
 void StartDefaultTask(void *argument)
 {
   /* USER CODE BEGIN StartDefaultTask */
+  // 上电初始化：电机上电等待、自检和参数同步耗时数秒，在任务中用osDelay等待
+  SerialDebug_Init();
+  Journal_Init();          // 扫描事件日志（必要时擦除扇区，控制启动前完成）
+  Profile_Load();          // 读取参数档案和保存的驱动参数表
+  Gimbal_SelfTest();
+  MotorConfig_BootCheck(); // 读取驱动参数；参数表已保存时写入差异，否则只报告
+  Gimbal_Init();
+  Profile_Init();          // 应用上电参数档案（第一个控制周期生效）
+  Cue_Init();
+  Gimbal_Enable();
+  // 初始化完成后再启动控制任务
+  xTaskCreate(StartGimbalTask, "Gimbal", GIMBAL_TASK_STACK_WORDS, NULL, osPriorityHigh, NULL);
+
   /* Infinite loop */
   for(;;)
   {
+    Gimbal_ProcessSelfTest(); // 执行串口命令发起的自检
+    MotorConfig_Process();  // 执行串口命令发起的驱动参数读写（阻塞收发）
+    Latency_Process();      // 执行串口命令发起的执行延迟测量（阻塞收发）
+    CamCalib_Process();     // 执行串口命令发起的相机-云台旋转标定
+    Stress_Process();       // 执行串口命令发起的压力测试（测试期间阻塞）
+    Journal_Process();      // 事件日志写入Flash、执行journal命令
+    Profile_Process();      // 执行profile命令、按距离自动切换参数档案
+    SysId_Process();        // 输出ident命令采集的辨识数据
+    FaultInject_Process();  // 交付/发出故障注入延迟的数据
+    SerialDebug_Process();  // 执行串口命令、转发相机端耗时统计
+    BinLog_Flush();         // 发送二进制日志（格式化在上位机完成）
     osDelay(1);
   }
   /* USER CODE END StartDefaultTask */
@@ -127,10 +181,24 @@ void StartDefaultTask(void *argument)
 
 void StartGimbalTask(void *argument)
 {
+  uint32_t wake_tick = osKernelGetTickCount();
+
   for (;;)
   {
+    Stress_OnControlWake();   // 压力测试：周期计时与位置轮询
     Gimbal_ControlTask();
-    osDelay(20);  // 50Hz控制频率
+    Cue_Update();             // 云台间引导：发送本机状态，丢失目标时按对方引导转向
+    Stress_OnControlDone();
+
+    // 按绝对时刻唤醒，周期由rate命令设置（默认20ms/50Hz）
+    wake_tick += Gimbal_GetPeriodMs();
+    if (osDelayUntil(wake_tick) != osOK)
+    {
+      // 本周期已超时：记录并以当前时刻重新对齐
+      Gimbal_NotifyOverrun();
+      Stress_OnOverrun();
+      wake_tick = osKernelGetTickCount();
+    }
   }
 }
 
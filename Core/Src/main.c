@@ -20,15 +20,13 @@
 #include "main.h"
 #include "cmsis_os.h"
 #include "dma.h"
+#include "tim.h"
 #include "usart.h"
 #include "gpio.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-#include "GimbalControl.h"
-#include "Camera.h"
-#include "Motor.h"
-#include "SerialDebug.h"
+#include "Timing.h"
  
 /* USER CODE END Includes */
 
@@ -64,38 +62,6 @@ void MX_FREERTOS_Init(void);
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
 
-// 云台测试函数
-void Gimbal_SelfTest(void)
-{
-    // 等待电机自己初始化（2秒）
-    HAL_Delay(2000);
-    
-    // STM32初始化电机
-    Motor_Init();
-    HAL_Delay(100);
-    
-    // 测试序列：使用较小的角度和较慢的速度，更平滑
-    
-    // 左转30°（减小角度）
-    Motor_MoveHorizontal(-30.0f);
-    HAL_Delay(500);
-    
-    // 右转30°
-    Motor_MoveHorizontal(30.0f);
-    HAL_Delay(500);
-    
-    // 上转15°（减小角度）
-    Motor_MoveVertical(15.0f);
-    HAL_Delay(500);
-    
-    // 下转15°
-    Motor_MoveVertical(-15.0f);
-    HAL_Delay(500);
-    
-    // 停止
-    Motor_Stop();
-}
-
 /* USER CODE END 0 */
 
 /**
@@ -132,17 +98,14 @@ int main(void)
   MX_USART6_UART_Init();
   MX_USART2_UART_Init();
   MX_USART3_UART_Init();
+  MX_UART4_Init();
+  MX_UART5_Init();
+  MX_TIM1_Init();
+  MX_TIM8_Init();
   /* USER CODE BEGIN 2 */
-	// 初始化串口调试
-	SerialDebug_Init();
-	
-	// 执行云台自检测试
-	Gimbal_SelfTest();
-	
-	// 初始化云台控制系统
-	Gimbal_Init();
-	Gimbal_Enable();
-
+	// 使能DWT周期计数器（延迟测量时间戳）
+	Timing_Init();
+	// 串口调试、云台自检和控制初始化在默认任务中执行（等待用osDelay，不占用CPU）
   /* USER CODE END 2 */
 
   /* Init scheduler */
@@ -213,50 +176,31 @@ void SystemClock_Config(void)
 
 /* USER CODE BEGIN 4 */
 
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)//接收回调
-{
-    if (huart->Instance == USART1)
-    {
-		// 摄像头数据接收
-		Camera_UART_RxCallback();
-		}
-		else if(huart->Instance == USART2)   // 串口调试
-		{
-		SerialDebug_ProcessCommand();
-		}
-		else if(huart->Instance == USART3)
-		{
-		// 水平轴电机反馈
-		}
-		else if(huart->Instance == USART6)
-		{
-		// 垂直轴电机反馈
-		}
-
-}
+// 串口收发由APP/UartFast.c在USARTx/DMA中断中直接处理寄存器（stm32f4xx_it.c的USER CODE段），
+// 不再经过HAL_UART_IRQHandler和HAL_UART_RxCpltCallback/TxCpltCallback
 
+/* USER CODE END 4 */
 
-void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)       //发送回调
+/**
+  * @brief  Period elapsed callback in non blocking mode
+  * @note   This function is called  when TIM6 interrupt took place, inside
+  * HAL_TIM_IRQHandler(). It makes a direct call to HAL_IncTick() to increment
+  * a global variable "uwTick" used as application time base.
+  * @param  htim : TIM handle
+  * @retval None
+  */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
-  if (huart->Instance == USART1)
-  {
-    
-  }
-  else if (huart->Instance == USART2)
-  {
-    
-  }
-  else if (huart->Instance == USART3)
-  {
-    
-  }
-  else if (huart->Instance == USART6)
-  {
-    
+  /* USER CODE BEGIN Callback 0 */
+
+  /* USER CODE END Callback 0 */
+  if (htim->Instance == TIM6) {
+    HAL_IncTick();
   }
-}
+  /* USER CODE BEGIN Callback 1 */
 
-/* USER CODE END 4 */
+  /* USER CODE END Callback 1 */
+}
 
 /**
   * @brief  This function is executed in case of error occurrence.
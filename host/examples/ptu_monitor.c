@@ -0,0 +1,156 @@
+/**
+ * @file    ptu_monitor.c
+ * @brief   上位机接口库示例：同时监视多台云台
+ * @details 订阅遥测，每秒打印各台云台的遥测帧率、到达间隔和最新数据；
+ *          -c指定的命令在每次（重新）连接后依次发送
+ *
+ *          用法: ptu_monitor [-c 命令]... [-t 秒] 串口...
+ *          例:   ptu_monitor -c enable -c "rate 100" /tmp/ptu/ttyUSART2
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#define _GNU_SOURCE
+#include "ptu_host.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_UNITS    16
+#define MAX_COMMANDS 8
+
+typedef struct {
+    PtuUnit *unit;
+    // 以下在I/O线程中更新，主线程每秒读取一次（仅用于显示，不加锁）
+    uint32_t frames;
+    uint64_t last_rx_us;
+    uint64_t max_gap_us;
+    PtuTelemetry last;
+} Monitor;
+
+static const char *startup_cmds[MAX_COMMANDS];
+static int startup_count = 0;
+static volatile sig_atomic_t running = 1;
+
+static void OnSignal(int sig)
+{
+    (void)sig;
+    running = 0;
+}
+
+static void OnConnection(PtuUnit *unit, int connected, void *user)
+{
+    (void)user;
+    printf("[%s] %s\n", PtuUnit_GetPath(unit), connected ? "connected" : "disconnected");
+    if (connected)
+    {
+        for (int i = 0; i < startup_count; i++) PtuUnit_Send(unit, "%s", startup_cmds[i]);
+    }
+}
+
+static void OnTelemetry(PtuUnit *unit, const PtuTelemetry *t, void *user)
+{
+    Monitor *m = (Monitor *)user;
+    (void)unit;
+
+    if (m->last_rx_us && t->rx_time_us - m->last_rx_us > m->max_gap_us)
+    {
+        m->max_gap_us = t->rx_time_us - m->last_rx_us;
+    }
+    m->last_rx_us = t->rx_time_us;
+    m->last = *t;
+    m->frames++;
+}
+
+static void OnCameraStats(PtuUnit *unit, const PtuCameraStats *s, void *user)
+{
+    (void)user;
+    printf("[%s] camera %u.%u fps, total avg %u us\n", PtuUnit_GetPath(unit),
+           s->fps_x10 / 10, s->fps_x10 % 10, s->stage[PTU_CAMERA_STAGES - 1].avg);
+}
+
+static void OnLine(PtuUnit *unit, PtuLineKind kind, const char *line, size_t len, void *user)
+{
+    (void)user;
+    if (kind == PTU_LINE_ECHO) return;
+    printf("[%s] %s%.*s\n", PtuUnit_GetPath(unit), (kind == PTU_LINE_REPLY) ? "  " : "| ", (int)len, line);
+}
+
+static void OnCommand(PtuUnit *unit, const char *cmd, PtuCmdResult result, void *user)
+{
+    static const char *const names[] = { "OK", "ERROR", "TIMEOUT", "DISCONNECTED" };
+    (void)user;
+    printf("[%s] '%s' -> %s\n", PtuUnit_GetPath(unit), cmd, names[result]);
+}
+
+int main(int argc, char **argv)
+{
+    static Monitor monitors[MAX_UNITS];
+    PtuHost *host;
+    int count = 0;
+    int duration = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:t:")) != -1)
+    {
+        if (opt == 'c' && startup_count < MAX_COMMANDS) startup_cmds[startup_count++] = optarg;
+        else if (opt == 't') duration = atoi(optarg);
+        else
+        {
+            fprintf(stderr, "Usage: %s [-c command]... [-t seconds] port...\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc)
+    {
+        fprintf(stderr, "Usage: %s [-c command]... [-t seconds] port...\n", argv[0]);
+        return 1;
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    host = PtuHost_Create();
+    if (!host)
+    {
+        fprintf(stderr, "PtuHost_Create failed\n");
+        return 1;
+    }
+
+    for (int i = optind; i < argc && count < MAX_UNITS; i++, count++)
+    {
+        PtuCallbacks cb = {
+            .on_connection = OnConnection,
+            .on_telemetry = OnTelemetry,
+            .on_camera_stats = OnCameraStats,
+            .on_line = OnLine,
+            .on_command = OnCommand,
+            .user = &monitors[count],
+        };
+        monitors[count].unit = PtuUnit_Open(host, argv[i], NULL, &cb);
+        PtuUnit_SubscribeTelemetry(monitors[count].unit, 1);
+    }
+
+    for (int elapsed = 0; running && (duration == 0 || elapsed < duration); elapsed++)
+    {
+        sleep(1);
+        for (int i = 0; i < count; i++)
+        {
+            Monitor *m = &monitors[i];
+            if (!PtuUnit_IsConnected(m->unit)) continue;
+            printf("[%s] %u Hz  max gap %.1f ms  target=(%d,%d) d=(%d,%d) pid=(%.1f,%.1f) state=%d\n",
+                   PtuUnit_GetPath(m->unit), m->frames, m->max_gap_us / 1000.0,
+                   m->last.target_x, m->last.target_y, m->last.dx, m->last.dy,
+                   m->last.pid_h, m->last.pid_v, (int)m->last.state);
+            m->frames = 0;
+            m->max_gap_us = 0;
+        }
+    }
+
+    PtuHost_Destroy(host);
+    return 0;
+}
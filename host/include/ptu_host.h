@@ -0,0 +1,227 @@
+/**
+ * @file    ptu_host.h
+ * @brief   云台上位机接口库头文件
+ * @details 通过调试串口（USART2，文本命令 + DATA/CAMS遥测行）控制一台或多台云台：
+ *          - 一个PtuHost对应一个I/O线程（epoll），可同时管理多台云台
+ *          - 命令排队发送，每条命令等固件回显和输出结束后才发下一条
+ *            （固件在串口中断中执行命令，执行期间收到的字符会丢失）
+ *          - 接收行在接收缓冲区中原地解析，回调拿到的字符串指向缓冲区，不做拷贝
+ *          - 串口断开（拔线、仿真退出）后按退避间隔自动重连，重连后恢复遥测订阅
+ *          支持真实串口和ptu_sim创建的pty（ttyUSART2）
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _PTU_HOST_H
+#define _PTU_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PTU_CMD_MAX_LEN       120   ///< 单条命令最大长度（固件命令缓冲区128字节）
+#define PTU_CMD_QUEUE_LEN     16    ///< 每台云台的命令队列长度
+#define PTU_CAMERA_STAGES     7     ///< 相机端阶段数（与APP/Camera.h一致）
+
+typedef struct PtuHost PtuHost;
+typedef struct PtuUnit PtuUnit;
+
+/**
+ * @brief 云台状态（与GimbalState一致）
+ */
+typedef enum {
+    PTU_STATE_IDLE = 0,
+    PTU_STATE_TRACKING,
+    PTU_STATE_LOCKED
+} PtuState;
+
+/**
+ * @brief 控制遥测（DATA行）
+ */
+typedef struct {
+    int16_t target_x;       ///< 目标X坐标（像素）
+    int16_t target_y;       ///< 目标Y坐标（像素）
+    int16_t dx;             ///< 水平偏差（像素）
+    int16_t dy;             ///< 垂直偏差（像素）
+    float pid_h;            ///< 水平PID输出
+    float pid_v;            ///< 垂直PID输出
+    PtuState state;         ///< 云台状态
+    uint64_t rx_time_us;    ///< 行尾到达上位机的时刻（CLOCK_MONOTONIC，us）
+} PtuTelemetry;
+
+/**
+ * @brief 相机端分阶段耗时（CAMS行，单位us）
+ */
+typedef struct {
+    uint32_t frames;        ///< 统计窗口内帧数
+    uint32_t fps_x10;       ///< 帧率×10
+    struct {
+        uint32_t min;
+        uint32_t avg;
+        uint32_t max;
+    } stage[PTU_CAMERA_STAGES];   ///< cap/blob/score/misc/tx/disp/total
+    uint64_t rx_time_us;
+} PtuCameraStats;
+
+/**
+ * @brief 接收行类型
+ */
+typedef enum {
+    PTU_LINE_ECHO = 0,      ///< 命令回显 "> cmd"
+    PTU_LINE_REPLY,         ///< 命令输出（回显之后、命令结束之前）
+    PTU_LINE_OTHER          ///< 其他输出（任务中打印的日志、延后执行的命令结果等）
+} PtuLineKind;
+
+/**
+ * @brief 命令执行结果
+ */
+typedef enum {
+    PTU_CMD_OK = 0,         ///< 固件已执行，输出中没有错误
+    PTU_CMD_ERROR,          ///< 输出中有"Error"或"Unknown command"
+    PTU_CMD_TIMEOUT,        ///< 没有收到回显（命令丢失或云台无响应）
+    PTU_CMD_DISCONNECTED    ///< 等待期间串口断开
+} PtuCmdResult;
+
+/**
+ * @brief 回调函数（均在I/O线程中调用，不要在回调中阻塞）
+ * @note  字符串参数指向接收缓冲区，只在回调期间有效；
+ *        回调中可以调用PtuUnit_*发送命令
+ */
+typedef struct {
+    void (*on_connection)(PtuUnit *unit, int connected, void *user);
+    void (*on_telemetry)(PtuUnit *unit, const PtuTelemetry *t, void *user);
+    void (*on_camera_stats)(PtuUnit *unit, const PtuCameraStats *s, void *user);
+    void (*on_line)(PtuUnit *unit, PtuLineKind kind, const char *line, size_t len, void *user);
+    void (*on_command)(PtuUnit *unit, const char *cmd, PtuCmdResult result, void *user);
+    /// BinLog二进制日志帧（校验通过的payload，格式见APP/BinLog.h，需配合固件ELF解码）
+    void (*on_binlog)(PtuUnit *unit, const uint8_t *payload, size_t len, void *user);
+    void *user;
+} PtuCallbacks;
+
+/**
+ * @brief 连接参数
+ */
+typedef struct {
+    uint32_t baud;              ///< 波特率，0=115200（pty忽略）
+    uint32_t echo_timeout_ms;   ///< 等待回显超时，0=500ms（命令在云台默认任务中执行，延迟测量、压力测试、
+                                ///< Flash擦除进行中回显推迟到其结束；stop/disable/stress stop立即回显）
+    uint32_t quiet_ms;          ///< 回显后无新数据多久视为命令结束，0=10ms
+    uint32_t reconnect_min_ms;  ///< 重连间隔初值，0=100ms（每次失败翻倍）
+    uint32_t reconnect_max_ms;  ///< 重连间隔上限，0=2000ms
+} PtuUnitConfig;
+
+// ==================== 事件循环 ====================
+
+/**
+ * @brief  创建上位机实例并启动I/O线程
+ * @retval 实例，NULL=失败
+ */
+PtuHost *PtuHost_Create(void);
+
+/**
+ * @brief  停止I/O线程，关闭所有云台并释放
+ * @param  host: 实例
+ * @retval None
+ */
+void PtuHost_Destroy(PtuHost *host);
+
+// ==================== 云台连接 ====================
+
+/**
+ * @brief  添加一台云台
+ * @param  host: 实例
+ * @param  path: 串口设备路径（如/dev/ttyUSB0，或仿真的ttyUSART2）
+ * @param  config: 连接参数，NULL=默认
+ * @param  callbacks: 回调，NULL=不接收事件
+ * @retval 云台句柄，NULL=参数无效或内存不足
+ * @note   立即返回，由I/O线程打开串口；打不开时按重连间隔重试
+ */
+PtuUnit *PtuUnit_Open(PtuHost *host, const char *path, const PtuUnitConfig *config,
+                      const PtuCallbacks *callbacks);
+
+/**
+ * @brief  关闭并释放一台云台
+ * @param  unit: 云台句柄
+ * @retval None
+ * @note   在其他线程调用时等I/O线程释放完成后返回，之后不会再有该云台的回调；
+ *         在回调中调用时，当前回调返回后释放
+ */
+void PtuUnit_Close(PtuUnit *unit);
+
+/**
+ * @brief  是否已连接
+ * @retval 1=已连接, 0=未连接
+ */
+int PtuUnit_IsConnected(const PtuUnit *unit);
+
+/**
+ * @brief  串口路径
+ */
+const char *PtuUnit_GetPath(const PtuUnit *unit);
+
+// ==================== 命令 ====================
+
+/**
+ * @brief  发送调试串口命令
+ * @param  unit: 云台句柄
+ * @param  fmt: 命令格式（不含换行）
+ * @retval 1=已排队, 0=未连接、队列满或命令过长
+ * @note   线程安全；结果通过on_command回调返回
+ */
+int PtuUnit_Send(PtuUnit *unit, const char *fmt, ...)
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+/**
+ * @brief  开启/关闭跟踪（enable/disable）
+ */
+int PtuUnit_Enable(PtuUnit *unit, int enable);
+
+/**
+ * @brief  设置PID参数
+ * @param  axis: 'h'或'v'
+ */
+int PtuUnit_SetPID(PtuUnit *unit, char axis, float kp, float ki, float kd);
+
+/**
+ * @brief  设置控制频率
+ * @param  hz: 10~500
+ */
+int PtuUnit_SetRate(PtuUnit *unit, uint32_t hz);
+
+/**
+ * @brief  相对移动
+ * @param  axis: 'h'或'v'
+ * @param  degrees: 角度
+ */
+int PtuUnit_Move(PtuUnit *unit, char axis, float degrees);
+
+/**
+ * @brief  停止电机
+ */
+int PtuUnit_Stop(PtuUnit *unit);
+
+/**
+ * @brief  订阅/取消遥测（debug on/off）
+ * @param  enable: 1=订阅DATA/CAMS行
+ * @retval 1=已排队, 0=失败
+ * @note   订阅状态在重连后自动恢复
+ */
+int PtuUnit_SubscribeTelemetry(PtuUnit *unit, int enable);
+
+/**
+ * @brief  上位机单调时钟
+ * @retval 微秒（CLOCK_MONOTONIC，与rx_time_us同一时基）
+ */
+uint64_t PtuHost_Micros(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,857 @@
+/**
+ * @file    ptu_host.c
+ * @brief   云台上位机接口库实现
+ * @details - I/O线程：epoll等待所有云台的串口fd和唤醒用的eventfd，超时时间取
+ *            最近的重连时刻/命令截止时刻
+ *          - 接收：每台云台一块固定接收缓冲区，完整的行原地替换行尾为'\0'后解析，
+ *            只把不完整的尾部移到缓冲区开头
+ *          - 命令：API线程把命令放进队列（加锁），I/O线程取出发送，
+ *            状态机 空闲 → 等待回显 → 接收输出（无新数据quiet_ms后结束）→ 空闲
+ *          - 断开：读到EOF/EIO或EPOLLHUP时关闭fd，未完成和排队中的命令报DISCONNECTED，
+ *            按退避间隔重新打开
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#define _GNU_SOURCE
+#include "ptu_host.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+// ==================== 配置 ====================
+
+#define PTU_RX_BUFFER_SIZE      1024    // 接收缓冲区（最长的CAMS行约150字节）
+#define PTU_EPOLL_EVENTS        32
+
+#define PTU_DEFAULT_BAUD        115200
+#define PTU_DEFAULT_ECHO_MS     500
+#define PTU_DEFAULT_QUIET_MS    10
+#define PTU_DEFAULT_RETRY_MIN   100
+#define PTU_DEFAULT_RETRY_MAX   2000
+
+// ==================== 数据结构 ====================
+
+typedef enum {
+    CMD_IDLE = 0,
+    CMD_WAIT_ECHO,
+    CMD_REPLY
+} CmdPhase;
+
+struct PtuUnit {
+    PtuHost *host;
+    PtuUnit *next;
+    char path[256];
+    PtuUnitConfig cfg;
+    PtuCallbacks cb;
+
+    // 以下由host->lock保护
+    int connected;
+    int telemetry;                  ///< 期望的遥测订阅状态
+    int closing;                    ///< 已请求关闭
+    char queue[PTU_CMD_QUEUE_LEN][PTU_CMD_MAX_LEN + 1];
+    uint32_t queue_head;
+    uint32_t queue_count;
+
+    // 以下只在I/O线程中访问
+    int fd;
+    uint32_t retry_ms;
+    uint64_t retry_at_us;
+    char rx[PTU_RX_BUFFER_SIZE];
+    size_t rx_len;
+    size_t rx_scan;                 ///< 已扫描到的位置（不完整的二进制帧从这里重新解析）
+    CmdPhase phase;
+    uint8_t cmd_error;
+    uint64_t deadline_us;
+    char current[PTU_CMD_MAX_LEN + 1];
+    char tx[PTU_CMD_MAX_LEN + 2];
+    size_t tx_len;
+    size_t tx_off;
+};
+
+struct PtuHost {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t closed;          ///< 云台释放完成（PtuUnit_Close等待）
+    int epfd;
+    int wakefd;
+    int stop;
+    PtuUnit *units;
+};
+
+// ==================== 工具函数 ====================
+
+uint64_t PtuHost_Micros(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static void PtuHost_Wake(PtuHost *host)
+{
+    uint64_t one = 1;
+    ssize_t ret = write(host->wakefd, &one, sizeof(one));
+    (void)ret;
+}
+
+static int PtuHost_InIoThread(const PtuHost *host)
+{
+    return pthread_equal(pthread_self(), host->thread);
+}
+
+/**
+ * @brief  波特率转termios常量
+ * @retval 常量，0=不支持
+ */
+static speed_t PtuHost_BaudConst(uint32_t baud)
+{
+    switch (baud)
+    {
+    case 9600:   return B9600;
+    case 19200:  return B19200;
+    case 38400:  return B38400;
+    case 57600:  return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default:     return 0;
+    }
+}
+
+// ==================== 串口 ====================
+
+/**
+ * @brief  打开串口（非阻塞、原始模式）
+ * @retval fd，-1=失败
+ */
+static int PtuUnit_OpenPort(PtuUnit *u)
+{
+    int fd = open(u->path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    if (isatty(fd))
+    {
+        struct termios tio;
+        if (tcgetattr(fd, &tio) == 0)
+        {
+            speed_t speed = PtuHost_BaudConst(u->cfg.baud);
+            cfmakeraw(&tio);
+            tio.c_cflag |= CLOCAL | CREAD;
+            tio.c_cc[VMIN] = 1;    // VMIN=0时无数据的read返回0，与挂断无法区分
+            tio.c_cc[VTIME] = 0;
+            if (speed)
+            {
+                cfsetispeed(&tio, speed);
+                cfsetospeed(&tio, speed);
+            }
+            tcsetattr(fd, TCSANOW, &tio);
+        }
+
+        // USB串口（FTDI等）默认16ms延迟定时器，打开低延迟模式；pty不支持，忽略错误
+        struct serial_struct ss;
+        if (ioctl(fd, TIOCGSERIAL, &ss) == 0)
+        {
+            ss.flags |= ASYNC_LOW_LATENCY;
+            ioctl(fd, TIOCSSERIAL, &ss);
+        }
+        tcflush(fd, TCIOFLUSH);
+    }
+
+    return fd;
+}
+
+/**
+ * @brief  更新epoll关注的事件（有待发数据时关注EPOLLOUT）
+ */
+static void PtuUnit_UpdateEvents(PtuUnit *u, int op)
+{
+    struct epoll_event ev;
+    ev.events = EPOLLIN | EPOLLRDHUP | ((u->tx_off < u->tx_len) ? EPOLLOUT : 0);
+    ev.data.ptr = u;
+    epoll_ctl(u->host->epfd, op, u->fd, &ev);
+}
+
+// ==================== 命令队列 ====================
+
+/**
+ * @brief  命令入队（调用者持有host->lock）
+ * @param  front: 1=插到队首（重连后恢复订阅）
+ */
+static int PtuUnit_EnqueueLocked(PtuUnit *u, const char *cmd, int front)
+{
+    uint32_t slot;
+
+    if (u->queue_count >= PTU_CMD_QUEUE_LEN) return 0;
+
+    if (front)
+    {
+        u->queue_head = (u->queue_head + PTU_CMD_QUEUE_LEN - 1) % PTU_CMD_QUEUE_LEN;
+        slot = u->queue_head;
+    }
+    else
+    {
+        slot = (u->queue_head + u->queue_count) % PTU_CMD_QUEUE_LEN;
+    }
+    strcpy(u->queue[slot], cmd);
+    u->queue_count++;
+    return 1;
+}
+
+/**
+ * @brief  命令结束，回调结果
+ */
+static void PtuUnit_FinishCommand(PtuUnit *u, PtuCmdResult result)
+{
+    u->phase = CMD_IDLE;
+    u->tx_len = u->tx_off = 0;
+    if (u->cb.on_command && !u->closing)
+    {
+        u->cb.on_command(u, u->current, result, u->cb.user);
+    }
+}
+
+/**
+ * @brief  写出待发数据
+ * @retval 0=成功或需要等待可写, -1=串口错误
+ */
+static int PtuUnit_Flush(PtuUnit *u)
+{
+    while (u->tx_off < u->tx_len)
+    {
+        ssize_t n = write(u->fd, u->tx + u->tx_off, u->tx_len - u->tx_off);
+        if (n > 0)
+        {
+            u->tx_off += (size_t)n;
+        }
+        else if (n < 0 && (errno == EAGAIN || errno == EINTR))
+        {
+            break;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+    PtuUnit_UpdateEvents(u, EPOLL_CTL_MOD);
+    return 0;
+}
+
+/**
+ * @brief  空闲时取出下一条命令发送
+ */
+static void PtuUnit_StartCommand(PtuUnit *u, uint64_t now)
+{
+    PtuHost *host = u->host;
+    int have = 0;
+
+    if (u->phase != CMD_IDLE || u->fd < 0) return;
+
+    pthread_mutex_lock(&host->lock);
+    if (u->queue_count > 0)
+    {
+        strcpy(u->current, u->queue[u->queue_head]);
+        u->queue_head = (u->queue_head + 1) % PTU_CMD_QUEUE_LEN;
+        u->queue_count--;
+        have = 1;
+    }
+    pthread_mutex_unlock(&host->lock);
+
+    if (!have) return;
+
+    u->tx_len = (size_t)snprintf(u->tx, sizeof(u->tx), "%s\r", u->current);
+    u->tx_off = 0;
+    u->cmd_error = 0;
+    u->phase = CMD_WAIT_ECHO;
+    u->deadline_us = now + (uint64_t)u->cfg.echo_timeout_ms * 1000ULL;
+    PtuUnit_Flush(u);
+}
+
+// ==================== 连接管理 ====================
+
+static void PtuUnit_Disconnect(PtuUnit *u, uint64_t now)
+{
+    PtuHost *host = u->host;
+    char dropped[PTU_CMD_QUEUE_LEN][PTU_CMD_MAX_LEN + 1];
+    uint32_t count = 0;
+
+    epoll_ctl(host->epfd, EPOLL_CTL_DEL, u->fd, NULL);
+    close(u->fd);
+    u->fd = -1;
+    u->rx_len = 0;
+    u->rx_scan = 0;
+    u->retry_ms = u->cfg.reconnect_min_ms;
+    u->retry_at_us = now + (uint64_t)u->retry_ms * 1000ULL;
+
+    // 排队中的命令不在重连后补发（移动命令过时后执行是危险的）
+    pthread_mutex_lock(&host->lock);
+    u->connected = 0;
+    while (u->queue_count > 0)
+    {
+        strcpy(dropped[count++], u->queue[u->queue_head]);
+        u->queue_head = (u->queue_head + 1) % PTU_CMD_QUEUE_LEN;
+        u->queue_count--;
+    }
+    pthread_mutex_unlock(&host->lock);
+
+    if (u->phase != CMD_IDLE)
+    {
+        PtuUnit_FinishCommand(u, PTU_CMD_DISCONNECTED);
+    }
+    for (uint32_t i = 0; i < count && u->cb.on_command && !u->closing; i++)
+    {
+        u->cb.on_command(u, dropped[i], PTU_CMD_DISCONNECTED, u->cb.user);
+    }
+    if (u->cb.on_connection && !u->closing)
+    {
+        u->cb.on_connection(u, 0, u->cb.user);
+    }
+}
+
+static void PtuUnit_TryConnect(PtuUnit *u, uint64_t now)
+{
+    PtuHost *host = u->host;
+    int fd = PtuUnit_OpenPort(u);
+
+    if (fd < 0)
+    {
+        u->retry_at_us = now + (uint64_t)u->retry_ms * 1000ULL;
+        u->retry_ms *= 2;
+        if (u->retry_ms > u->cfg.reconnect_max_ms) u->retry_ms = u->cfg.reconnect_max_ms;
+        return;
+    }
+
+    u->fd = fd;
+    u->rx_len = 0;
+    u->rx_scan = 0;
+    u->phase = CMD_IDLE;
+    u->retry_ms = u->cfg.reconnect_min_ms;
+
+    // 先发一个空行，清掉固件命令缓冲区里可能残留的半行
+    memcpy(u->tx, "\r", 1);
+    u->tx_len = 1;
+    u->tx_off = 0;
+    PtuUnit_UpdateEvents(u, EPOLL_CTL_ADD);
+    if (PtuUnit_Flush(u) < 0)
+    {
+        PtuUnit_Disconnect(u, now);
+        return;
+    }
+    u->tx_len = u->tx_off = 0;
+
+    pthread_mutex_lock(&host->lock);
+    u->connected = 1;
+    if (u->telemetry) PtuUnit_EnqueueLocked(u, "debug on", 1);
+    pthread_mutex_unlock(&host->lock);
+
+    if (u->cb.on_connection && !u->closing)
+    {
+        u->cb.on_connection(u, 1, u->cb.user);
+    }
+}
+
+// ==================== 接收解析 ====================
+
+/**
+ * @brief  依次解析逗号分隔的整数/浮点字段（原地，不拷贝）
+ * @retval 1=成功, 0=字段不足或格式错误
+ */
+static int PtuHost_NextLong(const char **p, long *v)
+{
+    char *end;
+    if (**p != ',') return 0;
+    *v = strtol(*p + 1, &end, 10);
+    if (end == *p + 1) return 0;
+    *p = end;
+    return 1;
+}
+
+static int PtuHost_NextFloat(const char **p, float *v)
+{
+    char *end;
+    if (**p != ',') return 0;
+    *v = strtof(*p + 1, &end);
+    if (end == *p + 1) return 0;
+    *p = end;
+    return 1;
+}
+
+/**
+ * @brief  DATA,target_x,target_y,dx,dy,pid_h,pid_v,state
+ */
+static int PtuHost_ParseTelemetry(const char *line, PtuTelemetry *t)
+{
+    const char *p = line + 4;
+    long x, y, dx, dy, state;
+
+    if (!PtuHost_NextLong(&p, &x) || !PtuHost_NextLong(&p, &y) ||
+        !PtuHost_NextLong(&p, &dx) || !PtuHost_NextLong(&p, &dy) ||
+        !PtuHost_NextFloat(&p, &t->pid_h) || !PtuHost_NextFloat(&p, &t->pid_v) ||
+        !PtuHost_NextLong(&p, &state) || *p != '\0')
+    {
+        return 0;
+    }
+    t->target_x = (int16_t)x;
+    t->target_y = (int16_t)y;
+    t->dx = (int16_t)dx;
+    t->dy = (int16_t)dy;
+    t->state = (PtuState)state;
+    return 1;
+}
+
+/**
+ * @brief  CAMS,frames,fps_x10,<min,avg,max>*阶段
+ */
+static int PtuHost_ParseCameraStats(const char *line, PtuCameraStats *s)
+{
+    const char *p = line + 4;
+    long v[2 + 3 * PTU_CAMERA_STAGES];
+
+    for (size_t i = 0; i < sizeof(v) / sizeof(v[0]); i++)
+    {
+        if (!PtuHost_NextLong(&p, &v[i])) return 0;
+    }
+    if (*p != '\0') return 0;
+
+    s->frames = (uint32_t)v[0];
+    s->fps_x10 = (uint32_t)v[1];
+    for (int i = 0; i < PTU_CAMERA_STAGES; i++)
+    {
+        s->stage[i].min = (uint32_t)v[2 + 3 * i];
+        s->stage[i].avg = (uint32_t)v[3 + 3 * i];
+        s->stage[i].max = (uint32_t)v[4 + 3 * i];
+    }
+    return 1;
+}
+
+/**
+ * @brief  处理一行（已替换行尾为'\0'）
+ */
+static void PtuUnit_HandleLine(PtuUnit *u, char *line, size_t len, uint64_t now)
+{
+    PtuLineKind kind = PTU_LINE_OTHER;
+
+    if (strncmp(line, "DATA,", 5) == 0)
+    {
+        PtuTelemetry t;
+        if (PtuHost_ParseTelemetry(line, &t))
+        {
+            t.rx_time_us = now;
+            if (u->cb.on_telemetry && !u->closing) u->cb.on_telemetry(u, &t, u->cb.user);
+            return;
+        }
+    }
+    else if (strncmp(line, "CAMS,", 5) == 0)
+    {
+        PtuCameraStats s;
+        if (PtuHost_ParseCameraStats(line, &s))
+        {
+            s.rx_time_us = now;
+            if (u->cb.on_camera_stats && !u->closing) u->cb.on_camera_stats(u, &s, u->cb.user);
+            return;
+        }
+    }
+    else if (u->phase == CMD_WAIT_ECHO && line[0] == '>' && line[1] == ' ' &&
+             strcmp(line + 2, u->current) == 0)
+    {
+        kind = PTU_LINE_ECHO;
+        u->phase = CMD_REPLY;
+    }
+    else if (u->phase == CMD_REPLY)
+    {
+        kind = PTU_LINE_REPLY;
+        if (strncmp(line, "Error", 5) == 0 || strncmp(line, "Unknown command", 15) == 0)
+        {
+            u->cmd_error = 1;
+        }
+    }
+
+    if (u->cb.on_line && !u->closing) u->cb.on_line(u, kind, line, len, u->cb.user);
+}
+
+/**
+ * @brief  读取并按行解析
+ * @retval 0=正常, -1=串口断开
+ */
+static int PtuUnit_Receive(PtuUnit *u, uint64_t now)
+{
+    for (;;)
+    {
+        if (u->rx_len >= sizeof(u->rx) - 1)
+        {
+            u->rx_len = 0;   // 整个缓冲区没有行尾，丢弃
+            u->rx_scan = 0;
+        }
+
+        ssize_t n = read(u->fd, u->rx + u->rx_len, sizeof(u->rx) - 1 - u->rx_len);
+        if (n == 0) return -1;
+        if (n < 0)
+        {
+            if (errno == EAGAIN || errno == EINTR) return 0;
+            return -1;
+        }
+
+        size_t start = 0;
+        size_t end = u->rx_len + (size_t)n;
+        size_t i = u->rx_scan;
+        while (i < end)
+        {
+            uint8_t c = (uint8_t)u->rx[i];
+
+            // BinLog二进制帧: 0xFF len payload checksum，取出后从缓冲区删除
+            if (c == 0xFF)
+            {
+                if (i + 2 > end || i + 3 + (uint8_t)u->rx[i + 1] > end) break;   // 帧不完整，等下次读取
+
+                size_t len = (uint8_t)u->rx[i + 1];
+                const uint8_t *payload = (const uint8_t *)u->rx + i + 2;
+                uint8_t sum = 0;
+                for (size_t k = 0; k < len; k++) sum += payload[k];
+                sum = (uint8_t)~sum;
+                if (sum == payload[len] && u->cb.on_binlog && !u->closing)
+                {
+                    u->cb.on_binlog(u, payload, len, u->cb.user);
+                }
+                memmove(u->rx + i, u->rx + i + 3 + len, end - i - 3 - len);
+                end -= 3 + len;
+                continue;
+            }
+
+            if (c == '\r' || c == '\n')
+            {
+                u->rx[i] = '\0';
+                if (i > start) PtuUnit_HandleLine(u, u->rx + start, i - start, now);
+                start = i + 1;
+            }
+            i++;
+        }
+        u->rx_len = end - start;
+        u->rx_scan = i - start;
+        if (start > 0 && u->rx_len > 0) memmove(u->rx, u->rx + start, u->rx_len);
+
+        // 命令输出期间收到任何数据都推迟结束时刻
+        if (u->phase == CMD_REPLY)
+        {
+            u->deadline_us = now + (uint64_t)u->cfg.quiet_ms * 1000ULL;
+        }
+    }
+}
+
+// ==================== I/O线程 ====================
+
+/**
+ * @brief  释放已请求关闭的云台（持有host->lock调用）
+ */
+static void PtuHost_ReapLocked(PtuHost *host)
+{
+    PtuUnit **pp = &host->units;
+    int reaped = 0;
+
+    while (*pp)
+    {
+        PtuUnit *u = *pp;
+        if (!u->closing)
+        {
+            pp = &u->next;
+            continue;
+        }
+        *pp = u->next;
+        if (u->fd >= 0)
+        {
+            epoll_ctl(host->epfd, EPOLL_CTL_DEL, u->fd, NULL);
+            close(u->fd);
+        }
+        free(u);
+        reaped = 1;
+    }
+    if (reaped) pthread_cond_broadcast(&host->closed);
+}
+
+/**
+ * @brief  到期的重连和命令超时，返回距下一个到期时刻的毫秒数
+ */
+static int PtuHost_RunTimers(PtuHost *host, uint64_t now)
+{
+    uint64_t next = now + 1000000ULL;
+
+    for (PtuUnit *u = host->units; u; u = u->next)
+    {
+        if (u->closing) continue;
+
+        if (u->fd < 0)
+        {
+            if (now >= u->retry_at_us) PtuUnit_TryConnect(u, now);
+            if (u->fd < 0)
+            {
+                if (u->retry_at_us < next) next = u->retry_at_us;
+                continue;
+            }
+        }
+
+        if (u->phase == CMD_WAIT_ECHO && now >= u->deadline_us)
+        {
+            PtuUnit_FinishCommand(u, PTU_CMD_TIMEOUT);
+        }
+        else if (u->phase == CMD_REPLY && now >= u->deadline_us)
+        {
+            PtuUnit_FinishCommand(u, u->cmd_error ? PTU_CMD_ERROR : PTU_CMD_OK);
+        }
+
+        if (u->fd >= 0) PtuUnit_StartCommand(u, now);
+        if (u->phase != CMD_IDLE && u->deadline_us < next) next = u->deadline_us;
+    }
+
+    return (next > now) ? (int)((next - now + 999ULL) / 1000ULL) : 0;
+}
+
+static void *PtuHost_Thread(void *arg)
+{
+    PtuHost *host = (PtuHost *)arg;
+    struct epoll_event events[PTU_EPOLL_EVENTS];
+    int timeout = 0;
+
+    for (;;)
+    {
+        int n = epoll_wait(host->epfd, events, PTU_EPOLL_EVENTS, timeout);
+        uint64_t now = PtuHost_Micros();
+
+        pthread_mutex_lock(&host->lock);
+        PtuHost_ReapLocked(host);
+        int stop = host->stop;
+        pthread_mutex_unlock(&host->lock);
+        if (stop) break;
+
+        for (int i = 0; i < n; i++)
+        {
+            if (events[i].data.ptr == NULL)
+            {
+                uint64_t v;
+                ssize_t ret = read(host->wakefd, &v, sizeof(v));
+                (void)ret;
+                continue;
+            }
+
+            PtuUnit *u = (PtuUnit *)events[i].data.ptr;
+            if (u->fd < 0 || u->closing) continue;
+
+            int failed = 0;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLRDHUP | EPOLLERR))
+            {
+                failed = PtuUnit_Receive(u, now) < 0;
+            }
+            if (!failed && (events[i].events & EPOLLOUT))
+            {
+                failed = PtuUnit_Flush(u) < 0;
+            }
+            if (failed) PtuUnit_Disconnect(u, now);
+        }
+
+        timeout = PtuHost_RunTimers(host, now);
+    }
+
+    return NULL;
+}
+
+// ==================== 对外接口 ====================
+
+PtuHost *PtuHost_Create(void)
+{
+    PtuHost *host = calloc(1, sizeof(*host));
+    struct epoll_event ev;
+
+    if (!host) return NULL;
+
+    host->epfd = epoll_create1(EPOLL_CLOEXEC);
+    host->wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (host->epfd < 0 || host->wakefd < 0) goto fail;
+
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (epoll_ctl(host->epfd, EPOLL_CTL_ADD, host->wakefd, &ev) < 0) goto fail;
+
+    pthread_mutex_init(&host->lock, NULL);
+    pthread_cond_init(&host->closed, NULL);
+    if (pthread_create(&host->thread, NULL, PtuHost_Thread, host) != 0)
+    {
+        pthread_mutex_destroy(&host->lock);
+        pthread_cond_destroy(&host->closed);
+        goto fail;
+    }
+    return host;
+
+fail:
+    if (host->epfd >= 0) close(host->epfd);
+    if (host->wakefd >= 0) close(host->wakefd);
+    free(host);
+    return NULL;
+}
+
+void PtuHost_Destroy(PtuHost *host)
+{
+    if (!host) return;
+
+    pthread_mutex_lock(&host->lock);
+    host->stop = 1;
+    for (PtuUnit *u = host->units; u; u = u->next) u->closing = 1;
+    pthread_mutex_unlock(&host->lock);
+    PtuHost_Wake(host);
+    pthread_join(host->thread, NULL);
+
+    // 线程退出前已释放所有云台
+    close(host->epfd);
+    close(host->wakefd);
+    pthread_mutex_destroy(&host->lock);
+    pthread_cond_destroy(&host->closed);
+    free(host);
+}
+
+PtuUnit *PtuUnit_Open(PtuHost *host, const char *path, const PtuUnitConfig *config,
+                      const PtuCallbacks *callbacks)
+{
+    PtuUnit *u;
+
+    if (!host || !path || strlen(path) >= sizeof(((PtuUnit *)0)->path)) return NULL;
+
+    u = calloc(1, sizeof(*u));
+    if (!u) return NULL;
+
+    u->host = host;
+    strcpy(u->path, path);
+    if (config) u->cfg = *config;
+    if (callbacks) u->cb = *callbacks;
+    if (u->cfg.baud == 0) u->cfg.baud = PTU_DEFAULT_BAUD;
+    if (u->cfg.echo_timeout_ms == 0) u->cfg.echo_timeout_ms = PTU_DEFAULT_ECHO_MS;
+    if (u->cfg.quiet_ms == 0) u->cfg.quiet_ms = PTU_DEFAULT_QUIET_MS;
+    if (u->cfg.reconnect_min_ms == 0) u->cfg.reconnect_min_ms = PTU_DEFAULT_RETRY_MIN;
+    if (u->cfg.reconnect_max_ms == 0) u->cfg.reconnect_max_ms = PTU_DEFAULT_RETRY_MAX;
+    u->fd = -1;
+    u->retry_ms = u->cfg.reconnect_min_ms;
+    u->retry_at_us = 0;   // 立即尝试
+
+    pthread_mutex_lock(&host->lock);
+    u->next = host->units;
+    host->units = u;
+    pthread_mutex_unlock(&host->lock);
+    PtuHost_Wake(host);
+
+    return u;
+}
+
+void PtuUnit_Close(PtuUnit *unit)
+{
+    PtuHost *host;
+
+    if (!unit) return;
+    host = unit->host;
+
+    pthread_mutex_lock(&host->lock);
+    unit->closing = 1;
+    if (!PtuHost_InIoThread(host))
+    {
+        PtuHost_Wake(host);
+        for (;;)
+        {
+            PtuUnit *u = host->units;
+            while (u && u != unit) u = u->next;
+            if (!u) break;
+            pthread_cond_wait(&host->closed, &host->lock);
+        }
+    }
+    pthread_mutex_unlock(&host->lock);
+}
+
+int PtuUnit_IsConnected(const PtuUnit *unit)
+{
+    PtuHost *host = unit->host;
+    int connected;
+
+    pthread_mutex_lock(&host->lock);
+    connected = unit->connected;
+    pthread_mutex_unlock(&host->lock);
+    return connected;
+}
+
+const char *PtuUnit_GetPath(const PtuUnit *unit)
+{
+    return unit->path;
+}
+
+int PtuUnit_Send(PtuUnit *unit, const char *fmt, ...)
+{
+    PtuHost *host = unit->host;
+    char cmd[PTU_CMD_MAX_LEN + 1];
+    va_list args;
+    int len, ok = 0;
+
+    va_start(args, fmt);
+    len = vsnprintf(cmd, sizeof(cmd), fmt, args);
+    va_end(args);
+    if (len <= 0 || len > PTU_CMD_MAX_LEN || strpbrk(cmd, "\r\n")) return 0;
+
+    pthread_mutex_lock(&host->lock);
+    if (unit->connected && !unit->closing)
+    {
+        ok = PtuUnit_EnqueueLocked(unit, cmd, 0);
+    }
+    pthread_mutex_unlock(&host->lock);
+
+    if (ok && !PtuHost_InIoThread(host)) PtuHost_Wake(host);
+    return ok;
+}
+
+int PtuUnit_Enable(PtuUnit *unit, int enable)
+{
+    return PtuUnit_Send(unit, "%s", enable ? "enable" : "disable");
+}
+
+int PtuUnit_SetPID(PtuUnit *unit, char axis, float kp, float ki, float kd)
+{
+    if (axis != 'h' && axis != 'v') return 0;
+    return PtuUnit_Send(unit, "pid %c %g %g %g", axis, kp, ki, kd);
+}
+
+int PtuUnit_SetRate(PtuUnit *unit, uint32_t hz)
+{
+    return PtuUnit_Send(unit, "rate %u", hz);
+}
+
+int PtuUnit_Move(PtuUnit *unit, char axis, float degrees)
+{
+    if (axis != 'h' && axis != 'v') return 0;
+    return PtuUnit_Send(unit, "move %c %.2f", axis, degrees);
+}
+
+int PtuUnit_Stop(PtuUnit *unit)
+{
+    return PtuUnit_Send(unit, "stop");
+}
+
+int PtuUnit_SubscribeTelemetry(PtuUnit *unit, int enable)
+{
+    PtuHost *host = unit->host;
+    int ok = 1;
+
+    pthread_mutex_lock(&host->lock);
+    unit->telemetry = enable ? 1 : 0;
+    if (unit->connected && !unit->closing)
+    {
+        ok = PtuUnit_EnqueueLocked(unit, enable ? "debug on" : "debug off", 0);
+    }
+    pthread_mutex_unlock(&host->lock);
+
+    if (ok && !PtuHost_InIoThread(host)) PtuHost_Wake(host);
+    return ok;
+}
@@ -0,0 +1,250 @@
+# [上位机] 二进制日志解码
+# 功能：从固件ELF（Keil的.axf或仿真的ptu_sim）读出ptu_log段的格式字符串，
+#       把调试串口上的BinLog帧还原成文本，普通文本行原样输出
+# 用法：python3 binlog_decode.py --elf 固件ELF [--baud 115200] [串口|抓包文件|-]
+#       例：python3 binlog_decode.py --elf MDK-ARM/PTU/PTU.axf /dev/ttyUSB0
+#           python3 binlog_decode.py --elf build-sim/ptu_sim /tmp/ptu/ttyUSART2
+# 帧格式见APP/BinLog.h
+# 依赖：仅标准库（Linux）
+
+import argparse
+import os
+import re
+import struct
+import sys
+import termios
+import tty
+
+FRAME_SYNC = 0xFF
+ID_DROPPED = 0xFFFFFFFF
+ID_TIME = 0xFFFFFFFE
+
+BAUD_RATES = {
+    9600: termios.B9600, 19200: termios.B19200, 38400: termios.B38400,
+    57600: termios.B57600, 115200: termios.B115200, 230400: termios.B230400,
+    460800: termios.B460800, 921600: termios.B921600,
+}
+
+# printf转换说明：标志 宽度 精度 长度修饰 转换字符
+SPEC_RE = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|j|t)?([diouxXcfFeEgG%])")
+
+
+# ==================== ELF ====================
+
+def load_strings(path):
+    """读取格式字符串段，返回(段数据, 段基址)"""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF":
+        sys.exit("{}: not an ELF file".format(path))
+    is64 = elf[4] == 2
+    endian = "<" if elf[5] == 1 else ">"
+
+    if is64:
+        shoff, = struct.unpack_from(endian + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x3A)
+        sh_fmt = endian + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2E)
+        sh_fmt = endian + "IIIIIIIIII"
+
+    sections = []
+    for i in range(shnum):
+        name, stype, flags, addr, offset, size, link, info, align, entsize = \
+            struct.unpack_from(sh_fmt, elf, shoff + i * shentsize)
+        sections.append(dict(name=name, type=stype, addr=addr, offset=offset, size=size,
+                             link=link, entsize=entsize))
+
+    def cstr(data, pos):
+        return data[pos:data.index(b"\0", pos)].decode(errors="replace")
+
+    shstr = sections[shstrndx]
+    for s in sections:
+        s["name"] = cstr(elf, shstr["offset"] + s["name"])
+
+    # GCC：不分配地址的.ptu_log段，ID即段内偏移
+    for s in sections:
+        if s["name"] == ".ptu_log":
+            return elf[s["offset"]:s["offset"] + s["size"]], 0
+
+    # ARMCC：段已合并进执行域，按armlink生成的ptu_log$$Base符号定位
+    base = None
+    for s in sections:
+        if s["type"] != 2:   # SHT_SYMTAB
+            continue
+        strtab = sections[s["link"]]
+        sym_fmt = endian + ("IBBHQQ" if is64 else "IIIBBH")
+        for j in range(s["size"] // s["entsize"]):
+            fields = struct.unpack_from(sym_fmt, elf, s["offset"] + j * s["entsize"])
+            name_off, value = (fields[0], fields[4]) if is64 else (fields[0], fields[1])
+            if cstr(elf, strtab["offset"] + name_off) == "ptu_log$$Base":
+                base = value
+    if base is None:
+        sys.exit("{}: no .ptu_log section or ptu_log$$Base symbol".format(path))
+    for s in sections:
+        if s["type"] == 1 and s["addr"] <= base < s["addr"] + s["size"]:   # SHT_PROGBITS
+            start = s["offset"] + base - s["addr"]
+            return elf[start:s["offset"] + s["size"]], base
+    sys.exit("{}: ptu_log$$Base 0x{:08X} not in any section".format(path, base))
+
+
+# ==================== 解码 ====================
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data) or shift > 28:
+            raise ValueError("bad varint")
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return value, pos
+
+
+def render(fmt, args):
+    """按printf格式渲染，参数为32位原始值"""
+    out = []
+    pos = 0
+    it = iter(args)
+    for m in SPEC_RE.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        raw = next(it, None)
+        if raw is None:
+            out.append("<?>")
+            continue
+        if conv in "di":
+            value, conv = struct.unpack("<i", struct.pack("<I", raw))[0], "d"
+        elif conv == "u":
+            value, conv = raw, "d"
+        elif conv == "c":
+            value = chr(raw & 0xFF)
+        elif conv in "fFeEgG":
+            value = struct.unpack("<f", struct.pack("<I", raw))[0]
+        else:
+            value = raw
+        spec = "%" + flags + width + ("." + prec if prec is not None else "") + conv
+        out.append(spec % value)
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+class Decoder:
+    def __init__(self, strings):
+        self.strings = strings
+        self.time_us = 0
+        self.synced = False
+        self.bad = 0
+
+    def format_of(self, fid):
+        if fid >= len(self.strings):
+            return None
+        end = self.strings.find(b"\0", fid)
+        return self.strings[fid:end if end >= 0 else None].decode(errors="replace")
+
+    def frame(self, payload):
+        fid, pos = read_varint(payload, 0)
+        dt, pos = read_varint(payload, pos)
+        args = []
+        while pos < len(payload):
+            v, pos = read_varint(payload, pos)
+            args.append(((v >> 1) ^ -(v & 1)) & 0xFFFFFFFF)   # zigzag
+        self.time_us += dt
+
+        if fid == ID_TIME:
+            if not self.synced and args:
+                self.time_us = args[0] * 1000
+                self.synced = True
+            return None
+        stamp = "[{:12.6f}] ".format(self.time_us / 1e6)
+        if fid == ID_DROPPED:
+            return stamp + "<{} log records dropped>".format(args[0] if args else "?")
+        fmt = self.format_of(fid)
+        if fmt is None:
+            return stamp + "<unknown id 0x{:X} {}> (ELF does not match firmware?)".format(fid, args)
+        return stamp + render(fmt, args)
+
+    def feed(self, buf, emit):
+        """解析缓冲区，返回未处理完的尾部"""
+        pos = 0
+        text_start = 0
+        while pos < len(buf):
+            if buf[pos] != FRAME_SYNC:
+                pos += 1
+                continue
+            if pos + 2 > len(buf):
+                break
+            n = buf[pos + 1]
+            if pos + 3 + n > len(buf):
+                break
+            payload = buf[pos + 2:pos + 2 + n]
+            emit(buf[text_start:pos], None)
+            if (~sum(payload)) & 0xFF == buf[pos + 2 + n]:
+                try:
+                    emit(b"", self.frame(payload))
+                except ValueError:
+                    self.bad += 1
+            else:
+                self.bad += 1
+            pos += 3 + n
+            text_start = pos
+        emit(buf[text_start:pos], None)
+        return buf[pos:]
+
+
+def open_input(path, baud):
+    if path == "-":
+        return sys.stdin.buffer.fileno()
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        attrs = termios.tcgetattr(fd)
+        attrs[4] = attrs[5] = BAUD_RATES[baud]
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BinLog decoder")
+    parser.add_argument("--elf", required=True, help="固件ELF（MDK-ARM/PTU/PTU.axf或仿真的ptu_sim）")
+    parser.add_argument("--baud", type=int, default=115200, choices=sorted(BAUD_RATES))
+    parser.add_argument("input", nargs="?", default="-", help="串口设备、抓包文件或-（标准输入）")
+    args = parser.parse_args()
+
+    strings, _ = load_strings(args.elf)
+    decoder = Decoder(strings)
+    fd = open_input(args.input, args.baud)
+    out = sys.stdout
+
+    def emit(text, line):
+        if text:
+            out.write(text.decode(errors="replace").replace("\r", ""))
+        if line is not None:
+            out.write(line + "\n")
+
+    pending = b""
+    try:
+        while True:
+            data = os.read(fd, 4096)
+            if not data:
+                break
+            pending = decoder.feed(pending + data, emit)
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+    except OSError as e:
+        print("input closed ({})".format(e.strerror), file=sys.stderr)
+    if decoder.bad:
+        print("{} bad frames".format(decoder.bad), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
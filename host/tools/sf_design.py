@@ -0,0 +1,383 @@
+# [上位机] 状态反馈（LQR/LQG）控制器综合
+# 功能：读取ident命令采集的辨识数据，拟合带延迟的单轴模型
+#           e[k+1] = e[k] - (b0·u[k] + b1·u[k-1] + ... + bn·u[k-n])
+#       （e：图像偏差/像素，u：每次测量下发的相对角度/度，k：测量序号），
+#       按给定的控制带宽或权重综合LQR增益和稳态卡尔曼增益，输出sf命令（可直接上传）
+# 用法：python3 sf_design.py [选项] 串口|抓包文件|-
+#       例：python3 sf_design.py --axis h --capture 300 --upload /dev/ttyUSB0   # 采集→综合→上传
+#           python3 sf_design.py --bandwidth 2 id_h.txt                       # 离线综合，打印命令
+# 模型和增益按测量间隔离散，使用时控制频率和相机帧率应与采集时相同
+# 依赖：仅标准库（Linux）
+
+import argparse
+import math
+import os
+import select
+import sys
+import termios
+import time
+import tty
+
+BAUD_RATES = {
+    9600: termios.B9600, 19200: termios.B19200, 38400: termios.B38400,
+    57600: termios.B57600, 115200: termios.B115200, 230400: termios.B230400,
+    460800: termios.B460800, 921600: termios.B921600,
+}
+
+ORDER_MAX = 6            # 与APP/StateFb.h STATEFB_ORDER_MAX一致
+CAPTURE_TIMEOUT_S = 60   # 等待采集结果的时间
+COMMAND_GAP_S = 0.2      # 上传时命令间隔（固件在中断中执行命令，一次一条）
+
+
+# ==================== 数据 ====================
+
+def parse_capture(lines):
+    """解析ID行，返回最后一次完整采集 (轴, 控制频率, [(间隔ms, e, u, 激励)])"""
+    result = None
+    current = None
+    for line in lines:
+        fields = line.strip().split()
+        if len(fields) < 2 or fields[0] != "ID":
+            continue
+        if fields[1] == "begin":
+            info = dict(f.split("=", 1) for f in fields[3:] if "=" in f)
+            current = (fields[2], float(info.get("rate", 0)), [])
+        elif fields[1] == "end":
+            if current is not None:
+                result = current
+            current = None
+        elif current is not None and len(fields) == 6:
+            current[2].append((int(fields[2]), float(fields[3]), float(fields[4]), float(fields[5])))
+    return result
+
+
+def open_port(path, baud):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = BAUD_RATES[baud]
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def read_lines(fd, until, timeout):
+    """读取文本行直到until(line)为真或超时"""
+    lines = []
+    pending = b""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        ready, _, _ = select.select([fd], [], [], 0.1)
+        if not ready:
+            continue
+        pending += os.read(fd, 4096)
+        while b"\n" in pending:
+            raw, pending = pending.split(b"\n", 1)
+            line = raw.decode(errors="replace").strip("\r")
+            lines.append(line)
+            if until(line):
+                return lines
+    return lines
+
+
+def send_command(fd, cmd):
+    os.write(fd, (cmd + "\r\n").encode())
+    return read_lines(fd, lambda line: False, COMMAND_GAP_S)
+
+
+# ==================== 矩阵（维数<=8，纯Python） ====================
+
+def mat_mul(a, b):
+    return [[sum(a[i][k] * b[k][j] for k in range(len(b))) for j in range(len(b[0]))] for i in range(len(a))]
+
+
+def mat_t(a):
+    return [list(r) for r in zip(*a)]
+
+
+def mat_add(a, b, s=1.0):
+    return [[a[i][j] + s * b[i][j] for j in range(len(a[0]))] for i in range(len(a))]
+
+
+def solve(m, v):
+    """高斯消元（列主元）解 m·x = v"""
+    n = len(v)
+    a = [list(m[i]) + [v[i]] for i in range(n)]
+    for c in range(n):
+        p = max(range(c, n), key=lambda r: abs(a[r][c]))
+        if abs(a[p][c]) < 1e-12:
+            raise ValueError("singular")
+        a[c], a[p] = a[p], a[c]
+        for r in range(n):
+            if r != c:
+                f = a[r][c] / a[c][c]
+                a[r] = [x - f * y for x, y in zip(a[r], a[c])]
+    return [a[i][n] / a[i][i] for i in range(n)]
+
+
+def spectral_radius(m):
+    """||M^(2^j)||^(1/2^j)，逐次平方并归一化"""
+    log_scale = 0.0
+    p = m
+    steps = 10
+    for _ in range(steps):
+        p = mat_mul(p, p)
+        log_scale *= 2.0
+        norm = max(max(abs(x) for x in row) for row in p)
+        if norm == 0.0:
+            return 0.0
+        p = [[x / norm for x in row] for row in p]
+        log_scale += math.log(norm)
+    return math.exp(log_scale / 2 ** steps)
+
+
+# ==================== 辨识 ====================
+
+def fit(samples, order):
+    """拟合 Δe[k+1] = c - Σ b_i·u[k-i]，返回 (b, 残差)；常数c吸收目标的缓慢漂移。
+    闭环采集中u含有对e测量噪声的反馈，普通最小二乘有偏，
+    用激励序列d（与噪声无关、与u相关）作工具变量：θ = (ZᵀX)⁻¹Zᵀy"""
+    e = [s[1] for s in samples]
+    u = [s[2] for s in samples]
+    d = [s[3] for s in samples]
+    rows, instruments, ys = [], [], []
+    for k in range(order, len(samples) - 1):
+        rows.append([-u[k - i] for i in range(order + 1)] + [1.0])
+        instruments.append([-d[k - i] for i in range(order + 1)] + [1.0])
+        ys.append(e[k + 1] - e[k])
+    if len(rows) <= order + 2:
+        raise ValueError("too few samples")
+    zt = mat_t(instruments)
+    theta = solve(mat_mul(zt, rows), [sum(a * y for a, y in zip(col, ys)) for col in zt])
+    residual = [y - sum(t * a for t, a in zip(theta, row)) for row, y in zip(rows, ys)]
+    return theta[:order + 1], residual
+
+
+def select_order(samples, order_max):
+    """按AIC选择阶数"""
+    best = None
+    for order in range(order_max + 1):
+        b, residual = fit(samples, order)
+        var = sum(r * r for r in residual) / len(residual)
+        aic = len(residual) * math.log(max(var, 1e-9)) + 2 * (order + 2)
+        if best is None or aic < best[0]:
+            best = (aic, order)
+    return best[1]
+
+
+def noise_model(residual):
+    """Δy = w + v[k+1] - v[k]：残差方差 = q + 2r，一阶自协方差 = -r"""
+    n = len(residual)
+    mean = sum(residual) / n
+    c0 = sum((x - mean) ** 2 for x in residual) / n
+    c1 = sum((residual[i] - mean) * (residual[i + 1] - mean) for i in range(n - 1)) / n
+    r = min(max(-c1, 0.0), c0 / 2.0)
+    q = max(c0 - 2.0 * r, 0.01 * c0, 1e-6)
+    return q, r
+
+
+def kalman_gain(q, r):
+    """ê的稳态卡尔曼增益（输入历史为已知量，只有e是随机状态）：P⁻² - qP⁻ - qr = 0"""
+    if r <= 0.0:
+        return 1.0
+    p = (q + math.sqrt(q * q + 4.0 * q * r)) / 2.0
+    return p / (p + r)
+
+
+# ==================== 综合 ====================
+
+def model(b):
+    """状态 x = [e, u[k-1], ..., u[k-n]]"""
+    n = len(b) - 1
+    dim = n + 1
+    a = [[0.0] * dim for _ in range(dim)]
+    a[0][0] = 1.0
+    for i in range(1, dim):
+        a[0][i] = -b[i]
+    for i in range(2, dim):
+        a[i][i - 1] = 1.0
+    bb = [[-b[0]]] + [[0.0] for _ in range(n)]
+    if n >= 1:
+        bb[1][0] = 1.0
+    return a, bb
+
+
+def lqr(b, rho):
+    """离散LQR：代价 Σ e² + rho·(Σb·u)²，Riccati迭代"""
+    a, bb = model(b)
+    dim = len(a)
+    q = [[1.0 if (i == 0 and j == 0) else 0.0 for j in range(dim)] for i in range(dim)]
+    r = rho * sum(b) ** 2
+    p = q
+    at, bt = mat_t(a), mat_t(bb)
+    for _ in range(20000):
+        pa = mat_mul(p, a)
+        btpa = mat_mul(bt, pa)
+        s = r + mat_mul(bt, mat_mul(p, bb))[0][0]
+        p_new = mat_add(mat_add(q, mat_mul(at, pa)), mat_mul(mat_t(btpa), btpa), -1.0 / s)
+        diff = max(abs(p_new[i][j] - p[i][j]) for i in range(dim) for j in range(dim))
+        p = p_new
+        if diff < 1e-10 * max(1.0, p[0][0]):
+            break
+    s = r + mat_mul(bt, mat_mul(p, bb))[0][0]
+    return [x / s for x in mat_mul(bt, mat_mul(p, a))[0]]
+
+
+def closed_loop(b, k, l, gain=1.0):
+    """与StateFb_Calculate相同的计算顺序，返回单步映射矩阵；状态 [e, ê[k-1], u[k-1], ..., u[k-1-n]]"""
+    n = len(b) - 1
+    dim = n + 3
+
+    def step(z):
+        e, e_hat_prev, hist = z[0], z[1], z[2:]
+        predicted = e_hat_prev - sum(b[i] * hist[i] for i in range(n + 1))
+        e_hat = predicted + l * (e - predicted)
+        u = -(k[0] * e_hat + sum(k[i] * hist[i - 1] for i in range(1, n + 1)))
+        new_hist = [u] + hist[:n]
+        e_next = e - gain * sum(b[i] * new_hist[i] for i in range(n + 1))
+        return [e_next, e_hat] + new_hist
+
+    cols = [step([1.0 if j == i else 0.0 for j in range(dim)]) for i in range(dim)]
+    return mat_t(cols)
+
+
+def step_response(b, k, l, samples):
+    """初始偏差1像素（目标跳变）的偏差序列"""
+    m = closed_loop(b, k, l)
+    z = [1.0, 1.0] + [0.0] * len(b)
+    out = []
+    for _ in range(samples):
+        out.append(z[0])
+        z = [sum(m[i][j] * z[j] for j in range(len(z))) for i in range(len(z))]
+    return out
+
+
+def response_metrics(b, k, l, period):
+    """(偏差衰减到1/e的时间s, 超调比例, 等效带宽Hz)"""
+    resp = step_response(b, k, l, 400)
+    tau = None
+    for i, e in enumerate(resp):
+        if abs(e) < math.exp(-1.0):
+            tau = i * period
+            break
+    overshoot = max(0.0, -min(resp))
+    bandwidth = 1.0 / (2.0 * math.pi * tau) if tau else 0.0
+    return tau, overshoot, bandwidth
+
+
+def gain_margin(b, k, l):
+    """模型增益缩放到多少倍时闭环失稳（上限10倍）"""
+    if spectral_radius(closed_loop(b, k, l)) >= 1.0:
+        return 0.0
+    lo, hi = 1.0, 10.0
+    if spectral_radius(closed_loop(b, k, l, hi)) < 1.0:
+        return hi
+    for _ in range(30):
+        mid = (lo + hi) / 2.0
+        if spectral_radius(closed_loop(b, k, l, mid)) < 1.0:
+            lo = mid
+        else:
+            hi = mid
+    return lo
+
+
+def rho_for_bandwidth(b, l, period, target_hz):
+    """二分控制权重rho，使等效带宽接近目标（带宽随rho减小而提高）"""
+    lo, hi = -8.0, 8.0   # log10(rho)
+    for _ in range(40):
+        mid = (lo + hi) / 2.0
+        _, _, bw = response_metrics(b, lqr(b, 10 ** mid), l, period)
+        if bw < target_hz:
+            hi = mid
+        else:
+            lo = mid
+    return 10 ** ((lo + hi) / 2.0)
+
+
+# ==================== 主程序 ====================
+
+def main():
+    parser = argparse.ArgumentParser(description="LQR/LQG design from ident data")
+    parser.add_argument("input", help="串口设备（先执行采集）、抓包文件或-（标准输入）")
+    parser.add_argument("--baud", type=int, default=115200, choices=sorted(BAUD_RATES))
+    parser.add_argument("--axis", choices=("h", "v"), default="h", help="采集的轴（串口时有效）")
+    parser.add_argument("--capture", type=int, default=300, help="采集样本数（串口时有效）")
+    parser.add_argument("--amp", type=float, default=0.5, help="激励幅度（度，串口时有效）")
+    parser.add_argument("--order", type=int, default=None, help="模型阶数（默认按AIC在0~{}中选择）".format(ORDER_MAX))
+    parser.add_argument("--bandwidth", type=float, default=None, help="目标闭环带宽(Hz)，按此选择控制权重")
+    parser.add_argument("--rho", type=float, default=1.0, help="控制权重（未给--bandwidth时使用，越小越激进）")
+    parser.add_argument("--lqr", action="store_true", help="不加估计器（L=1），直接使用测量值")
+    parser.add_argument("--upload", action="store_true", help="综合后通过串口上传并启用")
+    args = parser.parse_args()
+
+    fd = None
+    if args.input == "-":
+        lines = sys.stdin.read().splitlines()
+    else:
+        fd = os.open(args.input, os.O_RDONLY | os.O_NOCTTY)
+        if os.isatty(fd):
+            os.close(fd)
+            fd = open_port(args.input, args.baud)
+            send_command(fd, "ident {} {} {}".format(args.axis, args.capture, args.amp))
+            print("# capturing {} samples on axis {} ...".format(args.capture, args.axis), file=sys.stderr)
+            lines = read_lines(fd, lambda line: line.startswith("ID end") or "Error" in line, CAPTURE_TIMEOUT_S)
+        else:
+            with os.fdopen(fd, "r", errors="replace") as f:
+                lines = f.read().splitlines()
+            fd = None
+
+    capture = parse_capture(lines)
+    if capture is None or len(capture[2]) < 20:
+        errors = [line for line in lines if "Error" in line]
+        sys.exit("no complete capture{}".format(": " + errors[0] if errors else ""))
+    axis, rate, samples = capture
+
+    period = sum(s[0] for s in samples) / len(samples) * 0.001
+    order = args.order if args.order is not None else select_order(samples, ORDER_MAX)
+    if not 0 <= order <= ORDER_MAX:
+        sys.exit("order must be 0-{}".format(ORDER_MAX))
+    b, residual = fit(samples, order)
+    if abs(sum(b)) < 1e-3:
+        sys.exit("no response to excitation (sum(b)={:.4f}); check target and amplitude".format(sum(b)))
+
+    q, r = noise_model(residual)
+    l = 1.0 if args.lqr else kalman_gain(q, r)
+    rho = rho_for_bandwidth(b, l, period, args.bandwidth) if args.bandwidth else args.rho
+    k = lqr(b, rho)
+    tau, overshoot, bw = response_metrics(b, k, l, period)
+    margin = gain_margin(b, k, l)
+
+    delay = next((i for i, x in enumerate(b) if abs(x) > 0.1 * max(abs(y) for y in b)), 0)
+    print("# axis {}: {} samples, rate {:.1f} Hz, measurement period {:.1f} ms".format(
+        axis, len(samples), rate, period * 1000.0))
+    print("# model n={}: b = [{}] px/deg (sum {:.3f}), dead time ~{} sample(s)".format(
+        order, " ".join("{:.4g}".format(x) for x in b), sum(b), delay))
+    print("# noise: process q={:.3g} px^2, measurement r={:.3g} px^2 -> L={:.3f}".format(q, r, l))
+    print("# LQR rho={:.3g}: K = [{}]".format(rho, " ".join("{:.4g}".format(x) for x in k)))
+    if tau is None:
+        print("# closed loop: no settling within 400 samples (unstable or too slow)")
+    else:
+        print("# closed loop: 1/e time {:.0f} ms (~{:.2f} Hz), overshoot {:.0f}%, gain margin x{:.2f}".format(
+            tau * 1000.0, bw, overshoot * 100.0, margin))
+
+    commands = [
+        "sf {} k {}".format(axis, " ".join("{:.6g}".format(x) for x in k)),
+        "sf {} b {}".format(axis, " ".join("{:.6g}".format(x) for x in b)),
+        "sf {} l {:.4f}".format(axis, l),
+        "sf {} on".format(axis),
+    ]
+    for cmd in commands:
+        print(cmd)
+
+    if args.upload:
+        if fd is None:
+            sys.exit("--upload needs a serial port")
+        if margin < 1.5:
+            sys.exit("gain margin below 1.5, not uploaded (raise --rho or lower --bandwidth)")
+        for cmd in commands:
+            for line in send_command(fd, cmd):
+                if line and not line.startswith("DATA"):
+                    print("# " + line, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,6 @@
 # [MaixCAM] 二维云台 - 目标追踪
 # 功能：检测黑色边框 → 返回中心坐标 → 串口输出
+# 流程：相机直接输出灰度(Y平面) → find_blobs内按阈值直接找黑框，不生成中间图像
 # 适用：黑色边框 + 白色内部的矩形目标
 # 兼容：MaixCAM Pro + MaixVision IDE (MaixPy v4)
 
@@ -13,8 +14,12 @@ UART_PORT = "/dev/ttyS0"
 UART_BAUD = 115200
 UART_LINE_ENDING = "\n"
 ENABLE_CONSOLE_LOG = True  # 改为True方便调试
+SHOW_BINARY = False        # True=显示二值化画面（原地二值化，仅用于调试显示）
 
-# 检测黑色边框的阈值范围（二值化后矩形框是白色的）
+# 分阶段耗时统计：周期性通过串口发送统计帧 "S,..." 给STM32
+STATS_PERIOD_MS = 2000     # 统计帧发送周期(ms)，0=关闭
+
+# 检测黑色边框的灰度阈值范围（直接在灰度图上找blob，无需先二值化）
 BLACK_THRESHOLD = (0, 35)  # 检测黑色边框(灰度值越小越接近黑色)
 MIN_AREA = 100             # 最小有效面积
 MAX_AREA = 15000           # 最大面积限制
@@ -33,6 +38,339 @@ CENTER_WEIGHT = 0.4
 TRACK_WEIGHT = 1.2
 EDGE_MARGIN = 0
 
+# 目标区域测光的曝光/增益控制（替代传感器默认自动曝光）
+AE_ENABLE = True
+AE_PERIOD = 2              # 每N帧调整一次曝光/增益（传感器参数生效有1~2帧延迟）
+AE_TARGET_LUMA = 170       # 目标内部(白色区域)期望亮度
+AE_MIN_CONTRAST = 60       # 黑框与白色内部的最小亮度差（需明显高于BLACK_THRESHOLD上限）
+AE_STEP_MAX = 2.0          # 单次调整的最大倍率（防振荡）
+AE_ROI_MARGIN = 12         # 目标框外扩像素（包含黑框外侧背景）
+EXP_MIN_US = 100           # 曝光时间下限(us)
+EXP_MAX_US = 20000         # 曝光时间上限(us)，无运动时也不超过一帧
+GAIN_MIN = 1024            # 增益下限（传感器单位，1024=1x）
+GAIN_MAX = 16384           # 增益上限（增益越大噪声越大）
+MAX_BLUR_PX = 1.5          # 曝光期间允许的最大运动模糊(像素)
+PIXELS_PER_DEGREE = 4.0    # 镜头角分辨率(像素/度)，用于把云台角速度换算为像面速度
+
+# 静态杂波图：按云台指向把持续出现在同一方位的候选（窗框、标牌等）记为杂波，查询命中的候选不参与评分
+CLUTTER_ENABLE = True
+CLUTTER_CELL_DEG = 1.0     # 方位网格(度)，查询时合并相邻格（容许质心抖动和指向误差）
+CLUTTER_LEARN_HITS = 60    # 同一方位累计命中帧数达到该值判为杂波（30fps约2秒）
+CLUTTER_HITS_MAX = 120     # 命中计数上限（杂波移走后按衰减遗忘的时间）
+CLUTTER_DECAY_FRAMES = 30  # 每N个学习帧衰减一次：视场内本窗口未再出现的格减CLUTTER_DECAY_STEP
+CLUTTER_DECAY_STEP = 30
+CLUTTER_MAX_CELLS = 256    # 网格数上限（超出后不再新增）
+CLUTTER_LEARN_SPEED = 8.0  # 像面速度低于该值(像素/秒)才学习（运动中指向与图像不同步）
+CLUTTER_MATCH_SPEED = 60.0 # 像面速度高于该值时不做抑制
+CLUTTER_POINTING_MS = 500  # 指向超过该时间未更新视为未知（不学习也不抑制）
+CLUTTER_TRACK_RADIUS = 20  # 与上一帧目标距离小于该值(像素)的候选视为正在跟踪的目标，不学习也不抑制
+CLUTTER_STALE_FRAMES = 300 # 跟踪目标在同一方位停留超过该帧数（约10秒）视为锁到杂波，0=不判断
+
+class StageProfiler:
+    """逐帧分阶段计时，累计每阶段的 min/avg/max（单位us）"""
+
+    # 阶段顺序与STM32端Camera.c中的CAMERA_STAGE_*一致，total固定在最后
+    STAGES = ("cap", "blob", "score", "misc", "tx", "disp")
+
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        n = len(self.STAGES) + 1
+        self.frames = 0
+        self.t_min = [0] * n
+        self.t_sum = [0] * n
+        self.t_max = [0] * n
+        self.cur = [0] * n
+        self.window_start = time.ticks_ms()
+
+    def begin(self):
+        self.t_frame = time.ticks_us()
+        self.t_last = self.t_frame
+
+    def mark(self, stage):
+        now = time.ticks_us()
+        self.cur[stage] = now - self.t_last
+        self.t_last = now
+
+    def end(self):
+        self.cur[-1] = self.t_last - self.t_frame
+        for i, t in enumerate(self.cur):
+            if self.frames == 0 or t < self.t_min[i]:
+                self.t_min[i] = t
+            if t > self.t_max[i]:
+                self.t_max[i] = t
+            self.t_sum[i] += t
+        self.frames += 1
+
+    def due(self):
+        return STATS_PERIOD_MS and self.frames and \
+            time.ticks_ms() - self.window_start >= STATS_PERIOD_MS
+
+    def frame(self):
+        """生成统计帧: S,frames,fps*10,<min,avg,max>*阶段...,<min,avg,max>total"""
+        elapsed = max(time.ticks_ms() - self.window_start, 1)
+        fields = [self.frames, self.frames * 10000 // elapsed]
+        for i in range(len(self.cur)):
+            fields += [self.t_min[i], self.t_sum[i] // self.frames, self.t_max[i]]
+        return "S," + ",".join(str(int(v)) for v in fields) + UART_LINE_ENDING
+
+    def summary(self):
+        return " ".join(f"{name}:{self.t_sum[i] // max(self.frames, 1)}"
+                        for i, name in enumerate(self.STAGES + ("total",)))
+
+(STAGE_CAP, STAGE_BLOB, STAGE_SCORE, STAGE_MISC, STAGE_TX, STAGE_DISP) = range(len(StageProfiler.STAGES))
+
+class GimbalLink:
+    """接收STM32下发的云台状态帧 "R,rate_h,rate_v[,pan,tilt]"（角速度单位0.01度/秒，指向单位0.01度），
+    回送压力测试的"L,..."帧"""
+
+    def __init__(self):
+        self.buf = b""
+        self.rate_h = 0.0
+        self.rate_v = 0.0
+        self.pan = 0.0
+        self.tilt = 0.0
+        self.pointing_ms = None
+
+    def poll(self, serial):
+        if not serial:
+            return
+        try:
+            data = serial.read(timeout=0)
+        except Exception:
+            return
+        if not data:
+            return
+        self.buf += data
+        while b"\n" in self.buf:
+            line, self.buf = self.buf.split(b"\n", 1)
+            line = line.strip()
+            if line.startswith(b"L,"):
+                serial.write(line + b"\n")   # 压力测试回环帧：原样回送
+                continue
+            self.parse(line)
+        if len(self.buf) > 64:
+            self.buf = b""
+
+    def parse(self, line):
+        fields = line.split(b",")
+        try:
+            if fields[0] == b"R" and len(fields) in (3, 5):
+                self.rate_h = int(fields[1]) / 100.0
+                self.rate_v = int(fields[2]) / 100.0
+                if len(fields) == 5:
+                    self.pan = int(fields[3]) / 100.0
+                    self.tilt = int(fields[4]) / 100.0
+                    self.pointing_ms = time.ticks_ms()
+        except ValueError:
+            pass
+
+    def pointing(self):
+        """当前指向(pan, tilt)，按角速度外推到当前时刻；指向未知时返回None"""
+        if self.pointing_ms is None:
+            return None
+        age = time.ticks_ms() - self.pointing_ms
+        if age > CLUTTER_POINTING_MS:
+            return None
+        return self.pan + self.rate_h * age / 1000.0, self.tilt + self.rate_v * age / 1000.0
+
+    def image_speed(self):
+        """云台转动引起的像面速度(像素/秒)"""
+        return (self.rate_h ** 2 + self.rate_v ** 2) ** 0.5 * PIXELS_PER_DEGREE
+
+class ClutterMap:
+    """按云台指向学习的静态杂波图
+
+    - 候选的像面位置加上当前指向换算为方位(pan, tilt)，按CLUTTER_CELL_DEG网格累计命中帧数
+    - 云台静止且指向已知时学习：除正在跟踪的目标外，候选所在格+1；视场内长期不再出现的格逐渐衰减
+    - 查询：候选所在格及相邻8格的命中之和达到CLUTTER_LEARN_HITS即判为杂波，直接跳过（不计算评分）
+    - 正在跟踪的目标（靠近上一帧输出）不抑制，目标经过杂波前方时不会丢失；
+      但停在同一方位超过CLUTTER_STALE_FRAMES帧的"目标"视为锁到了杂波，直接记为杂波并取消例外
+    """
+
+    def __init__(self):
+        self.cells = {}            # (ix, iy) -> [命中帧数, 最近命中的学习帧序号]
+        self.learn_frames = 0
+        self.active = False
+        self.learning = False
+        self.observed = []
+        self.suppressed = 0
+        self.track_key = None
+        self.track_frames = 0
+        self.stale_key = None
+
+    @staticmethod
+    def near(a, b):
+        return b is not None and abs(a[0] - b[0]) <= 1 and abs(a[1] - b[1]) <= 1
+
+    def key(self, x, y):
+        """像面坐标 -> 方位网格"""
+        pan = self.pan + (x - self.img_cx) / PIXELS_PER_DEGREE
+        tilt = self.tilt - (y - self.img_cy) / PIXELS_PER_DEGREE
+        return round(pan / CLUTTER_CELL_DEG), round(tilt / CLUTTER_CELL_DEG)
+
+    def begin(self, link, img_w, img_h, last_cx, last_cy):
+        """每帧检测前调用：取当前指向，决定本帧是否学习/抑制"""
+        self.observed = []
+        self.suppressed = 0
+        pointing = link.pointing()
+        speed = link.image_speed()
+        self.active = pointing is not None and speed <= CLUTTER_MATCH_SPEED
+        self.learning = self.active and speed <= CLUTTER_LEARN_SPEED
+        if not self.active:
+            return
+        self.pan, self.tilt = pointing
+        self.img_cx = img_w / 2
+        self.img_cy = img_h / 2
+        self.half_w = img_w / 2 / PIXELS_PER_DEGREE
+        self.half_h = img_h / 2 / PIXELS_PER_DEGREE
+        self.last_cx = last_cx
+        self.last_cy = last_cy
+
+    def check(self, x, y):
+        """候选是否为杂波（True=跳过）；同时记录本帧候选供学习"""
+        if not self.active:
+            return False
+        k = self.key(x, y)
+        if (self.last_cx or self.last_cy) and not self.near(k, self.stale_key):
+            dx = x - self.last_cx
+            dy = y - self.last_cy
+            if dx * dx + dy * dy < CLUTTER_TRACK_RADIUS * CLUTTER_TRACK_RADIUS:
+                return False
+        self.observed.append(k)
+        hits = 0
+        for ix in (k[0] - 1, k[0], k[0] + 1):
+            for iy in (k[1] - 1, k[1], k[1] + 1):
+                c = self.cells.get((ix, iy))
+                if c:
+                    hits += c[0]
+        if hits >= CLUTTER_LEARN_HITS:
+            self.suppressed += 1
+            return True
+        return False
+
+    def end(self, cx, cy, valid):
+        """每帧输出后调用：跟踪目标的停留计时、学习和衰减"""
+        if not self.active:
+            return
+        if valid:
+            k = self.key(cx, cy)
+            if self.near(k, self.track_key):
+                self.track_frames += 1
+            else:
+                self.track_key = k
+                self.track_frames = 0
+                if not self.near(k, self.stale_key):
+                    self.stale_key = None
+        else:
+            self.track_key = None
+            self.track_frames = 0
+        if not self.learning:
+            return
+
+        if CLUTTER_STALE_FRAMES and self.track_frames >= CLUTTER_STALE_FRAMES and self.stale_key is None:
+            self.cells[self.track_key] = [CLUTTER_HITS_MAX, self.learn_frames + 1]
+            self.stale_key = self.track_key
+
+        self.learn_frames += 1
+        for k in set(self.observed):
+            c = self.cells.get(k)
+            if c:
+                c[0] = min(c[0] + 1, CLUTTER_HITS_MAX)
+                c[1] = self.learn_frames
+            elif len(self.cells) < CLUTTER_MAX_CELLS:
+                self.cells[k] = [1, self.learn_frames]
+
+        if self.learn_frames % CLUTTER_DECAY_FRAMES:
+            return
+        window = self.learn_frames - CLUTTER_DECAY_FRAMES
+        for k in list(self.cells):
+            c = self.cells[k]
+            if c[1] > window:
+                continue
+            # 只衰减视场内的格：转到别处时已学到的杂波保留
+            if abs(k[0] * CLUTTER_CELL_DEG - self.pan) > self.half_w or \
+               abs(k[1] * CLUTTER_CELL_DEG - self.tilt) > self.half_h:
+                continue
+            c[0] -= CLUTTER_DECAY_STEP
+            if c[0] <= 0:
+                del self.cells[k]
+
+    def count(self):
+        """已判为杂波的网格数"""
+        return sum(1 for c in self.cells.values() if c[0] >= CLUTTER_LEARN_HITS)
+
+class ExposureController:
+    """以目标区域为测光区的曝光/增益控制
+
+    - 亮度：调整 曝光×增益 使目标白色内部接近AE_TARGET_LUMA
+    - 对比度：黑框变亮(过曝)时降低、整体偏暗时提高，保持黑白差高于AE_MIN_CONTRAST
+    - 运动模糊：曝光时间不超过 MAX_BLUR_PX / 像面速度，不足部分由增益补偿
+    """
+
+    def __init__(self, cam):
+        self.cam = cam
+        self.frame_count = 0
+        self.exposure = EXP_MAX_US
+        self.gain = GAIN_MIN
+        try:
+            cam.exp_mode(1)  # 手动曝光
+            self.exposure = max(EXP_MIN_US, min(cam.exposure(), EXP_MAX_US))
+            self.gain = max(GAIN_MIN, min(cam.gain(), GAIN_MAX))
+        except Exception as e:
+            print(f"Manual exposure unavailable: {e}")
+            self.cam = None
+
+    def exposure_limit(self, image_speed):
+        if image_speed <= 0:
+            return EXP_MAX_US
+        limit = int(MAX_BLUR_PX / image_speed * 1000000)
+        return max(EXP_MIN_US, min(limit, EXP_MAX_US))
+
+    def update(self, gray_img, rect, image_speed):
+        if not self.cam:
+            return
+        self.frame_count += 1
+        if self.frame_count % AE_PERIOD:
+            return
+
+        # 测光区：锁定时为目标框(含黑框外侧)，否则为画面中心区域
+        w, h = gray_img.width(), gray_img.height()
+        if rect:
+            x, y, rw, rh = rect
+            x0 = max(x - AE_ROI_MARGIN, 0)
+            y0 = max(y - AE_ROI_MARGIN, 0)
+            roi = [x0, y0,
+                   min(x + rw + AE_ROI_MARGIN, w) - x0,
+                   min(y + rh + AE_ROI_MARGIN, h) - y0]
+        else:
+            roi = [w // 4, h // 4, w // 2, h // 2]
+        st = gray_img.get_statistics(roi=roi)
+        dark = st.l_lq()
+        bright = max(st.l_uq(), 1)
+
+        # 亮度校正倍率（作用于 曝光×增益）
+        ratio = AE_TARGET_LUMA / bright
+        if bright - dark < AE_MIN_CONTRAST:
+            if dark > BLACK_THRESHOLD[1]:
+                ratio = min(ratio, 0.7)   # 黑框被抬亮：降低
+            else:
+                ratio = max(ratio, 1.4)   # 整体偏暗：提高
+        ratio = max(1.0 / AE_STEP_MAX, min(ratio, AE_STEP_MAX))
+
+        # 曝光优先受模糊上限约束，剩余亮度需求由增益承担
+        product = self.exposure * self.gain * ratio
+        exposure = max(EXP_MIN_US, min(int(product / GAIN_MIN), self.exposure_limit(image_speed)))
+        gain = max(GAIN_MIN, min(int(product / exposure), GAIN_MAX))
+
+        if exposure != self.exposure:
+            self.exposure = exposure
+            self.cam.exposure(exposure)
+        if gain != self.gain:
+            self.gain = gain
+            self.cam.gain(gain)
+
 def init_uart():
     """初始化串口通信"""
     try:
@@ -41,14 +379,16 @@ def init_uart():
         print(f"UART failed: {e}")
         return None
 
-def find_white_frame_center(gray_img, black_binary_img, last_cx=0, last_cy=0):
-    """检测黑色边框(二值化为白色)并返回框的中心坐标"""
-    blobs = black_binary_img.find_blobs([(128, 255)],
-                                        pixels_threshold=MIN_AREA,
-                                        area_threshold=MIN_AREA,
-                                        merge=True)
+def find_white_frame_center(gray_img, last_cx=0, last_cy=0, prof=None, clutter=None):
+    """检测黑色边框并返回框的中心坐标（阈值判断在find_blobs内部逐像素完成）；命中杂波图的候选直接跳过"""
+    blobs = gray_img.find_blobs([BLACK_THRESHOLD],
+                                pixels_threshold=MIN_AREA,
+                                area_threshold=MIN_AREA,
+                                merge=True)
+    if prof:
+        prof.mark(STAGE_BLOB)
     if not blobs:
-        return 0, 0, 0, 0
+        return 0, 0, 0, 0, None
 
     img_w = gray_img.width()
     img_h = gray_img.height()
@@ -76,6 +416,9 @@ def find_white_frame_center(gray_img, black_binary_img, last_cx=0, last_cy=0):
             bc_x = b.cx()
             bc_y = b.cy()
 
+            if clutter and clutter.check(bc_x, bc_y):
+                continue
+
             dx0 = bc_x - img_cx
             dy0 = bc_y - img_cy
             score = b.area() - CENTER_WEIGHT * (dx0 * dx0 + dy0 * dy0)
@@ -115,22 +458,26 @@ def find_white_frame_center(gray_img, black_binary_img, last_cx=0, last_cy=0):
             continue
 
     if best is not None:
-        return best.cx(), best.cy(), len(blobs), 1
+        return best.cx(), best.cy(), len(blobs), 1, best.rect()
 
     if relaxed is not None:
-        return relaxed.cx(), relaxed.cy(), len(blobs), 3
+        return relaxed.cx(), relaxed.cy(), len(blobs), 3, relaxed.rect()
 
     if fallback is not None:
-        return fallback.cx(), fallback.cy(), len(blobs), 4
+        return fallback.cx(), fallback.cy(), len(blobs), 4, fallback.rect()
 
-    return 0, 0, len(blobs), 0
+    return 0, 0, len(blobs), 0, None
 
 def send_coord(serial, cx, cy):
     """通过串口发送坐标数据"""
+    return send_line(serial, f"{cx},{cy}{UART_LINE_ENDING}")
+
+def send_line(serial, line):
+    """通过串口发送一行数据"""
     if not serial:
         return None, 0
     try:
-        serial.write(f"{cx},{cy}{UART_LINE_ENDING}".encode())
+        serial.write(line.encode())
         return serial, 1
     except Exception as e:
         print(f"UART write failed: {e}")
@@ -141,8 +488,8 @@ if __name__ == "__main__":
     print("Starting MaixCAM Gimbal Tracker...")
     print("=" * 50)
 
-    # 初始化硬件
-    cam = camera.Camera(IMG_WIDTH, IMG_HEIGHT)
+    # 初始化硬件（直接采集灰度图，省去彩色帧和格式转换）
+    cam = camera.Camera(IMG_WIDTH, IMG_HEIGHT, image.Format.FMT_GRAYSCALE)
     disp = display.Display()
     serial = init_uart()
 
@@ -155,17 +502,31 @@ if __name__ == "__main__":
     last_cy = 0
     tx_count = 0
     last_tx_ok = 0
+    prof = StageProfiler()
+    link = GimbalLink()
+    ae = ExposureController(cam) if AE_ENABLE else None
+    clutter = ClutterMap() if CLUTTER_ENABLE else None
 
     while not app.need_exit():
-        # 获取图像并转换为灰度
-        img = cam.read()
-        gray = img.to_format(image.Format.FMT_GRAYSCALE)
-
-        # 二值化：突出黑色边框(黑色 -> 白色)
-        black_binary = gray.binary([BLACK_THRESHOLD])
-
-        # 检测白色矩形框中心坐标
-        cx, cy, blob_cnt, valid = find_white_frame_center(gray, black_binary, last_cx, last_cy)
+        prof.begin()
+
+        # 获取灰度图像（每帧只有这一块帧缓冲）
+        gray = cam.read()
+        prof.mark(STAGE_CAP)
+
+        # 检测黑色矩形框中心坐标（按上一帧收到的指向查询杂波图）
+        if clutter:
+            clutter.begin(link, gray.width(), gray.height(), last_cx, last_cy)
+        cx, cy, blob_cnt, valid, rect = find_white_frame_center(gray, last_cx, last_cy, prof, clutter)
+        prof.mark(STAGE_SCORE)
+
+        # 杂波图学习、接收云台状态、根据目标区域亮度和当前云台角速度调整曝光/增益（计入misc阶段）
+        if clutter:
+            clutter.end(cx, cy, valid)
+        link.poll(serial)
+        if ae:
+            ae.update(gray, rect if valid else None, link.image_speed())
+        prof.mark(STAGE_MISC)
 
         out_valid = valid
         if not valid:
@@ -181,22 +542,39 @@ if __name__ == "__main__":
             tx_count += 1
         if serial is None:
             serial = init_uart()
+        prof.mark(STAGE_TX)
+
+        # 调试显示：检测完成后原地二值化（黑色 -> 白色），不分配新图像
+        if SHOW_BINARY:
+            gray.binary([BLACK_THRESHOLD], copy=False)
 
         # 显示检测结果
         if cx and cy:
-            black_binary.draw_cross(cx, cy, image.Color.from_rgb(255, 255, 255), size=10)
-            black_binary.draw_string(cx+15, cy-10, f"({cx},{cy})", image.Color.from_rgb(255, 255, 255))
+            gray.draw_cross(cx, cy, image.COLOR_WHITE, size=10)
+            gray.draw_string(cx+15, cy-10, f"({cx},{cy})", image.COLOR_WHITE)
 
         # 显示状态信息
         uart_state = 1 if serial else 0
         status = f"Target: ({cx},{cy}) | PORT:{UART_PORT} UART_OK:{uart_state} TX:{tx_count} OK:{last_tx_ok} | Blobs:{blob_cnt} | ok:{out_valid}"
-        black_binary.draw_string(5, 5, status, image.Color.from_rgb(255, 255, 255))
-
-        # 显示二值化图像
-        disp.show(black_binary)
+        if clutter:
+            status += f" | Clutter:{clutter.suppressed}/{clutter.count()}"
+        gray.draw_string(5, 5, status, image.COLOR_WHITE)
+
+        # 显示图像
+        disp.show(gray)
+        prof.mark(STAGE_DISP)
+        prof.end()
+
+        # 周期性上报分阶段耗时统计（在prof.end()之后、下一帧begin()之前发送，统计帧本身的发送时间不计入任何阶段）
+        if prof.due():
+            if ENABLE_CONSOLE_LOG:
+                print(f"Stages(us): {prof.summary()}")
+            serial, _ = send_line(serial, prof.frame())
+            prof.reset()
 
         # 控制台输出
         if ENABLE_CONSOLE_LOG:
-            print(f"Target: ({cx}, {cy}) | TX:{tx_count} | FPS: {time.fps():.1f}")
+            exp_info = f" | EXP:{ae.exposure}us GAIN:{ae.gain}" if ae else ""
+            print(f"Target: ({cx}, {cy}) | TX:{tx_count} | FPS: {time.fps():.1f}{exp_info}")
 
     print("\nMaixCAM Gimbal Tracker stopped.")
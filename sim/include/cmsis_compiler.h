@@ -0,0 +1,98 @@
+/**
+ * @file    cmsis_compiler.h
+ * @brief   Linux仿真：CMSIS编译器/内核寄存器访问替身
+ * @details 供cmsis_os2.c使用。__get_IPSR()在仿真中断分发期间返回非0，
+ *          使IS_IRQ()与真实硬件行为一致；开关中断映射到POSIX端口的信号屏蔽。
+ *          CMSIS-DSP头文件用到的__SSAT/__CLZ以普通C实现
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef __CMSIS_COMPILER_H
+#define __CMSIS_COMPILER_H
+
+#include <stdint.h>
+
+#ifndef   __STATIC_INLINE
+  #define __STATIC_INLINE   static inline
+#endif
+#ifndef   __STATIC_FORCEINLINE
+  #define __STATIC_FORCEINLINE static inline
+#endif
+#ifndef   __WEAK
+  #define __WEAK            __attribute__((weak))
+#endif
+#ifndef   __NO_RETURN
+  #define __NO_RETURN       __attribute__((__noreturn__))
+#endif
+#ifndef   __USED
+  #define __USED            __attribute__((used))
+#endif
+#ifndef   __ALIGNED
+  #define __ALIGNED(x)      __attribute__((aligned(x)))
+#endif
+#ifndef   __NOP
+  #define __NOP()           ((void)0)
+#endif
+#ifndef   __DSB
+  #define __DSB()           __sync_synchronize()
+#endif
+#ifndef   __ISB
+  #define __ISB()           __sync_synchronize()
+#endif
+
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t val, uint32_t sat)
+{
+    int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+    int32_t min = -1 - max;
+    return (val > max) ? max : ((val < min) ? min : val);
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+/**
+ * @brief 仿真IRQ号（对应IPSR），0=线程模式
+ */
+extern volatile uint32_t sim_ipsr;
+
+/**
+ * @brief 仿真中断屏蔽嵌套计数（对应PRIMASK）
+ */
+extern volatile uint32_t sim_primask;
+
+void sim_disable_irq(void);
+void sim_enable_irq(void);
+
+__STATIC_INLINE uint32_t __get_IPSR(void)    { return sim_ipsr; }
+__STATIC_INLINE uint32_t __get_PRIMASK(void) { return sim_primask != 0U; }
+__STATIC_INLINE uint32_t __get_BASEPRI(void) { return 0U; }
+
+#define __disable_irq()   sim_disable_irq()
+#define __enable_irq()    sim_enable_irq()
+
+/**
+ * @brief SysTick寄存器替身（cmsis_os2.c的osKernelGetSysTimerCount会读取）
+ * @note  SysTick是变量而不是宏，避免cmsis_os2.c生成依赖xPortSysTickHandler的SysTick_Handler
+ */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type *const SysTick;
+
+typedef int32_t IRQn_Type;
+
+__STATIC_INLINE void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) { (void)IRQn; (void)priority; }
+
+/**
+ * @brief 软件复位替身：仿真进程退出
+ */
+__NO_RETURN void NVIC_SystemReset(void);
+
+#endif
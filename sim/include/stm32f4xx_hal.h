@@ -0,0 +1,249 @@
+/**
+ * @file    stm32f4xx_hal.h
+ * @brief   Linux仿真：STM32F4 HAL替身
+ * @details 只提供APP层与Core/Src/main.c、freertos.c用到的类型和接口。
+ *          UART由pty/管道实现，接收/发送完成回调由仿真中断任务触发，
+ *          时钟配置等硬件初始化为空操作
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "cmsis_compiler.h"
+
+/* ==================== 通用定义 ==================== */
+
+typedef enum {
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY      0xFFFFFFFFU
+
+#define UNUSED(X) (void)X
+
+/* ==================== 外设实例 ==================== */
+
+/**
+ * @brief USART外设替身（只用于区分实例）
+ */
+typedef struct {
+    const char *name;      ///< 外设名（"USART1"...）
+    uint32_t irqn;         ///< 仿真IRQ号（__get_IPSR()返回值）
+} USART_TypeDef;
+
+extern USART_TypeDef sim_usart1;
+extern USART_TypeDef sim_usart2;
+extern USART_TypeDef sim_usart3;
+extern USART_TypeDef sim_usart6;
+extern USART_TypeDef sim_uart4;
+
+#define USART1 (&sim_usart1)
+#define USART2 (&sim_usart2)
+#define USART3 (&sim_usart3)
+#define USART6 (&sim_usart6)
+#define UART4  (&sim_uart4)
+
+/**
+ * @brief TIM外设替身（HAL时基TIM6，只用于区分实例）
+ */
+typedef struct {
+    const char *name;
+} TIM_TypeDef;
+
+extern TIM_TypeDef sim_tim6;
+
+#define TIM6 (&sim_tim6)
+
+/* ==================== DMA ==================== */
+
+typedef struct {
+    void *Instance;
+} DMA_HandleTypeDef;
+
+/* ==================== TIM ==================== */
+
+typedef struct {
+    TIM_TypeDef *Instance;
+} TIM_HandleTypeDef;
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+
+/* ==================== UART ==================== */
+
+typedef enum {
+    HAL_UART_STATE_RESET      = 0x00U,
+    HAL_UART_STATE_READY      = 0x20U,
+    HAL_UART_STATE_BUSY       = 0x24U,
+    HAL_UART_STATE_BUSY_TX    = 0x21U,
+    HAL_UART_STATE_BUSY_RX    = 0x22U,
+    HAL_UART_STATE_BUSY_TX_RX = 0x23U,
+    HAL_UART_STATE_TIMEOUT    = 0xA0U,
+    HAL_UART_STATE_ERROR      = 0xE0U
+} HAL_UART_StateTypeDef;
+
+#define UART_WORDLENGTH_8B      0x00000000U
+#define UART_STOPBITS_1         0x00000000U
+#define UART_PARITY_NONE        0x00000000U
+#define UART_MODE_TX_RX         0x0000000CU
+#define UART_HWCONTROL_NONE     0x00000000U
+#define UART_OVERSAMPLING_16    0x00000000U
+
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct __UART_HandleTypeDef {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    uint8_t *pTxBuffPtr;
+    uint16_t TxXferSize;
+    volatile uint16_t TxXferCount;
+    uint8_t *pRxBuffPtr;
+    uint16_t RxXferSize;
+    volatile uint16_t RxXferCount;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+    volatile HAL_UART_StateTypeDef gState;
+    volatile HAL_UART_StateTypeDef RxState;
+    volatile uint32_t ErrorCode;
+
+    /* 仿真扩展字段 */
+    int sim_fd;                      ///< pty主端/管道文件描述符
+    uint64_t sim_tx_done_us;         ///< 中断/DMA发送完成时刻
+    /** 批量接收处理（UartFast替身注册；非NULL时不再按HAL_UART_Receive_IT分发） */
+    void (*sim_rx_handler)(struct __UART_HandleTypeDef *huart, const uint8_t *data, uint32_t len);
+} UART_HandleTypeDef;
+
+/* 实机读SR/DR清除溢出并丢弃接收寄存器中的旧字节；仿真中丢弃pty里未读的字节 */
+#define __HAL_UART_CLEAR_OREFLAG(__HANDLE__)  Sim_UartFlushRx(__HANDLE__)
+void Sim_UartFlushRx(UART_HandleTypeDef *huart);
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+
+/* ==================== 系统 ==================== */
+
+HAL_StatusTypeDef HAL_Init(void);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_IncTick(void);
+
+/* ==================== RCC/PWR（main.c时钟配置用，空操作） ==================== */
+
+typedef struct {
+    uint32_t PLLState;
+    uint32_t PLLSource;
+    uint32_t PLLM;
+    uint32_t PLLN;
+    uint32_t PLLP;
+    uint32_t PLLQ;
+} RCC_PLLInitTypeDef;
+
+typedef struct {
+    uint32_t OscillatorType;
+    uint32_t HSEState;
+    uint32_t LSEState;
+    uint32_t HSIState;
+    uint32_t HSICalibrationValue;
+    uint32_t LSIState;
+    RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct {
+    uint32_t ClockType;
+    uint32_t SYSCLKSource;
+    uint32_t AHBCLKDivider;
+    uint32_t APB1CLKDivider;
+    uint32_t APB2CLKDivider;
+} RCC_ClkInitTypeDef;
+
+#define RCC_OSCILLATORTYPE_HSI      0x00000002U
+#define RCC_HSI_ON                  1U
+#define RCC_HSICALIBRATION_DEFAULT  0x10U
+#define RCC_PLL_ON                  2U
+#define RCC_PLLSOURCE_HSI           0U
+#define RCC_PLLP_DIV2               2U
+#define RCC_CLOCKTYPE_SYSCLK        0x00000001U
+#define RCC_CLOCKTYPE_HCLK          0x00000002U
+#define RCC_CLOCKTYPE_PCLK1         0x00000004U
+#define RCC_CLOCKTYPE_PCLK2         0x00000008U
+#define RCC_SYSCLKSOURCE_PLLCLK     2U
+#define RCC_SYSCLK_DIV1             0U
+#define RCC_HCLK_DIV2               4U
+#define RCC_HCLK_DIV4               5U
+#define FLASH_LATENCY_5             5U
+#define PWR_REGULATOR_VOLTAGE_SCALE1 1U
+
+#define __HAL_RCC_PWR_CLK_ENABLE()            ((void)0)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(x)    ((void)(x))
+
+/**
+ * @brief RCC寄存器替身（只有复位标志寄存器CSR，事件日志读取复位原因）
+ */
+typedef struct {
+    volatile uint32_t CSR;
+} RCC_TypeDef;
+
+extern RCC_TypeDef sim_rcc;
+
+#define RCC (&sim_rcc)
+#define __HAL_RCC_CLEAR_RESET_FLAGS()         (RCC->CSR = 0U)
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+
+extern uint32_t SystemCoreClock;
+
+/* ==================== 仿真专用接口 ==================== */
+
+/**
+ * @brief  单调时钟（微秒）
+ * @retval 自进程启动以来的微秒数
+ */
+uint64_t Sim_Micros(void);
+
+/**
+ * @brief  按微秒阻塞等待（不让出CPU，模拟忙等）
+ * @param  us: 等待时间
+ * @retval None
+ */
+void Sim_BusyWait(uint64_t us);
+
+/**
+ * @brief  计算线路传输时间
+ * @param  huart: UART句柄
+ * @param  size: 字节数
+ * @retval 微秒（8N1，每字节10位）
+ */
+uint64_t Sim_WireTimeUs(UART_HandleTypeDef *huart, uint16_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
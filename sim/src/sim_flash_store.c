@@ -0,0 +1,118 @@
+/**
+ * @file    sim_flash_store.c
+ * @brief   Linux仿真：FlashStore模块替身
+ * @details 保留扇区映射到文件（环境变量SIM_FLASH指定，默认当前目录下flash.bin），
+ *          重启ptu_sim后数据仍在，接口与APP/FlashStore.c一致：
+ *          - 编程按NOR Flash语义只能把1写成0（与原内容按位与）
+ *          - 每次擦除/编程立即写回文件（模拟写入过程中掉电时文件内容与Flash一致）
+ *          - 不模拟擦除/编程期间的CPU停顿
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#define _GNU_SOURCE
+#include "FlashStore.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define SIM_FLASH_DEFAULT  "flash.bin"
+
+static uint8_t sim_flash[FLASH_STORE_AREA_COUNT][FLASH_STORE_AREA_SIZE];
+static int sim_flash_fd = -1;
+static uint8_t sim_flash_loaded = 0;
+
+/**
+ * @brief  首次访问时从文件载入（文件不存在或长度不足的部分为擦除状态）
+ * @retval None
+ */
+static void Sim_FlashLoad(void)
+{
+    const char *path = getenv("SIM_FLASH");
+    ssize_t n;
+
+    if (sim_flash_loaded) return;
+    sim_flash_loaded = 1;
+
+    memset(sim_flash, 0xFF, sizeof(sim_flash));
+    if (path == NULL) path = SIM_FLASH_DEFAULT;
+
+    sim_flash_fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (sim_flash_fd < 0) {
+        fprintf(stderr, "[sim] flash: cannot open %s, contents will not persist\n", path);
+        return;
+    }
+    n = pread(sim_flash_fd, sim_flash, sizeof(sim_flash), 0);
+    printf("[sim] flash: %s (%ld bytes loaded)\n", path, (long)(n > 0 ? n : 0));
+}
+
+/**
+ * @brief  写回文件
+ * @param  area: 区域
+ * @param  offset: 区域内偏移
+ * @param  len: 长度
+ * @retval None
+ */
+static void Sim_FlashWriteBack(FlashStoreArea area, uint32_t offset, uint32_t len)
+{
+    off_t pos = (off_t)area * FLASH_STORE_AREA_SIZE + offset;
+
+    if (sim_flash_fd >= 0 && pwrite(sim_flash_fd, &sim_flash[area][offset], len, pos) != (ssize_t)len) {
+        fprintf(stderr, "[sim] flash: write failed\n");
+    }
+}
+
+const uint8_t *FlashStore_Base(FlashStoreArea area)
+{
+    Sim_FlashLoad();
+    return sim_flash[area];
+}
+
+uint8_t FlashStore_Erase(FlashStoreArea area)
+{
+    Sim_FlashLoad();
+    memset(sim_flash[area], 0xFF, FLASH_STORE_AREA_SIZE);
+    Sim_FlashWriteBack(area, 0, FLASH_STORE_AREA_SIZE);
+    return 1;
+}
+
+uint8_t FlashStore_Program(FlashStoreArea area, uint32_t offset, const uint32_t *words, uint32_t count)
+{
+    if ((offset & 3U) != 0U || offset + count * 4U > FLASH_STORE_AREA_SIZE) {
+        return 0;
+    }
+
+    Sim_FlashLoad();
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t *p = (uint32_t *)&sim_flash[area][offset + i * 4U];
+        *p &= words[i];
+    }
+    Sim_FlashWriteBack(area, offset, count * 4U);
+    return 1;
+}
+
+uint8_t FlashStore_IsBlank(FlashStoreArea area)
+{
+    const uint32_t *p = (const uint32_t *)FlashStore_Base(area);
+
+    for (uint32_t i = 0; i < FLASH_STORE_AREA_SIZE / 4U; i++) {
+        if (p[i] != 0xFFFFFFFFU) return 0;
+    }
+    return 1;
+}
+
+uint16_t FlashStore_Crc16(const uint8_t *data, uint32_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
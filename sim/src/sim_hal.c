@@ -0,0 +1,594 @@
+/**
+ * @file    sim_hal.c
+ * @brief   Linux仿真：HAL替身、UART后端与仿真中断
+ * @details - UART由pty提供（默认），也可通过环境变量SIM_USARTx指定已有的设备/管道路径
+ *          - 仿真中断任务（最高优先级）每个tick轮询各UART，收到字节后以"中断上下文"
+ *            （临界区内、__get_IPSR()!=0）调用HAL_UART_RxCpltCallback；
+ *            注册了批量接收处理（UartFast替身）的UART每个tick一次"中断"交出全部已到达字节，
+ *            中断/DMA发送按波特率计算的线路时间到期后调用HAL_UART_TxCpltCallback
+ *          - HAL_UART_Transmit按线路时间阻塞，模拟真实的轮询发送开销
+ *          - 记录中断执行时间与任务激活周期，SIM_DURATION_MS到期或SIGINT时输出统计
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#define _GNU_SOURCE
+#include "main.h"
+#include "tim.h"
+#include "usart.h"
+#include "gpio.h"
+#include "dma.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/stat.h>
+
+// ==================== 配置 ====================
+#define SIM_NVIC_PRIORITY     (configMAX_PRIORITIES - 1)  // 仿真中断任务优先级
+#define SIM_NVIC_STACK        1024
+#define SIM_RX_BURST_MAX      64      // 每个tick每路UART最多分发的字节数
+#define SIM_TRACE_TASKS_MAX   16      // 跟踪的任务数上限
+
+// ==================== 外设实例 ====================
+USART_TypeDef sim_usart1 = { "USART1", 53 };
+USART_TypeDef sim_usart2 = { "USART2", 54 };
+USART_TypeDef sim_usart3 = { "USART3", 55 };
+USART_TypeDef sim_usart6 = { "USART6", 87 };
+USART_TypeDef sim_uart4 = { "UART4", 68 };
+TIM_TypeDef sim_tim6 = { "TIM6" };   // HAL时基，仿真中HAL_GetTick直接读单调时钟，不产生更新中断
+RCC_TypeDef sim_rcc = { 0x0E000000U };   // 复位标志：每次启动都视为上电复位（POR+PIN+BOR）
+
+UART_HandleTypeDef huart1;
+UART_HandleTypeDef huart2;
+UART_HandleTypeDef huart3;
+UART_HandleTypeDef huart6;
+UART_HandleTypeDef huart4;
+DMA_HandleTypeDef hdma_usart1_rx;
+DMA_HandleTypeDef hdma_usart2_tx;
+DMA_HandleTypeDef hdma_usart2_rx;
+DMA_HandleTypeDef hdma_usart3_tx;
+DMA_HandleTypeDef hdma_usart6_tx;
+
+static UART_HandleTypeDef *const sim_uarts[] = { &huart1, &huart2, &huart3, &huart6, &huart4 };
+#define SIM_UART_COUNT (sizeof(sim_uarts) / sizeof(sim_uarts[0]))
+
+uint32_t SystemCoreClock = 168000000U;
+
+volatile uint32_t sim_ipsr = 0;
+volatile uint32_t sim_primask = 0;
+
+static SysTick_Type sim_systick = { 0, 167999U, 0, 0 };
+SysTick_Type *const SysTick = &sim_systick;
+
+// ==================== 统计 ====================
+
+/**
+ * @brief 中断执行时间统计（单位us）
+ */
+typedef struct {
+    uint32_t count;
+    uint64_t sum;
+    uint32_t max;
+} SimIsrStats;
+
+/**
+ * @brief 任务激活周期统计（两次切入之间的间隔，单位us）
+ */
+typedef struct {
+    void *tcb;
+    uint64_t last_in;
+    uint32_t count;
+    uint64_t sum;
+    uint32_t min;
+    uint32_t max;
+} SimTaskTrace;
+
+static SimIsrStats isr_rx_stats[SIM_UART_COUNT];
+static SimIsrStats isr_tx_stats[SIM_UART_COUNT];
+static SimTaskTrace task_trace[SIM_TRACE_TASKS_MAX];
+static volatile sig_atomic_t sim_exit_requested = 0;
+static uint64_t sim_duration_us = 0;
+
+// ==================== 时间 ====================
+
+/**
+ * @brief  单调时钟（微秒）
+ * @retval 自进程启动以来的微秒数
+ */
+uint64_t Sim_Micros(void)
+{
+    static uint64_t start = 0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now = (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+    if (start == 0) start = now;
+    return now - start;
+}
+
+/**
+ * @brief  按微秒阻塞等待（不让出CPU，模拟忙等）
+ * @param  us: 等待时间
+ * @retval None
+ */
+void Sim_BusyWait(uint64_t us)
+{
+    struct timespec ts = { (time_t)(us / 1000000ULL), (long)(us % 1000000ULL) * 1000L };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+    Sim_Micros();
+    return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(Sim_Micros() / 1000ULL);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    Sim_BusyWait((uint64_t)Delay * 1000ULL);
+}
+
+void HAL_IncTick(void)
+{
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+    (void)RCC_OscInitStruct;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+    (void)RCC_ClkInitStruct;
+    (void)FLatency;
+    return HAL_OK;
+}
+
+// ==================== 中断屏蔽 ====================
+
+void sim_disable_irq(void)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING && sim_primask++ == 0) {
+        taskENTER_CRITICAL();
+    }
+}
+
+void sim_enable_irq(void)
+{
+    if (sim_primask > 0 && --sim_primask == 0) {
+        taskEXIT_CRITICAL();
+    }
+}
+
+void NVIC_SystemReset(void)
+{
+    fprintf(stderr, "[SIM] NVIC_SystemReset\n");
+    exit(1);
+}
+
+void Sim_AssertFailed(const char *file, int line)
+{
+    fprintf(stderr, "[SIM] configASSERT failed: %s:%d\n", file, line);
+    abort();
+}
+
+// ==================== UART后端 ====================
+
+/**
+ * @brief  计算线路传输时间
+ * @param  huart: UART句柄
+ * @param  size: 字节数
+ * @retval 微秒（8N1，每字节10位）
+ */
+uint64_t Sim_WireTimeUs(UART_HandleTypeDef *huart, uint16_t size)
+{
+    uint32_t baud = huart->Init.BaudRate ? huart->Init.BaudRate : 115200U;
+    return (uint64_t)size * 10ULL * 1000000ULL / baud;
+}
+
+/**
+ * @brief  打开UART后端
+ * @param  huart: UART句柄
+ * @retval None
+ * @note   环境变量SIM_<名称>指定路径时直接打开；否则创建pty，
+ *         并在当前目录创建符号链接tty<名称>指向从端
+ */
+static void Sim_UartOpen(UART_HandleTypeDef *huart)
+{
+    char env_name[32];
+    const char *path;
+    int fd;
+
+    snprintf(env_name, sizeof(env_name), "SIM_%s", huart->Instance->name);
+    path = getenv(env_name);
+
+    if (path != NULL && path[0] != '\0') {
+        fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (fd < 0) {
+            fprintf(stderr, "[SIM] %s: open %s failed: %s\n", huart->Instance->name, path, strerror(errno));
+            exit(1);
+        }
+        printf("[SIM] %s -> %s\n", huart->Instance->name, path);
+    } else {
+        char link_name[32];
+        struct termios tio;
+
+        fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+            fprintf(stderr, "[SIM] %s: pty failed: %s\n", huart->Instance->name, strerror(errno));
+            exit(1);
+        }
+
+        // 保持从端打开，避免无外部连接时主端读取返回EIO
+        int slave = open(ptsname(fd), O_RDWR | O_NOCTTY);
+        if (slave >= 0 && tcgetattr(slave, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(slave, TCSANOW, &tio);
+        }
+
+        snprintf(link_name, sizeof(link_name), "tty%s", huart->Instance->name);
+        unlink(link_name);
+        if (symlink(ptsname(fd), link_name) != 0) {
+            fprintf(stderr, "[SIM] %s: symlink failed: %s\n", link_name, strerror(errno));
+        }
+        printf("[SIM] %s -> %s (./%s)\n", huart->Instance->name, ptsname(fd), link_name);
+    }
+
+    huart->sim_fd = fd;
+    huart->gState = HAL_UART_STATE_READY;
+    huart->RxState = HAL_UART_STATE_READY;
+}
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    Sim_UartOpen(huart);
+    return HAL_OK;
+}
+
+/**
+ * @brief  写入后端（不阻塞；对端未读取导致缓冲区满时丢弃，与物理线路一致）
+ */
+static void Sim_UartWrite(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size)
+{
+    ssize_t ret = write(huart->sim_fd, data, size);
+    (void)ret;
+}
+
+/**
+ * @brief  丢弃后端中未读取的字节（__HAL_UART_CLEAR_OREFLAG的替身）
+ */
+void Sim_UartFlushRx(UART_HandleTypeDef *huart)
+{
+    uint8_t buf[64];
+    if (huart->sim_fd < 0) return;
+    while (read(huart->sim_fd, buf, sizeof(buf)) > 0) {}
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    if (pData == NULL || Size == 0U) return HAL_ERROR;
+    if (huart->gState != HAL_UART_STATE_READY) return HAL_BUSY;
+
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    Sim_UartWrite(huart, pData, Size);
+    Sim_BusyWait(Sim_WireTimeUs(huart, Size));
+    huart->gState = HAL_UART_STATE_READY;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    uint32_t start = HAL_GetTick();
+    uint16_t got = 0;
+
+    if (huart->RxState != HAL_UART_STATE_READY) return HAL_BUSY;
+
+    while (got < Size) {
+        ssize_t n = read(huart->sim_fd, pData + got, Size - got);
+        if (n > 0) {
+            got += (uint16_t)n;
+        } else if (HAL_GetTick() - start >= Timeout) {
+            return HAL_TIMEOUT;
+        } else {
+            Sim_BusyWait(100);
+        }
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    if (pData == NULL || Size == 0U) return HAL_ERROR;
+    if (huart->gState != HAL_UART_STATE_READY) return HAL_BUSY;
+
+    huart->pTxBuffPtr = (uint8_t *)pData;
+    huart->TxXferSize = Size;
+    huart->TxXferCount = 0;
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    Sim_UartWrite(huart, pData, Size);
+    huart->sim_tx_done_us = Sim_Micros() + Sim_WireTimeUs(huart, Size);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    return HAL_UART_Transmit_IT(huart, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    if (pData == NULL || Size == 0U) return HAL_ERROR;
+    if (huart->RxState != HAL_UART_STATE_READY) return HAL_BUSY;
+
+    huart->pRxBuffPtr = pData;
+    huart->RxXferSize = Size;
+    huart->RxXferCount = Size;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
+{
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+__WEAK void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+__WEAK void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+// ==================== CubeMX初始化函数替身 ====================
+
+static void Sim_UartSetup(UART_HandleTypeDef *huart, USART_TypeDef *instance)
+{
+    memset(huart, 0, sizeof(*huart));
+    huart->Instance = instance;
+    huart->Init.BaudRate = 115200;
+    huart->Init.WordLength = UART_WORDLENGTH_8B;
+    huart->Init.StopBits = UART_STOPBITS_1;
+    huart->Init.Parity = UART_PARITY_NONE;
+    huart->Init.Mode = UART_MODE_TX_RX;
+    huart->sim_fd = -1;
+    if (HAL_UART_Init(huart) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+void MX_USART1_UART_Init(void) { Sim_UartSetup(&huart1, USART1); }
+void MX_USART2_UART_Init(void) { Sim_UartSetup(&huart2, USART2); }
+void MX_USART3_UART_Init(void) { Sim_UartSetup(&huart3, USART3); }
+void MX_USART6_UART_Init(void) { Sim_UartSetup(&huart6, USART6); }
+void MX_UART4_Init(void) { Sim_UartSetup(&huart4, UART4); }
+void MX_UART5_Init(void) {}   // 锁定事件输出由sim_lock_out.c替代
+void MX_TIM1_Init(void) {}    // 脉冲输出由sim_motor_step.c替代
+void MX_TIM8_Init(void) {}
+
+void MX_GPIO_Init(void)
+{
+}
+
+// ==================== 任务切换跟踪 ====================
+
+/**
+ * @brief  任务切入时记录激活间隔
+ * @param  tcb: 当前任务TCB
+ * @retval None
+ * @note   在调度器内部调用（traceTASK_SWITCHED_IN），不得调用阻塞API
+ */
+void SimTrace_TaskSwitchedIn(void *tcb)
+{
+    uint64_t now = Sim_Micros();
+
+    for (uint32_t i = 0; i < SIM_TRACE_TASKS_MAX; i++) {
+        SimTaskTrace *t = &task_trace[i];
+        if (t->tcb == NULL) {
+            t->tcb = tcb;
+            t->last_in = now;
+            t->min = UINT32_MAX;
+            return;
+        }
+        if (t->tcb == tcb) {
+            uint32_t dt = (uint32_t)(now - t->last_in);
+            t->last_in = now;
+            t->count++;
+            t->sum += dt;
+            if (dt < t->min) t->min = dt;
+            if (dt > t->max) t->max = dt;
+            return;
+        }
+    }
+}
+
+// ==================== 仿真中断 ====================
+
+static void Sim_IsrRecord(SimIsrStats *st, uint64_t start)
+{
+    uint32_t dt = (uint32_t)(Sim_Micros() - start);
+    st->count++;
+    st->sum += dt;
+    if (dt > st->max) st->max = dt;
+}
+
+/**
+ * @brief  以中断上下文执行回调
+ * @param  huart: UART句柄
+ * @param  callback: 回调函数
+ * @param  st: 统计
+ * @retval None
+ * @note   临界区保证回调期间不被任务抢占（等效于真实中断的优先级关系）
+ */
+static void Sim_Dispatch(UART_HandleTypeDef *huart, void (*callback)(UART_HandleTypeDef *), SimIsrStats *st)
+{
+    uint64_t start = Sim_Micros();
+
+    taskENTER_CRITICAL();
+    sim_ipsr = huart->Instance->irqn;
+    callback(huart);
+    sim_ipsr = 0;
+    taskEXIT_CRITICAL();
+
+    Sim_IsrRecord(st, start);
+}
+
+/**
+ * @brief  以中断上下文交出一批接收字节
+ * @param  huart: UART句柄
+ * @param  data: 字节
+ * @param  len: 字节数
+ * @param  st: 统计
+ * @retval None
+ */
+static void Sim_DispatchRx(UART_HandleTypeDef *huart, const uint8_t *data, uint32_t len, SimIsrStats *st)
+{
+    uint64_t start = Sim_Micros();
+
+    taskENTER_CRITICAL();
+    sim_ipsr = huart->Instance->irqn;
+    huart->sim_rx_handler(huart, data, len);
+    sim_ipsr = 0;
+    taskEXIT_CRITICAL();
+
+    Sim_IsrRecord(st, start);
+}
+
+static void Sim_PrintStats(void)
+{
+    static char buf[2048];
+
+    printf("\n=== Simulation statistics (%.1f s) ===\n", Sim_Micros() / 1e6);
+
+    printf("Task activation period (us):\n");
+    for (uint32_t i = 0; i < SIM_TRACE_TASKS_MAX && task_trace[i].tcb; i++) {
+        SimTaskTrace *t = &task_trace[i];
+        if (t->count == 0) continue;
+        printf("  %-16s n=%-8u min=%-8u avg=%-8llu max=%u\n",
+               pcTaskGetName((TaskHandle_t)t->tcb), t->count, t->min,
+               (unsigned long long)(t->sum / t->count), t->max);
+    }
+
+    printf("Simulated ISR execution time (us):\n");
+    for (uint32_t i = 0; i < SIM_UART_COUNT; i++) {
+        SimIsrStats *rx = &isr_rx_stats[i];
+        SimIsrStats *tx = &isr_tx_stats[i];
+        printf("  %-7s RX n=%-8u avg=%-6llu max=%-6u TX n=%-6u avg=%-6llu max=%u\n",
+               sim_uarts[i]->Instance->name,
+               rx->count, (unsigned long long)(rx->count ? rx->sum / rx->count : 0), rx->max,
+               tx->count, (unsigned long long)(tx->count ? tx->sum / tx->count : 0), tx->max);
+    }
+
+    vTaskGetRunTimeStats(buf);
+    printf("Run time (us / %%):\n%s", buf);
+    fflush(stdout);
+}
+
+static void Sim_SignalHandler(int sig)
+{
+    (void)sig;
+    sim_exit_requested = 1;
+}
+
+/**
+ * @brief  仿真中断任务
+ * @param  argument: 未使用
+ * @retval None
+ */
+static void Sim_NvicTask(void *argument)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+    uint64_t stop_us = sim_duration_us ? Sim_Micros() + sim_duration_us : 0;  // 从调度器启动开始计时
+    (void)argument;
+
+    for (;;) {
+        for (uint32_t i = 0; i < SIM_UART_COUNT; i++) {
+            UART_HandleTypeDef *huart = sim_uarts[i];
+            if (huart->sim_fd < 0) continue;
+
+            // 批量接收：对应实机DMA接收+空闲线中断
+            if (huart->sim_rx_handler != NULL) {
+                uint8_t buf[SIM_RX_BURST_MAX];
+                ssize_t n = read(huart->sim_fd, buf, sizeof(buf));
+                if (n > 0) {
+                    Sim_DispatchRx(huart, buf, (uint32_t)n, &isr_rx_stats[i]);
+                }
+            }
+
+            // 接收：每个字节一次RxCplt（与HAL_UART_Receive_IT单字节接收一致）
+            for (uint32_t n = 0; n < SIM_RX_BURST_MAX && huart->RxState == HAL_UART_STATE_BUSY_RX; n++) {
+                uint8_t byte;
+                if (read(huart->sim_fd, &byte, 1) != 1) break;
+
+                *huart->pRxBuffPtr++ = byte;
+                if (--huart->RxXferCount == 0) {
+                    huart->pRxBuffPtr -= huart->RxXferSize;
+                    huart->RxState = HAL_UART_STATE_READY;
+                    Sim_Dispatch(huart, HAL_UART_RxCpltCallback, &isr_rx_stats[i]);
+                }
+            }
+
+            // 发送完成
+            if (huart->gState == HAL_UART_STATE_BUSY_TX && huart->sim_tx_done_us != 0 &&
+                Sim_Micros() >= huart->sim_tx_done_us) {
+                huart->sim_tx_done_us = 0;
+                huart->TxXferCount = huart->TxXferSize;
+                huart->gState = HAL_UART_STATE_READY;
+                Sim_Dispatch(huart, HAL_UART_TxCpltCallback, &isr_tx_stats[i]);
+            }
+        }
+
+        if (sim_exit_requested || (stop_us && Sim_Micros() >= stop_us)) {
+            Sim_PrintStats();
+            exit(0);
+        }
+
+        vTaskDelayUntil(&last_wake, 1);
+    }
+}
+
+/**
+ * @brief  启动仿真中断任务
+ * @retval None
+ * @note   由MX_DMA_Init调用（main.c中位于所有外设初始化之前），
+ *         调度器启动后开始运行
+ */
+void MX_DMA_Init(void)
+{
+    const char *duration = getenv("SIM_DURATION_MS");
+    struct sigaction sa;
+
+    if (duration != NULL) {
+        sim_duration_us = strtoull(duration, NULL, 10) * 1000ULL;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = Sim_SignalHandler;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    xTaskCreate(Sim_NvicTask, "SimNVIC", SIM_NVIC_STACK, NULL, SIM_NVIC_PRIORITY, NULL);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file    sim_lock_out.c
+ * @brief   Linux仿真：LockOut模块替身
+ * @details 没有GPIO和UART5，锁定/解锁事件按帧内容打印到标准输出，
+ *          时间为进程启动以来的us（单调时钟，与sim_timing.c的DWT替身同源），
+ *          用于检查锁定判定的时刻和残差；接口与APP/LockOut.c一致
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "LockOut.h"
+#include "Timing.h"
+
+#include <stdio.h>
+
+static uint8_t lock_state = 0;
+static uint8_t lock_seq = 0;
+static LockOutStats lock_stats;
+
+void LockOut_Init(void)
+{
+    lock_state = 0;
+}
+
+void LockOut_Set(uint8_t locked, float err_h, float err_v)
+{
+    uint32_t cycles;
+
+    locked = locked ? 1U : 0U;
+    if (locked == lock_state) return;
+
+    cycles = Timing_GetCycles();
+    lock_state = locked;
+
+    printf("[sim] lock: %s seq=%u t=%lluus tick=%lu err=[%+.1f,%+.1f]px\n",
+           locked ? "LOCK" : "UNLOCK", lock_seq++, (unsigned long long)Sim_Micros(),
+           (unsigned long)HAL_GetTick(), err_h, err_v);
+    fflush(stdout);
+
+    __disable_irq();
+    lock_stats.locked = locked;
+    lock_stats.events++;
+    lock_stats.last_cycles = cycles;
+    lock_stats.last_err_h = err_h;
+    lock_stats.last_err_v = err_v;
+    __enable_irq();
+}
+
+void LockOut_GetStats(LockOutStats *stats)
+{
+    __disable_irq();
+    *stats = lock_stats;
+    __enable_irq();
+}
+
+void LockOut_IRQHandler(void)
+{
+}
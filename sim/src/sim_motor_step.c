@@ -0,0 +1,213 @@
+/**
+ * @file    sim_motor_step.c
+ * @brief   Linux仿真：MotorStep模块替身
+ * @details 脉冲规划与实机相同（APP/StepGen.c），定时器+DMA由仿真任务代替：
+ *          每个tick按各段时长消耗缓冲区，一块取完时以"中断上下文"调用StepGen_OnBufferDone；
+ *          本tick发出的脉冲数以"S,水平,垂直\n"写入ttySTEP（pty），由sim_plant.py积分为云台角度。
+ *          DIR由缓冲区方向直接决定，段内脉冲按段结束时刻计入（分辨率0.5ms）
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#define _GNU_SOURCE
+#include "MotorStep.h"
+#include "StepGen.h"
+#include "Motor.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+#define SIM_STEP_PRIORITY     (configMAX_PRIORITIES - 2)  // 仅低于仿真中断任务
+#define SIM_STEP_STACK        512
+
+#define STEP_PULSES_PER_REV   3200    // 16细分，与Motor.c一致
+#define STEP_PULSES_PER_DEG   (STEP_PULSES_PER_REV / 360.0f)
+
+typedef struct {
+    StepGen gen;
+    float remainder;
+    uint32_t cur;           // 正在发出的缓冲区
+    uint32_t seg;           // 正在发出的段
+    uint64_t seg_end_us;    // 当前段结束时刻
+} SimStepAxis;
+
+static SimStepAxis axis_h;
+static SimStepAxis axis_v;
+static int step_fd = -1;
+static uint8_t step_initialized = 0;
+
+static SimStepAxis *MotorStep_Axis(uint8_t motor_id)
+{
+    return (motor_id == MOTOR_ID_HORIZONTAL) ? &axis_h : &axis_v;
+}
+
+/**
+ * @brief  一段的时长(us)
+ */
+static uint64_t Sim_SegmentUs(const StepSegment *s)
+{
+    uint64_t ticks = (uint64_t)(s->arr + 1U) * (s->rcr + 1U);
+    return ticks * 1000000ULL / MOTOR_STEP_TICK_HZ;
+}
+
+/**
+ * @brief  推进一个轴到当前时刻
+ * @param  a: 轴
+ * @param  now: 当前时刻(us)
+ * @retval 本次发出的脉冲数（带符号）
+ */
+static int32_t Sim_StepAdvance(SimStepAxis *a, uint64_t now)
+{
+    int32_t pulses = 0;
+
+    while (now >= a->seg_end_us)
+    {
+        const StepSegment *s = &a->gen.buf[a->cur][a->seg];
+        uint8_t ch = a->gen.cfg.channel - 1U;
+
+        if (s->ccr[ch] != 0) pulses += a->gen.buf_dir[a->cur] * (int32_t)(s->rcr + 1U);
+
+        if (++a->seg == STEPGEN_BUF_SEGMENTS)
+        {
+            taskENTER_CRITICAL();
+            StepGen_OnBufferDone(&a->gen, a->cur);
+            taskEXIT_CRITICAL();
+            a->cur ^= 1U;
+            a->seg = 0;
+        }
+        a->seg_end_us += Sim_SegmentUs(&a->gen.buf[a->cur][a->seg]);
+    }
+    return pulses;
+}
+
+/**
+ * @brief  仿真定时器+DMA任务
+ */
+static void Sim_StepTask(void *argument)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+    char line[48];
+    (void)argument;
+
+    for (;;)
+    {
+        uint64_t now = Sim_Micros();
+        int32_t h = Sim_StepAdvance(&axis_h, now);
+        int32_t v = Sim_StepAdvance(&axis_v, now);
+
+        if ((h != 0 || v != 0) && step_fd >= 0)
+        {
+            int len = snprintf(line, sizeof(line), "S,%d,%d\n", (int)h, (int)v);
+            ssize_t ret = write(step_fd, line, (size_t)len);
+            (void)ret;
+        }
+        vTaskDelayUntil(&last_wake, 1);
+    }
+}
+
+/**
+ * @brief  创建ttySTEP（pty，符号链接在当前目录）
+ */
+static void Sim_StepOpen(void)
+{
+    struct termios tio;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0)
+    {
+        fprintf(stderr, "[SIM] STEP: pty failed: %s\n", strerror(errno));
+        return;
+    }
+    int slave = open(ptsname(fd), O_RDWR | O_NOCTTY);
+    if (slave >= 0 && tcgetattr(slave, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+    }
+    unlink("ttySTEP");
+    if (symlink(ptsname(fd), "ttySTEP") != 0)
+    {
+        fprintf(stderr, "[SIM] ttySTEP: symlink failed: %s\n", strerror(errno));
+    }
+    printf("[SIM] STEP -> %s (./ttySTEP)\n", ptsname(fd));
+    step_fd = fd;
+}
+
+static void Sim_StepAxisInit(SimStepAxis *a, uint8_t channel)
+{
+    StepGenConfig cfg;
+
+    cfg.tick_hz = MOTOR_STEP_TICK_HZ;
+    cfg.pulse_ticks = MOTOR_STEP_TICK_HZ / 1000000U * MOTOR_STEP_PULSE_US;
+    cfg.channel = channel;
+    cfg.max_pps = MOTOR_STEP_MAX_RPM / 60.0f * STEP_PULSES_PER_REV;
+    cfg.accel_pps2 = MOTOR_STEP_ACCEL_DEG_S2 * STEP_PULSES_PER_DEG;
+    StepGen_Init(&a->gen, &cfg);
+    a->remainder = 0.0f;
+    a->cur = 0;
+    a->seg = 0;
+    a->seg_end_us = Sim_Micros() + Sim_SegmentUs(&a->gen.buf[0][0]);
+}
+
+// ==================== 对外接口（与APP/MotorStep.c一致） ====================
+
+void MotorStep_Init(void)
+{
+    if (step_initialized) return;   // Motor_Init会被调用两次（自检+Gimbal_Init）
+    step_initialized = 1;
+    Sim_StepOpen();
+    Sim_StepAxisInit(&axis_h, 1);
+    Sim_StepAxisInit(&axis_v, 3);
+    xTaskCreate(Sim_StepTask, "SimSTEP", SIM_STEP_STACK, NULL, SIM_STEP_PRIORITY, NULL);
+}
+
+void MotorStep_Move(uint8_t motor_id, float angle)
+{
+    SimStepAxis *a = MotorStep_Axis(motor_id);
+    float p = angle * STEP_PULSES_PER_DEG + a->remainder;
+    int32_t pulses = (int32_t)p;
+
+    a->remainder = p - (float)pulses;
+    if (pulses != 0) StepGen_Move(&a->gen, pulses);
+}
+
+void MotorStep_Stop(uint8_t motor_id)
+{
+    SimStepAxis *a = MotorStep_Axis(motor_id);
+
+    StepGen_Stop(&a->gen);
+    a->remainder = 0.0f;
+}
+
+void MotorStep_Decelerate(uint8_t motor_id)
+{
+    SimStepAxis *a = MotorStep_Axis(motor_id);
+
+    StepGen_Decelerate(&a->gen);
+    a->remainder = 0.0f;
+}
+
+float MotorStep_GetPosition(uint8_t motor_id)
+{
+    return MotorStep_Axis(motor_id)->gen.position / STEP_PULSES_PER_DEG;
+}
+
+uint8_t MotorStep_IsMoving(uint8_t motor_id)
+{
+    SimStepAxis *a = MotorStep_Axis(motor_id);
+
+    return (a->gen.target != a->gen.position || a->gen.velocity != 0.0f) ? 1 : 0;
+}
+
+uint32_t MotorStep_GetUnderruns(uint8_t motor_id)
+{
+    (void)motor_id;
+    return 0;
+}
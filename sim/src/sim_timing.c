@@ -0,0 +1,23 @@
+/**
+ * @file    sim_timing.c
+ * @brief   Linux仿真：Timing模块替身
+ * @details 没有DWT，周期计数由单调时钟按SystemCoreClock换算，接口与APP/Timing.c一致
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "Timing.h"
+
+void Timing_Init(void)
+{
+}
+
+uint32_t Timing_GetCycles(void)
+{
+    return (uint32_t)(Sim_Micros() * (SystemCoreClock / 1000000U));
+}
+
+uint32_t Timing_CyclesToUs(uint32_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000U);
+}
@@ -0,0 +1,222 @@
+/**
+ * @file    sim_uart_fast.c
+ * @brief   Linux仿真：UartFast模块替身
+ * @details 没有USART/DMA寄存器，收发映射到sim_hal.c的pty后端：
+ *          - 接收：注册批量接收处理，仿真中断任务每个tick一次"中断"交出已到达的字节
+ *            （对应实机DMA接收+空闲线中断），在其中逐字节调用应用层处理函数
+ *          - 环形发送（相机、引导）：立即写入后端，按线路时间估算缓冲区占用，超出时丢弃
+ *          - DMA发送（电机）：等待上一帧的线路时间后写入，立即返回
+ *          - 阻塞发送/轮询接收：使用HAL_UART_Transmit/HAL_UART_Receive替身；调试串口阻塞发送被
+ *            打断时与实机相同写入暂存区，由被打断的发送补发
+ *          - 故障注入：与实机相同，在接收分发、轮询接收和发送入口经过APP/FaultInject.c
+ *          接口与APP/UartFast.c一致
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "UartFast.h"
+#include "FaultInject.h"
+#include "usart.h"
+
+#include <unistd.h>
+
+static UART_HandleTypeDef *const uart_fast_huart[UART_FAST_PORT_COUNT] = {
+    [UART_FAST_CAMERA]  = &huart1,
+    [UART_FAST_DEBUG]   = &huart2,
+    [UART_FAST_MOTOR_H] = &huart3,
+    [UART_FAST_MOTOR_V] = &huart6,
+    [UART_FAST_CUE]     = &huart4,
+};
+
+static UartFastRxHandler uart_fast_handler[UART_FAST_PORT_COUNT];
+static uint64_t uart_fast_tx_done_us[UART_FAST_PORT_COUNT];   // 已排队数据发完的时刻
+static UartFastStats uart_fast_stats[UART_FAST_PORT_COUNT];
+static volatile uint8_t uart_fast_write_busy[UART_FAST_PORT_COUNT];
+static uint8_t uart_fast_pending[UART_FAST_WRITE_PENDING_LEN];   // 调试串口暂存区
+static volatile uint32_t uart_fast_pending_head;
+static uint32_t uart_fast_pending_tail;
+static volatile uint8_t uart_fast_pending_lost;
+
+static UartFastPort UartFast_SimPort(UART_HandleTypeDef *huart)
+{
+    for (uint32_t i = 0; i < UART_FAST_PORT_COUNT; i++) {
+        if (uart_fast_huart[i] == huart) return (UartFastPort)i;
+    }
+    return UART_FAST_PORT_COUNT;
+}
+
+static uint8_t UartFast_SimIsDma(UartFastPort port)
+{
+    return port == UART_FAST_MOTOR_H || port == UART_FAST_MOTOR_V;
+}
+
+static void UartFast_SimRx(UART_HandleTypeDef *huart, const uint8_t *data, uint32_t len)
+{
+    UartFastPort port = UartFast_SimPort(huart);
+
+    if (port == UART_FAST_PORT_COUNT) return;
+    uart_fast_stats[port].rx_irqs++;
+    for (uint32_t i = 0; i < len; i++) {
+        uart_fast_stats[port].rx_bytes++;
+        if (uart_fast_handler[port] == NULL) continue;
+        if (FaultInject_IsActive(port, FAULT_DIR_RX)) FaultInject_Rx(port, data[i], uart_fast_handler[port]);
+        else uart_fast_handler[port](data[i]);
+    }
+}
+
+void UartFast_StartRx(UartFastPort port, UartFastRxHandler handler)
+{
+    uart_fast_handler[port] = handler;
+    uart_fast_huart[port]->sim_rx_handler = UartFast_SimRx;
+}
+
+uint8_t UartFast_Send(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    if (FaultInject_IsActive(port, FAULT_DIR_TX)) return FaultInject_Send(port, data, len, 0);
+
+    return UartFast_SendRaw(port, data, len);
+}
+
+uint8_t UartFast_SendRaw(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    UART_HandleTypeDef *huart = uart_fast_huart[port];
+    uint64_t now = Sim_Micros();
+    uint64_t done = uart_fast_tx_done_us[port];
+    ssize_t ret;
+
+    if (len == 0) return 1;
+
+    if (UartFast_SimIsDma(port)) {
+        if (len > UART_FAST_DMA_TX_LEN) {
+            uart_fast_stats[port].tx_dropped++;
+            return 0;
+        }
+        if (done > now) {
+            Sim_BusyWait(done - now);
+            now = Sim_Micros();
+        }
+        done = now;
+    } else if (port == UART_FAST_DEBUG) {
+        UartFast_WriteRaw(port, data, len);
+        return 1;
+    } else {
+        uint64_t backlog = (done > now) ? done - now : 0;
+        if (backlog + Sim_WireTimeUs(huart, len) > Sim_WireTimeUs(huart, UART_FAST_TX_RING_LEN)) {
+            uart_fast_stats[port].tx_dropped++;
+            return 0;
+        }
+        if (done < now) done = now;
+    }
+
+    ret = write(huart->sim_fd, data, len);
+    (void)ret;
+    uart_fast_tx_done_us[port] = done + Sim_WireTimeUs(huart, len);
+    uart_fast_stats[port].tx_bytes += len;
+    return 1;
+}
+
+void UartFast_Write(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    if (FaultInject_IsActive(port, FAULT_DIR_TX)) {
+        (void)FaultInject_Send(port, data, len, 1);
+        return;
+    }
+    UartFast_WriteRaw(port, data, len);
+}
+
+static void UartFast_SimTransmit(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    if (HAL_UART_Transmit(uart_fast_huart[port], data, len, 100) == HAL_OK) {
+        uart_fast_stats[port].tx_bytes += len;
+    } else {
+        uart_fast_stats[port].tx_dropped++;
+    }
+}
+
+void UartFast_WriteRaw(UartFastPort port, const uint8_t *data, uint16_t len)
+{
+    static const uint8_t dropped_mark[] = "\r\n[output dropped]\r\n";
+    uint8_t chunk[64];
+    uint16_t n;
+
+    __disable_irq();
+    if (uart_fast_write_busy[port]) {
+        if (port == UART_FAST_DEBUG &&
+            UART_FAST_WRITE_PENDING_LEN - (uart_fast_pending_head - uart_fast_pending_tail) >= len) {
+            for (uint16_t i = 0; i < len; i++) {
+                uart_fast_pending[(uart_fast_pending_head + i) & (UART_FAST_WRITE_PENDING_LEN - 1U)] = data[i];
+            }
+            uart_fast_pending_head += len;
+        } else {
+            uart_fast_stats[port].tx_dropped++;
+            if (port == UART_FAST_DEBUG) uart_fast_pending_lost = 1;
+        }
+        __enable_irq();
+        return;
+    }
+    uart_fast_write_busy[port] = 1;
+    __enable_irq();
+
+    UartFast_Flush(port);
+    UartFast_SimTransmit(port, data, len);
+
+    for (;;) {
+        __disable_irq();
+        n = 0;
+        while (n < sizeof(chunk) && uart_fast_pending_tail != uart_fast_pending_head && port == UART_FAST_DEBUG) {
+            chunk[n++] = uart_fast_pending[uart_fast_pending_tail & (UART_FAST_WRITE_PENDING_LEN - 1U)];
+            uart_fast_pending_tail++;
+        }
+        if (n == 0) {
+            if (port != UART_FAST_DEBUG || !uart_fast_pending_lost) {
+                uart_fast_write_busy[port] = 0;
+                __enable_irq();
+                break;
+            }
+            uart_fast_pending_lost = 0;
+            __enable_irq();
+            UartFast_SimTransmit(port, dropped_mark, sizeof(dropped_mark) - 1U);
+            continue;
+        }
+        __enable_irq();
+        UartFast_SimTransmit(port, chunk, n);
+    }
+}
+
+void UartFast_Flush(UartFastPort port)
+{
+    uint64_t now = Sim_Micros();
+
+    if (uart_fast_tx_done_us[port] > now) {
+        Sim_BusyWait(uart_fast_tx_done_us[port] - now);
+    }
+}
+
+uint8_t UartFast_Read(UartFastPort port, uint8_t *data, uint16_t len, uint32_t timeout)
+{
+    if (HAL_UART_Receive(uart_fast_huart[port], data, len, timeout) != HAL_OK) return 0;
+    if (FaultInject_IsActive(port, FAULT_DIR_RX)) return FaultInject_Read(port, data, len);
+    return 1;
+}
+
+void UartFast_DiscardRx(UartFastPort port)
+{
+    Sim_UartFlushRx(uart_fast_huart[port]);
+}
+
+void UartFast_GetStats(UartFastPort port, UartFastStats *stats)
+{
+    __disable_irq();
+    *stats = uart_fast_stats[port];
+    __enable_irq();
+}
+
+void UartFast_IRQHandler(UartFastPort port)
+{
+    (void)port;
+}
+
+void UartFast_DmaIRQHandler(UartFastPort port)
+{
+    (void)port;
+}
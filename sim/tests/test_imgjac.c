@@ -0,0 +1,85 @@
+/**
+ * @file    test_imgjac.c
+ * @brief   ImgJac主机测试：变焦+滚转失配时雅可比收敛、目标漂移下不被带偏、坏帧被拒绝
+ * @details 真实J = 6像素/度·R(8°)，估计器按名义4像素/度、滚转0初始化；
+ *          云台两轴正弦转动，30Hz测量，坐标噪声0.5像素
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "ImgJac.h"
+#include "Imm.h"
+#include "test_util.h"
+#include <math.h>
+
+#define DT          (1.0f / 30.0f)
+#define TRUE_SCALE  6.0f
+#define TRUE_ROLL   8.0f
+#define NOISE_PX    0.5f
+#define PI_F        3.14159265f
+
+/**
+ * @brief  运行seconds秒
+ * @param  drift: 目标在图像中的漂移（像素/秒，x方向）
+ * @param  t0: 起始时刻(s)，接着上一段继续
+ */
+static void Run(ImgJac *jac, float seconds, float drift, float t0)
+{
+    float c = cosf(TRUE_ROLL * PI_F / 180.0f) * TRUE_SCALE;
+    float s = sinf(TRUE_ROLL * PI_F / 180.0f) * TRUE_SCALE;
+
+    for (float t = t0; t < t0 + seconds; t += DT)
+    {
+        float q_h = 3.0f * sinf(2.0f * PI_F * 0.5f * t);
+        float q_v = 2.0f * sinf(2.0f * PI_F * 0.3f * t + 1.0f);
+        float dx = -(c * q_h - s * q_v) + drift * t + Test_Gauss(NOISE_PX);
+        float dy = -(s * q_h + c * q_v) + Test_Gauss(NOISE_PX);
+
+        ImgJac_Update(jac, dx, dy, q_h, q_v, DT);
+    }
+}
+
+int main(void)
+{
+    static ImgJac jac;
+    float scale, roll, err_h, err_v;
+
+    // 变焦+滚转：从名义值收敛到真实值
+    ImgJac_Init(&jac, 0.0f);
+    ImgJac_GetScaleRoll(&jac, &scale, &roll);
+    CHECK(fabsf(scale - IMM_PIXELS_PER_DEG) < 1e-4f && fabsf(roll) < 1e-4f, "init: %.2f px/deg, %.2f deg", scale, roll);
+    Run(&jac, 10.0f, 0.0f, 0.0f);
+    ImgJac_GetScaleRoll(&jac, &scale, &roll);
+    printf("static target: scale %.3f px/deg, roll %.2f deg, %u updates, %u gated, %u rejected\n",
+           scale, roll, (unsigned)jac.updates, (unsigned)jac.gated, (unsigned)jac.rejected);
+    CHECK(fabsf(scale - TRUE_SCALE) < 0.05f * TRUE_SCALE, "scale %.3f, true %.1f", scale, TRUE_SCALE);
+    CHECK(fabsf(roll - TRUE_ROLL) < 1.0f, "roll %.2f, true %.1f", roll, TRUE_ROLL);
+    CHECK(jac.updates > 50, "only %u updates", (unsigned)jac.updates);
+
+    // 换算：云台转1度造成的图像偏差换算回名义像素约为(名义像素/度, 0)
+    ImgJac_Correct(&jac, -TRUE_SCALE * cosf(TRUE_ROLL * PI_F / 180.0f), -TRUE_SCALE * sinf(TRUE_ROLL * PI_F / 180.0f),
+                   &err_h, &err_v);
+    CHECK(fabsf(err_h + IMM_PIXELS_PER_DEG) < 0.2f && fabsf(err_v) < 0.2f, "corrected (%.2f, %.2f)", err_h, err_v);
+
+    // 目标匀速漂移：漂移由ḋ吸收，J保持在真实值附近
+    ImgJac_Init(&jac, 0.0f);
+    Run(&jac, 15.0f, 10.0f, 0.0f);
+    ImgJac_GetScaleRoll(&jac, &scale, &roll);
+    printf("drifting target: scale %.3f px/deg, roll %.2f deg, drift %.1f px/s\n", scale, roll, jac.theta[2]);
+    CHECK(fabsf(scale - TRUE_SCALE) < 0.1f * TRUE_SCALE, "drift: scale %.3f, true %.1f", scale, TRUE_SCALE);
+    CHECK(fabsf(roll - TRUE_ROLL) < 2.0f, "drift: roll %.2f, true %.1f", roll, TRUE_ROLL);
+    CHECK(fabsf(jac.theta[2] - 10.0f) < 3.0f, "drift estimate %.2f px/s, true 10", jac.theta[2]);
+
+    // 坏帧：偏差跳变被拒绝，估计值不变
+    float theta[4];
+    uint32_t rejected = jac.rejected;
+    for (int i = 0; i < 4; i++) theta[i] = jac.theta[i];
+    ImgJac_Restart(&jac);
+    ImgJac_Update(&jac, 0.0f, 0.0f, 0.0f, 0.0f, DT);
+    ImgJac_Update(&jac, 200.0f, 0.0f, 1.0f, 0.0f, DT);
+    CHECK(jac.rejected == rejected + 1, "jump not rejected");
+    CHECK(jac.theta[0] == theta[0] && jac.theta[1] == theta[1], "jump changed the estimate");
+
+    printf("test_imgjac: %s\n", test_failures ? "FAILED" : "passed");
+    return test_failures != 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file    test_imm.c
+ * @brief   Imm主机测试：静止/匀速/端点急停轨迹上的模型概率和速度估计
+ * @details 30Hz测量，噪声1像素（IMM_PIXELS_PER_DEG换算为度），轨迹与sim_plant.py --target sweep相同
+ *          （匀速往返、端点急停停留），按阶段统计平均模型概率和速度阶跃后的匀加速模型概率峰值
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "Imm.h"
+#include "test_util.h"
+#include <math.h>
+
+#define DT          (1.0f / 30.0f)
+#define NOISE_DEG   (1.0f / IMM_PIXELS_PER_DEG)
+
+/**
+ * @brief 轨迹阶段：速度、时长，统计平均概率时跳过开头的过渡时间
+ */
+typedef struct {
+    const char *name;
+    float velocity;     ///< 度/秒（阶段开始时阶跃）
+    float duration;     ///< s
+    float settle;       ///< s
+} Phase;
+
+static const Phase phases[] = {
+    { "stationary", 0.0f,   2.0f, 0.5f },
+    { "cv",         20.0f,  3.0f, 0.7f },
+    { "stop",       0.0f,   1.5f, 0.7f },   // 行程端点急停停留
+    { "cv back",    -20.0f, 3.0f, 0.7f },
+};
+
+#define PHASES (sizeof(phases) / sizeof(phases[0]))
+
+int main(void)
+{
+    static ImmFilter f;
+    float mu[PHASES][IMM_MODEL_COUNT] = {{0}};
+    float v_err[PHASES] = {0};
+    float ca_peak[PHASES] = {0};
+    int counted[PHASES] = {0};
+    float pos = 10.0f;
+
+    Imm_Reset(&f);
+    for (uint32_t p = 0; p < PHASES; p++)
+    {
+        int steps = (int)(phases[p].duration / DT + 0.5f);
+        float vel = phases[p].velocity;
+
+        for (int k = 0; k < steps; k++)
+        {
+            pos += vel * DT;
+            Imm_Update(&f, pos + Test_Gauss(NOISE_DEG), DT);
+
+            CHECK(fabsf(f.mu[0] + f.mu[1] + f.mu[2] - 1.0f) < 1e-4f, "probabilities sum to %f",
+                  f.mu[0] + f.mu[1] + f.mu[2]);
+            if (f.mu[IMM_MODEL_CA] > ca_peak[p]) ca_peak[p] = f.mu[IMM_MODEL_CA];
+            if (k * DT < phases[p].settle) continue;
+            for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) mu[p][j] += f.mu[j];
+            v_err[p] += fabsf(f.xc[1] - vel);
+            counted[p]++;
+        }
+        for (uint8_t j = 0; j < IMM_MODEL_COUNT; j++) mu[p][j] /= counted[p];
+        v_err[p] /= counted[p];
+        printf("%-10s mu = %.2f %.2f %.2f  ca peak %.2f  |v error| = %.2f deg/s\n",
+               phases[p].name, mu[p][0], mu[p][1], mu[p][2], ca_peak[p], v_err[p]);
+    }
+
+    // 静止、停留：静止模型概率最高，速度估计接近0
+    for (uint32_t p = 0; p < PHASES; p += 2)
+    {
+        CHECK(mu[p][IMM_MODEL_STATIONARY] > mu[p][IMM_MODEL_CV] && mu[p][IMM_MODEL_STATIONARY] > mu[p][IMM_MODEL_CA],
+              "%s: stationary mu = %.2f", phases[p].name, mu[p][IMM_MODEL_STATIONARY]);
+        CHECK(v_err[p] < 1.0f, "%s: velocity error %.2f", phases[p].name, v_err[p]);
+    }
+
+    // 匀速：匀速模型占优，速度误差小；起动（速度阶跃）时匀加速模型短时占优
+    for (uint32_t p = 1; p < PHASES; p += 2)
+    {
+        CHECK(mu[p][IMM_MODEL_CV] > 0.6f, "%s: cv mu = %.2f", phases[p].name, mu[p][IMM_MODEL_CV]);
+        CHECK(mu[p][IMM_MODEL_STATIONARY] < 0.1f, "%s: stationary mu = %.2f",
+              phases[p].name, mu[p][IMM_MODEL_STATIONARY]);
+        CHECK(v_err[p] < 3.0f, "%s: velocity error %.2f", phases[p].name, v_err[p]);
+        CHECK(ca_peak[p] > 0.7f && ca_peak[p] > 2.0f * mu[p][IMM_MODEL_CA], "%s: ca peak %.2f, steady %.2f",
+              phases[p].name, ca_peak[p], mu[p][IMM_MODEL_CA]);
+    }
+
+    printf("test_imm: %s\n", test_failures ? "FAILED" : "passed");
+    return test_failures != 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file    test_selftune.c
+ * @brief   SelfTune主机测试：合成一阶对象上的RLS参数收敛、负载变化后的跟随和增益倍数
+ * @details 对象与估计模型同构：Δq[k] = a·Δq[k-1] + b0·u[k-1] + b1·u[k-2]，稳态增益1，
+ *          u为±1度随机阶跃（与ident的PRBS激励相同量级），30Hz测量，指向噪声0.01度
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "SelfTune.h"
+#include "test_util.h"
+#include <math.h>
+
+#define DT          (1.0f / 30.0f)
+#define NOISE_DEG   0.01f
+
+/**
+ * @brief 合成对象
+ */
+typedef struct {
+    float a, b0, b1;
+    float q;            ///< 指向（度）
+    float dq;           ///< 上一个间隔的转角
+    float u[2];         ///< u[k-1] u[k-2]
+} Plant;
+
+static void Plant_Set(Plant *p, float a, float b_split)
+{
+    // 稳态增益 (b0+b1)/(1-a) = 1
+    p->a = a;
+    p->b0 = (1.0f - a) * b_split;
+    p->b1 = (1.0f - a) * (1.0f - b_split);
+}
+
+/**
+ * @brief  运行n次测量，返回估计更新次数
+ * @param  hold: 1=下发角度保持不变（平稳跟踪，应冻结）
+ */
+static uint32_t Run(SelfTune *st, Plant *p, int n, uint8_t hold)
+{
+    uint32_t updates = 0;
+
+    for (int k = 0; k < n; k++)
+    {
+        p->dq = p->a * p->dq + p->b0 * p->u[0] + p->b1 * p->u[1];
+        p->q += p->dq;
+        updates += SelfTune_Update(st, p->q + Test_Gauss(NOISE_DEG), DT, 1);
+
+        float u = hold ? p->u[0] : ((Test_Uniform() > 0.0f) ? 1.0f : -1.0f);
+        SelfTune_Commit(st, u);
+        p->u[1] = p->u[0];
+        p->u[0] = u;
+    }
+    return updates;
+}
+
+/**
+ * @brief  检查参数和设计结果
+ */
+static void Expect(SelfTune *st, const Plant *p, const char *name)
+{
+    float delay = ((p->b0 + 2.0f * p->b1) / (p->b0 + p->b1) + p->a / (1.0f - p->a)) * DT;
+
+    printf("%s: a=%.3f b0=%.3f b1=%.3f (true %.3f %.3f %.3f)", name,
+           st->theta[0], st->theta[1], st->theta[2], p->a, p->b0, p->b1);
+    CHECK(fabsf(st->theta[0] - p->a) < 0.05f, "%s: a = %.3f, true %.3f", name, st->theta[0], p->a);
+    CHECK(fabsf(st->theta[1] - p->b0) < 0.05f, "%s: b0 = %.3f, true %.3f", name, st->theta[1], p->b0);
+    CHECK(fabsf(st->theta[2] - p->b1) < 0.05f, "%s: b1 = %.3f, true %.3f", name, st->theta[2], p->b1);
+
+    CHECK(SelfTune_Design(st), "%s: no design", name);
+    printf("  delay %.1fms (true %.1fms) scale %.3f\n", st->delay * 1000.0f, delay * 1000.0f, st->scale);
+    CHECK(fabsf(st->delay - delay) < 0.1f * delay, "%s: delay %.4fs, true %.4fs", name, st->delay, delay);
+    CHECK(fabsf(st->scale - SELFTUNE_DELAY_NOMINAL_S / delay) < 0.1f * SELFTUNE_DELAY_NOMINAL_S / delay,
+          "%s: scale %.3f", name, st->scale);
+}
+
+int main(void)
+{
+    static SelfTune st;
+    Plant p = {0};
+    uint32_t updates;
+
+    SelfTune_Init(&st);
+
+    // 激励不足：下发角度不变时冻结，不设计
+    Plant_Set(&p, 0.5f, 0.6f);
+    updates = Run(&st, &p, 100, 1);
+    CHECK(updates == 0, "%u updates with constant input", (unsigned)updates);
+    CHECK(!SelfTune_Design(&st), "designed without excitation");
+
+    // 名义负载：收敛到对象参数
+    updates = Run(&st, &p, 300, 0);
+    CHECK(updates > 200, "only %u updates", (unsigned)updates);
+    Expect(&st, &p, "nominal");
+
+    // 负载加重：拖尾变长，遗忘因子下重新收敛，增益倍数降低
+    float scale_nominal = st.scale;
+    Plant_Set(&p, 0.8f, 0.6f);
+    Run(&st, &p, 300, 0);
+    Expect(&st, &p, "heavy");
+    CHECK(st.scale < 0.6f * scale_nominal, "scale %.3f did not drop from %.3f", st.scale, scale_nominal);
+
+    printf("test_selftune: %s\n", test_failures ? "FAILED" : "passed");
+    return test_failures != 0;
+}
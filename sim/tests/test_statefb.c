@@ -0,0 +1,110 @@
+/**
+ * @file    test_statefb.c
+ * @brief   StateFb主机测试：与host/tools/sf_design.py的闭环预测一致
+ * @details 模型、增益和L取自sf_design.py（增益按sf命令的6位有效数字），在模型对象上运行
+ *          StateFb_Calculate，检查初始偏差的响应与sf_design.step_response相同，
+ *          对象增益缩放到sf_design.gain_margin两侧时分别收敛/发散。期望值由下面的命令生成：
+ *              cd host/tools && python3 -c "import sf_design as s; b=[0,1.6,1.8,0.6]; k=s.lqr(b,0.1);
+ *                  print(k, s.step_response(b,k,0.6,12), s.gain_margin(b,k,0.6))"
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "StateFb.h"
+#include "test_util.h"
+#include <math.h>
+
+#define ORDER       3
+#define L_GAIN      0.6f
+#define E0_PX       4.0f        // 初始偏差，下发角度不触及STATEFB_RATE_MAX限幅
+#define DT          0.02f
+
+static const float model_b[ORDER + 1] = { 0.0f, 1.6f, 1.8f, 0.6f };
+static const float lqr_k[ORDER + 1] = { -0.338313f, 1.24337f, 0.811951f, 0.202988f };
+
+// sf_design.step_response(b, k, 0.6, 12)：初始偏差1像素
+static const float expected[] = {
+    1.000000f, 1.000000f, 0.458700f, -0.018525f, -0.045892f, 0.013204f,
+    0.001829f, -0.001896f, 0.000260f, 0.000145f, -0.000064f, -0.000000f,
+};
+
+#define SAMPLES (sizeof(expected) / sizeof(expected[0]))
+
+// sf_design.gain_margin(b, k, 0.6) = 2.63
+#define GAIN_MARGIN 2.63f
+
+static void Setup(StateFb_Controller *sf)
+{
+    StateFbParams p = {0};
+
+    p.order = ORDER;
+    p.l = L_GAIN;
+    for (int i = 0; i <= ORDER; i++)
+    {
+        p.k[i] = lqr_k[i];
+        p.b[i] = model_b[i];
+    }
+    CHECK(StateFb_CheckParams(&p), "params rejected");
+    StateFb_Init(sf, &p);
+    StateFb_SetSampleTime(sf, DT);
+}
+
+/**
+ * @brief  在模型对象上运行steps次，返回最后window次的最大偏差
+ * @param  gain: 对象增益相对模型的倍数
+ * @param  trace: 输出各次的偏差（可为NULL）
+ */
+static float Run(float gain, int steps, int window, float *trace)
+{
+    static StateFb_Controller sf;
+    float u[ORDER + 1] = {0};   // u[i] = u[k-i]
+    float e = E0_PX;
+    float tail = 0.0f;
+
+    Setup(&sf);
+    for (int k = 0; k < steps; k++)
+    {
+        if (trace) trace[k] = e;
+        if (k >= steps - window && fabsf(e) > tail) tail = fabsf(e);
+
+        for (int i = ORDER; i > 0; i--) u[i] = u[i - 1];
+        u[0] = StateFb_Calculate(&sf, e);
+        for (int i = 0; i <= ORDER; i++) e -= gain * model_b[i] * u[i];
+    }
+    return tail;
+}
+
+int main(void)
+{
+    float trace[SAMPLES];
+    StateFbParams bad = {0};
+
+    // 闭环响应与sf_design.py的预测一致
+    Run(1.0f, SAMPLES, 0, trace);
+    for (uint32_t k = 0; k < SAMPLES; k++)
+    {
+        CHECK(fabsf(trace[k] / E0_PX - expected[k]) < 1e-4f, "sample %u: %.6f px, sf_design %.6f px",
+              (unsigned)k, trace[k], expected[k] * E0_PX);
+    }
+
+    // 增益裕度与sf_design.py一致
+    float inside = Run(0.9f * GAIN_MARGIN, 600, 50, NULL);
+    float outside = Run(1.1f * GAIN_MARGIN, 600, 50, NULL);
+    CHECK(inside < 0.1f * E0_PX, "gain x%.2f: still %.3f px after 600 samples", 0.9f * GAIN_MARGIN, inside);
+    CHECK(outside > E0_PX, "gain x%.2f: settled to %.3f px beyond the margin", 1.1f * GAIN_MARGIN, outside);
+    printf("margin: x%.2f -> %.4f px, x%.2f -> %.1f px\n", 0.9f * GAIN_MARGIN, inside, 1.1f * GAIN_MARGIN, outside);
+
+    // 参数检查
+    bad.order = ORDER;
+    bad.l = 0.0f;
+    CHECK(!StateFb_CheckParams(&bad), "L = 0 accepted");
+    bad.l = 1.0f;
+    bad.k[1] = NAN;
+    CHECK(!StateFb_CheckParams(&bad), "NaN gain accepted");
+    bad.k[1] = 0.0f;
+    bad.order = STATEFB_ORDER_MAX + 1;
+    CHECK(!StateFb_CheckParams(&bad), "order %d accepted", bad.order);
+
+    printf("test_statefb: %s\n", test_failures ? "FAILED" : "passed");
+    return test_failures != 0;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file    test_stepgen.c
+ * @brief   StepGen主机测试：速度曲线、位置精确、换向规则、减速停止
+ * @details 按DMA双缓冲的顺序消耗缓冲区（发出buf[b]后以b调用StepGen_OnBufferDone），
+ *          记录每段的带符号脉冲数；参数与MotorStep.c相同
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#include "StepGen.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define TICK_HZ         8000000U
+#define PULSES_PER_DEG  (3200 / 360.0f)
+#define MAX_PPS         (1200.0f / 60.0f * 3200)
+#define ACCEL_PPS2      (2000.0f * PULSES_PER_DEG)
+#define SEG_S           (STEPGEN_SEGMENT_US * 1e-6f)
+#define MAX_SEGMENTS    40000
+
+// StepGen_Move等在任务中关中断，主机测试单线程
+volatile uint32_t sim_ipsr = 0;
+volatile uint32_t sim_primask = 0;
+void sim_disable_irq(void) {}
+void sim_enable_irq(void) {}
+
+static int32_t seg_pulses[MAX_SEGMENTS];   // 各段带符号脉冲数
+static int n_segments;
+static int flip_violations;                 // 相邻两块有脉冲的缓冲区方向相反的次数
+static int8_t last_dir;                     // 上一块有脉冲的缓冲区的方向
+static uint32_t cur_buf;
+
+/**
+ * @brief  发出count块缓冲区
+ */
+static void Run(StepGen *g, int count)
+{
+    for (int k = 0; k < count && n_segments + STEPGEN_BUF_SEGMENTS <= MAX_SEGMENTS; k++)
+    {
+        int8_t d = g->buf_dir[cur_buf];
+        int32_t sum = 0;
+
+        for (uint32_t i = 0; i < STEPGEN_BUF_SEGMENTS; i++)
+        {
+            const StepSegment *s = &g->buf[cur_buf][i];
+            int32_t n = (s->ccr[g->cfg.channel - 1U] != 0) ? (int32_t)s->rcr + 1 : 0;
+
+            // 段时长与名义值一致（整除误差不超过一个脉冲周期）
+            uint32_t ticks = (uint32_t)(s->arr + 1U) * (s->rcr + 1U);
+            CHECK(ticks <= g->segment_ticks && ticks + (s->arr + 1U) > g->segment_ticks,
+                  "segment %d lasts %u ticks", n_segments, (unsigned)ticks);
+            seg_pulses[n_segments++] = d * n;
+            sum += n;
+        }
+        if (sum != 0)
+        {
+            if (last_dir != 0 && d != last_dir) flip_violations++;
+            last_dir = d;
+        }
+        else
+        {
+            last_dir = 0;
+        }
+        StepGen_OnBufferDone(g, cur_buf);
+        cur_buf ^= 1U;
+    }
+}
+
+/**
+ * @brief  发出直到规划停止（目标到达、速度为零、两块缓冲区都为空）
+ */
+static void RunUntilIdle(StepGen *g)
+{
+    while (n_segments + STEPGEN_BUF_SEGMENTS <= MAX_SEGMENTS)
+    {
+        Run(g, 1);
+        if (g->target == g->position && g->velocity == 0.0f &&
+            g->buf_pulses[0] == 0 && g->buf_pulses[1] == 0)
+        {
+            Run(g, 2);
+            return;
+        }
+    }
+    CHECK(0, "planner did not stop within %d segments", MAX_SEGMENTS);
+}
+
+static void Setup(StepGen *g)
+{
+    StepGenConfig cfg;
+
+    cfg.tick_hz = TICK_HZ;
+    cfg.pulse_ticks = TICK_HZ / 1000000U * 2U;
+    cfg.channel = 1;
+    cfg.max_pps = MAX_PPS;
+    cfg.accel_pps2 = ACCEL_PPS2;
+    StepGen_Init(g, &cfg);
+    n_segments = 0;
+    flip_violations = 0;
+    last_dir = 0;
+    cur_buf = 0;
+}
+
+static int32_t Sum(int from, int to)
+{
+    int32_t s = 0;
+    for (int i = from; i < to; i++) s += seg_pulses[i];
+    return s;
+}
+
+/**
+ * @brief  三角形曲线：脉冲数精确，加减速受限，用时接近2·sqrt(D/a)
+ */
+static void Test_Ramp(void)
+{
+    static StepGen g;
+    const int32_t dist = 10000;
+    int first = -1, last = -1, half = -1;
+    int32_t peak = 0;
+
+    Setup(&g);
+    StepGen_Move(&g, dist);
+    RunUntilIdle(&g);
+
+    CHECK(Sum(0, n_segments) == dist, "emitted %d pulses, expected %d", (int)Sum(0, n_segments), (int)dist);
+    CHECK(g.position == dist, "position %d", (int)g.position);
+
+    for (int i = 0; i < n_segments; i++)
+    {
+        CHECK(seg_pulses[i] >= 0, "segment %d runs backwards", i);
+        if (seg_pulses[i] != 0)
+        {
+            if (first < 0) first = i;
+            last = i;
+        }
+        if (seg_pulses[i] > peak) peak = seg_pulses[i];
+        if (half < 0 && 2 * Sum(0, i + 1) >= dist) half = i;
+        // 每段速度变化a·dt，对应段内脉冲数变化远小于1，加上余量进位不超过2
+        if (i > 0) CHECK(abs(seg_pulses[i] - seg_pulses[i - 1]) <= 2, "jump at segment %d: %d -> %d",
+                         i, (int)seg_pulses[i - 1], (int)seg_pulses[i]);
+    }
+
+    // 峰值速度 sqrt(a·D)；加减速对称，走完一半行程用时一半
+    float v_peak = sqrtf(ACCEL_PPS2 * dist);
+    float t_total = (last - first + 1) * SEG_S;
+    float t_ideal = 2.0f * sqrtf(dist / ACCEL_PPS2);
+    float t_half = (half - first + 1) * SEG_S;
+    CHECK(fabsf(peak - v_peak * SEG_S) <= 1.5f, "peak %d pulses/segment, expected %.1f", (int)peak, v_peak * SEG_S);
+    CHECK(fabsf(t_total - t_ideal) < t_ideal * 0.05f, "move took %.3fs, ideal %.3fs", t_total, t_ideal);
+    CHECK(fabsf(2.0f * t_half - t_total) < t_total * 0.05f, "half distance at %.3fs of %.3fs", t_half, t_total);
+    printf("ramp: %d pulses in %.3fs (ideal %.3fs), peak %d/segment\n", (int)dist, t_total, t_ideal, (int)peak);
+}
+
+/**
+ * @brief  梯形曲线：长行程限速在最高速度
+ */
+static void Test_MaxSpeed(void)
+{
+    static StepGen g;
+    const int32_t dist = 400000;    // 加减速各需 v²/(2a) = 115200脉冲
+    int32_t peak = 0;
+
+    Setup(&g);
+    StepGen_Move(&g, -dist);
+    RunUntilIdle(&g);
+
+    for (int i = 0; i < n_segments; i++)
+    {
+        if (-seg_pulses[i] > peak) peak = -seg_pulses[i];
+    }
+    CHECK(Sum(0, n_segments) == -dist, "emitted %d pulses, expected %d", (int)Sum(0, n_segments), (int)-dist);
+    CHECK(peak <= (int32_t)(MAX_PPS * SEG_S) + 1 && peak >= (int32_t)(MAX_PPS * SEG_S) - 1,
+          "peak %d pulses/segment, limit %.0f", (int)peak, MAX_PPS * SEG_S);
+}
+
+/**
+ * @brief  运动中反向：先减速到零，空闲一块缓冲区后换向，最终位置精确
+ */
+static void Test_Reverse(void)
+{
+    static StepGen g;
+
+    Setup(&g);
+    StepGen_Move(&g, 20000);
+    Run(&g, 300);                   // 0.3s，仍在加速
+    CHECK(g.velocity > 0.0f, "not moving before reversal");
+    StepGen_Move(&g, -30000);       // 目标 -10000
+    RunUntilIdle(&g);
+
+    CHECK(Sum(0, n_segments) == -10000, "net %d pulses, expected -10000", (int)Sum(0, n_segments));
+    CHECK(g.position == -10000, "position %d", (int)g.position);
+    CHECK(flip_violations == 0, "%d direction changes without an idle buffer", flip_violations);
+}
+
+/**
+ * @brief  减速停止：速度单调下降，刹车距离 v²/(2a)，不反向
+ */
+static void Test_Decelerate(void)
+{
+    static StepGen g;
+    int start;
+
+    Setup(&g);
+    StepGen_Move(&g, 1000000);
+    Run(&g, 400);                   // 0.4s：约7100脉冲/s
+    float v = g.velocity;
+    int32_t pos = g.position;
+    StepGen_Decelerate(&g);
+    int32_t brake = g.target - pos;
+    start = n_segments;
+    RunUntilIdle(&g);
+
+    float expect = v * v / (2.0f * ACCEL_PPS2);
+    CHECK(brake >= expect && brake <= expect + 1.0f, "braking distance %d, expected %.1f", (int)brake, expect);
+    CHECK(g.position == g.target, "stopped at %d, target %d", (int)g.position, (int)g.target);
+    for (int i = start + 1; i < n_segments; i++)
+    {
+        CHECK(seg_pulses[i] >= 0, "segment %d runs backwards", i);
+        CHECK(seg_pulses[i] <= seg_pulses[i - 1] + 1, "speeds up at segment %d: %d -> %d",
+              i, (int)seg_pulses[i - 1], (int)seg_pulses[i]);
+    }
+    float t_stop = 0.0f;
+    for (int i = start; i < n_segments; i++)
+    {
+        if (seg_pulses[i] != 0) t_stop = (i - start + 1) * SEG_S;
+    }
+    // 已写入的两块缓冲区按原速度发出，之后按a减速
+    CHECK(t_stop < v / ACCEL_PPS2 * 1.1f + 2 * STEPGEN_BUF_SEGMENTS * SEG_S,
+          "stop took %.3fs, v/a = %.3fs", t_stop, v / ACCEL_PPS2);
+    printf("decelerate: %.0f pulses/s stopped in %.3fs over %d pulses\n", v, t_stop, (int)brake);
+}
+
+int main(void)
+{
+    Test_Ramp();
+    Test_MaxSpeed();
+    Test_Reverse();
+    Test_Decelerate();
+    printf("test_stepgen: %s\n", test_failures ? "FAILED" : "passed");
+    return test_failures != 0;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file    test_util.h
+ * @brief   主机测试公共定义
+ * @details 检查宏（失败时打印位置并计数，不中止，main返回失败次数）
+ *          和可复现的伪随机噪声（LCG，不依赖libc的rand实现）
+ * @version 1.0
+ * @date    2026-02-25
+ */
+
+#ifndef _TEST_UTIL_H
+#define _TEST_UTIL_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+static int test_failures = 0;
+
+#define CHECK(cond, ...)                                                \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);                 \
+            printf(__VA_ARGS__);                                        \
+            printf("\n");                                               \
+            test_failures++;                                            \
+        }                                                               \
+    } while (0)
+
+static uint32_t test_seed = 12345U;
+
+/**
+ * @brief  [-0.5, 0.5)均匀分布
+ */
+static inline float Test_Uniform(void)
+{
+    test_seed = test_seed * 1664525U + 1013904223U;
+    return (float)(test_seed >> 8) / 16777216.0f - 0.5f;
+}
+
+/**
+ * @brief  标准差为sigma的近似高斯噪声（12个均匀分布之和）
+ */
+static inline float Test_Gauss(float sigma)
+{
+    float s = 0.0f;
+    for (int i = 0; i < 12; i++) s += Test_Uniform();
+    return s * sigma;
+}
+
+#endif
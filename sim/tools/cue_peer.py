@@ -0,0 +1,132 @@
+# [仿真] 相邻云台替身（云台间引导链路）
+# 功能：模拟已锁定目标的相邻云台，按10Hz向ttyUART4发送引导帧"C,状态,水平,垂直,距离*校验\n"，
+#       并打印本机发来的引导帧
+# 流程：目标在本机坐标系中的方位/俯仰/距离 + 机间几何（与本机cue geo一致）→ 反算对方的两轴角度
+#       坐标系与APP/Cue.c一致：x=零位右方, y=零位前方, z=上方；俯仰与垂直轴同向（向下为正）
+# 用法：python3 cue_peer.py [--dir 仿真运行目录] [--target-az 度] [--target-el 度] [--range 米]
+#                           [--geo dx dy dz yaw] [--state 0|1|2] [--duration 秒]
+# 依赖：仅标准库（Linux）
+
+import argparse
+import math
+import os
+import sys
+import termios
+import time
+import tty
+
+SEND_PERIOD_S = 0.1
+STATE_NAMES = ("NONE", "TRACKING", "LOCKED")
+
+
+def open_raw(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        attrs = termios.tcgetattr(fd)
+        attrs[4] = attrs[5] = termios.B115200
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def checksum(body):
+    value = 0
+    for b in body:
+        value ^= b
+    return value
+
+
+def encode(state, pan, tilt, rng):
+    body = "C,{},{},{},{}".format(state, int(round(pan * 100)), int(round(tilt * 100)),
+                                  int(round(rng * 10))).encode()
+    return body + "*{:02X}\n".format(checksum(body)).encode()
+
+
+def decode(line):
+    body, sep, tail = line.partition(b"*")
+    if not sep or not body.startswith(b"C,"):
+        return None
+    try:
+        if int(tail, 16) != checksum(body):
+            return None
+        state, pan, tilt, rng = (int(v) for v in body[2:].split(b","))
+    except ValueError:
+        return None
+    return state, pan / 100.0, tilt / 100.0, rng / 10.0
+
+
+def peer_pointing(args):
+    """目标（本机坐标系）→ 对方两轴角度和距离"""
+    az = math.radians(args.target_az)
+    el = -math.radians(args.target_el)
+    tx = args.range * math.cos(el) * math.sin(az)
+    ty = args.range * math.cos(el) * math.cos(az)
+    tz = args.range * math.sin(el)
+    dx, dy, dz, yaw = args.geo
+    # 平移到对方位置，再按对方零位方位角反向旋转
+    rx, ry, rz = tx - dx, ty - dy, tz - dz
+    c, s = math.cos(math.radians(yaw)), math.sin(math.radians(yaw))
+    px = rx * c - ry * s
+    py = rx * s + ry * c
+    horiz = math.hypot(px, py)
+    return (math.degrees(math.atan2(px, py)), -math.degrees(math.atan2(rz, horiz)),
+            math.sqrt(horiz * horiz + rz * rz))
+
+
+def run(args):
+    fd = open_raw(os.path.join(args.dir, "ttyUART4"))
+    pan, tilt, rng = peer_pointing(args)
+    frame = encode(args.state, pan, tilt, rng)
+    print("peer {} pan={:+.2f} tilt={:+.2f} range={:.1f} m -> {}".format(
+        STATE_NAMES[args.state], pan, tilt, rng, frame.decode().strip()))
+    sys.stdout.flush()
+
+    start = time.monotonic()
+    next_send = start
+    rx = b""
+    last = None
+    while True:
+        now = time.monotonic()
+        if now >= next_send:
+            next_send += SEND_PERIOD_S
+            os.write(fd, frame)
+        try:
+            rx += os.read(fd, 256)
+        except BlockingIOError:
+            pass
+        while b"\n" in rx:
+            line, rx = rx.split(b"\n", 1)
+            cue = decode(line.strip())
+            if cue is None:
+                print("t={:6.1f}s bad frame {!r}".format(now - start, line))
+            elif cue[0] != last:
+                # 状态变化时打印，避免刷屏
+                last = cue[0]
+                print("t={:6.1f}s unit {} pan={:+.2f} tilt={:+.2f} range={:.1f} m".format(
+                    now - start, STATE_NAMES[cue[0]] if cue[0] < 3 else cue[0], cue[1], cue[2], cue[3]))
+            sys.stdout.flush()
+        if args.duration and now - start >= args.duration:
+            break
+        time.sleep(0.005)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PTU simulation inter-unit cue peer")
+    parser.add_argument("--dir", default=".", help="ptu_sim运行目录（ttyUART4所在目录）")
+    parser.add_argument("--target-az", type=float, default=60.0, help="目标方位(度，本机坐标系)，默认60")
+    parser.add_argument("--target-el", type=float, default=-5.0, help="目标俯仰(度，与垂直轴同向)，默认-5")
+    parser.add_argument("--range", type=float, default=20.0, help="目标到本机的距离(m)，默认20")
+    parser.add_argument("--geo", type=float, nargs=4, default=(0.0, 0.0, 0.0, 0.0),
+                        metavar=("DX", "DY", "DZ", "YAW"), help="对方相对本机的几何（与cue geo一致）")
+    parser.add_argument("--state", type=int, choices=(0, 1, 2), default=2, help="发送的目标状态，默认2(锁定)")
+    parser.add_argument("--duration", type=float, default=0.0, help="运行时间(s)，0=一直运行")
+    args = parser.parse_args()
+
+    try:
+        run(args)
+    except OSError as e:
+        print("pty closed ({}), ptu_sim exited".format(e.strerror))
+
+
+if __name__ == "__main__":
+    main()
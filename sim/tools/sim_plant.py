@@ -0,0 +1,515 @@
+# [仿真] 云台对象 + 相机替身
+# 功能：解析STM32发往两路电机的ZDT指令帧 → 积分得到云台角度 → 按目标角度生成"X,Y\n"坐标发给STM32
+# 流程：ptu_sim创建的 ttyUSART3(水平电机) / ttyUSART6(垂直电机) / ttyUSART1(相机) 三个pty
+#       output step时运动由ttySTEP上的脉冲计数"S,水平,垂直"驱动（驱动脉冲端口直接跟随）
+# 用法：python3 sim_plant.py [--dir 仿真运行目录] [--target static|sine|sweep] [--target-az 度] [--target-el 度] [--duration 秒] [--camera-latency-ms 毫秒] [--camera-roll-deg 度]
+#       镜头：[--pixels-per-deg 像素/度] [--zoom 时刻:像素/度]（验证图像雅可比在线估计jac）
+#       负载：[--load 倍数] [--load-change 时刻:倍数]（驱动加速度按倍数降低，验证自校正str）
+#       故障：[--fault-window 起:止] [--cam-drop 概率] [--cam-corrupt 概率] [--stall h|v] [--freeze h|v]
+#       （固件侧故障用fault命令注入，--fault-window只用于统计窗口内误差和窗口结束后的恢复时间）
+# 依赖：仅标准库（Linux）
+
+import argparse
+import collections
+import math
+import os
+import random
+import select
+import sys
+import termios
+import time
+import tty
+
+# === 参数配置 ===
+IMG_WIDTH = 240
+IMG_HEIGHT = 240
+PIXELS_PER_DEGREE = 4.0    # 与maixcam.py一致：像素/度
+CAMERA_FPS = 30            # 坐标帧发送频率(Hz)
+DRIVER_DELAY_S = 0.0015    # 驱动收到运动命令到开始运动的延迟(s)
+
+# 目标（相对云台零位，单位：度）
+TARGET_AZ = 8.0
+TARGET_EL = -5.0
+SINE_AMPLITUDE = 10.0      # sine模式：方位幅值(度)
+SINE_PERIOD_S = 6.0        # sine模式：周期(s)
+SWEEP_AMPLITUDE = 10.0     # sweep模式：方位往返幅值(度)，到端点急停、停留后反向
+SWEEP_SPEED = 15.0         # sweep模式：移动速度(度/秒)
+SWEEP_DWELL_S = 1.0        # sweep模式：端点停留时间(s)
+ERR_STATS_START_S = 5.0    # 跟踪误差统计起始时间(s)，跳过上电自检
+RECOVERY_DEG = 1.0         # 恢复判据：两轴误差都小于该值(度)，大于默认死区（4px）
+RECOVERY_HOLD_S = 0.5      # 并保持该时间(s)
+
+# 电机指令（与APP/Motor.c一致）
+MOTOR_ID_VERTICAL = 0x01
+MOTOR_ID_HORIZONTAL = 0x02
+CMD_POSITION_CONTROL = 0xFD
+CMD_SPEED_CONTROL = 0xF6
+CMD_STOP = 0xFE
+CMD_ENABLE = 0xF3
+CMD_READ_CONFIG = 0x42
+CMD_WRITE_CONFIG = 0x48
+CMD_READ_PID = 0x21
+CMD_WRITE_PID = 0x4A
+CMD_READ_POSITION = 0x36
+CHECKSUM = 0x6B
+FRAME_LEN = {CMD_POSITION_CONTROL: 13, CMD_SPEED_CONTROL: 8, CMD_STOP: 5, CMD_ENABLE: 6,
+             CMD_READ_CONFIG: 4, CMD_WRITE_CONFIG: 33, CMD_READ_PID: 3, CMD_WRITE_PID: 17,
+             CMD_READ_POSITION: 3}
+MOTION_CMDS = (CMD_POSITION_CONTROL, CMD_SPEED_CONTROL, CMD_STOP, CMD_ENABLE)
+CONFIG_RESPONSE_INDEX = 18  # 参数区中"控制命令应答"的位置（1=收到即应答）
+POSITION_COUNTS_PER_REV = 65536
+
+# 驱动参数区（与APP/MotorConfig.c参数表顺序一致，28字节）；出厂值与参数表有差异，用于验证上电同步
+DRIVER_CONFIG = bytes([0x19, 0x02, 0x02, 0x02, 0x00, 0x10, 0x01, 0x00,
+                       0x03, 0xE8, 0x0B, 0xB8, 0x13, 0x88,
+                       0x05, 0x07, 0x00, 0x00, 0x01, 0x01,
+                       0x00, 0x08, 0x09, 0x60, 0x07, 0xD0, 0x00, 0x03])
+DRIVER_PID = (18000, 10, 18000)
+PULSES_PER_DEGREE = 3200.0 / 360.0
+DIR_CW = 0x01
+
+
+class Axis:
+    """单轴步进电机：位置模式按速度走完相对脉冲，速度模式持续转动直到停止"""
+
+    def __init__(self, name):
+        self.name = name
+        self.angle = 0.0       # 当前角度(度)
+        self.goal = None       # 位置模式目标角度
+        self.rate = 0.0        # 目标角速度(度/s)，位置模式下为绝对值
+        self.speed = 0.0       # 当前角速度(度/s)，按加速度档位向目标角速度变化
+        self.accel = None      # 角加速度(度/s^2)，None=不使用曲线
+        self.enabled = True
+        self.config = None     # 驱动参数区（首次读取时按地址生成）
+        self.pid = DRIVER_PID
+        self.frames = 0
+        self.bad_frames = 0
+        self.pending = collections.deque()  # (生效时刻, 帧)：模拟驱动处理延迟
+        self.stalled = False   # 故障：卡死（收到的运动命令不执行，轴不动）
+        self.frozen = None     # 故障：位置读取返回的冻结角度，None=正常
+        self.load = 1.0        # 负载惯量倍数：实际加速度为档位加速度的1/load
+
+    def handle(self, frame, now):
+        """处理一帧指令，返回应答（无应答返回None）；运动命令延迟DRIVER_DELAY_S后生效"""
+        addr = frame[0]
+        cmd = frame[1]
+        if self.config is None:
+            self.config = DRIVER_CONFIG[:16] + bytes([addr]) + DRIVER_CONFIG[17:]
+        if cmd == CMD_READ_CONFIG:
+            return bytes([addr, CMD_READ_CONFIG, 33, 0x15]) + self.config + bytes([CHECKSUM])
+        if cmd == CMD_WRITE_CONFIG:
+            self.config = bytes(frame[4:32])
+            return bytes([addr, CMD_WRITE_CONFIG, 0x02, CHECKSUM])
+        if cmd == CMD_READ_PID:
+            return bytes([addr, CMD_READ_PID]) + b"".join(v.to_bytes(4, "big") for v in self.pid) + bytes([CHECKSUM])
+        if cmd == CMD_WRITE_PID:
+            self.pid = tuple(int.from_bytes(frame[4 + 4 * i:8 + 4 * i], "big") for i in range(3))
+            return bytes([addr, CMD_WRITE_PID, 0x02, CHECKSUM])
+        if cmd == CMD_READ_POSITION:
+            angle = self.angle if self.frozen is None else self.frozen
+            counts = int(round(abs(angle) * POSITION_COUNTS_PER_REV / 360.0))
+            return bytes([addr, CMD_READ_POSITION, 1 if angle < 0 else 0]) + \
+                counts.to_bytes(4, "big") + bytes([CHECKSUM])
+        self.frames += 1
+        self.pending.append((now + DRIVER_DELAY_S, frame))
+        if self.config[CONFIG_RESPONSE_INDEX] == 1:
+            return bytes([addr, cmd, 0x02, CHECKSUM])
+        return None
+
+    def apply(self, frame):
+        cmd = frame[1]
+        if cmd == CMD_POSITION_CONTROL:
+            sign = 1.0 if frame[2] == DIR_CW else -1.0
+            rpm = (frame[3] << 8) | frame[4]
+            pulses = (frame[6] << 24) | (frame[7] << 16) | (frame[8] << 8) | frame[9]
+            base = self.goal if self.goal is not None else self.angle
+            self.goal = base + sign * pulses / PULSES_PER_DEGREE
+            self.rate = rpm * 6.0
+            self.accel = accel_from_level(frame[5], self.load)
+        elif cmd == CMD_SPEED_CONTROL:
+            sign = 1.0 if frame[2] == DIR_CW else -1.0
+            rpm = (frame[3] << 8) | frame[4]
+            self.goal = None
+            self.rate = sign * rpm * 6.0
+            self.accel = accel_from_level(frame[5], self.load)
+        elif cmd == CMD_STOP:
+            self.goal = None
+            self.rate = 0.0
+            self.speed = 0.0
+        elif cmd == CMD_ENABLE:
+            self.enabled = frame[3] != 0
+
+    def step(self, now, dt):
+        if self.stalled:
+            self.pending.clear()
+            self.goal = None
+            self.rate = self.speed = 0.0
+            return
+        while self.pending and self.pending[0][0] <= now:
+            self.apply(self.pending.popleft()[1])
+        if not self.enabled:
+            return
+        if self.goal is None:
+            self.speed = self.ramp(self.speed, self.rate, dt)
+            self.angle += self.speed * dt
+            return
+        delta = self.goal - self.angle
+        direction = 1.0 if delta > 0 else -1.0
+        # 梯形曲线：剩余行程不够减速时开始减速
+        want = self.rate
+        if self.accel is not None:
+            want = min(want, math.sqrt(2.0 * self.accel * abs(delta)))
+        self.speed = self.ramp(self.speed, direction * want, dt)
+        move = abs(self.speed) * dt
+        if abs(delta) <= move or abs(delta) < 1e-6:
+            self.angle = self.goal
+            self.goal = None
+            self.rate = 0.0
+            self.speed = 0.0
+        else:
+            self.angle += move if delta > 0 else -move
+
+    def pulses(self, n):
+        """脉冲端口：闭环驱动直接跟随脉冲"""
+        if self.enabled and not self.stalled:
+            self.angle += n / PULSES_PER_DEGREE
+            if self.goal is not None:
+                self.goal += n / PULSES_PER_DEGREE
+
+    def ramp(self, speed, target, dt):
+        if self.accel is None:
+            return target
+        step = self.accel * dt
+        if abs(target - speed) <= step:
+            return target
+        return speed + (step if target > speed else -step)
+
+
+def accel_from_level(acc, load=1.0):
+    """加速度档位→角加速度：每(256-acc)*50us速度变化1RPM，acc=0不使用曲线；负载加重时按倍数降低"""
+    if acc == 0:
+        return None
+    return 6.0 / ((256 - acc) * 50e-6) / load
+
+
+class MotorPort:
+    """电机串口：按功能码确定帧长并校验0x6B"""
+
+    def __init__(self, path, axis):
+        self.fd = open_raw(path)
+        self.axis = axis
+        self.buf = bytearray()
+
+    def poll(self):
+        try:
+            data = os.read(self.fd, 256)
+        except BlockingIOError:
+            return
+        self.buf.extend(data)
+        while len(self.buf) >= 2:
+            length = FRAME_LEN.get(self.buf[1])
+            if length is None:
+                del self.buf[0]
+                self.axis.bad_frames += 1
+                continue
+            if len(self.buf) < length:
+                break
+            frame = bytes(self.buf[:length])
+            if frame[-1] != CHECKSUM:
+                del self.buf[0]
+                self.axis.bad_frames += 1
+                continue
+            del self.buf[:length]
+            reply = self.axis.handle(frame, time.monotonic())
+            if reply:
+                try:
+                    os.write(self.fd, reply)
+                except BlockingIOError:
+                    pass   # STM32未读取应答（运动命令应答通常不读），缓冲区满时丢弃
+
+
+def open_raw(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        attrs = termios.tcgetattr(fd)
+        attrs[4] = attrs[5] = termios.B115200
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def target_angles(args, t):
+    if args.target == "sine":
+        return args.target_az + SINE_AMPLITUDE * math.sin(2.0 * math.pi * t / SINE_PERIOD_S), args.target_el
+    if args.target == "sweep":
+        travel = 2.0 * SWEEP_AMPLITUDE / SWEEP_SPEED
+        phase = t % (2.0 * (travel + SWEEP_DWELL_S))
+        if phase < travel:
+            offset = -SWEEP_AMPLITUDE + SWEEP_SPEED * phase
+        elif phase < travel + SWEEP_DWELL_S:
+            offset = SWEEP_AMPLITUDE
+        elif phase < 2.0 * travel + SWEEP_DWELL_S:
+            offset = SWEEP_AMPLITUDE - SWEEP_SPEED * (phase - travel - SWEEP_DWELL_S)
+        else:
+            offset = -SWEEP_AMPLITUDE
+        return args.target_az + offset, args.target_el
+    return args.target_az, args.target_el
+
+
+class FaultStats:
+    """故障窗口内的跟踪误差和窗口结束后的恢复时间（按相机帧时刻的真实误差，不论目标是否在视野内）"""
+
+    def __init__(self, window, threshold):
+        self.window = window
+        self.threshold = threshold
+        self.n = 0
+        self.sq = [0.0, 0.0]
+        self.max = [0.0, 0.0]
+        self.settle_start = None
+        self.recovery = None
+
+    def add(self, t, err):
+        start, end = self.window
+        if start <= t < end:
+            self.n += 1
+            for i, e in enumerate(err):
+                self.sq[i] += e * e
+                self.max[i] = max(self.max[i], abs(e))
+        elif t >= end and self.recovery is None:
+            if max(abs(e) for e in err) < self.threshold:
+                if self.settle_start is None:
+                    self.settle_start = t
+                if t - self.settle_start >= RECOVERY_HOLD_S:
+                    self.recovery = self.settle_start - end
+            else:
+                self.settle_start = None
+
+    def report(self):
+        start, end = self.window
+        if self.n:
+            print("fault window {:.1f}-{:.1f}s: rms=({:.3f},{:.3f}) max=({:.3f},{:.3f}) deg over {} frames".format(
+                start, end, math.sqrt(self.sq[0] / self.n), math.sqrt(self.sq[1] / self.n),
+                self.max[0], self.max[1], self.n))
+        if self.recovery is not None:
+            print("recovery: {:.2f}s after window (|err|<{} deg for {} s)".format(
+                self.recovery, self.threshold, RECOVERY_HOLD_S))
+        else:
+            print("recovery: not recovered before end of run")
+
+
+def corrupt_frame(line):
+    """随机翻转一个字节中的一位"""
+    data = bytearray(line)
+    i = random.randrange(len(data))
+    data[i] ^= 1 << random.randrange(8)
+    return bytes(data)
+
+
+def run(args):
+    pan = Axis("pan")
+    tilt = Axis("tilt")
+    ports = [MotorPort(os.path.join(args.dir, "ttyUSART3"), pan),
+             MotorPort(os.path.join(args.dir, "ttyUSART6"), tilt)]
+    cam_fd = open_raw(os.path.join(args.dir, "ttyUSART1"))
+    step_path = os.path.join(args.dir, "ttySTEP")
+    step_fd = None      # Motor_Init之后才创建，出现后再打开
+    step_rx = b""
+
+    start = time.monotonic()
+    last = start
+    next_frame = start
+    next_log = start
+    err_n = 0              # 跟踪误差统计（目标在视野内的相机帧，按当时的真实云台角度）
+    err_sq = [0.0, 0.0]
+    err_max = [0.0, 0.0]
+    hit_sq = [0.0, 0.0]    # 命中误差：当前视轴与载荷延迟之后的目标位置之差（载荷此刻动作，延迟后生效）
+    hit_max = [0.0, 0.0]
+    payload_latency = args.payload_latency_ms / 1000.0
+    frame_period = 1.0 / CAMERA_FPS
+    history = collections.deque()   # (时刻, 水平角, 垂直角)，用于相机延迟
+    cam_latency = args.camera_latency_ms / 1000.0
+    cam_rx = b""
+    roll_cos = math.cos(math.radians(args.camera_roll_deg))
+    roll_sin = math.sin(math.radians(args.camera_roll_deg))
+    fault = FaultStats(args.fault_window, args.recovery_deg) if args.fault_window else None
+    fault_axes = {"h": pan, "v": tilt}
+    fault_on = False
+
+    while True:
+        wake = next_frame
+        for axis in (pan, tilt):
+            if axis.pending:
+                wake = min(wake, axis.pending[0][0])
+            if axis.goal is not None or axis.speed != 0.0:
+                wake = min(wake, last + 0.001)   # 运动中按1ms积分
+        timeout = max(0.0, wake - time.monotonic())
+        if step_fd is None and os.path.exists(step_path):
+            step_fd = open_raw(step_path)
+        fds = [p.fd for p in ports] + [cam_fd] + ([step_fd] if step_fd is not None else [])
+        readable, _, _ = select.select(fds, [], [], timeout)
+
+        # 先积分到当前时刻，位置读取应答使用最新角度
+        now = time.monotonic()
+        pan.step(now, now - last)
+        tilt.step(now, now - last)
+        last = now
+        t = now - start
+        history.append((now, pan.angle, tilt.angle))
+        while len(history) > 1 and history[1][0] <= now - cam_latency:
+            history.popleft()
+
+        # 负载变化（两轴同时）
+        load = args.load_change[1] if args.load_change and t >= args.load_change[0] else args.load
+        if load != pan.load:
+            pan.load = tilt.load = load
+            print("t={:6.1f}s load x{:g}".format(t, load))
+
+        # 故障窗口：进入时设置卡死/冻结，离开时解除
+        in_window = fault is not None and fault.window[0] <= t < fault.window[1]
+        if in_window != fault_on:
+            fault_on = in_window
+            if args.stall:
+                fault_axes[args.stall].stalled = fault_on
+            if args.freeze:
+                axis = fault_axes[args.freeze]
+                axis.frozen = axis.angle if fault_on else None
+            print("t={:6.1f}s fault {}".format(t, "on" if fault_on else "off"))
+
+        for p in ports:
+            if p.fd in readable:
+                p.poll()
+        if step_fd is not None and step_fd in readable:
+            try:
+                step_rx += os.read(step_fd, 1024)
+            except BlockingIOError:
+                pass
+            while b"\n" in step_rx:
+                line, step_rx = step_rx.split(b"\n", 1)
+                fields = line.split(b",")
+                if len(fields) == 3 and fields[0] == b"S":
+                    pan.pulses(int(fields[1]))
+                    tilt.pulses(int(fields[2]))
+        if cam_fd in readable:
+            try:
+                cam_rx += os.read(cam_fd, 256)
+            except BlockingIOError:
+                pass
+            # 下行"R,..."帧：仿真中忽略；压力测试的"L,..."回环帧原样回送
+            while b"\n" in cam_rx:
+                line, cam_rx = cam_rx.split(b"\n", 1)
+                if line.startswith(b"L,"):
+                    os.write(cam_fd, line + b"\n")
+            if len(cam_rx) > 64:
+                cam_rx = b""
+
+        if now >= next_frame:
+            next_frame += frame_period
+            az, el = target_angles(args, t - cam_latency)
+            _, pan_seen, tilt_seen = history[0]
+            # 相机绕光轴滚转：云台坐标系下的偏差旋转到图像坐标系
+            ppd = args.zoom[1] if args.zoom and t >= args.zoom[0] else args.pixels_per_deg
+            ex = (az - pan_seen) * ppd
+            ey = (el - tilt_seen) * ppd
+            x = int(round(IMG_WIDTH / 2 + ex * roll_cos - ey * roll_sin))
+            y = int(round(IMG_HEIGHT / 2 + ex * roll_sin + ey * roll_cos))
+            # 与maixcam一致每帧都发送，目标不在视野内时发送"0,0"
+            if fault is not None:
+                fault.add(t, (az - pan.angle, el - tilt.angle))
+            if not (0 <= x < IMG_WIDTH and 0 <= y < IMG_HEIGHT):
+                x = y = 0
+            elif t >= ERR_STATS_START_S:
+                err_n += 1
+                for i, e in enumerate((az - pan.angle, el - tilt.angle)):
+                    err_sq[i] += e * e
+                    err_max[i] = max(err_max[i], abs(e))
+                az_hit, el_hit = target_angles(args, t + payload_latency)
+                for i, e in enumerate((az_hit - pan.angle, el_hit - tilt.angle)):
+                    hit_sq[i] += e * e
+                    hit_max[i] = max(hit_max[i], abs(e))
+            frame = "{},{}\n".format(x, y).encode()
+            if fault_on and args.cam_corrupt and random.random() < args.cam_corrupt:
+                frame = corrupt_frame(frame)
+            if not (fault_on and args.cam_drop and random.random() < args.cam_drop):
+                os.write(cam_fd, frame)
+
+        if now >= next_log:
+            next_log += 1.0
+            az, el = target_angles(args, t)
+            print("t={:6.1f}s pan={:+7.2f} tilt={:+7.2f} err=({:+6.2f},{:+6.2f}) frames={}/{} bad={}/{}".format(
+                t, pan.angle, tilt.angle, az - pan.angle, el - tilt.angle,
+                pan.frames, tilt.frames, pan.bad_frames, tilt.bad_frames))
+            sys.stdout.flush()
+
+        if args.duration and t >= args.duration:
+            break
+
+    if err_n:
+        print("tracking error: rms=({:.3f},{:.3f}) max=({:.3f},{:.3f}) deg over {} frames".format(
+            math.sqrt(err_sq[0] / err_n), math.sqrt(err_sq[1] / err_n), err_max[0], err_max[1], err_n))
+        if payload_latency > 0.0:
+            print("hit error ({:.0f}ms payload): rms=({:.3f},{:.3f}) max=({:.3f},{:.3f}) deg".format(
+                args.payload_latency_ms, math.sqrt(hit_sq[0] / err_n), math.sqrt(hit_sq[1] / err_n),
+                hit_max[0], hit_max[1]))
+    if fault is not None:
+        fault.report()
+
+
+def parse_window(text):
+    start, sep, end = text.partition(":")
+    if not sep or float(end) <= float(start):
+        raise argparse.ArgumentTypeError("格式为 起:止（秒）")
+    return float(start), float(end)
+
+
+def parse_change(text):
+    try:
+        when, value = text.split(":")
+        return float(when), float(value)
+    except ValueError:
+        raise argparse.ArgumentTypeError("格式为 时刻:值")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PTU simulation plant")
+    parser.add_argument("--dir", default=".", help="ptu_sim运行目录（ttyUSARTx所在目录）")
+    parser.add_argument("--target", choices=("static", "sine", "sweep"), default="static")
+    parser.add_argument("--target-az", type=float, default=TARGET_AZ,
+                        help="目标方位(度)，默认{}；超出视场(±30°)时需要引导(cue)才能捕获".format(TARGET_AZ))
+    parser.add_argument("--target-el", type=float, default=TARGET_EL,
+                        help="目标俯仰(度，与垂直轴同向)，默认{}".format(TARGET_EL))
+    parser.add_argument("--duration", type=float, default=0.0, help="运行时间(s)，0=一直运行")
+    parser.add_argument("--camera-latency-ms", type=float, default=0.0,
+                        help="相机延迟(ms)：坐标按该时间之前的云台角度计算，默认0")
+    parser.add_argument("--camera-roll-deg", type=float, default=0.0,
+                        help="相机相对云台的滚转角(度)，用于验证calib标定，默认0")
+    parser.add_argument("--pixels-per-deg", type=float, default=PIXELS_PER_DEGREE,
+                        help="相机像素/度（模拟变焦、目标距离变化），默认{}".format(PIXELS_PER_DEGREE))
+    parser.add_argument("--zoom", type=parse_change, default=None, metavar="T:PPD",
+                        help="运行到T秒时像素/度变为PPD（变焦阶跃）")
+    parser.add_argument("--load", type=float, default=1.0,
+                        help="负载惯量倍数：驱动加速度按该倍数降低（模拟更重的载荷），默认1")
+    parser.add_argument("--load-change", type=parse_change, default=None, metavar="T:X",
+                        help="运行到T秒时负载倍数变为X")
+    parser.add_argument("--payload-latency-ms", type=float, default=0.0,
+                        help="载荷响应延迟(ms)：另外统计视轴与该时间之后目标位置的命中误差（验证lead），默认0")
+    parser.add_argument("--fault-window", type=parse_window, default=None, metavar="START:END",
+                        help="故障窗口(s)：窗口内施加以下对象侧故障，统计窗口内误差和结束后的恢复时间")
+    parser.add_argument("--recovery-deg", type=float, default=RECOVERY_DEG,
+                        help="恢复判据(度)：两轴误差都小于该值并保持{}s，默认{}".format(RECOVERY_HOLD_S, RECOVERY_DEG))
+    parser.add_argument("--cam-drop", type=float, default=0.0, help="窗口内相机帧丢弃概率(0~1)")
+    parser.add_argument("--cam-corrupt", type=float, default=0.0, help="窗口内相机帧翻转一位的概率(0~1)")
+    parser.add_argument("--stall", choices=("h", "v"), help="窗口内该轴卡死（忽略运动命令）")
+    parser.add_argument("--freeze", choices=("h", "v"), help="窗口内该轴位置读取保持窗口开始时的角度")
+    args = parser.parse_args()
+    if (args.cam_drop or args.cam_corrupt or args.stall or args.freeze) and not args.fault_window:
+        parser.error("--cam-drop/--cam-corrupt/--stall/--freeze需要--fault-window")
+
+    try:
+        run(args)
+    except OSError as e:
+        # ptu_sim退出后pty主端关闭，读写返回EIO
+        print("pty closed ({}), ptu_sim exited".format(e.strerror))
+
+
+if __name__ == "__main__":
+    main()